@@ -0,0 +1,166 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "crypto_desc.h"
+#include "dbrandom.h"
+#include "cpufeatures.h"
+#include "bench.h"
+
+#define BENCH_MAX_COLUMNS 16
+
+struct bench_opts bench_opts;
+
+static unsigned int column_widths[BENCH_MAX_COLUMNS];
+static unsigned int num_columns;
+static unsigned int cur_column;
+
+static void bench_usage(const char *progname, const char *usage_extra) {
+	fprintf(stderr, "Usage: %s [options]\n"
+		"-m		Machine readable (CSV) output\n"
+		"-t <seconds>	Minimum time per measurement (default %.2f)\n"
+		"-f <GHz>	Clock rate to estimate cycles if there's no cycle counter\n"
+		"-a <name>	Only run algorithms containing name\n"
+		"-s		Use the portable code rather than CPU crypto instructions\n"
+		"%s",
+		progname, bench_opts.seconds, usage_extra ? usage_extra : "");
+}
+
+int bench_getopts(int argc, char **argv, const char *usage_extra) {
+	int i;
+
+	bench_opts.machine = 0;
+	bench_opts.seconds = 0.1;
+	bench_opts.ghz = 0;
+	bench_opts.filter = NULL;
+
+	for (i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		if (strcmp(arg, "-m") == 0) {
+			bench_opts.machine = 1;
+		} else if (strcmp(arg, "-t") == 0 && i+1 < argc) {
+			bench_opts.seconds = atof(argv[++i]);
+		} else if (strcmp(arg, "-f") == 0 && i+1 < argc) {
+			bench_opts.ghz = atof(argv[++i]);
+		} else if (strcmp(arg, "-a") == 0 && i+1 < argc) {
+			bench_opts.filter = argv[++i];
+		} else if (strcmp(arg, "-s") == 0) {
+			cpu_disable(~0U);
+		} else if (arg[0] == '-' && strcmp(arg, "--") != 0) {
+			bench_usage(argv[0], usage_extra);
+			exit(EXIT_FAILURE);
+		} else {
+			if (strcmp(arg, "--") == 0) {
+				i++;
+			}
+			break;
+		}
+	}
+
+	if (bench_opts.seconds <= 0) {
+		bench_opts.seconds = 0.1;
+	}
+	return i;
+}
+
+void bench_init() {
+	crypto_init();
+	seedrandom();
+}
+
+int bench_match(const char *name) {
+	return bench_opts.filter == NULL || strstr(name, bench_opts.filter) != NULL;
+}
+
+uint64_t bench_nsec() {
+	struct timespec now;
+	gettime_wrapper(&now);
+	return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+uint64_t bench_cycles() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	unsigned int lo, hi;
+	__asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+	return ((uint64_t)hi << 32) | lo;
+#else
+	return 0;
+#endif
+}
+
+void bench_timer_start(struct bench_timer *t) {
+	t->start_ns = bench_nsec();
+	t->start_cycles = bench_cycles();
+}
+
+void bench_timer_stop(struct bench_timer *t) {
+	t->total_cycles += bench_cycles() - t->start_cycles;
+	t->total_ns += bench_nsec() - t->start_ns;
+}
+
+double bench_timer_cycles(const struct bench_timer *t) {
+	if (t->total_cycles > 0) {
+		return (double)t->total_cycles;
+	}
+	if (bench_opts.ghz > 0) {
+		return t->total_ns * bench_opts.ghz;
+	}
+	return -1;
+}
+
+void bench_print_header(const char *const *columns, const unsigned int *widths) {
+	unsigned int i;
+
+	for (i = 0; columns[i] && i < BENCH_MAX_COLUMNS; i++) {
+		column_widths[i] = MAX(strlen(columns[i]), 8);
+		if (widths) {
+			column_widths[i] = MAX(column_widths[i], widths[i]);
+		}
+	}
+	num_columns = i;
+	cur_column = 0;
+
+	for (i = 0; i < num_columns; i++) {
+		bench_print_str(columns[i]);
+	}
+	bench_print_end();
+}
+
+static void print_field(const char *val) {
+	unsigned int width = 0;
+	if (cur_column + 1 < num_columns) {
+		/* last column isn't padded */
+		width = column_widths[cur_column];
+	}
+	if (bench_opts.machine) {
+		printf("%s%s", cur_column > 0 ? "," : "", val);
+	} else {
+		printf("%s%-*s", cur_column > 0 ? "  " : "", width, val);
+	}
+	cur_column++;
+}
+
+void bench_print_str(const char *val) {
+	print_field(val);
+}
+
+void bench_print_uint(unsigned long val) {
+	char str[30];
+	snprintf(str, sizeof(str), "%lu", val);
+	print_field(str);
+}
+
+void bench_print_double(double val) {
+	char str[40];
+	if (val < 0) {
+		/* not measured */
+		print_field(bench_opts.machine ? "" : "-");
+		return;
+	}
+	snprintf(str, sizeof(str), "%.2f", val);
+	print_field(str);
+}
+
+void bench_print_end() {
+	printf("\n");
+	cur_column = 0;
+	fflush(stdout);
+}
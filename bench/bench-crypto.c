@@ -0,0 +1,294 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "algo.h"
+#include "session.h"
+#include "packet.h"
+#include "dbrandom.h"
+#include "bench.h"
+
+/* Measures packet encryption and decryption throughput for each
+ * cipher and MAC combination, using the same cipher mode and make_mac()
+ * code as a session. AEAD modes are run with their own MAC. The "none"
+ * cipher or MAC rows give the cost of each part separately. */
+
+static const unsigned int default_sizes[] = {
+	64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384, 32768
+};
+
+/* Packets are encrypted in batches of about this many bytes then
+ * decrypted again, so that stateful modes stay in sync */
+#define BATCH_BYTES (256*1024)
+
+struct bench_result {
+	struct bench_timer timer;
+	unsigned long bytes;
+};
+
+static const char *const columns[] = {
+	"cipher", "mac", "size", "direction", "MB/s", "cycles/byte", NULL
+};
+static const unsigned int column_widths[] = {
+	29, 13, 5, 9, 8, 11
+};
+
+static void setup_directional(struct key_context_directional *key_state,
+		const struct dropbear_cipher *cipher,
+		const struct dropbear_cipher_mode *mode,
+		const struct dropbear_hash *mac) {
+	unsigned char key[MAX_KEY_LEN];
+	unsigned char iv[MAX_IV_LEN];
+
+	memset(key_state, 0x0, sizeof(*key_state));
+	key_state->algo_crypt = cipher;
+	key_state->crypt_mode = mode;
+	key_state->algo_mac = mac;
+
+	/* Both directions need the same keys */
+	memset(key, 0x42, sizeof(key));
+	memset(iv, 0x24, sizeof(iv));
+
+	if (cipher->cipherdesc != NULL) {
+		int cipher_index = -1;
+		if (cipher->cipherdesc->name != NULL) {
+			cipher_index = find_cipher(cipher->cipherdesc->name);
+			if (cipher_index < 0) {
+				dropbear_exit("Crypto error");
+			}
+		}
+		if (mode->start(cipher_index, iv, key, cipher->keysize, 0,
+				&key_state->cipher_state) != CRYPT_OK) {
+			dropbear_exit("Crypto error");
+		}
+	}
+
+	if (mac->hash_desc != NULL) {
+		memset(key_state->mackey, 0x11, mac->keysize);
+		key_state->hash_index = find_hash(mac->hash_desc->name);
+		setup_mac_key(key_state);
+	}
+}
+
+static void encrypt_one(struct key_context_directional *trans,
+		unsigned int seq, buffer *pkt, unsigned int len) {
+	unsigned char mac_bytes[MAX_MAC_LEN];
+	unsigned int mac_size = trans->algo_mac->hashsize;
+
+	if (trans->crypt_mode->aead_crypt) {
+		buf_setlen(pkt, len + mac_size);
+		buf_setpos(pkt, 0);
+		if (trans->crypt_mode->aead_crypt(seq,
+					buf_getptr(pkt, len),
+					buf_getwriteptr(pkt, len + mac_size),
+					len, mac_size,
+					&trans->cipher_state, LTC_ENCRYPT) != CRYPT_OK) {
+			dropbear_exit("Error encrypting");
+		}
+		return;
+	}
+
+	buf_setlen(pkt, len);
+	make_mac(seq, trans, pkt, len, mac_bytes);
+	buf_setpos(pkt, 0);
+	if (trans->crypt_mode->encrypt(
+				buf_getptr(pkt, len),
+				buf_getwriteptr(pkt, len),
+				len,
+				&trans->cipher_state) != CRYPT_OK) {
+		dropbear_exit("Error encrypting");
+	}
+	buf_setpos(pkt, len);
+	buf_putbytes(pkt, mac_bytes, mac_size);
+}
+
+static void decrypt_one(struct key_context_directional *recv,
+		unsigned int seq, buffer *pkt, unsigned int len) {
+	unsigned char mac_bytes[MAX_MAC_LEN];
+	unsigned int mac_size = recv->algo_mac->hashsize;
+
+	buf_setpos(pkt, 0);
+	if (recv->crypt_mode->aead_crypt) {
+		unsigned int plen;
+		if (recv->crypt_mode->aead_getlength(seq,
+					buf_getptr(pkt, recv->algo_crypt->blocksize), &plen,
+					recv->algo_crypt->blocksize,
+					&recv->cipher_state) != CRYPT_OK) {
+			dropbear_exit("Error decrypting");
+		}
+		if (recv->crypt_mode->aead_crypt(seq,
+					buf_getptr(pkt, len + mac_size),
+					buf_getwriteptr(pkt, len),
+					len, mac_size,
+					&recv->cipher_state, LTC_DECRYPT) != CRYPT_OK) {
+			dropbear_exit("Integrity error");
+		}
+		return;
+	}
+
+	if (recv->crypt_mode->decrypt(
+				buf_getptr(pkt, len),
+				buf_getwriteptr(pkt, len),
+				len,
+				&recv->cipher_state) != CRYPT_OK) {
+		dropbear_exit("Error decrypting");
+	}
+	make_mac(seq, recv, pkt, len, mac_bytes);
+	buf_setpos(pkt, len);
+	if (constant_time_memcmp(mac_bytes, buf_getptr(pkt, mac_size), mac_size) != 0) {
+		dropbear_exit("Integrity error");
+	}
+}
+
+static void print_result(const char *ciphername, const char *macname,
+		unsigned int size, const char *direction,
+		const struct bench_result *result) {
+	double seconds = result->timer.total_ns / 1e9;
+	double cycles = bench_timer_cycles(&result->timer);
+
+	bench_print_str(ciphername);
+	bench_print_str(macname);
+	bench_print_uint(size);
+	bench_print_str(direction);
+	bench_print_double(result->bytes / seconds / 1e6);
+	bench_print_double(cycles < 0 ? -1 : cycles / result->bytes);
+	bench_print_end();
+}
+
+static void bench_mode(const char *ciphername,
+		const struct dropbear_cipher *cipher,
+		const struct dropbear_cipher_mode *mode,
+		const char *macname,
+		const struct dropbear_hash *mac,
+		unsigned int size) {
+	struct key_context_directional *trans = NULL, *recv = NULL;
+	struct bench_result enc, dec;
+	buffer *plain = NULL;
+	buffer **pkts = NULL;
+	unsigned int npackets, len, i;
+	unsigned int trans_seq = 0, recv_seq = 0;
+	uint64_t target_ns = bench_opts.seconds * 1e9;
+
+	trans = m_malloc(sizeof(*trans));
+	recv = m_malloc(sizeof(*recv));
+	setup_directional(trans, cipher, mode, mac);
+	setup_directional(recv, cipher, mode, mac);
+
+	/* AEAD packet lengths exclude the length field */
+	len = size + (mode->aead_crypt ? 4 : 0);
+	npackets = MAX(1, BATCH_BYTES / size);
+
+	plain = buf_new(len);
+	genrandom(buf_getwriteptr(plain, len), len);
+	buf_incrwritepos(plain, len);
+	pkts = m_malloc(npackets * sizeof(buffer*));
+	for (i = 0; i < npackets; i++) {
+		pkts[i] = buf_new(len + MAX_MAC_LEN);
+	}
+
+	memset(&enc, 0x0, sizeof(enc));
+	memset(&dec, 0x0, sizeof(dec));
+	while (enc.timer.total_ns < target_ns || dec.timer.total_ns < target_ns) {
+		for (i = 0; i < npackets; i++) {
+			buf_setpos(pkts[i], 0);
+			buf_putbytes(pkts[i], plain->data, len);
+		}
+
+		bench_timer_start(&enc.timer);
+		for (i = 0; i < npackets; i++) {
+			encrypt_one(trans, trans_seq, pkts[i], len);
+			trans_seq++;
+		}
+		bench_timer_stop(&enc.timer);
+		enc.bytes += npackets * size;
+
+		bench_timer_start(&dec.timer);
+		for (i = 0; i < npackets; i++) {
+			decrypt_one(recv, recv_seq, pkts[i], len);
+			recv_seq++;
+		}
+		bench_timer_stop(&dec.timer);
+		dec.bytes += npackets * size;
+	}
+
+	if (memcmp(pkts[0]->data, plain->data, len) != 0) {
+		dropbear_exit("Decrypted data mismatch for %s %s", ciphername, macname);
+	}
+
+	print_result(ciphername, macname, size, "encrypt", &enc);
+	print_result(ciphername, macname, size, "decrypt", &dec);
+
+	for (i = 0; i < npackets; i++) {
+		buf_free(pkts[i]);
+	}
+	m_free(pkts);
+	buf_free(plain);
+	m_burn(trans, sizeof(*trans));
+	m_burn(recv, sizeof(*recv));
+	m_free(trans);
+	m_free(recv);
+}
+
+static void bench_cipher(const char *ciphername,
+		const struct dropbear_cipher *cipher,
+		const struct dropbear_cipher_mode *mode,
+		unsigned int size) {
+	unsigned int i;
+
+	if (mode->aead_crypt) {
+		if (bench_match(ciphername)) {
+			bench_mode(ciphername, cipher, mode, "-", mode->aead_mac, size);
+		}
+		return;
+	}
+
+	if (mode != &dropbear_mode_none && bench_match(ciphername)) {
+		bench_mode(ciphername, cipher, mode, "none", &dropbear_nohash, size);
+	}
+
+	for (i = 0; sshhashes[i].name != NULL; i++) {
+		if (bench_match(ciphername) || bench_match(sshhashes[i].name)) {
+			bench_mode(ciphername, cipher, mode, sshhashes[i].name,
+				(const struct dropbear_hash*)sshhashes[i].data, size);
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	unsigned int *sizes = NULL;
+	unsigned int nsizes, i, s;
+	int argi;
+
+	argi = bench_getopts(argc, argv,
+		"[size ...]	Packet sizes to test (default 64 to 32768)\n");
+	bench_init();
+
+	nsizes = argc - argi;
+	if (nsizes > 0) {
+		sizes = m_malloc(nsizes * sizeof(unsigned int));
+		for (i = 0; i < nsizes; i++) {
+			sizes[i] = atoi(argv[argi + i]);
+			/* whole blocks for any cipher */
+			if (sizes[i] < 16 || sizes[i] % 16 != 0) {
+				dropbear_exit("Size must be a multiple of 16");
+			}
+		}
+	} else {
+		nsizes = sizeof(default_sizes) / sizeof(default_sizes[0]);
+		sizes = m_malloc(sizeof(default_sizes));
+		memcpy(sizes, default_sizes, sizeof(default_sizes));
+	}
+
+	bench_print_header(columns, column_widths);
+
+	for (s = 0; s < nsizes; s++) {
+		for (i = 0; sshciphers[i].name != NULL; i++) {
+			bench_cipher(sshciphers[i].name,
+				(const struct dropbear_cipher*)sshciphers[i].data,
+				(const struct dropbear_cipher_mode*)sshciphers[i].mode,
+				sizes[s]);
+		}
+		bench_cipher("none", &dropbear_nocipher, &dropbear_mode_none, sizes[s]);
+	}
+
+	m_free(sizes);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,600 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "session.h"
+#include "kex.h"
+#include "curve25519.h"
+#include "rsa.h"
+#include "genrsa.h"
+#include "dbrandom.h"
+#include "algo.h"
+#include "bignum.h"
+#include "dh_groups.h"
+#include "ecc.h"
+#include "ecdsa.h"
+#include "sntrup761.h"
+#include "sntrup761-accel.h"
+#include "cpufeatures.h"
+#include "bench.h"
+
+/* Measures the public key operations of a key exchange: generating the
+ * ephemeral key, deriving the shared secret and signing or verifying the
+ * exchange hash with the host key. The handshake rows combine those into
+ * the work done by a server or client for one connection. */
+
+static const char *const columns[] = {
+	"operation", "ops/s", "usec/op", "cycles/op", NULL
+};
+static const unsigned int column_widths[] = {
+	26, 10, 10, 12
+};
+
+/* Stand in for the exchange hash */
+static unsigned char exchange_hash[SHA256_HASH_SIZE];
+
+#if DROPBEAR_CURVE25519_DEP
+static buffer *curve25519_peer;
+
+static void curve25519_setup(void) {
+	struct kex_curve25519_param *peer = gen_kexcurve25519_param();
+	curve25519_peer = buf_new(CURVE25519_LEN);
+	buf_putbytes(curve25519_peer, peer->pub, CURVE25519_LEN);
+	buf_setpos(curve25519_peer, 0);
+	free_kexcurve25519_param(peer);
+}
+
+static void curve25519_keygen(void) {
+	free_kexcurve25519_param(gen_kexcurve25519_param());
+}
+
+static void curve25519_derive(void) {
+	static struct kex_curve25519_param *param = NULL;
+	unsigned char out[CURVE25519_LEN];
+
+	if (param == NULL) {
+		param = gen_kexcurve25519_param();
+	}
+	kexcurve25519_derive(param, curve25519_peer, out);
+}
+
+static void curve25519_exchange(void) {
+	struct kex_curve25519_param *param = gen_kexcurve25519_param();
+	unsigned char out[CURVE25519_LEN];
+
+	kexcurve25519_derive(param, curve25519_peer, out);
+	free_kexcurve25519_param(param);
+}
+#endif /* DROPBEAR_CURVE25519_DEP */
+
+#if DROPBEAR_NORMAL_DH
+/* Ephemeral keys come from kex-dh.c, the exptmod rows do the same with
+ * libtommath's general mp_exptmod() for comparison */
+static struct key_context dh_keys;
+static const char *dh_kexname;
+static struct kex_dh_param *dh_peer;
+static mp_int dh_p;
+
+static void dh_select(const char *kexname) {
+	unsigned int i;
+	const struct dropbear_kex *kex = NULL;
+	DEF_MP_INT(check);
+	DEF_MP_INT(g);
+
+	if (dh_kexname == kexname) {
+		return;
+	}
+	for (i = 0; sshkex[i].name != NULL; i++) {
+		if (strcmp(sshkex[i].name, kexname) == 0) {
+			kex = sshkex[i].data;
+		}
+	}
+	if (kex == NULL) {
+		dropbear_exit("no kex %s", kexname);
+	}
+
+	if (dh_kexname == NULL) {
+		m_mp_init(&dh_p);
+	} else {
+		free_kexdh_param(dh_peer);
+	}
+	dh_kexname = kexname;
+	dh_keys.algo_kex = kex;
+	ses.newkeys = &dh_keys;
+	bytes_to_mp(&dh_p, kex->dh_p_bytes, kex->dh_p_len);
+	dh_peer = gen_kexdh_param();
+
+	/* the engine must agree with mp_exptmod() */
+	m_mp_init_multi(&check, &g, NULL);
+	mp_set_ul(&g, DH_G_VAL);
+	if (mp_exptmod(&g, &dh_peer->priv, &dh_p, &check) != MP_OKAY
+			|| mp_cmp(&check, &dh_peer->pub) != MP_EQ) {
+		dropbear_exit("%s keygen mismatch", kexname);
+	}
+	mp_clear_multi(&check, &g, NULL);
+}
+
+static void dh_keygen(const char *kexname) {
+	dh_select(kexname);
+	free_kexdh_param(gen_kexdh_param());
+}
+
+static void dh_keygen_exptmod(const char *kexname) {
+	DEF_MP_INT(g);
+	DEF_MP_INT(pub);
+
+	dh_select(kexname);
+	m_mp_init_multi(&g, &pub, NULL);
+	mp_set_ul(&g, DH_G_VAL);
+	if (mp_exptmod(&g, &dh_peer->priv, &dh_p, &pub) != MP_OKAY) {
+		dropbear_exit("mp_exptmod failed");
+	}
+	mp_clear_multi(&g, &pub, NULL);
+}
+
+/* The shared secret, as kexdh_comb_key() computes it */
+static void dh_derive(const char *kexname) {
+	DEF_MP_INT(k);
+
+	dh_select(kexname);
+	m_mp_init(&k);
+	if (mp_exptmod(&dh_peer->pub, &dh_peer->priv, &dh_p, &k) != MP_OKAY) {
+		dropbear_exit("mp_exptmod failed");
+	}
+	mp_clear(&k);
+}
+
+#if DROPBEAR_DH_GROUP14
+#if DROPBEAR_DH_GROUP14_SHA256
+#define DH14_NAME "diffie-hellman-group14-sha256"
+#else
+#define DH14_NAME "diffie-hellman-group14-sha1"
+#endif
+static void dh14_keygen(void) { dh_keygen(DH14_NAME); }
+static void dh14_keygen_exptmod(void) { dh_keygen_exptmod(DH14_NAME); }
+static void dh14_derive(void) { dh_derive(DH14_NAME); }
+#endif
+#if DROPBEAR_DH_GROUP16
+#define DH16_NAME "diffie-hellman-group16-sha512"
+static void dh16_keygen(void) { dh_keygen(DH16_NAME); }
+static void dh16_keygen_exptmod(void) { dh_keygen_exptmod(DH16_NAME); }
+static void dh16_derive(void) { dh_derive(DH16_NAME); }
+#endif
+#endif /* DROPBEAR_NORMAL_DH */
+
+#if DROPBEAR_ECC
+/* The ECDH and ECDSA rows for a curve share a key pair and signature */
+struct ecc_bench {
+	unsigned int bits;
+	ecc_key *key;
+	ecc_key *peer;
+	buffer *sig;
+	buffer *data;
+};
+
+static void ecc_setup(struct ecc_bench *eb) {
+	if (eb->key) {
+		return;
+	}
+	eb->key = gen_ecdsa_priv_key(eb->bits);
+	eb->peer = gen_ecdsa_priv_key(eb->bits);
+	eb->data = buf_new(sizeof(exchange_hash));
+	buf_putbytes(eb->data, exchange_hash, sizeof(exchange_hash));
+	eb->sig = buf_new(200);
+	buf_put_ecdsa_sign(eb->sig, eb->key, eb->data);
+}
+
+static void ecc_keygen(struct ecc_bench *eb) {
+	ecc_key *key = gen_ecdsa_priv_key(eb->bits);
+	ecc_free(key);
+	m_free(key);
+}
+
+static void ecc_derive(struct ecc_bench *eb) {
+	mp_int *secret = NULL;
+
+	ecc_setup(eb);
+	secret = dropbear_ecc_shared_secret(eb->peer, eb->key);
+	mp_clear(secret);
+	m_free(secret);
+}
+
+static void ecc_sign(struct ecc_bench *eb) {
+	buffer *sig = buf_new(200);
+
+	ecc_setup(eb);
+	buf_put_ecdsa_sign(sig, eb->key, eb->data);
+	buf_free(sig);
+}
+
+static void ecc_verify(struct ecc_bench *eb) {
+	ecc_setup(eb);
+	/* skip the signature name */
+	buf_setpos(eb->sig, 0);
+	buf_eatstring(eb->sig);
+	if (buf_ecdsa_verify(eb->sig, eb->key, eb->data) != DROPBEAR_SUCCESS) {
+		dropbear_exit("ecdsa verify failed");
+	}
+}
+
+#if DROPBEAR_ECC_256
+static struct ecc_bench ecc256 = { 256, NULL, NULL, NULL, NULL };
+static void ecc256_keygen(void) { ecc_keygen(&ecc256); }
+static void ecc256_derive(void) { ecc_derive(&ecc256); }
+static void ecc256_sign(void) { ecc_sign(&ecc256); }
+static void ecc256_verify(void) { ecc_verify(&ecc256); }
+#endif
+#if DROPBEAR_ECC_384
+static struct ecc_bench ecc384 = { 384, NULL, NULL, NULL, NULL };
+static void ecc384_keygen(void) { ecc_keygen(&ecc384); }
+static void ecc384_derive(void) { ecc_derive(&ecc384); }
+static void ecc384_sign(void) { ecc_sign(&ecc384); }
+static void ecc384_verify(void) { ecc_verify(&ecc384); }
+#endif
+#endif /* DROPBEAR_ECC */
+
+#if DROPBEAR_ED25519
+static unsigned char ed25519_priv[CURVE25519_LEN];
+static unsigned char ed25519_pub[CURVE25519_LEN];
+static unsigned char ed25519_sig[64];
+
+static void ed25519_setup(void) {
+	unsigned long slen;
+
+	dropbear_ed25519_make_key(ed25519_pub, ed25519_priv);
+	dropbear_ed25519_sign(exchange_hash, sizeof(exchange_hash),
+		ed25519_sig, &slen, ed25519_priv, ed25519_pub);
+}
+
+static void ed25519_keygen(void) {
+	unsigned char priv[CURVE25519_LEN], pub[CURVE25519_LEN];
+	dropbear_ed25519_make_key(pub, priv);
+}
+
+static void ed25519_sign(void) {
+	unsigned char sig[64];
+	unsigned long slen;
+
+	dropbear_ed25519_sign(exchange_hash, sizeof(exchange_hash),
+		sig, &slen, ed25519_priv, ed25519_pub);
+}
+
+static void ed25519_verify(void) {
+	if (dropbear_ed25519_verify(exchange_hash, sizeof(exchange_hash),
+			ed25519_sig, sizeof(ed25519_sig), ed25519_pub) != 0) {
+		dropbear_exit("ed25519 verify failed");
+	}
+}
+#endif /* DROPBEAR_ED25519 */
+
+#if DROPBEAR_RSA && DROPBEAR_RSA_SHA256
+static dropbear_rsa_key *rsa_hostkey;
+static buffer *rsa_sig;
+
+/* Key generation is slow so only done if an RSA row is run */
+static void rsa_setup(void) {
+	buffer *data_buf = NULL;
+
+	if (rsa_hostkey != NULL) {
+		return;
+	}
+	rsa_hostkey = gen_rsa_priv_key(2048);
+	data_buf = buf_new(sizeof(exchange_hash));
+	buf_putbytes(data_buf, exchange_hash, sizeof(exchange_hash));
+	rsa_sig = buf_new(1000);
+	buf_put_rsa_sign(rsa_sig, rsa_hostkey, DROPBEAR_SIGNATURE_RSA_SHA256, data_buf);
+	buf_free(data_buf);
+}
+
+static void rsa_sign(void) {
+	buffer *data_buf = NULL, *sig = NULL;
+
+	rsa_setup();
+	data_buf = buf_new(sizeof(exchange_hash));
+	buf_putbytes(data_buf, exchange_hash, sizeof(exchange_hash));
+	sig = buf_new(1000);
+	buf_put_rsa_sign(sig, rsa_hostkey, DROPBEAR_SIGNATURE_RSA_SHA256, data_buf);
+	buf_free(sig);
+	buf_free(data_buf);
+}
+
+#if DROPBEAR_SIGNKEY_VERIFY
+static void rsa_verify(void) {
+	buffer *data_buf = NULL;
+
+	rsa_setup();
+	data_buf = buf_new(sizeof(exchange_hash));
+	buf_putbytes(data_buf, exchange_hash, sizeof(exchange_hash));
+	/* skip the signature name */
+	buf_setpos(rsa_sig, 0);
+	buf_eatstring(rsa_sig);
+	if (buf_rsa_verify(rsa_sig, rsa_hostkey, DROPBEAR_SIGNATURE_RSA_SHA256,
+			data_buf) != DROPBEAR_SUCCESS) {
+		dropbear_exit("rsa verify failed");
+	}
+	buf_free(data_buf);
+}
+#endif /* DROPBEAR_SIGNKEY_VERIFY */
+#endif /* DROPBEAR_RSA && DROPBEAR_RSA_SHA256 */
+
+#if DROPBEAR_SNTRUP761
+/* The client generates the key pair and decapsulates, the server
+ * encapsulates */
+static unsigned char sntrup761_pk[crypto_kem_sntrup761_PUBLICKEYBYTES];
+static unsigned char sntrup761_sk[crypto_kem_sntrup761_SECRETKEYBYTES];
+static unsigned char sntrup761_ct[crypto_kem_sntrup761_CIPHERTEXTBYTES];
+
+#if DROPBEAR_SNTRUP761_ACCEL
+/* The SIMD and portable code must give identical results. Each function
+ * with a SIMD version and the whole KEM are run on fixed inputs and seeds,
+ * then again in a child process with the SIMD code disabled */
+#define SNTRUP761_CHECK_RUNS 16
+#define SNTRUP761_CHECK_KEMS 2
+
+struct sntrup761_check {
+	int8_t r3_mult[SNTRUP761_CHECK_RUNS][SNTRUP761_P];
+	int16_t rq_mult_small[SNTRUP761_CHECK_RUNS][SNTRUP761_P];
+	int8_t r3_recip[SNTRUP761_CHECK_RUNS][SNTRUP761_P];
+	int16_t rq_recip3[SNTRUP761_CHECK_RUNS][SNTRUP761_P];
+	int recip_ret[SNTRUP761_CHECK_RUNS][2];
+	uint32_t sort[SNTRUP761_CHECK_RUNS][SNTRUP761_ACCEL_SORT_MAX];
+	unsigned char pk[SNTRUP761_CHECK_KEMS][crypto_kem_sntrup761_PUBLICKEYBYTES];
+	unsigned char sk[SNTRUP761_CHECK_KEMS][crypto_kem_sntrup761_SECRETKEYBYTES];
+	unsigned char ct[SNTRUP761_CHECK_KEMS][crypto_kem_sntrup761_CIPHERTEXTBYTES];
+	/* encapsulated, decapsulated, and decapsulated from a bad ciphertext */
+	unsigned char k[SNTRUP761_CHECK_KEMS][3][crypto_kem_sntrup761_BYTES];
+};
+
+static struct sntrup761_check sntrup761_simd, sntrup761_portable;
+
+/* xorshift, the inputs only need to be varied and repeatable */
+static uint32_t sntrup761_check_rand(uint64_t *state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return (uint32_t)(*state >> 32);
+}
+
+static void sntrup761_check_run(struct sntrup761_check *out) {
+	int8_t f[SNTRUP761_P], g[SNTRUP761_P];
+	int16_t fq[SNTRUP761_P];
+	unsigned char seed[4];
+	uint64_t state = 0x9e3779b97f4a7c15ULL;
+	long long n;
+	unsigned int t, i;
+
+	for (t = 0; t < SNTRUP761_CHECK_RUNS; t++) {
+		for (i = 0; i < SNTRUP761_P; i++) {
+			f[i] = (int8_t)(sntrup761_check_rand(&state) % 3) - 1;
+			g[i] = (int8_t)(sntrup761_check_rand(&state) % 3) - 1;
+			fq[i] = (int16_t)(sntrup761_check_rand(&state) % SNTRUP761_Q)
+				- (SNTRUP761_Q - 1) / 2;
+			/* the largest coefficients */
+			if (t == 1) {
+				f[i] = g[i] = -1;
+				fq[i] = (i & 1) ? (SNTRUP761_Q - 1) / 2 : -(SNTRUP761_Q - 1) / 2;
+			}
+			if (t == 2) {
+				f[i] = g[i] = 1;
+				fq[i] = (SNTRUP761_Q - 1) / 2;
+			}
+		}
+		sntrup761_r3_mult(out->r3_mult[t], f, g);
+		sntrup761_rq_mult_small(out->rq_mult_small[t], fq, g);
+
+		/* zero has no inverse */
+		if (t == 3) {
+			memset(f, 0x0, sizeof(f));
+		}
+		out->recip_ret[t][0] = sntrup761_r3_recip(out->r3_recip[t], f);
+		out->recip_ret[t][1] = sntrup761_rq_recip3(out->rq_recip3[t], f);
+
+		n = SNTRUP761_P;
+		if (t == 1) {
+			n = SNTRUP761_ACCEL_SORT_MAX;
+		} else if (t > 3) {
+			n = sntrup761_check_rand(&state) % (SNTRUP761_ACCEL_SORT_MAX + 1);
+		}
+		for (i = 0; i < n; i++) {
+			out->sort[t][i] = sntrup761_check_rand(&state);
+			/* repeated values and both ends of the range */
+			if (t % 3 == 0) {
+				out->sort[t][i] &= 0x80000007;
+			}
+			if (t == 2) {
+				out->sort[t][i] = 0xffffffff;
+			}
+		}
+		sntrup761_sort_uint32(out->sort[t], n);
+	}
+
+	for (t = 0; t < SNTRUP761_CHECK_KEMS; t++) {
+		STORE32H(t, seed);
+		seedrandom_fixed(seed, sizeof(seed));
+		crypto_kem_sntrup761_keypair(out->pk[t], out->sk[t]);
+		crypto_kem_sntrup761_enc(out->ct[t], out->k[t][0], out->pk[t]);
+		crypto_kem_sntrup761_dec(out->k[t][1], out->ct[t], out->sk[t]);
+		out->ct[t][t] ^= 1;
+		crypto_kem_sntrup761_dec(out->k[t][2], out->ct[t], out->sk[t]);
+	}
+}
+
+static void sntrup761_check(void) {
+	pid_t pid;
+	int status;
+
+	if (!sntrup761_accel()) {
+		return;
+	}
+	sntrup761_check_run(&sntrup761_simd);
+	seedrandom();
+
+	/* disabling the SIMD code can't be undone, so in a child */
+	pid = fork();
+	if (pid < 0) {
+		dropbear_exit("fork failed");
+	}
+	if (pid == 0) {
+		cpu_disable(CPU_AVX2 | CPU_ARM_NEON);
+		sntrup761_check_run(&sntrup761_portable);
+		_exit(memcmp(&sntrup761_simd, &sntrup761_portable,
+			sizeof(sntrup761_simd)) == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+	if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)
+			|| WEXITSTATUS(status) != EXIT_SUCCESS) {
+		dropbear_exit("sntrup761 SIMD and portable results differ");
+	}
+}
+#endif /* DROPBEAR_SNTRUP761_ACCEL */
+
+static void sntrup761_setup(void) {
+	unsigned char k[crypto_kem_sntrup761_BYTES];
+
+#if DROPBEAR_SNTRUP761_ACCEL
+	sntrup761_check();
+#endif
+	crypto_kem_sntrup761_keypair(sntrup761_pk, sntrup761_sk);
+	crypto_kem_sntrup761_enc(sntrup761_ct, k, sntrup761_pk);
+}
+
+static void sntrup761_keygen(void) {
+	unsigned char pk[crypto_kem_sntrup761_PUBLICKEYBYTES];
+	unsigned char sk[crypto_kem_sntrup761_SECRETKEYBYTES];
+
+	crypto_kem_sntrup761_keypair(pk, sk);
+}
+
+static void sntrup761_enc(void) {
+	unsigned char ct[crypto_kem_sntrup761_CIPHERTEXTBYTES];
+	unsigned char k[crypto_kem_sntrup761_BYTES];
+
+	crypto_kem_sntrup761_enc(ct, k, sntrup761_pk);
+}
+
+static void sntrup761_dec(void) {
+	unsigned char k[crypto_kem_sntrup761_BYTES];
+
+	crypto_kem_sntrup761_dec(k, sntrup761_ct, sntrup761_sk);
+}
+#endif /* DROPBEAR_SNTRUP761 */
+
+#if DROPBEAR_CURVE25519_DEP && DROPBEAR_ED25519
+static void handshake_server(void) {
+	curve25519_exchange();
+	ed25519_sign();
+}
+
+static void handshake_client(void) {
+	curve25519_exchange();
+	ed25519_verify();
+}
+#endif
+
+static const struct {
+	const char *name;
+	void (*op)(void);
+} operations[] = {
+#if DROPBEAR_CURVE25519_DEP
+	{"curve25519-keygen", curve25519_keygen},
+	{"curve25519-derive", curve25519_derive},
+#endif
+#if DROPBEAR_DH_GROUP14
+	{"dh-group14-keygen", dh14_keygen},
+	{"dh-group14-keygen-exptmod", dh14_keygen_exptmod},
+	{"dh-group14-derive", dh14_derive},
+#endif
+#if DROPBEAR_DH_GROUP16
+	{"dh-group16-keygen", dh16_keygen},
+	{"dh-group16-keygen-exptmod", dh16_keygen_exptmod},
+	{"dh-group16-derive", dh16_derive},
+#endif
+#if DROPBEAR_ECC_256
+	{"nistp256-keygen", ecc256_keygen},
+	{"nistp256-derive", ecc256_derive},
+	{"ecdsa-nistp256-sign", ecc256_sign},
+	{"ecdsa-nistp256-verify", ecc256_verify},
+#endif
+#if DROPBEAR_ECC_384
+	{"nistp384-keygen", ecc384_keygen},
+	{"nistp384-derive", ecc384_derive},
+	{"ecdsa-nistp384-sign", ecc384_sign},
+	{"ecdsa-nistp384-verify", ecc384_verify},
+#endif
+#if DROPBEAR_ED25519
+	{"ed25519-keygen", ed25519_keygen},
+	{"ed25519-sign", ed25519_sign},
+	{"ed25519-verify", ed25519_verify},
+#endif
+#if DROPBEAR_SNTRUP761
+	{"sntrup761-keygen", sntrup761_keygen},
+	{"sntrup761-enc", sntrup761_enc},
+	{"sntrup761-dec", sntrup761_dec},
+#endif
+#if DROPBEAR_RSA && DROPBEAR_RSA_SHA256
+	{"rsa2048-sha256-sign", rsa_sign},
+#if DROPBEAR_SIGNKEY_VERIFY
+	{"rsa2048-sha256-verify", rsa_verify},
+#endif
+#endif
+#if DROPBEAR_CURVE25519_DEP && DROPBEAR_ED25519
+	/* curve25519-sha256 with an ed25519 host key */
+	{"handshake-server-x25519", handshake_server},
+	{"handshake-client-x25519", handshake_client},
+#endif
+	{NULL, NULL}
+};
+
+static void bench_op(const char *name, void (*op)(void)) {
+	struct bench_timer timer;
+	uint64_t target_ns = bench_opts.seconds * 1e9;
+	unsigned long count = 0, batch = 1, i;
+	double cycles;
+
+	/* warm up, including any one-time table setup */
+	op();
+
+	memset(&timer, 0x0, sizeof(timer));
+	while (timer.total_ns < target_ns) {
+		bench_timer_start(&timer);
+		for (i = 0; i < batch; i++) {
+			op();
+		}
+		bench_timer_stop(&timer);
+		count += batch;
+		if (batch < 64) {
+			batch *= 2;
+		}
+	}
+
+	cycles = bench_timer_cycles(&timer);
+	bench_print_str(name);
+	bench_print_double(count / (timer.total_ns / 1e9));
+	bench_print_double(timer.total_ns / 1e3 / count);
+	bench_print_double(cycles < 0 ? -1 : cycles / count);
+	bench_print_end();
+}
+
+int main(int argc, char **argv) {
+	unsigned int i;
+
+	bench_getopts(argc, argv, NULL);
+	bench_init();
+
+	genrandom(exchange_hash, sizeof(exchange_hash));
+#if DROPBEAR_CURVE25519_DEP
+	curve25519_setup();
+#endif
+#if DROPBEAR_ED25519
+	ed25519_setup();
+#endif
+#if DROPBEAR_SNTRUP761
+	sntrup761_setup();
+#endif
+
+	bench_print_header(columns, column_widths);
+	for (i = 0; operations[i].name != NULL; i++) {
+		if (bench_match(operations[i].name)) {
+			bench_op(operations[i].name, operations[i].op);
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,50 @@
+#ifndef DROPBEAR_BENCH_H_
+#define DROPBEAR_BENCH_H_
+
+#include "includes.h"
+
+/* Shared helpers for the standalone benchmark programs, built with
+ * "make bench". Results are printed either as an aligned table or with -m
+ * as comma separated values, one result per line with a header line. */
+
+struct bench_opts {
+	int machine; /* -m, print CSV */
+	double seconds; /* -t, minimum run time per measurement */
+	double ghz; /* -f, clock rate to estimate cycles when no counter */
+	const char *filter; /* -a, only run algorithms containing this */
+};
+
+extern struct bench_opts bench_opts;
+
+/* Parses the common arguments. Returns the index of the first unparsed
+ * argument */
+int bench_getopts(int argc, char **argv, const char *usage_extra);
+/* Sets up crypto, random source etc */
+void bench_init(void);
+int bench_match(const char *name);
+
+/* Monotonic time in nanoseconds */
+uint64_t bench_nsec(void);
+/* Cycle counter, 0 if the platform has none */
+uint64_t bench_cycles(void);
+
+/* Timing around a batch of operations */
+struct bench_timer {
+	uint64_t start_ns, start_cycles;
+	uint64_t total_ns, total_cycles;
+};
+void bench_timer_start(struct bench_timer *t);
+void bench_timer_stop(struct bench_timer *t);
+/* Returns the number of cycles, estimated from -f if no counter */
+double bench_timer_cycles(const struct bench_timer *t);
+
+/* columns is a NULL terminated list. Table output pads each column to
+ * widths[i], or the width of its header if larger. widths may be NULL */
+void bench_print_header(const char *const *columns, const unsigned int *widths);
+/* Each printed field is the next column */
+void bench_print_str(const char *val);
+void bench_print_uint(unsigned long val);
+void bench_print_double(double val);
+void bench_print_end(void);
+
+#endif /* DROPBEAR_BENCH_H_ */
@@ -62,6 +62,12 @@ static const ulong32 K[64] = {
 #define Gamma0(x)       (S(x, 7) ^ S(x, 18) ^ R(x, 3))
 #define Gamma1(x)       (S(x, 17) ^ S(x, 19) ^ R(x, 10))
 
+#if DROPBEAR_SHA2_ACCEL
+/* Dropbear's sha2-accel.c, returns 0 if the CPU lacks SHA instructions */
+int sha256_accel_compress(ulong32 *state, const unsigned char *buf,
+        unsigned long nblocks);
+#endif
+
 /* compress 512-bits */
 #ifdef LTC_CLEAN_STACK
 static int _sha256_compress(hash_state * md, unsigned char *buf)
@@ -75,6 +81,12 @@ static int  sha256_compress(hash_state * md, unsigned char *buf)
 #endif
     int i;
 
+#if DROPBEAR_SHA2_ACCEL
+    if (sha256_accel_compress(md->sha256.state, buf, 1)) {
+        return CRYPT_OK;
+    }
+#endif
+
     /* copy state into S */
     for (i = 0; i < 8; i++) {
         S[i] = md->sha256.state[i];
@@ -218,6 +230,50 @@ int sha256_init(hash_state * md)
     return CRYPT_OK;
 }
 
+#if DROPBEAR_SHA2_ACCEL
+static HASH_PROCESS(sha256_process_buffered, sha256_compress, sha256, 64)
+
+/**
+   Process a block of memory though the hash. Runs of whole blocks are
+   passed to sha256_accel_compress() together
+   @param md     The hash state
+   @param in     The data to hash
+   @param inlen  The length of the data (octets)
+   @return CRYPT_OK if successful
+*/
+int sha256_process(hash_state * md, const unsigned char *in, unsigned long inlen)
+{
+    unsigned long n;
+    int err;
+
+    LTC_ARGCHK(md != NULL);
+    LTC_ARGCHK(in != NULL);
+    if (md->sha256.curlen > sizeof(md->sha256.buf)) {
+       return CRYPT_INVALID_ARG;
+    }
+
+    /* complete a partly filled block first */
+    if (md->sha256.curlen != 0) {
+       n = MIN(inlen, 64 - md->sha256.curlen);
+       if ((err = sha256_process_buffered(md, in, n)) != CRYPT_OK) {
+          return err;
+       }
+       in    += n;
+       inlen -= n;
+    }
+
+    n = inlen / 64;
+    if (n > 0 && md->sha256.curlen == 0
+        && (md->sha256.length + n * 64 * 8) > md->sha256.length
+        && sha256_accel_compress(md->sha256.state, in, n)) {
+       md->sha256.length += n * 64 * 8;
+       in    += n * 64;
+       inlen -= n * 64;
+    }
+
+    return sha256_process_buffered(md, in, inlen);
+}
+#else
 /**
    Process a block of memory though the hash
    @param md     The hash state
@@ -226,6 +282,7 @@ int sha256_init(hash_state * md)
    @return CRYPT_OK if successful
 */
 HASH_PROCESS(sha256_process, sha256_compress, sha256, 64)
+#endif
 
 /**
    Terminate the hash to get the digest
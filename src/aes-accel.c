@@ -0,0 +1,831 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "cpufeatures.h"
+#include "aes-accel.h"
+
+#if DROPBEAR_AES_ACCEL
+
+/* The round keys are stored as bytes in the eK and dK arrays of
+ * struct rijndael_key, which have room for 15 round keys each.
+ * dK holds the keys for the "equivalent inverse cipher", in the order
+ * used by AESDEC, which is the same as libtomcrypt's dK. */
+#define ACCEL_MAX_ROUNDS 14
+#define ACCEL_EK(skey) ((unsigned char*)(skey)->rijndael.eK)
+#define ACCEL_DK(skey) ((unsigned char*)(skey)->rijndael.dK)
+
+#define GCM_BLOCK_LEN 16
+#define GCM_IV_LEN 12
+
+typedef ulong32 (*sub_word_fn)(ulong32 w);
+typedef void (*inv_mix_fn)(const unsigned char *in, unsigned char *out);
+
+/* FIPS-197 key expansion. SubWord and InvMixColumns are done with the AES
+ * instructions so there are no secret dependent table lookups */
+static int accel_expand_key(const unsigned char *key, int keylen,
+		int num_rounds, symmetric_key *skey,
+		sub_word_fn sub_word, inv_mix_fn inv_mix) {
+	static const unsigned char rcon[] = {
+		0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+	};
+	ulong32 w[4 * (ACCEL_MAX_ROUNDS + 1)];
+	unsigned char *ek = ACCEL_EK(skey), *dk = ACCEL_DK(skey);
+	int nk, nr, i, r;
+
+	if (keylen != 16 && keylen != 24 && keylen != 32) {
+		return CRYPT_INVALID_KEYSIZE;
+	}
+	nk = keylen / 4;
+	nr = nk + 6;
+	if (num_rounds != 0 && num_rounds != nr) {
+		return CRYPT_INVALID_ROUNDS;
+	}
+
+	for (i = 0; i < nk; i++) {
+		LOAD32L(w[i], key + 4*i);
+	}
+	for (i = nk; i < 4 * (nr + 1); i++) {
+		ulong32 t = w[i-1];
+		if (i % nk == 0) {
+			/* little endian words, RotWord is a right rotate */
+			t = sub_word(RORc(t, 8)) ^ rcon[i/nk - 1];
+		} else if (nk > 6 && i % nk == 4) {
+			t = sub_word(t);
+		}
+		w[i] = w[i-nk] ^ t;
+	}
+	for (i = 0; i < 4 * (nr + 1); i++) {
+		STORE32L(w[i], ek + 4*i);
+	}
+
+	memcpy(dk, ek + 16*nr, 16);
+	for (r = 1; r < nr; r++) {
+		inv_mix(ek + 16*(nr-r), dk + 16*r);
+	}
+	memcpy(dk + 16*nr, ek, 16);
+
+	skey->rijndael.Nr = nr;
+	m_burn(w, sizeof(w));
+	return CRYPT_OK;
+}
+
+/* Loads the full width counter used by ctr_encrypt() */
+static void accel_ctr_load(const unsigned char *IV, int mode,
+		ulong64 *hi, ulong64 *lo) {
+	if (mode == CTR_COUNTER_BIG_ENDIAN) {
+		LOAD64H(*hi, IV);
+		LOAD64H(*lo, IV + 8);
+	} else {
+		LOAD64L(*lo, IV);
+		LOAD64L(*hi, IV + 8);
+	}
+}
+
+static void accel_ctr_store(unsigned char *IV, int mode,
+		ulong64 hi, ulong64 lo) {
+	if (mode == CTR_COUNTER_BIG_ENDIAN) {
+		STORE64H(hi, IV);
+		STORE64H(lo, IV + 8);
+	} else {
+		STORE64L(lo, IV);
+		STORE64L(hi, IV + 8);
+	}
+}
+
+#define CTR_INCREMENT(hi, lo) do { (lo)++; if ((lo) == 0) { (hi)++; } } while (0)
+
+/* Length block for the end of GHASH */
+static void gcm_length_block(unsigned char *block,
+		unsigned long aadlen, unsigned long len) {
+	STORE64H((ulong64)aadlen * 8, block);
+	STORE64H((ulong64)len * 8, block + 8);
+}
+
+/* FIPS-197 Appendix C, and the ciphertext decrypts to the plaintext */
+static int accel_test(const struct ltc_cipher_descriptor *desc) {
+	static const unsigned char pt[16] = {
+		0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+		0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+	};
+	static const unsigned char ct[3][16] = {
+		{ 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+		  0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a },
+		{ 0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+		  0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91 },
+		{ 0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+		  0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 }
+	};
+	unsigned char key[32], buf[16];
+	symmetric_key skey;
+	int i, k, err;
+
+	for (i = 0; i < 32; i++) {
+		key[i] = i;
+	}
+	for (k = 0; k < 3; k++) {
+		if ((err = desc->setup(key, 16 + 8*k, 0, &skey)) != CRYPT_OK) {
+			return err;
+		}
+		desc->ecb_encrypt(pt, buf, &skey);
+		if (memcmp(buf, ct[k], 16) != 0) {
+			return CRYPT_FAIL_TESTVECTOR;
+		}
+		desc->ecb_decrypt(buf, buf, &skey);
+		if (memcmp(buf, pt, 16) != 0) {
+			return CRYPT_FAIL_TESTVECTOR;
+		}
+	}
+	return CRYPT_OK;
+}
+
+static void accel_done(symmetric_key *UNUSED(skey)) {
+}
+
+static int accel_keysize(int *keysize) {
+	if (*keysize < 16) {
+		return CRYPT_INVALID_KEYSIZE;
+	}
+	if (*keysize < 24) {
+		*keysize = 16;
+	} else if (*keysize < 32) {
+		*keysize = 24;
+	} else {
+		*keysize = 32;
+	}
+	return CRYPT_OK;
+}
+
+#if DROPBEAR_CPU_X86
+/* AES-NI and PCLMULQDQ. Functions using the instructions are compiled
+ * for them with a target attribute, and only called after cpu_has() */
+#include <wmmintrin.h>
+#include <smmintrin.h>
+
+#define AESNI_TARGET __attribute__((target("aes,pclmul,sse4.1")))
+/* Dropbear is often built with -Os, the helpers need to be inlined */
+#define AESNI_INLINE AESNI_TARGET static inline __attribute__((always_inline))
+
+AESNI_TARGET static ulong32 aesni_sub_word(ulong32 w) {
+	/* AESKEYGENASSIST applies SubWord to the second word */
+	__m128i x = _mm_set_epi32(0, 0, (int)w, 0);
+	return (ulong32)_mm_cvtsi128_si32(_mm_aeskeygenassist_si128(x, 0));
+}
+
+AESNI_TARGET static void aesni_inv_mix(const unsigned char *in, unsigned char *out) {
+	_mm_storeu_si128((__m128i*)out,
+		_mm_aesimc_si128(_mm_loadu_si128((const __m128i*)in)));
+}
+
+static int aesni_setup(const unsigned char *key, int keylen, int num_rounds,
+		symmetric_key *skey) {
+	return accel_expand_key(key, keylen, num_rounds, skey,
+		aesni_sub_word, aesni_inv_mix);
+}
+
+AESNI_INLINE void aesni_load_keys(const unsigned char *keys,
+		int nr, __m128i *rk) {
+	int r;
+	for (r = 0; r <= nr; r++) {
+		rk[r] = _mm_loadu_si128((const __m128i*)(keys + 16*r));
+	}
+}
+
+AESNI_INLINE __m128i aesni_enc1(__m128i b, const __m128i *rk, int nr) {
+	int r;
+	b = _mm_xor_si128(b, rk[0]);
+	for (r = 1; r < nr; r++) {
+		b = _mm_aesenc_si128(b, rk[r]);
+	}
+	return _mm_aesenclast_si128(b, rk[nr]);
+}
+
+/* Eight independent blocks keep the AES unit's pipeline busy */
+#define AESNI_LANES 8
+#define AESNI_EACH(op) do { \
+	op(b0); op(b1); op(b2); op(b3); op(b4); op(b5); op(b6); op(b7); \
+	} while (0)
+
+AESNI_INLINE void aesni_enc8(__m128i *b, const __m128i *rk, int nr) {
+	__m128i b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+	__m128i b4 = b[4], b5 = b[5], b6 = b[6], b7 = b[7];
+	int r;
+
+#define XOR_KEY(x) x = _mm_xor_si128(x, rk[0])
+#define ENC_ROUND(x) x = _mm_aesenc_si128(x, rk[r])
+#define ENC_LAST(x) x = _mm_aesenclast_si128(x, rk[nr])
+	AESNI_EACH(XOR_KEY);
+	for (r = 1; r < nr; r++) {
+		AESNI_EACH(ENC_ROUND);
+	}
+	AESNI_EACH(ENC_LAST);
+#undef XOR_KEY
+#undef ENC_ROUND
+#undef ENC_LAST
+
+	b[0] = b0;
+	b[1] = b1;
+	b[2] = b2;
+	b[3] = b3;
+	b[4] = b4;
+	b[5] = b5;
+	b[6] = b6;
+	b[7] = b7;
+}
+
+AESNI_TARGET static int aesni_ecb_encrypt(const unsigned char *pt,
+		unsigned char *ct, symmetric_key *skey) {
+	__m128i rk[ACCEL_MAX_ROUNDS + 1];
+	int nr = skey->rijndael.Nr;
+
+	aesni_load_keys(ACCEL_EK(skey), nr, rk);
+	_mm_storeu_si128((__m128i*)ct,
+		aesni_enc1(_mm_loadu_si128((const __m128i*)pt), rk, nr));
+	return CRYPT_OK;
+}
+
+AESNI_TARGET static int aesni_ecb_decrypt(const unsigned char *ct,
+		unsigned char *pt, symmetric_key *skey) {
+	__m128i rk[ACCEL_MAX_ROUNDS + 1];
+	__m128i b;
+	int nr = skey->rijndael.Nr, r;
+
+	aesni_load_keys(ACCEL_DK(skey), nr, rk);
+	b = _mm_xor_si128(_mm_loadu_si128((const __m128i*)ct), rk[0]);
+	for (r = 1; r < nr; r++) {
+		b = _mm_aesdec_si128(b, rk[r]);
+	}
+	_mm_storeu_si128((__m128i*)pt, _mm_aesdeclast_si128(b, rk[nr]));
+	return CRYPT_OK;
+}
+
+AESNI_INLINE __m128i aesni_ctr_block(int mode, ulong64 hi, ulong64 lo) {
+	if (mode == CTR_COUNTER_BIG_ENDIAN) {
+		return _mm_set_epi64x((long long)__builtin_bswap64(lo),
+			(long long)__builtin_bswap64(hi));
+	}
+	return _mm_set_epi64x((long long)hi, (long long)lo);
+}
+
+/* Called by ctr_encrypt() with the counter of the last used block, so the
+ * counter is incremented before each block is encrypted */
+AESNI_TARGET static int aesni_ctr_encrypt(const unsigned char *pt,
+		unsigned char *ct, unsigned long blocks, unsigned char *IV,
+		int mode, symmetric_key *skey) {
+	__m128i rk[ACCEL_MAX_ROUNDS + 1];
+	__m128i b[AESNI_LANES];
+	ulong64 hi, lo;
+	int nr = skey->rijndael.Nr, i;
+
+	aesni_load_keys(ACCEL_EK(skey), nr, rk);
+	accel_ctr_load(IV, mode, &hi, &lo);
+
+	for (; blocks >= AESNI_LANES; blocks -= AESNI_LANES) {
+		for (i = 0; i < AESNI_LANES; i++) {
+			CTR_INCREMENT(hi, lo);
+			b[i] = aesni_ctr_block(mode, hi, lo);
+		}
+		aesni_enc8(b, rk, nr);
+		for (i = 0; i < AESNI_LANES; i++) {
+			_mm_storeu_si128((__m128i*)(ct + 16*i), _mm_xor_si128(b[i],
+				_mm_loadu_si128((const __m128i*)(pt + 16*i))));
+		}
+		pt += 16*AESNI_LANES;
+		ct += 16*AESNI_LANES;
+	}
+	for (; blocks > 0; blocks--) {
+		CTR_INCREMENT(hi, lo);
+		b[0] = aesni_enc1(aesni_ctr_block(mode, hi, lo), rk, nr);
+		_mm_storeu_si128((__m128i*)ct, _mm_xor_si128(b[0],
+			_mm_loadu_si128((const __m128i*)pt)));
+		pt += 16;
+		ct += 16;
+	}
+
+	accel_ctr_store(IV, mode, hi, lo);
+	return CRYPT_OK;
+}
+
+/* GHASH works on byte reversed blocks, following Intel's "Carry-Less
+ * Multiplication and Its Usage for Computing the GCM Mode" */
+AESNI_INLINE __m128i ghash_bswap(__m128i x) {
+	return _mm_shuffle_epi8(x,
+		_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+/* 256 bit carry-less product, accumulated into lo and hi */
+AESNI_INLINE void clmul_acc(__m128i a, __m128i b,
+		__m128i *lo, __m128i *hi) {
+	__m128i t0 = _mm_clmulepi64_si128(a, b, 0x00);
+	__m128i t1 = _mm_clmulepi64_si128(a, b, 0x10);
+	__m128i t2 = _mm_clmulepi64_si128(a, b, 0x01);
+	__m128i t3 = _mm_clmulepi64_si128(a, b, 0x11);
+	t1 = _mm_xor_si128(t1, t2);
+	*lo = _mm_xor_si128(*lo, _mm_xor_si128(t0, _mm_slli_si128(t1, 8)));
+	*hi = _mm_xor_si128(*hi, _mm_xor_si128(t3, _mm_srli_si128(t1, 8)));
+}
+
+/* Shifts the reflected product left one bit and reduces it modulo
+ * x^128 + x^7 + x^2 + x + 1 */
+AESNI_INLINE __m128i ghash_reduce(__m128i lo, __m128i hi) {
+	__m128i t2, t4, t5, t7, t8, t9;
+
+	t7 = _mm_srli_epi32(lo, 31);
+	t8 = _mm_srli_epi32(hi, 31);
+	lo = _mm_slli_epi32(lo, 1);
+	hi = _mm_slli_epi32(hi, 1);
+	t9 = _mm_srli_si128(t7, 12);
+	t8 = _mm_slli_si128(t8, 4);
+	t7 = _mm_slli_si128(t7, 4);
+	lo = _mm_or_si128(lo, t7);
+	hi = _mm_or_si128(hi, t8);
+	hi = _mm_or_si128(hi, t9);
+
+	t7 = _mm_slli_epi32(lo, 31);
+	t8 = _mm_slli_epi32(lo, 30);
+	t9 = _mm_slli_epi32(lo, 25);
+	t7 = _mm_xor_si128(t7, t8);
+	t7 = _mm_xor_si128(t7, t9);
+	t8 = _mm_srli_si128(t7, 4);
+	t7 = _mm_slli_si128(t7, 12);
+	lo = _mm_xor_si128(lo, t7);
+
+	t2 = _mm_srli_epi32(lo, 1);
+	t4 = _mm_srli_epi32(lo, 2);
+	t5 = _mm_srli_epi32(lo, 7);
+	t2 = _mm_xor_si128(t2, t4);
+	t2 = _mm_xor_si128(t2, t5);
+	t2 = _mm_xor_si128(t2, t8);
+	lo = _mm_xor_si128(lo, t2);
+	return _mm_xor_si128(hi, lo);
+}
+
+AESNI_INLINE __m128i ghash_mul(__m128i a, __m128i b) {
+	__m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+	clmul_acc(a, b, &lo, &hi);
+	return ghash_reduce(lo, hi);
+}
+
+/* Hashes four blocks with a single reduction, using powers of H */
+AESNI_INLINE __m128i ghash_update4(__m128i x, const __m128i *c,
+		const __m128i *hpow) {
+	__m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+	clmul_acc(_mm_xor_si128(x, ghash_bswap(c[0])), hpow[3], &lo, &hi);
+	clmul_acc(ghash_bswap(c[1]), hpow[2], &lo, &hi);
+	clmul_acc(ghash_bswap(c[2]), hpow[1], &lo, &hi);
+	clmul_acc(ghash_bswap(c[3]), hpow[0], &lo, &hi);
+	return ghash_reduce(lo, hi);
+}
+
+AESNI_INLINE __m128i ghash_update(__m128i x, __m128i c, __m128i h) {
+	return ghash_mul(_mm_xor_si128(x, ghash_bswap(c)), h);
+}
+
+AESNI_INLINE __m128i ghash_update_partial(__m128i x,
+		const unsigned char *in, unsigned long len, __m128i h) {
+	unsigned char block[GCM_BLOCK_LEN];
+
+	memset(block, 0x0, sizeof(block));
+	memcpy(block, in, len);
+	return ghash_update(x, _mm_loadu_si128((const __m128i*)block), h);
+}
+
+AESNI_TARGET static int aesni_gcm_crypt(symmetric_key *skey,
+		const unsigned char *H, const unsigned char *iv,
+		const unsigned char *aad, unsigned long aadlen,
+		const unsigned char *in, unsigned char *out, unsigned long len,
+		unsigned char *tag, int direction) {
+	__m128i rk[ACCEL_MAX_ROUNDS + 1];
+	__m128i hpow[4], x, j0, ks[AESNI_LANES], c[AESNI_LANES];
+	unsigned char block[GCM_BLOCK_LEN];
+	unsigned long i, remain;
+	ulong32 counter = 1;
+	int nr = skey->rijndael.Nr, k;
+
+	aesni_load_keys(ACCEL_EK(skey), nr, rk);
+	hpow[0] = ghash_bswap(_mm_loadu_si128((const __m128i*)H));
+	hpow[1] = ghash_mul(hpow[0], hpow[0]);
+	hpow[2] = ghash_mul(hpow[1], hpow[0]);
+	hpow[3] = ghash_mul(hpow[2], hpow[0]);
+
+	/* J0 is IV || 1, data counters start from 2 */
+	memcpy(block, iv, GCM_IV_LEN);
+	STORE32H(counter, block + GCM_IV_LEN);
+	j0 = _mm_loadu_si128((const __m128i*)block);
+
+	x = _mm_setzero_si128();
+	for (i = 0; i + GCM_BLOCK_LEN <= aadlen; i += GCM_BLOCK_LEN) {
+		x = ghash_update(x, _mm_loadu_si128((const __m128i*)(aad + i)), hpow[0]);
+	}
+	if (i < aadlen) {
+		x = ghash_update_partial(x, aad + i, aadlen - i, hpow[0]);
+	}
+
+	for (i = 0; i + AESNI_LANES*GCM_BLOCK_LEN <= len;
+			i += AESNI_LANES*GCM_BLOCK_LEN) {
+		for (k = 0; k < AESNI_LANES; k++) {
+			counter++;
+			ks[k] = _mm_insert_epi32(j0, (int)__builtin_bswap32(counter), 3);
+			c[k] = _mm_loadu_si128((const __m128i*)(in + i + 16*k));
+		}
+		if (direction == LTC_DECRYPT) {
+			x = ghash_update4(x, c, hpow);
+			x = ghash_update4(x, c + 4, hpow);
+		}
+		aesni_enc8(ks, rk, nr);
+		for (k = 0; k < AESNI_LANES; k++) {
+			c[k] = _mm_xor_si128(c[k], ks[k]);
+			_mm_storeu_si128((__m128i*)(out + i + 16*k), c[k]);
+		}
+		if (direction == LTC_ENCRYPT) {
+			x = ghash_update4(x, c, hpow);
+			x = ghash_update4(x, c + 4, hpow);
+		}
+	}
+
+	for (; i < len; i += GCM_BLOCK_LEN) {
+		remain = MIN(len - i, GCM_BLOCK_LEN);
+		counter++;
+		ks[0] = aesni_enc1(_mm_insert_epi32(j0,
+			(int)__builtin_bswap32(counter), 3), rk, nr);
+		memset(block, 0x0, sizeof(block));
+		memcpy(block, in + i, remain);
+		c[0] = _mm_loadu_si128((const __m128i*)block);
+		if (direction == LTC_DECRYPT) {
+			x = ghash_update(x, c[0], hpow[0]);
+		}
+		c[0] = _mm_xor_si128(c[0], ks[0]);
+		_mm_storeu_si128((__m128i*)block, c[0]);
+		memcpy(out + i, block, remain);
+		if (direction == LTC_ENCRYPT) {
+			/* only the ciphertext bytes are hashed */
+			memset(block + remain, 0x0, sizeof(block) - remain);
+			x = ghash_update(x, _mm_loadu_si128((const __m128i*)block), hpow[0]);
+		}
+	}
+
+	gcm_length_block(block, aadlen, len);
+	x = ghash_update(x, _mm_loadu_si128((const __m128i*)block), hpow[0]);
+	x = _mm_xor_si128(ghash_bswap(x), aesni_enc1(j0, rk, nr));
+	_mm_storeu_si128((__m128i*)tag, x);
+
+	m_burn(block, sizeof(block));
+	return CRYPT_OK;
+}
+
+static int aesni_test(void);
+
+static const struct ltc_cipher_descriptor aesni_desc = {
+	"aes",
+	6,
+	16, 32, 16, 10,
+	aesni_setup, aesni_ecb_encrypt, aesni_ecb_decrypt, aesni_test,
+	accel_done, accel_keysize,
+	NULL, NULL, NULL, NULL, aesni_ctr_encrypt,
+	NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+};
+
+static int aesni_test(void) {
+	return accel_test(&aesni_desc);
+}
+#endif /* DROPBEAR_CPU_X86 */
+
+#if DROPBEAR_CPU_ARM64
+/* ARMv8 crypto extensions */
+#include <arm_neon.h>
+
+#if defined(__clang__)
+#define ARMCE_TARGET __attribute__((target("crypto")))
+#else
+#define ARMCE_TARGET __attribute__((target("+crypto")))
+#endif
+#define ARMCE_INLINE ARMCE_TARGET static inline __attribute__((always_inline))
+
+ARMCE_TARGET static ulong32 armce_sub_word(ulong32 w) {
+	/* With every column the same ShiftRows has no effect, AESE with a
+	 * zero key is then just SubBytes */
+	uint8x16_t x = vreinterpretq_u8_u32(vdupq_n_u32(w));
+	x = vaeseq_u8(x, vdupq_n_u8(0));
+	return vgetq_lane_u32(vreinterpretq_u32_u8(x), 0);
+}
+
+ARMCE_TARGET static void armce_inv_mix(const unsigned char *in, unsigned char *out) {
+	vst1q_u8(out, vaesimcq_u8(vld1q_u8(in)));
+}
+
+static int armce_setup(const unsigned char *key, int keylen, int num_rounds,
+		symmetric_key *skey) {
+	return accel_expand_key(key, keylen, num_rounds, skey,
+		armce_sub_word, armce_inv_mix);
+}
+
+ARMCE_INLINE void armce_load_keys(const unsigned char *keys,
+		int nr, uint8x16_t *rk) {
+	int r;
+	for (r = 0; r <= nr; r++) {
+		rk[r] = vld1q_u8(keys + 16*r);
+	}
+}
+
+/* AESE includes the AddRoundKey at the start of each round */
+ARMCE_INLINE uint8x16_t armce_enc1(uint8x16_t b,
+		const uint8x16_t *rk, int nr) {
+	int r;
+	for (r = 0; r < nr - 1; r++) {
+		b = vaesmcq_u8(vaeseq_u8(b, rk[r]));
+	}
+	b = vaeseq_u8(b, rk[nr-1]);
+	return veorq_u8(b, rk[nr]);
+}
+
+ARMCE_INLINE void armce_enc4(uint8x16_t *b,
+		const uint8x16_t *rk, int nr) {
+	uint8x16_t b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+	int r;
+
+	for (r = 0; r < nr - 1; r++) {
+		b0 = vaesmcq_u8(vaeseq_u8(b0, rk[r]));
+		b1 = vaesmcq_u8(vaeseq_u8(b1, rk[r]));
+		b2 = vaesmcq_u8(vaeseq_u8(b2, rk[r]));
+		b3 = vaesmcq_u8(vaeseq_u8(b3, rk[r]));
+	}
+	b[0] = veorq_u8(vaeseq_u8(b0, rk[nr-1]), rk[nr]);
+	b[1] = veorq_u8(vaeseq_u8(b1, rk[nr-1]), rk[nr]);
+	b[2] = veorq_u8(vaeseq_u8(b2, rk[nr-1]), rk[nr]);
+	b[3] = veorq_u8(vaeseq_u8(b3, rk[nr-1]), rk[nr]);
+}
+
+ARMCE_TARGET static int armce_ecb_encrypt(const unsigned char *pt,
+		unsigned char *ct, symmetric_key *skey) {
+	uint8x16_t rk[ACCEL_MAX_ROUNDS + 1];
+	int nr = skey->rijndael.Nr;
+
+	armce_load_keys(ACCEL_EK(skey), nr, rk);
+	vst1q_u8(ct, armce_enc1(vld1q_u8(pt), rk, nr));
+	return CRYPT_OK;
+}
+
+ARMCE_TARGET static int armce_ecb_decrypt(const unsigned char *ct,
+		unsigned char *pt, symmetric_key *skey) {
+	uint8x16_t rk[ACCEL_MAX_ROUNDS + 1];
+	uint8x16_t b;
+	int nr = skey->rijndael.Nr, r;
+
+	armce_load_keys(ACCEL_DK(skey), nr, rk);
+	b = vld1q_u8(ct);
+	for (r = 0; r < nr - 1; r++) {
+		b = vaesimcq_u8(vaesdq_u8(b, rk[r]));
+	}
+	b = vaesdq_u8(b, rk[nr-1]);
+	vst1q_u8(pt, veorq_u8(b, rk[nr]));
+	return CRYPT_OK;
+}
+
+ARMCE_INLINE uint8x16_t armce_ctr_block(int mode,
+		ulong64 hi, ulong64 lo) {
+	if (mode == CTR_COUNTER_BIG_ENDIAN) {
+		return vreinterpretq_u8_u64(vcombine_u64(
+			vcreate_u64(__builtin_bswap64(hi)),
+			vcreate_u64(__builtin_bswap64(lo))));
+	}
+	return vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(lo), vcreate_u64(hi)));
+}
+
+ARMCE_TARGET static int armce_ctr_encrypt(const unsigned char *pt,
+		unsigned char *ct, unsigned long blocks, unsigned char *IV,
+		int mode, symmetric_key *skey) {
+	uint8x16_t rk[ACCEL_MAX_ROUNDS + 1];
+	uint8x16_t b[4];
+	ulong64 hi, lo;
+	int nr = skey->rijndael.Nr, i;
+
+	armce_load_keys(ACCEL_EK(skey), nr, rk);
+	accel_ctr_load(IV, mode, &hi, &lo);
+
+	for (; blocks >= 4; blocks -= 4) {
+		for (i = 0; i < 4; i++) {
+			CTR_INCREMENT(hi, lo);
+			b[i] = armce_ctr_block(mode, hi, lo);
+		}
+		armce_enc4(b, rk, nr);
+		for (i = 0; i < 4; i++) {
+			vst1q_u8(ct + 16*i, veorq_u8(b[i], vld1q_u8(pt + 16*i)));
+		}
+		pt += 64;
+		ct += 64;
+	}
+	for (; blocks > 0; blocks--) {
+		CTR_INCREMENT(hi, lo);
+		b[0] = armce_enc1(armce_ctr_block(mode, hi, lo), rk, nr);
+		vst1q_u8(ct, veorq_u8(b[0], vld1q_u8(pt)));
+		pt += 16;
+		ct += 16;
+	}
+
+	accel_ctr_store(IV, mode, hi, lo);
+	return CRYPT_OK;
+}
+
+/* The same byte reversed GHASH as the x86 code, with the reduction
+ * done in general purpose registers */
+ARMCE_INLINE uint8x16_t armce_ghash_bswap(uint8x16_t x) {
+	x = vrev64q_u8(x);
+	return vextq_u8(x, x, 8);
+}
+
+struct armce_wide {
+	uint64x2_t lo, hi;
+};
+
+ARMCE_INLINE void armce_clmul_acc(uint8x16_t a, uint8x16_t b,
+		struct armce_wide *acc) {
+	poly64_t a0 = vgetq_lane_p64(vreinterpretq_p64_u8(a), 0);
+	poly64_t a1 = vgetq_lane_p64(vreinterpretq_p64_u8(a), 1);
+	poly64_t b0 = vgetq_lane_p64(vreinterpretq_p64_u8(b), 0);
+	poly64_t b1 = vgetq_lane_p64(vreinterpretq_p64_u8(b), 1);
+	uint64x2_t t0 = vreinterpretq_u64_p128(vmull_p64(a0, b0));
+	uint64x2_t t1 = vreinterpretq_u64_p128(vmull_p64(a0, b1));
+	uint64x2_t t2 = vreinterpretq_u64_p128(vmull_p64(a1, b0));
+	uint64x2_t t3 = vreinterpretq_u64_p128(vmull_p64(a1, b1));
+	uint64x2_t zero = vdupq_n_u64(0);
+
+	t1 = veorq_u64(t1, t2);
+	acc->lo = veorq_u64(acc->lo, veorq_u64(t0, vextq_u64(zero, t1, 1)));
+	acc->hi = veorq_u64(acc->hi, veorq_u64(t3, vextq_u64(t1, zero, 1)));
+}
+
+ARMCE_INLINE uint8x16_t armce_ghash_reduce(const struct armce_wide *acc) {
+	ulong64 x0 = vgetq_lane_u64(acc->lo, 0), x1 = vgetq_lane_u64(acc->lo, 1);
+	ulong64 x2 = vgetq_lane_u64(acc->hi, 0), x3 = vgetq_lane_u64(acc->hi, 1);
+	ulong64 d, h0, h1;
+
+	/* shift left one bit */
+	x3 = (x3 << 1) | (x2 >> 63);
+	x2 = (x2 << 1) | (x1 >> 63);
+	x1 = (x1 << 1) | (x0 >> 63);
+	x0 <<= 1;
+
+	d = x1 ^ (x0 << 63) ^ (x0 << 62) ^ (x0 << 57);
+	h0 = x0 ^ ((x0 >> 1) | (d << 63)) ^ ((x0 >> 2) | (d << 62))
+		^ ((x0 >> 7) | (d << 57));
+	h1 = d ^ (d >> 1) ^ (d >> 2) ^ (d >> 7);
+
+	return vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(x2 ^ h0),
+		vcreate_u64(x3 ^ h1)));
+}
+
+ARMCE_INLINE uint8x16_t armce_ghash_mul(uint8x16_t a, uint8x16_t b) {
+	struct armce_wide acc;
+	acc.lo = acc.hi = vdupq_n_u64(0);
+	armce_clmul_acc(a, b, &acc);
+	return armce_ghash_reduce(&acc);
+}
+
+ARMCE_INLINE uint8x16_t armce_ghash_update4(uint8x16_t x,
+		const uint8x16_t *c, const uint8x16_t *hpow) {
+	struct armce_wide acc;
+	acc.lo = acc.hi = vdupq_n_u64(0);
+	armce_clmul_acc(veorq_u8(x, armce_ghash_bswap(c[0])), hpow[3], &acc);
+	armce_clmul_acc(armce_ghash_bswap(c[1]), hpow[2], &acc);
+	armce_clmul_acc(armce_ghash_bswap(c[2]), hpow[1], &acc);
+	armce_clmul_acc(armce_ghash_bswap(c[3]), hpow[0], &acc);
+	return armce_ghash_reduce(&acc);
+}
+
+ARMCE_INLINE uint8x16_t armce_ghash_update(uint8x16_t x,
+		uint8x16_t c, uint8x16_t h) {
+	return armce_ghash_mul(veorq_u8(x, armce_ghash_bswap(c)), h);
+}
+
+ARMCE_TARGET static int armce_gcm_crypt(symmetric_key *skey,
+		const unsigned char *H, const unsigned char *iv,
+		const unsigned char *aad, unsigned long aadlen,
+		const unsigned char *in, unsigned char *out, unsigned long len,
+		unsigned char *tag, int direction) {
+	uint8x16_t rk[ACCEL_MAX_ROUNDS + 1];
+	uint8x16_t hpow[4], x, j0, ks[4], c[4];
+	unsigned char block[GCM_BLOCK_LEN];
+	unsigned long i, remain;
+	ulong32 counter = 1;
+	int nr = skey->rijndael.Nr, k;
+
+	armce_load_keys(ACCEL_EK(skey), nr, rk);
+	hpow[0] = armce_ghash_bswap(vld1q_u8(H));
+	hpow[1] = armce_ghash_mul(hpow[0], hpow[0]);
+	hpow[2] = armce_ghash_mul(hpow[1], hpow[0]);
+	hpow[3] = armce_ghash_mul(hpow[2], hpow[0]);
+
+	memcpy(block, iv, GCM_IV_LEN);
+	STORE32H(counter, block + GCM_IV_LEN);
+	j0 = vld1q_u8(block);
+
+	x = vdupq_n_u8(0);
+	for (i = 0; i + GCM_BLOCK_LEN <= aadlen; i += GCM_BLOCK_LEN) {
+		x = armce_ghash_update(x, vld1q_u8(aad + i), hpow[0]);
+	}
+	if (i < aadlen) {
+		memset(block, 0x0, sizeof(block));
+		memcpy(block, aad + i, aadlen - i);
+		x = armce_ghash_update(x, vld1q_u8(block), hpow[0]);
+	}
+
+	for (i = 0; i + 4*GCM_BLOCK_LEN <= len; i += 4*GCM_BLOCK_LEN) {
+		for (k = 0; k < 4; k++) {
+			counter++;
+			ks[k] = vreinterpretq_u8_u32(vsetq_lane_u32(
+				__builtin_bswap32(counter), vreinterpretq_u32_u8(j0), 3));
+			c[k] = vld1q_u8(in + i + 16*k);
+		}
+		if (direction == LTC_DECRYPT) {
+			x = armce_ghash_update4(x, c, hpow);
+		}
+		armce_enc4(ks, rk, nr);
+		for (k = 0; k < 4; k++) {
+			c[k] = veorq_u8(c[k], ks[k]);
+			vst1q_u8(out + i + 16*k, c[k]);
+		}
+		if (direction == LTC_ENCRYPT) {
+			x = armce_ghash_update4(x, c, hpow);
+		}
+	}
+
+	for (; i < len; i += GCM_BLOCK_LEN) {
+		remain = MIN(len - i, GCM_BLOCK_LEN);
+		counter++;
+		ks[0] = armce_enc1(vreinterpretq_u8_u32(vsetq_lane_u32(
+			__builtin_bswap32(counter), vreinterpretq_u32_u8(j0), 3)), rk, nr);
+		memset(block, 0x0, sizeof(block));
+		memcpy(block, in + i, remain);
+		c[0] = vld1q_u8(block);
+		if (direction == LTC_DECRYPT) {
+			x = armce_ghash_update(x, c[0], hpow[0]);
+		}
+		vst1q_u8(block, veorq_u8(c[0], ks[0]));
+		memcpy(out + i, block, remain);
+		if (direction == LTC_ENCRYPT) {
+			memset(block + remain, 0x0, sizeof(block) - remain);
+			x = armce_ghash_update(x, vld1q_u8(block), hpow[0]);
+		}
+	}
+
+	gcm_length_block(block, aadlen, len);
+	x = armce_ghash_update(x, vld1q_u8(block), hpow[0]);
+	vst1q_u8(tag, veorq_u8(armce_ghash_bswap(x), armce_enc1(j0, rk, nr)));
+
+	m_burn(block, sizeof(block));
+	return CRYPT_OK;
+}
+
+static int armce_test(void);
+
+static const struct ltc_cipher_descriptor armce_desc = {
+	"aes",
+	6,
+	16, 32, 16, 10,
+	armce_setup, armce_ecb_encrypt, armce_ecb_decrypt, armce_test,
+	accel_done, accel_keysize,
+	NULL, NULL, NULL, NULL, armce_ctr_encrypt,
+	NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+};
+
+static int armce_test(void) {
+	return accel_test(&armce_desc);
+}
+#endif /* DROPBEAR_CPU_ARM64 */
+
+const struct ltc_cipher_descriptor* aes_accel_desc(void) {
+#if DROPBEAR_CPU_X86
+	if (cpu_has(CPU_AESNI)) {
+		return &aesni_desc;
+	}
+#endif
+#if DROPBEAR_CPU_ARM64
+	if (cpu_has(CPU_ARM_AES)) {
+		return &armce_desc;
+	}
+#endif
+	return NULL;
+}
+
+int aes_accel_gcm_crypt(int cipher, symmetric_key *skey,
+		const unsigned char *H, const unsigned char *iv,
+		const unsigned char *aad, unsigned long aadlen,
+		const unsigned char *in, unsigned char *out, unsigned long len,
+		unsigned char *tag, int direction) {
+	const struct ltc_cipher_descriptor *desc = &cipher_descriptor[cipher];
+
+#if DROPBEAR_CPU_X86
+	if (desc->setup == aesni_setup && cpu_has(CPU_PCLMUL)) {
+		return aesni_gcm_crypt(skey, H, iv, aad, aadlen,
+			in, out, len, tag, direction);
+	}
+#endif
+#if DROPBEAR_CPU_ARM64
+	if (desc->setup == armce_setup && cpu_has(CPU_ARM_PMULL)) {
+		return armce_gcm_crypt(skey, H, iv, aad, aadlen,
+			in, out, len, tag, direction);
+	}
+#endif
+	(void)desc;
+	return CRYPT_NOP;
+}
+
+#endif /* DROPBEAR_AES_ACCEL */
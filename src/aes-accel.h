@@ -0,0 +1,31 @@
+#ifndef DROPBEAR_AES_ACCEL_H_
+#define DROPBEAR_AES_ACCEL_H_
+
+#include "includes.h"
+
+/* AES using the CPU's AES instructions (AES-NI, or the ARMv8 crypto
+ * extensions), with GHASH using carry-less multiply for GCM. These are
+ * faster than the table based libtomcrypt code and don't have its cache
+ * timing side channels. */
+
+#if DROPBEAR_AES_ACCEL
+
+/* Returns a descriptor named "aes" if the CPU has AES instructions,
+ * otherwise NULL. crypto_init() registers it in place of aes_desc, so
+ * find_cipher("aes") and the ctr/cbc/gcm modes use it. Keys are
+ * compatible with aes_desc's symmetric_key layout in size only */
+const struct ltc_cipher_descriptor* aes_accel_desc(void);
+
+/* Encrypts or decrypts a packet with GCM in one pass, using the key
+ * schedule and hash key of a gcm_state from gcm_init(). iv is 12 bytes.
+ * Returns CRYPT_NOP if cipher isn't the accelerated descriptor or the CPU
+ * lacks carry-less multiply, then libtomcrypt's gcm should be used */
+int aes_accel_gcm_crypt(int cipher, symmetric_key *skey,
+		const unsigned char *H, const unsigned char *iv,
+		const unsigned char *aad, unsigned long aadlen,
+		const unsigned char *in, unsigned char *out, unsigned long len,
+		unsigned char *tag, int direction);
+
+#endif /* DROPBEAR_AES_ACCEL */
+
+#endif /* DROPBEAR_AES_ACCEL_H_ */
@@ -91,6 +91,19 @@ void bytes_to_mp(mp_int *mp, const unsigned char* bytes, unsigned int len) {
 	}
 }
 
+/* Writes mp big endian, zero padded to exactly len bytes */
+void mp_to_fixed_bytes(const mp_int *mp, unsigned char* bytes, unsigned int len) {
+	size_t size = mp_ubin_size(mp);
+
+	if (size > len) {
+		dropbear_exit("Bad mp size");
+	}
+	memset(bytes, 0x0, len - size);
+	if (mp_to_ubin(mp, &bytes[len - size], size, NULL) != MP_OKAY) {
+		dropbear_exit("Bad mp size");
+	}
+}
+
 /* hash the ssh representation of the mp_int mp */
 void hash_process_mp(const struct ltc_hash_descriptor *hash_desc,
 				hash_state *hs, const mp_int *mp) {
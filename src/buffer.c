@@ -91,6 +91,19 @@ buffer* buf_newcopy(const buffer* buf) {
 	return ret;
 }
 
+/* Make view an empty buffer using size bytes of buf's memory starting from
+ * offset. view is a plain struct rather than an allocation from buf_new(),
+ * and is only valid while buf is */
+void buf_setview(buffer* view, const buffer* buf, unsigned int offset, unsigned int size) {
+	if (offset > buf->size || size > buf->size - offset) {
+		dropbear_exit("Bad buf_setview");
+	}
+	view->data = buf->data + offset;
+	view->size = size;
+	view->len = 0;
+	view->pos = 0;
+}
+
 /* Set the length of the buffer */
 void buf_setlen(buffer* buf, unsigned int len) {
 	if (len > buf->size) {
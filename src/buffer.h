@@ -46,6 +46,7 @@ buffer * buf_resize(buffer *buf, unsigned int newsize);
 void buf_free(buffer* buf);
 void buf_burn_free(buffer* buf);
 buffer* buf_newcopy(const buffer* buf);
+void buf_setview(buffer* view, const buffer* buf, unsigned int offset, unsigned int size);
 void buf_setlen(buffer* buf, unsigned int len);
 void buf_incrlen(buffer* buf, unsigned int incr);
 void buf_setpos(buffer* buf, unsigned int pos);
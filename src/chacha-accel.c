@@ -0,0 +1,267 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "cpufeatures.h"
+#include "chacha-accel.h"
+
+#if DROPBEAR_CHACHA_ACCEL
+
+#define CHACHA_BLOCK_LEN 64
+
+/* Each vector register x[i] holds word i of the state for several blocks,
+ * so the quarter rounds run on all of the blocks at once. The VADD, VXOR,
+ * VROTL, VROTL16 and VROTL8 operations are defined for each instruction
+ * set below */
+#define CHACHA_QR(x, a, b, c, d) do { \
+	x[a] = VADD(x[a], x[b]); x[d] = VROTL16(VXOR(x[d], x[a])); \
+	x[c] = VADD(x[c], x[d]); x[b] = VROTL(VXOR(x[b], x[c]), 12); \
+	x[a] = VADD(x[a], x[b]); x[d] = VROTL8(VXOR(x[d], x[a])); \
+	x[c] = VADD(x[c], x[d]); x[b] = VROTL(VXOR(x[b], x[c]), 7); \
+} while (0)
+
+#define CHACHA_DOUBLEROUND(x) do { \
+	CHACHA_QR(x, 0, 4, 8, 12); \
+	CHACHA_QR(x, 1, 5, 9, 13); \
+	CHACHA_QR(x, 2, 6, 10, 14); \
+	CHACHA_QR(x, 3, 7, 11, 15); \
+	CHACHA_QR(x, 0, 5, 10, 15); \
+	CHACHA_QR(x, 1, 6, 11, 12); \
+	CHACHA_QR(x, 2, 7, 8, 13); \
+	CHACHA_QR(x, 3, 4, 9, 14); \
+} while (0)
+
+/* Counter words for a block. With a 64 bit IV the counter is 64 bits,
+ * otherwise word 13 is part of the IV */
+#define CTR_LO(ctr, n) ((ulong32)((ctr) + (n)))
+#define CTR_HI(st, ctr, n) ((st)->ivlen == 8 \
+	? (ulong32)(((ctr) + (n)) >> 32) : (st)->input[13])
+
+#if DROPBEAR_CPU_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#define SSE2_TARGET __attribute__((target("sse2")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+#define VADD(a, b) _mm_add_epi32(a, b)
+#define VXOR(a, b) _mm_xor_si128(a, b)
+#define VROTL(a, n) _mm_or_si128(_mm_slli_epi32(a, n), _mm_srli_epi32(a, 32 - (n)))
+#define VROTL16(a) _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, 0xb1), 0xb1)
+#define VROTL8(a) VROTL(a, 8)
+
+/* Transposes four vectors of one word from four blocks into four
+ * consecutive words of each block */
+#define TRANSPOSE4(a, b, c, d, epi32lo, epi32hi, epi64lo, epi64hi) do { \
+	t0 = epi32lo(a, b); t1 = epi32lo(c, d); \
+	t2 = epi32hi(a, b); t3 = epi32hi(c, d); \
+	a = epi64lo(t0, t1); b = epi64hi(t0, t1); \
+	c = epi64lo(t2, t3); d = epi64hi(t2, t3); \
+} while (0)
+
+SSE2_TARGET static void chacha_sse2_4(const chacha_state *st, ulong64 ctr,
+		const unsigned char *in, unsigned char *out) {
+	__m128i x[16], orig[16], t0, t1, t2, t3;
+	int i, g;
+
+	for (i = 0; i < 16; i++) {
+		orig[i] = _mm_set1_epi32((int)st->input[i]);
+	}
+	orig[12] = _mm_set_epi32((int)CTR_LO(ctr, 3), (int)CTR_LO(ctr, 2),
+		(int)CTR_LO(ctr, 1), (int)CTR_LO(ctr, 0));
+	orig[13] = _mm_set_epi32((int)CTR_HI(st, ctr, 3), (int)CTR_HI(st, ctr, 2),
+		(int)CTR_HI(st, ctr, 1), (int)CTR_HI(st, ctr, 0));
+	memcpy(x, orig, sizeof(x));
+
+	for (i = st->rounds; i > 0; i -= 2) {
+		CHACHA_DOUBLEROUND(x);
+	}
+
+	for (g = 0; g < 16; g += 4) {
+		for (i = g; i < g + 4; i++) {
+			x[i] = _mm_add_epi32(x[i], orig[i]);
+		}
+		TRANSPOSE4(x[g], x[g+1], x[g+2], x[g+3],
+			_mm_unpacklo_epi32, _mm_unpackhi_epi32,
+			_mm_unpacklo_epi64, _mm_unpackhi_epi64);
+		for (i = 0; i < 4; i++) {
+			const unsigned char *ip = in + i*CHACHA_BLOCK_LEN + g*4;
+			unsigned char *op = out + i*CHACHA_BLOCK_LEN + g*4;
+			_mm_storeu_si128((__m128i*)op, _mm_xor_si128(x[g+i],
+				_mm_loadu_si128((const __m128i*)ip)));
+		}
+	}
+}
+
+#undef VADD
+#undef VXOR
+#undef VROTL
+#undef VROTL16
+#undef VROTL8
+
+#define VADD(a, b) _mm256_add_epi32(a, b)
+#define VXOR(a, b) _mm256_xor_si256(a, b)
+#define VROTL(a, n) _mm256_or_si256(_mm256_slli_epi32(a, n), _mm256_srli_epi32(a, 32 - (n)))
+#define VROTL16(a) _mm256_shuffle_epi8(a, rot16)
+#define VROTL8(a) _mm256_shuffle_epi8(a, rot8)
+
+AVX2_TARGET static void chacha_avx2_8(const chacha_state *st, ulong64 ctr,
+		const unsigned char *in, unsigned char *out) {
+	const __m256i rot16 = _mm256_setr_epi8(
+		2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+		2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+	const __m256i rot8 = _mm256_setr_epi8(
+		3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+		3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+	__m256i x[16], orig[16], t0, t1, t2, t3;
+	int i, g;
+
+	for (i = 0; i < 16; i++) {
+		orig[i] = _mm256_set1_epi32((int)st->input[i]);
+	}
+	orig[12] = _mm256_setr_epi32(
+		(int)CTR_LO(ctr, 0), (int)CTR_LO(ctr, 1),
+		(int)CTR_LO(ctr, 2), (int)CTR_LO(ctr, 3),
+		(int)CTR_LO(ctr, 4), (int)CTR_LO(ctr, 5),
+		(int)CTR_LO(ctr, 6), (int)CTR_LO(ctr, 7));
+	orig[13] = _mm256_setr_epi32(
+		(int)CTR_HI(st, ctr, 0), (int)CTR_HI(st, ctr, 1),
+		(int)CTR_HI(st, ctr, 2), (int)CTR_HI(st, ctr, 3),
+		(int)CTR_HI(st, ctr, 4), (int)CTR_HI(st, ctr, 5),
+		(int)CTR_HI(st, ctr, 6), (int)CTR_HI(st, ctr, 7));
+	memcpy(x, orig, sizeof(x));
+
+	for (i = st->rounds; i > 0; i -= 2) {
+		CHACHA_DOUBLEROUND(x);
+	}
+
+	for (g = 0; g < 16; g += 4) {
+		for (i = g; i < g + 4; i++) {
+			x[i] = _mm256_add_epi32(x[i], orig[i]);
+		}
+		/* Transposes within each 128 bit lane, the low lane has
+		 * blocks 0-3 and the high lane blocks 4-7 */
+		TRANSPOSE4(x[g], x[g+1], x[g+2], x[g+3],
+			_mm256_unpacklo_epi32, _mm256_unpackhi_epi32,
+			_mm256_unpacklo_epi64, _mm256_unpackhi_epi64);
+		for (i = 0; i < 4; i++) {
+			const unsigned char *ip = in + i*CHACHA_BLOCK_LEN + g*4;
+			unsigned char *op = out + i*CHACHA_BLOCK_LEN + g*4;
+			_mm_storeu_si128((__m128i*)op, _mm_xor_si128(
+				_mm256_castsi256_si128(x[g+i]),
+				_mm_loadu_si128((const __m128i*)ip)));
+			ip += 4*CHACHA_BLOCK_LEN;
+			op += 4*CHACHA_BLOCK_LEN;
+			_mm_storeu_si128((__m128i*)op, _mm_xor_si128(
+				_mm256_extracti128_si256(x[g+i], 1),
+				_mm_loadu_si128((const __m128i*)ip)));
+		}
+	}
+}
+#endif /* DROPBEAR_CPU_X86 */
+
+#if DROPBEAR_CPU_ARM64
+#include <arm_neon.h>
+
+#define VADD(a, b) vaddq_u32(a, b)
+#define VXOR(a, b) veorq_u32(a, b)
+#define VROTL(a, n) vsriq_n_u32(vshlq_n_u32(a, n), a, 32 - (n))
+#define VROTL16(a) vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(a)))
+#define VROTL8(a) VROTL(a, 8)
+
+static void chacha_neon_4(const chacha_state *st, ulong64 ctr,
+		const unsigned char *in, unsigned char *out) {
+	uint32x4_t x[16], orig[16];
+	uint32x4x2_t t0, t1;
+	ulong32 lanes[4];
+	int i, g;
+
+	for (i = 0; i < 16; i++) {
+		orig[i] = vdupq_n_u32(st->input[i]);
+	}
+	for (i = 0; i < 4; i++) {
+		lanes[i] = CTR_LO(ctr, i);
+	}
+	orig[12] = vld1q_u32(lanes);
+	for (i = 0; i < 4; i++) {
+		lanes[i] = CTR_HI(st, ctr, i);
+	}
+	orig[13] = vld1q_u32(lanes);
+	memcpy(x, orig, sizeof(x));
+
+	for (i = st->rounds; i > 0; i -= 2) {
+		CHACHA_DOUBLEROUND(x);
+	}
+
+	for (g = 0; g < 16; g += 4) {
+		for (i = g; i < g + 4; i++) {
+			x[i] = vaddq_u32(x[i], orig[i]);
+		}
+		t0 = vtrnq_u32(x[g], x[g+1]);
+		t1 = vtrnq_u32(x[g+2], x[g+3]);
+		x[g] = vcombine_u32(vget_low_u32(t0.val[0]), vget_low_u32(t1.val[0]));
+		x[g+1] = vcombine_u32(vget_low_u32(t0.val[1]), vget_low_u32(t1.val[1]));
+		x[g+2] = vcombine_u32(vget_high_u32(t0.val[0]), vget_high_u32(t1.val[0]));
+		x[g+3] = vcombine_u32(vget_high_u32(t0.val[1]), vget_high_u32(t1.val[1]));
+		for (i = 0; i < 4; i++) {
+			const unsigned char *ip = in + i*CHACHA_BLOCK_LEN + g*4;
+			unsigned char *op = out + i*CHACHA_BLOCK_LEN + g*4;
+			vst1q_u8(op, veorq_u8(vreinterpretq_u8_u32(x[g+i]), vld1q_u8(ip)));
+		}
+	}
+}
+#endif /* DROPBEAR_CPU_ARM64 */
+
+unsigned long chacha_accel_crypt(chacha_state *st, const unsigned char *in,
+		unsigned char *out, unsigned long len) {
+	unsigned long blocks = len / CHACHA_BLOCK_LEN, done = 0;
+	ulong64 ctr;
+
+	if (st->ksleft != 0 || blocks == 0) {
+		return 0;
+	}
+
+	/* chacha_crypt() fails rather than wrapping the counter, leave
+	 * that case to it */
+	if (st->ivlen == 8) {
+		ctr = ((ulong64)st->input[13] << 32) | st->input[12];
+		if (ctr + blocks <= ctr) {
+			return 0;
+		}
+	} else {
+		ctr = st->input[12];
+		if (ctr + blocks > 0xffffffffUL) {
+			return 0;
+		}
+	}
+
+#if DROPBEAR_CPU_X86
+	if (cpu_has(CPU_AVX2)) {
+		for (; blocks - done >= 8; done += 8) {
+			chacha_avx2_8(st, ctr + done, in + done*CHACHA_BLOCK_LEN,
+				out + done*CHACHA_BLOCK_LEN);
+		}
+	}
+	if (cpu_has(CPU_SSE2)) {
+		for (; blocks - done >= 4; done += 4) {
+			chacha_sse2_4(st, ctr + done, in + done*CHACHA_BLOCK_LEN,
+				out + done*CHACHA_BLOCK_LEN);
+		}
+	}
+#endif
+#if DROPBEAR_CPU_ARM64
+	if (cpu_has(CPU_ARM_NEON)) {
+		for (; blocks - done >= 4; done += 4) {
+			chacha_neon_4(st, ctr + done, in + done*CHACHA_BLOCK_LEN,
+				out + done*CHACHA_BLOCK_LEN);
+		}
+	}
+#endif
+
+	ctr += done;
+	st->input[12] = (ulong32)ctr;
+	if (st->ivlen == 8) {
+		st->input[13] = (ulong32)(ctr >> 32);
+	}
+	return done * CHACHA_BLOCK_LEN;
+}
+
+#endif /* DROPBEAR_CHACHA_ACCEL */
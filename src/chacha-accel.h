@@ -0,0 +1,21 @@
+#ifndef DROPBEAR_CHACHA_ACCEL_H_
+#define DROPBEAR_CHACHA_ACCEL_H_
+
+#include "includes.h"
+
+/* ChaCha20 computing several blocks in parallel with SIMD instructions
+ * (SSE2 or AVX2 on x86, NEON on arm64), chosen at runtime. */
+
+#if DROPBEAR_CHACHA_ACCEL
+
+/* Encrypts or decrypts the whole 64 byte blocks of in, continuing from the
+ * state of a libtomcrypt chacha_state and advancing its counter in the same
+ * way as chacha_crypt(). st must not have a partially used keystream block.
+ * Returns the number of bytes processed, which may be 0 if the CPU has no
+ * suitable instructions. chacha_crypt() should be used for the rest */
+unsigned long chacha_accel_crypt(chacha_state *st, const unsigned char *in,
+		unsigned char *out, unsigned long len);
+
+#endif /* DROPBEAR_CHACHA_ACCEL */
+
+#endif /* DROPBEAR_CHACHA_ACCEL_H_ */
@@ -27,6 +27,7 @@
 #include "algo.h"
 #include "dbutil.h"
 #include "chachapoly.h"
+#include "chacha-accel.h"
 
 #if DROPBEAR_CHACHA20POLY1305
 
@@ -35,6 +36,10 @@
 #define POLY1305_KEY_LEN 32
 #define POLY1305_TAG_LEN 16
 
+/* Packets are encrypted and MACed in pieces of this size, so that the
+ * ciphertext is still in L1 cache when Poly1305 reads it */
+#define CHACHAPOLY_CHUNK 1024
+
 static const struct ltc_cipher_descriptor dummy = {.name = NULL};
 
 static const struct dropbear_hash dropbear_chachapoly_mac =
@@ -43,6 +48,184 @@ static const struct dropbear_hash dropbear_chachapoly_mac =
 const struct dropbear_cipher dropbear_chachapoly =
 	{&dummy, CHACHA20_KEY_LEN*2, CHACHA20_BLOCKSIZE};
 
+#if defined(__SIZEOF_INT128__)
+/* Poly1305 with 44 bit limbs and 64x64 bit multiplies, after
+ * poly1305-donna-64. About twice the speed of libtomcrypt's 26 bit limbs
+ * on 64 bit CPUs */
+typedef unsigned __int128 poly_u128;
+
+#define POLY_MASK44 0xfffffffffffULL
+#define POLY_MASK42 0x3ffffffffffULL
+
+typedef struct {
+	ulong64 r[3], h[3], pad[2];
+	unsigned char buf[16];
+	unsigned int leftover;
+} chachapoly_mac;
+
+static void mac_init(chachapoly_mac *st, const unsigned char *key) {
+	ulong64 t0, t1;
+
+	LOAD64L(t0, key);
+	LOAD64L(t1, key + 8);
+	/* clamped r */
+	st->r[0] = t0 & 0xffc0fffffffULL;
+	st->r[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffffULL;
+	st->r[2] = (t1 >> 24) & 0x00ffffffc0fULL;
+	st->h[0] = st->h[1] = st->h[2] = 0;
+	LOAD64L(st->pad[0], key + 16);
+	LOAD64L(st->pad[1], key + 24);
+	st->leftover = 0;
+}
+
+/* hibit is 2^128 for full blocks, 0 for the padded final block */
+static void mac_blocks(chachapoly_mac *st, const unsigned char *m,
+		unsigned long len, ulong64 hibit) {
+	ulong64 r0 = st->r[0], r1 = st->r[1], r2 = st->r[2];
+	ulong64 s1 = r1 * (5 << 2), s2 = r2 * (5 << 2);
+	ulong64 h0 = st->h[0], h1 = st->h[1], h2 = st->h[2];
+	ulong64 t0, t1, c;
+	poly_u128 d0, d1, d2;
+
+	for (; len >= 16; len -= 16, m += 16) {
+		LOAD64L(t0, m);
+		LOAD64L(t1, m + 8);
+		h0 += t0 & POLY_MASK44;
+		h1 += ((t0 >> 44) | (t1 << 20)) & POLY_MASK44;
+		h2 += ((t1 >> 24) & POLY_MASK42) | hibit;
+
+		/* h *= r mod 2^130 - 5 */
+		d0 = (poly_u128)h0 * r0 + (poly_u128)h1 * s2 + (poly_u128)h2 * s1;
+		d1 = (poly_u128)h0 * r1 + (poly_u128)h1 * r0 + (poly_u128)h2 * s2;
+		d2 = (poly_u128)h0 * r2 + (poly_u128)h1 * r1 + (poly_u128)h2 * r0;
+
+		c = (ulong64)(d0 >> 44);
+		h0 = (ulong64)d0 & POLY_MASK44;
+		d1 += c;
+		c = (ulong64)(d1 >> 44);
+		h1 = (ulong64)d1 & POLY_MASK44;
+		d2 += c;
+		c = (ulong64)(d2 >> 42);
+		h2 = (ulong64)d2 & POLY_MASK42;
+		h0 += c * 5;
+		c = h0 >> 44;
+		h0 &= POLY_MASK44;
+		h1 += c;
+	}
+
+	st->h[0] = h0;
+	st->h[1] = h1;
+	st->h[2] = h2;
+}
+
+static void mac_update(chachapoly_mac *st, const unsigned char *m,
+		unsigned long len) {
+	unsigned long n;
+
+	if (st->leftover) {
+		n = MIN(len, 16 - st->leftover);
+		memcpy(st->buf + st->leftover, m, n);
+		st->leftover += n;
+		m += n;
+		len -= n;
+		if (st->leftover < 16) {
+			return;
+		}
+		mac_blocks(st, st->buf, 16, 1ULL << 40);
+		st->leftover = 0;
+	}
+
+	n = len & ~15UL;
+	mac_blocks(st, m, n, 1ULL << 40);
+	m += n;
+	len -= n;
+
+	if (len) {
+		memcpy(st->buf, m, len);
+		st->leftover = len;
+	}
+}
+
+static void mac_done(chachapoly_mac *st, unsigned char *mac) {
+	ulong64 h0, h1, h2, g0, g1, g2, c, t0, t1;
+
+	if (st->leftover) {
+		st->buf[st->leftover] = 1;
+		memset(st->buf + st->leftover + 1, 0x0, 15 - st->leftover);
+		mac_blocks(st, st->buf, 16, 0);
+	}
+
+	/* fully carry h */
+	h0 = st->h[0];
+	h1 = st->h[1];
+	h2 = st->h[2];
+	c = h1 >> 44; h1 &= POLY_MASK44;
+	h2 += c; c = h2 >> 42; h2 &= POLY_MASK42;
+	h0 += c * 5; c = h0 >> 44; h0 &= POLY_MASK44;
+	h1 += c; c = h1 >> 44; h1 &= POLY_MASK44;
+	h2 += c; c = h2 >> 42; h2 &= POLY_MASK42;
+	h0 += c * 5; c = h0 >> 44; h0 &= POLY_MASK44;
+	h1 += c;
+
+	/* g = h - p, selected in constant time if h >= p */
+	g0 = h0 + 5; c = g0 >> 44; g0 &= POLY_MASK44;
+	g1 = h1 + c; c = g1 >> 44; g1 &= POLY_MASK44;
+	g2 = h2 + c - (1ULL << 42);
+	c = (g2 >> 63) - 1;
+	g0 &= c;
+	g1 &= c;
+	g2 &= c;
+	c = ~c;
+	h0 = (h0 & c) | g0;
+	h1 = (h1 & c) | g1;
+	h2 = (h2 & c) | g2;
+
+	/* h + pad mod 2^128 */
+	t0 = st->pad[0];
+	t1 = st->pad[1];
+	h0 += t0 & POLY_MASK44; c = h0 >> 44; h0 &= POLY_MASK44;
+	h1 += (((t0 >> 44) | (t1 << 20)) & POLY_MASK44) + c;
+	c = h1 >> 44; h1 &= POLY_MASK44;
+	h2 += ((t1 >> 24) & POLY_MASK42) + c;
+	h2 &= POLY_MASK42;
+
+	h0 = h0 | (h1 << 44);
+	h1 = (h1 >> 20) | (h2 << 24);
+	STORE64L(h0, mac);
+	STORE64L(h1, mac + 8);
+
+	m_burn(st, sizeof(*st));
+}
+#else
+/* libtomcrypt's 32 bit implementation */
+typedef poly1305_state chachapoly_mac;
+
+static void mac_init(chachapoly_mac *st, const unsigned char *key) {
+	poly1305_init(st, key, POLY1305_KEY_LEN);
+}
+
+static void mac_update(chachapoly_mac *st, const unsigned char *m,
+		unsigned long len) {
+	poly1305_process(st, m, len);
+}
+
+static void mac_done(chachapoly_mac *st, unsigned char *mac) {
+	unsigned long maclen = POLY1305_TAG_LEN;
+	poly1305_done(st, mac, &maclen);
+}
+#endif /* __SIZEOF_INT128__ */
+
+/* chacha_crypt() with the SIMD implementation for whole blocks */
+static int chachapoly_stream(chacha_state *st, const unsigned char *in,
+		unsigned long len, unsigned char *out) {
+	unsigned long done = 0;
+
+#if DROPBEAR_CHACHA_ACCEL
+	done = chacha_accel_crypt(st, in, out, len);
+#endif
+	return chacha_crypt(st, in + done, len - done, out + done);
+}
+
 static int dropbear_chachapoly_start(int UNUSED(cipher), const unsigned char* UNUSED(IV),
 			const unsigned char *key, int keylen,
 			int UNUSED(num_rounds), dropbear_chachapoly_state *state) {
@@ -72,8 +255,9 @@ static int dropbear_chachapoly_crypt(unsigned int seq,
 			const unsigned char *in, unsigned char *out,
 			unsigned long len, unsigned long taglen,
 			dropbear_chachapoly_state *state, int direction) {
-	poly1305_state poly;
+	chachapoly_mac poly;
 	unsigned char seqbuf[8], key[POLY1305_KEY_LEN], tag[POLY1305_TAG_LEN];
+	unsigned long pos, n;
 	int err;
 
 	TRACE2(("enter dropbear_chachapoly_crypt"))
@@ -88,10 +272,14 @@ static int dropbear_chachapoly_crypt(unsigned int seq,
 		return err;
 	}
 
-	poly1305_init(&poly, key, sizeof(key));
+	mac_init(&poly, key);
+	m_burn(key, sizeof(key));
 	if (direction == LTC_DECRYPT) {
-		poly1305_process(&poly, in, len);
-		poly1305_done(&poly, tag, &taglen);
+		/* Authenticate before decrypting anything. A received packet
+		 * is at most a few tens of kB, so it stays in cache for the
+		 * decryption pass */
+		mac_update(&poly, in, len);
+		mac_done(&poly, tag);
 		if (constant_time_memcmp(in + len, tag, taglen) != 0) {
 			return CRYPT_ERROR;
 		}
@@ -103,13 +291,22 @@ static int dropbear_chachapoly_crypt(unsigned int seq,
 	}
 
 	chacha_ivctr64(&state->chacha, seqbuf, sizeof(seqbuf), 1);
-	if ((err = chacha_crypt(&state->chacha, in + 4, len - 4, out + 4)) != CRYPT_OK) {
-		return err;
-	}
-
-	if (direction == LTC_ENCRYPT) {
-		poly1305_process(&poly, out, len);
-		poly1305_done(&poly, out + len, &taglen);
+	if (direction == LTC_DECRYPT) {
+		if ((err = chachapoly_stream(&state->chacha, in + 4, len - 4, out + 4)) != CRYPT_OK) {
+			return err;
+		}
+	} else {
+		/* Encrypt-then-MAC in a single pass over the packet, each chunk
+		 * is MACed straight after it's encrypted */
+		mac_update(&poly, out, 4);
+		for (pos = 4; pos < len; pos += n) {
+			n = MIN(len - pos, CHACHAPOLY_CHUNK);
+			if ((err = chachapoly_stream(&state->chacha, in + pos, n, out + pos)) != CRYPT_OK) {
+				return err;
+			}
+			mac_update(&poly, out + pos, n);
+		}
+		mac_done(&poly, out + len);
 	}
 
 	TRACE2(("leave dropbear_chachapoly_crypt"))
@@ -49,6 +49,17 @@ struct Channel {
 	unsigned int recvwindow, transwindow;
 	unsigned int recvdonelen;
 	unsigned int recvmaxpacket, transmaxpacket;
+	/* Receive window auto-tuning, see autotune_recv_window().
+	   recvwindowsize starts at opts.recv_window */
+	unsigned int recvwindowsize;
+	unsigned long long recvgranted, recvtotal; /* window given to the peer,
+												  and data received */
+	int rtt_probing; /* timing an adjust, until data beyond rtt_probe_credit */
+	unsigned long long rtt_probe_credit;
+	struct timespec rtt_probe_time;
+	long long rtt_min_us; /* 0 until measured */
+	struct timespec rate_start;
+	unsigned long long rate_start_total;
 	void* typedata; /* a pointer to type specific data */
 	int writefd; /* read from wire, written to insecure side */
 	int readfd; /* read from insecure side, written to wire */
@@ -84,6 +95,21 @@ struct Channel {
 	const struct ChanType* type;
 
 	enum dropbear_prio prio;
+
+	/* Sending is scheduled by deficit round robin between channels with
+	 * data ready, see channel_schedule_sends(). A channel's share is in
+	 * proportion to its weight, from its type */
+	unsigned int sched_weight;
+	int sched_deficit;
+	int sched_ready; /* fds with data to read this pass */
+	int sched_again; /* fds already read from this pass */
+	struct Channel *sched_next;
+	/* Sent bytes and packets, and the write queue length each packet
+	 * joined. Added to the metrics when the channel is removed */
+	unsigned long long sched_bytes;
+	unsigned long long sched_packets;
+	unsigned long long sched_queue_sum;
+	unsigned int sched_queue_max;
 };
 
 struct ChanType {
@@ -107,8 +133,8 @@ void channel_connect_done(int result, int sock, void* user_data, const char* err
 
 void chaninitialise(const struct ChanType *chantypes[]);
 void chancleanup(void);
-void setchannelfds(fd_set *readfds, fd_set *writefds, int allow_reads);
-void channelio(const fd_set *readfd, const fd_set *writefd);
+void setchannelfds(int allow_reads);
+void channelio(void);
 struct Channel* getchannel(void);
 /* Returns an arbitrary channel that is in a ready state - not
 being initialised and no EOF in either direction. NULL if none. */
@@ -47,6 +47,32 @@ circbuffer * cbuf_new(unsigned int size) {
 	return cbuf;
 }
 
+/* Grows the buffer to newsize, keeping its contents */
+void cbuf_resize(circbuffer *cbuf, unsigned int newsize) {
+	unsigned char *data = NULL;
+	unsigned char *p1 = NULL, *p2 = NULL;
+	unsigned int len1, len2;
+
+	if (newsize > MAX_CBUF_SIZE || newsize < cbuf->used) {
+		dropbear_exit("Bad cbuf size");
+	}
+
+	if (cbuf->data) {
+		data = m_malloc(newsize);
+		cbuf_readptrs(cbuf, &p1, &len1, &p2, &len2);
+		memcpy(data, p1, len1);
+		if (len2 > 0) {
+			memcpy(&data[len1], p2, len2);
+		}
+		m_burn(cbuf->data, cbuf->size);
+		m_free(cbuf->data);
+		cbuf->data = data;
+	}
+	cbuf->readpos = 0;
+	cbuf->writepos = cbuf->used % newsize;
+	cbuf->size = newsize;
+}
+
 void cbuf_free(circbuffer * cbuf) {
 
 	if (cbuf->data) {
@@ -37,6 +37,7 @@ typedef struct circbuf circbuffer;
 
 circbuffer * cbuf_new(unsigned int size);
 void cbuf_free(circbuffer * cbuf);
+void cbuf_resize(circbuffer *cbuf, unsigned int newsize);
 
 unsigned int cbuf_getused(const circbuffer * cbuf); /* how much data stored */
 unsigned int cbuf_getavail(const circbuffer * cbuf); /* how much we can write */
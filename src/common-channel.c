@@ -35,6 +35,8 @@
 #include "listener.h"
 #include "runopts.h"
 #include "netio.h"
+#include "eventloop.h"
+#include "metrics.h"
 
 static void send_msg_channel_open_failure(unsigned int remotechan, int reason,
 		const char *text, const char *lang);
@@ -45,7 +47,9 @@ static int writechannel(struct Channel* channel, int fd, circbuffer *cbuf,
 	const unsigned char *moredata, unsigned int *morelen);
 static void send_msg_channel_window_adjust(const struct Channel *channel,
 		unsigned int incr);
-static void send_msg_channel_data(struct Channel *channel, int isextended);
+static int send_msg_channel_data(struct Channel *channel, int isextended,
+		int again);
+static void channel_schedule_sends(struct Channel *list);
 static void send_msg_channel_eof(struct Channel *channel);
 static void send_msg_channel_close(struct Channel *channel);
 static void remove_channel(struct Channel *channel);
@@ -59,6 +63,10 @@ static void close_chan_fd(struct Channel *channel, int fd, int how);
 #define ERRFD_IS_READ(channel) ((channel)->extrabuf == NULL)
 #define ERRFD_IS_WRITE(channel) (!ERRFD_IS_READ(channel))
 
+/* Channel sched_ready and sched_again flags */
+#define CHANNEL_SCHED_READFD 1
+#define CHANNEL_SCHED_ERRFD 2
+
 /* allow space for:
  * 1 byte  byte      SSH_MSG_CHANNEL_DATA
  * 4 bytes uint32    recipient channel
@@ -157,12 +165,20 @@ static struct Channel* newchannel(unsigned int remotechan,
 
 	newchan->writebuf = cbuf_new(opts.recv_window);
 	newchan->recvwindow = opts.recv_window;
+	newchan->recvwindowsize = opts.recv_window;
+	newchan->recvgranted = opts.recv_window;
 
 	newchan->extrabuf = NULL; /* The user code can set it up */
 	newchan->recvdonelen = 0;
 	newchan->recvmaxpacket = RECV_MAX_CHANNEL_DATA_LEN;
 
 	newchan->prio = DROPBEAR_PRIO_NORMAL;
+	if (strcmp(type->name, "session") == 0) {
+		newchan->sched_weight = CHANNEL_SCHED_WEIGHT_SESSION;
+	} else {
+		newchan->sched_weight = CHANNEL_SCHED_WEIGHT_FORWARD;
+	}
+	metrics_add(METRIC_CHANNELS, 1);
 
 	ses.channels[i] = newchan;
 	ses.chancount++;
@@ -195,65 +211,106 @@ struct Channel* getchannel() {
 	return getchannel_msg(NULL);
 }
 
-/* Iterate through the channels, performing IO if available */
-void channelio(const fd_set *readfds, const fd_set *writefds) {
+/* Performs IO for a channel if its fds are ready. Readiness is taken so
+ * that a channel with several ready fds is only handled once. Ready fds to
+ * read from are marked for channel_schedule_sends().
+ * Returns 1 if the channel should have check_close() run after sending */
+static int channel_ready_io(struct Channel *channel) {
 
-	/* Listeners such as TCP, X11, agent-auth */
-	struct Channel *channel;
-	unsigned int i;
+	/* Close checking only needs to occur for channels that had IO events */
+	int do_check_close = 0;
 
-	/* foreach channel */
-	for (i = 0; i < ses.chansize; i++) {
-		/* Close checking only needs to occur for channels that had IO events */
-		int do_check_close = 0;
+	channel->sched_ready = 0;
+	channel->sched_again = 0;
 
-		channel = ses.channels[i];
-		if (channel == NULL) {
-			/* only process in-use channels */
-			continue;
-		}
+	/* read data and send it over the wire */
+	if (channel->readfd >= 0 && evloop_take(channel->readfd, EVLOOP_READ)) {
+		TRACE(("send normal readfd"))
+		channel->sched_ready |= CHANNEL_SCHED_READFD;
+		do_check_close = 1;
+	}
 
-		/* read data and send it over the wire */
-		if (channel->readfd >= 0 && FD_ISSET(channel->readfd, readfds)) {
-			TRACE(("send normal readfd"))
-			send_msg_channel_data(channel, 0);
-			do_check_close = 1;
-		}
+	/* read stderr data and send it over the wire */
+	if (ERRFD_IS_READ(channel) && channel->errfd >= 0
+		&& evloop_take(channel->errfd, EVLOOP_READ)) {
+			TRACE(("send normal errfd"))
+			channel->sched_ready |= CHANNEL_SCHED_ERRFD;
+		do_check_close = 1;
+	}
 
-		/* read stderr data and send it over the wire */
-		if (ERRFD_IS_READ(channel) && channel->errfd >= 0
-			&& FD_ISSET(channel->errfd, readfds)) {
-				TRACE(("send normal errfd"))
-				send_msg_channel_data(channel, 1);
-			do_check_close = 1;
-		}
+	/* write to program/pipe stdin */
+	if (channel->writefd >= 0 && evloop_take(channel->writefd, EVLOOP_WRITE)) {
+		writechannel(channel, channel->writefd, channel->writebuf, NULL, NULL);
+		do_check_close = 1;
+	}
+	
+	/* stderr for client mode */
+	if (ERRFD_IS_WRITE(channel)
+			&& channel->errfd >= 0 && evloop_take(channel->errfd, EVLOOP_WRITE)) {
+		writechannel(channel, channel->errfd, channel->extrabuf, NULL, NULL);
+		do_check_close = 1;
+	}
 
-		/* write to program/pipe stdin */
-		if (channel->writefd >= 0 && FD_ISSET(channel->writefd, writefds)) {
-			writechannel(channel, channel->writefd, channel->writebuf, NULL, NULL);
-			do_check_close = 1;
-		}
-		
-		/* stderr for client mode */
-		if (ERRFD_IS_WRITE(channel)
-				&& channel->errfd >= 0 && FD_ISSET(channel->errfd, writefds)) {
-			writechannel(channel, channel->errfd, channel->extrabuf, NULL, NULL);
-			do_check_close = 1;
-		}
+	if (ses.channel_signal_pending) {
+		/* SIGCHLD can change channel state for server sessions */
+		do_check_close = 1;
+	}
+
+	return do_check_close;
+}
 
-		if (ses.channel_signal_pending) {
-			/* SIGCHLD can change channel state for server sessions */
-			do_check_close = 1;
+/* Iterate through the channels, performing IO if available */
+void channelio() {
+
+	struct Channel *channel;
+	struct Channel *list = NULL, **tail = &list;
+	unsigned int i;
+
+	if (ses.channel_signal_pending) {
+		/* SIGCHLD may affect any channel, check them all */
+		for (i = 0; i < ses.chansize; i++) {
+			channel = ses.channels[i];
+			if (channel == NULL) {
+				/* only process in-use channels */
+				continue;
+			}
+			if (channel_ready_io(channel)) {
+				channel->sched_next = NULL;
+				*tail = channel;
+				tail = &channel->sched_next;
+			}
 		}
-	
-		/* handle any channel closing etc */
-		if (do_check_close) {
-			check_close(channel);
+	} else {
+		/* otherwise only channels with ready fds need attention */
+		unsigned int iter = 0;
+		while (evloop_next_ready(&iter, EVLOOP_KIND_CHANNEL, &i)) {
+			if (i >= ses.chansize) {
+				continue;
+			}
+			channel = ses.channels[i];
+			if (channel == NULL) {
+				continue;
+			}
+			if (channel_ready_io(channel)) {
+				channel->sched_next = NULL;
+				*tail = channel;
+				tail = &channel->sched_next;
+			}
 		}
 	}
 
+	channel_schedule_sends(list);
+
+	/* handle any channel closing etc, this may remove the channel */
+	while (list != NULL) {
+		channel = list;
+		list = channel->sched_next;
+		check_close(channel);
+	}
+
+	/* Listeners such as TCP, X11, agent-auth */
 #if DROPBEAR_LISTENERS
-	handle_listeners(readfds);
+	handle_listeners();
 #endif
 }
 
@@ -506,6 +563,81 @@ static int writechannel_writev(struct Channel* channel, int fd, circbuffer *cbuf
 }
 #endif /* HAVE_WRITEV */
 
+#if RECV_WINDOW_AUTOTUNE_MAX
+static long long timespec_diff_us(const struct timespec *later,
+		const struct timespec *earlier) {
+	return (later->tv_sec - earlier->tv_sec) * 1000000LL
+		+ (later->tv_nsec - earlier->tv_nsec) / 1000;
+}
+
+/* Grows a channel's receive window when it is what limits the transfer
+ * rate. Each time a window adjust is sent with none being timed, the time
+ * until data arrives beyond the window given before that adjust is
+ * measured. The peer can't send that data until the adjust reaches it, so
+ * the shortest such time is the round trip time. If the data received per
+ * round trip approaches the window size, and the local side has written
+ * out what was received, the peer is waiting on the window and it is
+ * doubled, up to RECV_WINDOW_AUTOTUNE_MAX. The extra window is given to
+ * the peer with the next adjust. */
+static void autotune_recv_window(struct Channel *channel, unsigned int datalen) {
+	struct timespec now;
+	long long rtt_us, elapsed_us;
+	unsigned long long per_rtt;
+	unsigned int buffered, newsize;
+
+	channel->recvtotal += datalen;
+	if (!channel->rtt_probing || channel->recvtotal <= channel->rtt_probe_credit) {
+		return;
+	}
+	channel->rtt_probing = 0;
+
+	gettime_wrapper(&now);
+	rtt_us = MAX(timespec_diff_us(&now, &channel->rtt_probe_time), 1);
+	if (channel->rtt_min_us == 0 || rtt_us < channel->rtt_min_us) {
+		channel->rtt_min_us = rtt_us;
+	}
+
+	/* measure the rate over at least a round trip */
+	elapsed_us = timespec_diff_us(&now, &channel->rate_start);
+	if (channel->rate_start.tv_sec == 0 && channel->rate_start.tv_nsec == 0) {
+		channel->rate_start = now;
+		channel->rate_start_total = channel->recvtotal;
+		return;
+	}
+	if (elapsed_us < channel->rtt_min_us) {
+		return;
+	}
+	per_rtt = (channel->recvtotal - channel->rate_start_total)
+		* channel->rtt_min_us / elapsed_us;
+	channel->rate_start = now;
+	channel->rate_start_total = channel->recvtotal;
+
+	if (channel->recvwindowsize >= RECV_WINDOW_AUTOTUNE_MAX
+			|| per_rtt < channel->recvwindowsize / 4 * 3) {
+		return;
+	}
+	buffered = cbuf_getused(channel->writebuf);
+	if (channel->extrabuf) {
+		buffered = MAX(buffered, cbuf_getused(channel->extrabuf));
+	}
+	if (buffered > channel->recvwindowsize / 4) {
+		/* the local side is slower than the peer */
+		return;
+	}
+
+	newsize = MIN(channel->recvwindowsize * 2, RECV_WINDOW_AUTOTUNE_MAX);
+	TRACE(("autotune_recv_window: channel %d rtt %lldus %llu per rtt, window %u -> %u",
+		channel->index, channel->rtt_min_us, per_rtt, channel->recvwindowsize, newsize))
+	cbuf_resize(channel->writebuf, newsize);
+	if (channel->extrabuf) {
+		cbuf_resize(channel->extrabuf, newsize);
+	}
+	/* sent with the next window adjust */
+	channel->recvdonelen += newsize - channel->recvwindowsize;
+	channel->recvwindowsize = newsize;
+}
+#endif /* RECV_WINDOW_AUTOTUNE_MAX */
+
 /* Called to write data out to the local side of the channel.
    Writes the circular buffer contents and also the "moredata" buffer
    if not null. Will ignore EAGAIN.
@@ -521,13 +653,20 @@ static int writechannel(struct Channel* channel, int fd, circbuffer *cbuf,
 #endif
 
 	/* Window adjust handling */
-	if (channel->recvdonelen >= RECV_WINDOWEXTEND) {
+	if (channel->recvdonelen >= RECV_WINDOWEXTEND(channel)) {
+		if (!channel->rtt_probing) {
+			/* time how long until the peer uses this adjust */
+			channel->rtt_probing = 1;
+			channel->rtt_probe_credit = channel->recvgranted;
+			gettime_wrapper(&channel->rtt_probe_time);
+		}
 		send_msg_channel_window_adjust(channel, channel->recvdonelen);
 		channel->recvwindow += channel->recvdonelen;
+		channel->recvgranted += channel->recvdonelen;
 		channel->recvdonelen = 0;
 	}
 
-	dropbear_assert(channel->recvwindow <= opts.recv_window);
+	dropbear_assert(channel->recvwindow <= channel->recvwindowsize);
 	dropbear_assert(channel->recvwindow <= cbuf_getavail(channel->writebuf));
 	dropbear_assert(channel->extrabuf == NULL ||
 			channel->recvwindow <= cbuf_getavail(channel->extrabuf));
@@ -537,9 +676,9 @@ static int writechannel(struct Channel* channel, int fd, circbuffer *cbuf,
 }
 
 
-/* Set the file descriptors for the main select in session.c
+/* Set the file descriptors for the main event loop in session.c
  * This avoid channels which don't have any window available, are closed, etc*/
-void setchannelfds(fd_set *readfds, fd_set *writefds, int allow_reads) {
+void setchannelfds(int allow_reads) {
 	
 	unsigned int i;
 	struct Channel * channel;
@@ -560,28 +699,32 @@ void setchannelfds(fd_set *readfds, fd_set *writefds, int allow_reads) {
 		   && ((ses.dataallowed && allow_reads) || channel->read_mangler)) {
 
 			if (channel->readfd >= 0) {
-				FD_SET(channel->readfd, readfds);
+				evloop_want(channel->readfd, EVLOOP_READ,
+					EVLOOP_KIND_CHANNEL, channel->index);
 			}
 			
 			if (ERRFD_IS_READ(channel) && channel->errfd >= 0) {
-					FD_SET(channel->errfd, readfds);
+					evloop_want(channel->errfd, EVLOOP_READ,
+						EVLOOP_KIND_CHANNEL, channel->index);
 			}
 		}
 
 		/* Stuff from the wire */
 		if (channel->writefd >= 0 && cbuf_getused(channel->writebuf) > 0) {
-				FD_SET(channel->writefd, writefds);
+				evloop_want(channel->writefd, EVLOOP_WRITE,
+					EVLOOP_KIND_CHANNEL, channel->index);
 		}
 
 		if (ERRFD_IS_WRITE(channel) && channel->errfd >= 0
 				&& cbuf_getused(channel->extrabuf) > 0) {
-				FD_SET(channel->errfd, writefds);
+				evloop_want(channel->errfd, EVLOOP_WRITE,
+					EVLOOP_KIND_CHANNEL, channel->index);
 		}
 
 	} /* foreach channel */
 
 #if DROPBEAR_LISTENERS
-	set_listener_fds(readfds);
+	set_listener_fds();
 #endif
 
 }
@@ -626,6 +769,17 @@ static void remove_channel(struct Channel * channel) {
 
 	TRACE(("enter remove_channel"))
 	TRACE(("channel index is %d", channel->index))
+	TRACE(("channel sent %llu bytes in %llu packets, queue depth avg %llu max %u",
+		channel->sched_bytes, channel->sched_packets,
+		channel->sched_packets ? channel->sched_queue_sum / channel->sched_packets : 0,
+		channel->sched_queue_max))
+	if (channel->sched_packets > 0) {
+		metrics_hist_add(METRIC_CHANNEL_SENT_BYTES, channel->sched_bytes);
+		metrics_hist_add(METRIC_CHANNEL_QUEUE_AVG_BYTES,
+			channel->sched_queue_sum / channel->sched_packets);
+		metrics_hist_add(METRIC_CHANNEL_QUEUE_MAX_BYTES,
+			channel->sched_queue_max);
+	}
 
 	cbuf_free(channel->writebuf);
 	channel->writebuf = NULL;
@@ -689,12 +843,105 @@ void recv_msg_channel_request() {
 
 }
 
+/* Sends data from a channel's ready fds until its deficit is used up, it
+ * has no more data ready or budget bytes are queued. While reads
+ * fill whole packets more are made, so that packets are encrypted back to
+ * back and written out together by a single writev() in the main loop */
+static void channel_sched_turn(struct Channel *channel, unsigned int budget) {
+
+	int quantum = channel->sched_weight * CHANNEL_SCHED_QUANTUM;
+	unsigned int queued;
+	int flag, full;
+
+	channel->sched_deficit = MIN(channel->sched_deficit + quantum, quantum);
+
+	while (channel->sched_deficit > 0 && channel->sched_ready) {
+		flag = (channel->sched_ready & CHANNEL_SCHED_ERRFD)
+			? CHANNEL_SCHED_ERRFD : CHANNEL_SCHED_READFD;
+		if (ses.dataallowed
+			? ses.writequeue_len >= budget
+			: (channel->sched_again & flag)) {
+			/* Left for a later pass. During key exchange each ready fd is
+			 * still read once since packets are held aside until it is
+			 * done */
+			return;
+		}
+
+		queued = ses.writequeue_len;
+		full = send_msg_channel_data(channel, flag == CHANNEL_SCHED_ERRFD,
+				channel->sched_again & flag);
+		channel->sched_again |= flag;
+
+		if (ses.writequeue_len > queued) {
+			channel->sched_deficit -= ses.writequeue_len - queued;
+			channel->sched_bytes += ses.writequeue_len - queued;
+			metrics_add(METRIC_CHANNEL_BYTES, ses.writequeue_len - queued);
+			metrics_add(METRIC_CHANNEL_PACKETS, 1);
+			channel->sched_packets++;
+			channel->sched_queue_sum += queued;
+			channel->sched_queue_max = MAX(channel->sched_queue_max, queued);
+		}
+
+		if (!full || (flag == CHANNEL_SCHED_ERRFD
+				? channel->errfd : channel->readfd) < 0) {
+			channel->sched_ready &= ~flag;
+		}
+	}
+
+	if (!channel->sched_ready) {
+		/* Nothing backlogged, doesn't keep credit */
+		channel->sched_deficit = 0;
+	}
+}
+
+/* Reads from channels that have ready fds and sends the data, in deficit
+ * round robin order. Each round a backlogged channel may send its weight
+ * times CHANNEL_SCHED_QUANTUM bytes, so a bulk transfer can't hold up other
+ * channels for more than a packet. Low delay (interactive) channels have a
+ * turn before the rounds, so keystrokes go ahead of any bulk data queued in
+ * this pass. Sending stops once the pass's budget is queued, leaving the fds
+ * ready for a later pass. The budget is smaller while an interactive
+ * channel is open, so that its data waits less for a pass to finish */
+static void channel_schedule_sends(struct Channel *list) {
+
+	struct Channel *channel;
+	unsigned int budget = SESSION_SEND_BATCH_LEN;
+	int backlogged;
+
+	if (ses.socket_prio == DROPBEAR_PRIO_LOWDELAY) {
+		budget = SESSION_SEND_BATCH_LOWDELAY_LEN;
+	}
+
+	for (channel = list; channel != NULL; channel = channel->sched_next) {
+		if (channel->sched_ready && channel->prio == DROPBEAR_PRIO_LOWDELAY) {
+			channel_sched_turn(channel, budget);
+		}
+	}
+
+	do {
+		backlogged = 0;
+		for (channel = list; channel != NULL; channel = channel->sched_next) {
+			if (!channel->sched_ready) {
+				continue;
+			}
+			if (ses.writequeue_len >= budget) {
+				return;
+			}
+			channel_sched_turn(channel, budget);
+			backlogged |= channel->sched_ready;
+		}
+	} while (backlogged && ses.dataallowed);
+}
+
 /* Reads data from the server's program/shell/etc, and puts it in a
  * channel_data packet to send.
  * chan is the remote channel, isextended is 0 if it is normal data, 1
  * if it is extended data. if it is extended, then the type is in
- * exttype */
-static void send_msg_channel_data(struct Channel *channel, int isextended) {
+ * exttype. again is set for a further read after a full packet, where
+ * EAGAIN just means no more data is waiting.
+ * Returns 1 if a full packet was read, so more data may be waiting */
+static int send_msg_channel_data(struct Channel *channel, int isextended,
+		int again) {
 
 	int len;
 	size_t maxlen, size_pos;
@@ -721,7 +968,7 @@ static void send_msg_channel_data(struct Channel *channel, int isextended) {
 	TRACE(("maxlen %zd", maxlen))
 	if (maxlen == 0) {
 		TRACE(("leave send_msg_channel_data: no window"))
-		return;
+		return 0;
 	}
 
 	buf_putbyte(ses.writepayload,
@@ -738,7 +985,7 @@ static void send_msg_channel_data(struct Channel *channel, int isextended) {
 	len = read(fd, buf_getwriteptr(ses.writepayload, maxlen), maxlen);
 
 	if (len <= 0) {
-		if (len == 0 || errno != EINTR) {
+		if (len == 0 || (errno != EINTR && !(again && errno == EAGAIN))) {
 			/* This will also get hit in the case of EAGAIN. The only
 			time we expect to receive EAGAIN is when we're flushing a FD,
 			in which case it can be treated the same as EOF */
@@ -748,7 +995,7 @@ static void send_msg_channel_data(struct Channel *channel, int isextended) {
 		buf_setlen(ses.writepayload, 0);
 		TRACE(("leave send_msg_channel_data: len %d read err %d or EOF for fd %d",
 					len, errno, fd))
-		return;
+		return 0;
 	}
 
 	if (channel->read_mangler) {
@@ -756,7 +1003,7 @@ static void send_msg_channel_data(struct Channel *channel, int isextended) {
 		if (len == 0) {
 			buf_setpos(ses.writepayload, 0);
 			buf_setlen(ses.writepayload, 0);
-			return;
+			return 0;
 		}
 	}
 
@@ -770,6 +1017,7 @@ static void send_msg_channel_data(struct Channel *channel, int isextended) {
 
 	encrypt_packet();
 	TRACE(("leave send_msg_channel_data"))
+	return (size_t)len == maxlen;
 }
 
 /* We receive channel data */
@@ -821,7 +1069,11 @@ void common_recv_msg_channel_data(struct Channel *channel, int fd,
 
 	dropbear_assert(channel->recvwindow >= datalen);
 	channel->recvwindow -= datalen;
-	dropbear_assert(channel->recvwindow <= opts.recv_window);
+	dropbear_assert(channel->recvwindow <= channel->recvwindowsize);
+
+#if RECV_WINDOW_AUTOTUNE_MAX
+	autotune_recv_window(channel, datalen);
+#endif
 
 	/* Attempt to write the data immediately without having to put it in the circular buffer */
 	consumed = datalen;
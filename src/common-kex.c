@@ -34,6 +34,7 @@
 #include "bignum.h"
 #include "dbrandom.h"
 #include "runopts.h"
+#include "metrics.h"
 
 static void kexinitialise(void);
 static void gen_new_keys(void);
@@ -102,6 +103,7 @@ void send_msg_kexinit() {
 	ses.dataallowed = 0; /* don't send other packets during kex */
 
 	ses.kexstate.sentkexinit = 1;
+	metrics_event_start(METRIC_KEX_USEC);
 
 	ses.newkeys = (struct key_context*)m_malloc(sizeof(struct key_context));
 
@@ -154,6 +156,8 @@ static void switch_keys() {
 		m_free(ses.newkeys);
 		ses.newkeys = NULL;
 		kexinitialise();
+		metrics_event_done(METRIC_KEX_USEC);
+		metrics_add(METRIC_KEX, 1);
 	}
 	TRACE2(("leave switch_keys"))
 }
@@ -385,12 +389,14 @@ static void gen_new_keys() {
 		hashkeys(ses.newkeys->trans.mackey,
 				ses.newkeys->trans.algo_mac->keysize, &hs, mactransletter);
 		ses.newkeys->trans.hash_index = find_hash(ses.newkeys->trans.algo_mac->hash_desc->name);
+		setup_mac_key(&ses.newkeys->trans);
 	}
 
 	if (ses.newkeys->recv.algo_mac->hash_desc != NULL) {
 		hashkeys(ses.newkeys->recv.mackey,
 				ses.newkeys->recv.algo_mac->keysize, &hs, macrecvletter);
 		ses.newkeys->recv.hash_index = find_hash(ses.newkeys->recv.algo_mac->hash_desc->name);
+		setup_mac_key(&ses.newkeys->recv);
 	}
 
 	/* Ready to switch over */
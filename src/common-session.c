@@ -35,6 +35,8 @@
 #include "channel.h"
 #include "runopts.h"
 #include "netio.h"
+#include "eventloop.h"
+#include "metrics.h"
 
 static void checktimeouts(void);
 static long select_timeout(void);
@@ -101,7 +103,10 @@ void common_session_init(int sock_in, int sock_out) {
 	ses.maxfd = MAX(ses.maxfd, ses.signal_pipe[1]);
 	}
 	
-	ses.writepayload = buf_new(TRANS_MAX_PAYLOAD_LEN);
+	evloop_init();
+
+	metrics_session_start();
+	writebuf_pool_init();
 	ses.transseq = 0;
 
 	ses.readbuf = NULL;
@@ -115,8 +120,7 @@ void common_session_init(int sock_in, int sock_out) {
 							send the SSH_MSG_KEXINIT */
 	ses.ignorenext = 0;
 	ses.lastpacket = 0;
-	ses.reply_queue_head = NULL;
-	ses.reply_queue_tail = NULL;
+	initqueue(&ses.reply_queue);
 
 	/* set all the algos to none */
 	ses.keys = (struct key_context*)m_malloc(sizeof(struct key_context));
@@ -159,18 +163,14 @@ void common_session_init(int sock_in, int sock_out) {
 
 void session_loop(void(*loophandler)(void)) {
 
-	fd_set readfd, writefd;
-	struct timeval timeout;
 	int val;
+	unsigned long long channelio_start;
 
-	/* main loop, select()s for all sockets in use */
+	/* main loop, waits for all sockets in use */
 	for(;;) {
 		const int writequeue_has_space = (ses.writequeue_len <= 2*TRANS_MAX_PAYLOAD_LEN);
 
-		timeout.tv_sec = select_timeout();
-		timeout.tv_usec = 0;
-		DROPBEAR_FD_ZERO(&writefd);
-		DROPBEAR_FD_ZERO(&readfd);
+		evloop_begin();
 
 		dropbear_assert(ses.payload == NULL);
 
@@ -180,14 +180,14 @@ void session_loop(void(*loophandler)(void)) {
 		if (!fuzz.fuzzing)
 #endif
 		{
-		FD_SET(ses.signal_pipe[0], &readfd);
+		evloop_want(ses.signal_pipe[0], EVLOOP_READ, EVLOOP_KIND_OTHER, 0);
 		}
 
 		/* set up for channels which can be read/written */
-		setchannelfds(&readfd, &writefd, writequeue_has_space);
+		setchannelfds(writequeue_has_space);
 
 		/* Pending connections to test */
-		set_connect_fds(&writefd);
+		set_connect_fds();
 
 		/* We delay reading from the input socket during initial setup until
 		after we have written out our initial KEXINIT packet (empty writequeue).
@@ -198,39 +198,41 @@ void session_loop(void(*loophandler)(void)) {
 		if (ses.sock_in != -1
 			&& (ses.remoteident || isempty(&ses.writequeue))
 			&& writequeue_has_space) {
-			FD_SET(ses.sock_in, &readfd);
+			evloop_want(ses.sock_in, EVLOOP_READ, EVLOOP_KIND_OTHER, 0);
 		}
 
 		/* Ordering is important, this test must occur after any other function
 		might have queued packets (such as connection handlers) */
 		if (ses.sock_out != -1 && !isempty(&ses.writequeue)) {
-			FD_SET(ses.sock_out, &writefd);
+			evloop_want(ses.sock_out, EVLOOP_WRITE, EVLOOP_KIND_OTHER, 0);
 		}
 
-		val = select(ses.maxfd+1, &readfd, &writefd, NULL, &timeout);
+		/* Packets left over from an earlier read are handled without
+		 * waiting */
+		if (ses.sock_in != -1 && writequeue_has_space && read_packet_pending()) {
+			val = evloop_wait(0);
+		} else {
+			val = evloop_wait(select_timeout());
+		}
 
 		if (ses.exitflag) {
 			dropbear_exit("Terminated by signal");
 		}
 		
 		if (val < 0 && errno != EINTR) {
-			dropbear_exit("Error in select");
+			dropbear_exit("Error in %s", evloop_backend_name());
 		}
+		metrics_add(METRIC_LOOPS, 1);
 
-		if (val <= 0) {
-			/* If we were interrupted or the select timed out, we still
-			 * want to iterate over channels etc for reading, to handle
-			 * server processes exiting etc.
-			 * We don't want to read/write FDs. */
-			DROPBEAR_FD_ZERO(&writefd);
-			DROPBEAR_FD_ZERO(&readfd);
-		}
+		/* If we were interrupted or the wait timed out, we still
+		 * want to iterate over channels etc for reading, to handle
+		 * server processes exiting etc. No FDs will be ready. */
 		
 		/* We'll just empty out the pipe if required. We don't do
 		any thing with the data, since the pipe's purpose is purely to
-		wake up the select() above. */
+		wake up the wait above. */
 		ses.channel_signal_pending = 0;
-		if (FD_ISSET(ses.signal_pipe[0], &readfd)) {
+		if (evloop_ready(ses.signal_pipe[0], EVLOOP_READ)) {
 			char x;
 			TRACE(("signal pipe set"))
 			while (read(ses.signal_pipe[0], &x, 1) > 0) {}
@@ -242,19 +244,29 @@ void session_loop(void(*loophandler)(void)) {
 
 		/* process session socket's incoming data */
 		if (ses.sock_in != -1) {
-			if (FD_ISSET(ses.sock_in, &readfd)) {
+			if (evloop_ready(ses.sock_in, EVLOOP_READ)) {
 				if (!ses.remoteident) {
 					/* blocking read of the version string */
 					read_session_identification();
 				} else {
 					read_packet();
 				}
+			} else if (writequeue_has_space) {
+				read_buffered_packet();
 			}
 			
 			/* Process the decrypted packet. After this, the read buffer
 			 * will be ready for a new packet */
-			if (ses.payload != NULL) {
+			while (ses.payload != NULL) {
 				process_packet();
+
+				/* Further packets from the same read can be handled now.
+				 * Transport and auth packets are left to one per loop
+				 * since the loophandler follows their progress */
+				if (ses.lastpacket >= SSH_MSG_GLOBAL_REQUEST
+					&& ses.writequeue_len <= 2*TRANS_MAX_PAYLOAD_LEN) {
+					read_buffered_packet();
+				}
 			}
 		}
 
@@ -262,7 +274,7 @@ void session_loop(void(*loophandler)(void)) {
 		were being held up during a KEX */
 		maybe_flush_reply_queue();
 
-		handle_connect_fds(&writefd);
+		handle_connect_fds();
 
 		/* loop handler prior to channelio, in case the server loophandler closes
 		channels on process exit */
@@ -270,7 +282,9 @@ void session_loop(void(*loophandler)(void)) {
 
 		/* process pipes etc for the channels, ses.dataallowed == 0
 		 * during rekeying ) */
-		channelio(&readfd, &writefd);
+		channelio_start = metrics_now();
+		channelio();
+		metrics_time(METRIC_CHANNELIO_NSEC, channelio_start);
 
 		/* process session socket's outgoing data */
 		if (ses.sock_out != -1) {
@@ -305,6 +319,8 @@ void session_cleanup() {
 
 	/* BEWARE of changing order of functions here. */
 
+	metrics_flush();
+
 	/* Must be before extra_session_cleanup() */
 	chancleanup();
 
@@ -321,8 +337,13 @@ void session_cleanup() {
 	remove_connect_pending();
 
 	while (!isempty(&ses.writequeue)) {
-		buf_free(dequeue(&ses.writequeue));
+		writebuf_release(dequeue(&ses.writequeue));
+	}
+	freequeue(&ses.writequeue);
+	while (!isempty(&ses.reply_queue)) {
+		buf_free(dequeue(&ses.reply_queue));
 	}
+	freequeue(&ses.reply_queue);
 
 	m_free(ses.newkeys);
 #ifndef DISABLE_ZLIB
@@ -351,8 +372,10 @@ void session_cleanup() {
 	cleanup_buf(&ses.session_id);
 	cleanup_buf(&ses.hash);
 	cleanup_buf(&ses.payload);
+	TRACE(("socket reads: %u for %u packets", ses.recv_reads, ses.recvseq))
 	cleanup_buf(&ses.readbuf);
-	cleanup_buf(&ses.writepayload);
+	cleanup_buf(&ses.recvbuf);
+	writebuf_pool_cleanup();
 	cleanup_buf(&ses.kexhashbuf);
 	cleanup_buf(&ses.transkexinit);
 	if (ses.dh_K) {
@@ -366,6 +389,8 @@ void session_cleanup() {
 	m_burn(ses.keys, sizeof(struct key_context));
 	m_free(ses.keys);
 
+	evloop_cleanup();
+
 	TRACE(("leave session_cleanup"))
 }
 
@@ -547,6 +572,8 @@ static void checktimeouts() {
 	time_t now;
 	now = monotonic_now();
 
+	metrics_check_flush(now);
+
 	if (IS_DROPBEAR_SERVER && ses.connect_time != 0
 		&& elapsed(now, ses.connect_time) >= AUTH_TIMEOUT) {
 			dropbear_close("Timeout before auth");
@@ -632,6 +659,9 @@ static long select_timeout() {
 	update_timeout(opts.idle_timeout_secs, now, ses.last_packet_time_idle,
 		&timeout);
 
+	update_timeout(METRICS_FLUSH_INTERVAL, now, metrics_unflushed_since(),
+		&timeout);
+
 	/* clamp negative timeouts to zero - event has already triggered */
 	return MAX(timeout, 0);
 }
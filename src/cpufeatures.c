@@ -0,0 +1,148 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "cpufeatures.h"
+
+#if DROPBEAR_CPU_X86
+#include <cpuid.h>
+#ifndef bit_SHA
+#define bit_SHA (1 << 29)
+#endif
+#endif
+
+#if DROPBEAR_CPU_ARM64 && defined(HAVE_GETAUXVAL)
+#include <sys/auxv.h>
+/* From asm/hwcap.h */
+#ifndef HWCAP_AES
+#define HWCAP_AES (1 << 3)
+#endif
+#ifndef HWCAP_ASIMD
+#define HWCAP_ASIMD (1 << 1)
+#endif
+#ifndef HWCAP_PMULL
+#define HWCAP_PMULL (1 << 4)
+#endif
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#endif
+
+static int detected;
+static unsigned int cpu_features;
+static unsigned int cpu_disabled;
+
+static const struct {
+	unsigned int feature;
+	const char *name;
+} feature_names[] = {
+	{CPU_AESNI, "aesni"},
+	{CPU_PCLMUL, "pclmul"},
+	{CPU_SSE2, "sse2"},
+	{CPU_AVX2, "avx2"},
+	{CPU_SHANI, "sha"},
+	{CPU_ARM_AES, "aes"},
+	{CPU_ARM_PMULL, "pmull"},
+	{CPU_ARM_NEON, "neon"},
+	{CPU_ARM_SHA2, "sha2"},
+	{0, NULL}
+};
+
+#if DROPBEAR_CPU_X86
+/* AVX registers need to be saved by the OS as well as supported */
+static int os_saves_avx(unsigned int ecx) {
+	unsigned int xcr0_lo, xcr0_hi;
+
+	if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) {
+		return 0;
+	}
+	__asm__ __volatile__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+	(void)xcr0_hi;
+	/* XMM and YMM state */
+	return (xcr0_lo & 0x6) == 0x6;
+}
+#endif
+
+static unsigned int detect_features(void) {
+	unsigned int features = 0;
+
+#if DROPBEAR_CPU_X86
+	unsigned int eax, ebx, ecx, edx, ebx7, ecx7, edx7;
+
+	if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		if (edx & bit_SSE2) {
+			features |= CPU_SSE2;
+		}
+		/* SSSE3 and SSE4.1 are used for byte shuffles alongside AES-NI,
+		 * every CPU with AES-NI has them */
+		if ((ecx & bit_AES) && (ecx & bit_SSSE3) && (ecx & bit_SSE4_1)) {
+			features |= CPU_AESNI;
+			if (ecx & bit_PCLMUL) {
+				features |= CPU_PCLMUL;
+			}
+		}
+		if (__get_cpuid_count(7, 0, &eax, &ebx7, &ecx7, &edx7)) {
+			if (os_saves_avx(ecx) && (ebx7 & bit_AVX2)) {
+				features |= CPU_AVX2;
+			}
+			if ((ebx7 & bit_SHA) && (ecx & bit_SSSE3) && (ecx & bit_SSE4_1)) {
+				features |= CPU_SHANI;
+			}
+		}
+	}
+#endif
+
+#if DROPBEAR_CPU_ARM64
+#if defined(__APPLE__)
+	/* All Apple arm64 CPUs have the crypto extensions */
+	features |= CPU_ARM_AES | CPU_ARM_PMULL | CPU_ARM_NEON | CPU_ARM_SHA2;
+#else
+	{
+		unsigned long hwcap = getauxval(AT_HWCAP);
+		if (hwcap & HWCAP_AES) {
+			features |= CPU_ARM_AES;
+		}
+		if (hwcap & HWCAP_PMULL) {
+			features |= CPU_ARM_PMULL;
+		}
+		if (hwcap & HWCAP_ASIMD) {
+			features |= CPU_ARM_NEON;
+		}
+		if (hwcap & HWCAP_SHA2) {
+			features |= CPU_ARM_SHA2;
+		}
+	}
+#endif
+#endif
+
+	return features;
+}
+
+int cpu_has(unsigned int features) {
+	if (!detected) {
+		cpu_features = detect_features();
+		detected = 1;
+	}
+	return (cpu_features & ~cpu_disabled & features) == features;
+}
+
+void cpu_disable(unsigned int features) {
+	cpu_disabled |= features;
+}
+
+const char* cpu_feature_names(void) {
+	static char names[100];
+	unsigned int i;
+
+	names[0] = '\0';
+	for (i = 0; feature_names[i].name != NULL; i++) {
+		if (cpu_has(feature_names[i].feature)) {
+			if (names[0] != '\0') {
+				strlcat(names, " ", sizeof(names));
+			}
+			strlcat(names, feature_names[i].name, sizeof(names));
+		}
+	}
+	if (names[0] == '\0') {
+		strlcpy(names, "none", sizeof(names));
+	}
+	return names;
+}
@@ -0,0 +1,33 @@
+#ifndef DROPBEAR_CPUFEATURES_H_
+#define DROPBEAR_CPUFEATURES_H_
+
+#include "includes.h"
+
+/* Runtime detection of CPU instructions used by the accelerated crypto
+ * implementations. Those are compiled with per-function target attributes
+ * so the binary still runs on CPUs without them, callers must check
+ * cpu_has() before using one. */
+
+enum cpu_feature {
+	/* x86 */
+	CPU_AESNI = 1 << 0, /* includes SSSE3 and SSE4.1 */
+	CPU_PCLMUL = 1 << 1,
+	CPU_SSE2 = 1 << 2,
+	CPU_AVX2 = 1 << 3, /* and enabled by the OS */
+	CPU_SHANI = 1 << 4, /* includes SSE4.1 */
+	/* ARMv8 */
+	CPU_ARM_AES = 1 << 8,
+	CPU_ARM_PMULL = 1 << 9,
+	CPU_ARM_NEON = 1 << 10,
+	CPU_ARM_SHA2 = 1 << 11,
+};
+
+/* Returns non-zero if all the given features are present */
+int cpu_has(unsigned int features);
+/* Treats the features as absent, to compare against the portable code.
+ * Must be called before crypto_init() */
+void cpu_disable(unsigned int features);
+/* Space separated names of the detected features, for logging */
+const char* cpu_feature_names(void);
+
+#endif /* DROPBEAR_CPUFEATURES_H_ */
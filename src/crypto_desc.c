@@ -4,6 +4,8 @@
 #include "ltc_prng.h"
 #include "ecc.h"
 #include "dbrandom.h"
+#include "cpufeatures.h"
+#include "aes-accel.h"
 
 #if DROPBEAR_LTC_PRNG
 	int dropbear_ltc_prng = -1;
@@ -48,10 +50,18 @@ void crypto_init() {
 	int i;
 
 	for (i = 0; regciphers[i] != NULL; i++) {
-		if (register_cipher(regciphers[i]) == -1) {
+		const struct ltc_cipher_descriptor *desc = regciphers[i];
+#if DROPBEAR_AES_ACCEL
+		/* Has the same name, so find_cipher("aes") returns it */
+		if (desc == &aes_desc && aes_accel_desc() != NULL) {
+			desc = aes_accel_desc();
+		}
+#endif
+		if (register_cipher(desc) == -1) {
 			dropbear_exit("Error registering crypto");
 		}
 	}
+	TRACE(("crypto_init: CPU features %s", cpu_feature_names()))
 
 	for (i = 0; reghashes[i] != NULL; i++) {
 		if (register_hash(reghashes[i]) == -1) {
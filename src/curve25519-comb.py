@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+# Prints base_comb for curve25519.c, the comb table for fixed base
+# multiplication on edwards25519. base_comb[t][b] is the sum of
+# 2^(32*(r+4*t))*B for each bit r set in b, stored as (y+x, y-x, 2*d*x*y)
+# mod p, each 32 bytes little endian.
+#
+# python3 curve25519-comb.py > table.txt, then replace the table in
+# curve25519.c with it.
+
+p = 2**255 - 19
+d = -121665 * pow(121666, p - 2, p) % p
+
+def recover_x(y):
+	xx = (y * y - 1) * pow(d * y * y + 1, p - 2, p) % p
+	x = pow(xx, (p + 3) // 8, p)
+	if (x * x - xx) % p != 0:
+		x = x * pow(2, (p - 1) // 4, p) % p
+	if x % 2 != 0:
+		x = p - x
+	return x
+
+def add(P, Q):
+	x1, y1 = P
+	x2, y2 = Q
+	t = d * x1 * x2 * y1 * y2 % p
+	x3 = (x1 * y2 + x2 * y1) * pow(1 + t, p - 2, p) % p
+	y3 = (y1 * y2 + x1 * x2) * pow(1 - t, p - 2, p) % p
+	return (x3, y3)
+
+def mul(k, P):
+	R = (0, 1)
+	while k > 0:
+		if k & 1:
+			R = add(R, P)
+		P = add(P, P)
+		k >>= 1
+	return R
+
+By = 4 * pow(5, p - 2, p) % p
+B = (recover_x(By), By)
+
+def le_bytes(v):
+	return ", ".join("0x%02x" % c for c in v.to_bytes(32, "little"))
+
+print("static const u8 base_comb[2][16][96] = {")
+for t in range(2):
+	print("\t{")
+	for b in range(16):
+		P = (0, 1)
+		for r in range(4):
+			if b & (1 << r):
+				P = add(P, mul(2**(32 * (r + 4 * t)), B))
+		x, y = P
+		fields = [(y + x) % p, (y - x) % p, 2 * d * x * y % p]
+		print("\t\t{%s," % le_bytes(fields[0]))
+		print("\t\t %s," % le_bytes(fields[1]))
+		print("\t\t %s}%s" % (le_bytes(fields[2]), "," if b < 15 else ""))
+	print("\t}%s" % ("," if t < 1 else ""))
+print("};")
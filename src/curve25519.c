@@ -23,13 +23,25 @@
  * SOFTWARE. */
 
 #include "includes.h"
+#include "dbutil.h"
 #include "dbrandom.h"
 #include "curve25519.h"
 
 #if DROPBEAR_CURVE25519_DEP || DROPBEAR_ED25519
 
-/* Modified TweetNaCl version 20140427, a self-contained public-domain C library.
- * https://tweetnacl.cr.yp.to/ */
+/* X25519 and Ed25519.
+ *
+ * Field elements mod 2^255-19 are five 51 bit limbs when the compiler has a
+ * 128 bit integer type for the products, as in curve25519-donna-c64. Otherwise
+ * the sixteen 16 bit limbs of TweetNaCl are used. Ed25519 points use extended
+ * twisted Edwards coordinates, and fixed base multiplications (key generation
+ * and signing, and X25519 public keys) use a precomputed comb table.
+ *
+ * Everything operating on secret values runs in constant time, verification
+ * only handles public values so uses a simpler variable time method.
+ *
+ * The scalar arithmetic mod L is from TweetNaCl version 20140427, a
+ * self-contained public-domain C library. https://tweetnacl.cr.yp.to/ */
 
 #define FOR(i,n) for (i = 0;i < n;++i)
 #define sv static void
@@ -38,49 +50,224 @@ typedef unsigned char u8;
 typedef unsigned long u32;
 typedef unsigned long long u64;
 typedef long long i64;
-typedef i64 gf[16];
+
+#if defined(__SIZEOF_INT128__)
+
+typedef unsigned __int128 u128;
+typedef u64 fe[5];
+
+#define FE_MASK51 0x7ffffffffffffULL
+
+/* The field operations are small and called very often, inlining them is
+ * much faster especially with return thunks or stack protection */
+#if defined(__GNUC__)
+#define FE_INLINE static inline __attribute__((always_inline))
+#else
+#define FE_INLINE static inline
+#endif
+
+/* Limbs of all values are kept below about 2^51 + 2^13 so that products
+ * in fe_mul() fit in 128 bits and fe_sub() can add 2*p */
+
+FE_INLINE void fe_0(fe h) {
+	h[0] = h[1] = h[2] = h[3] = h[4] = 0;
+}
+
+FE_INLINE void fe_1(fe h) {
+	fe_0(h);
+	h[0] = 1;
+}
+
+FE_INLINE void fe_copy(fe h, const fe f) {
+	h[0] = f[0];
+	h[1] = f[1];
+	h[2] = f[2];
+	h[3] = f[3];
+	h[4] = f[4];
+}
+
+FE_INLINE void fe_carry(fe h) {
+	u64 c;
+
+	c = h[0] >> 51; h[0] &= FE_MASK51; h[1] += c;
+	c = h[1] >> 51; h[1] &= FE_MASK51; h[2] += c;
+	c = h[2] >> 51; h[2] &= FE_MASK51; h[3] += c;
+	c = h[3] >> 51; h[3] &= FE_MASK51; h[4] += c;
+	c = h[4] >> 51; h[4] &= FE_MASK51; h[0] += 19 * c;
+	c = h[0] >> 51; h[0] &= FE_MASK51; h[1] += c;
+}
+
+FE_INLINE void fe_add(fe h, const fe f, const fe g) {
+	h[0] = f[0] + g[0];
+	h[1] = f[1] + g[1];
+	h[2] = f[2] + g[2];
+	h[3] = f[3] + g[3];
+	h[4] = f[4] + g[4];
+	fe_carry(h);
+}
+
+FE_INLINE void fe_sub(fe h, const fe f, const fe g) {
+	/* 2*p is added to keep the limbs positive */
+	h[0] = f[0] + 0xfffffffffffdaULL - g[0];
+	h[1] = f[1] + 0xffffffffffffeULL - g[1];
+	h[2] = f[2] + 0xffffffffffffeULL - g[2];
+	h[3] = f[3] + 0xffffffffffffeULL - g[3];
+	h[4] = f[4] + 0xffffffffffffeULL - g[4];
+	fe_carry(h);
+}
+
+FE_INLINE void fe_reduce128(fe h, u128 r0, u128 r1, u128 r2, u128 r3, u128 r4) {
+	u64 c;
+
+	c = (u64)(r0 >> 51); h[0] = (u64)r0 & FE_MASK51; r1 += c;
+	c = (u64)(r1 >> 51); h[1] = (u64)r1 & FE_MASK51; r2 += c;
+	c = (u64)(r2 >> 51); h[2] = (u64)r2 & FE_MASK51; r3 += c;
+	c = (u64)(r3 >> 51); h[3] = (u64)r3 & FE_MASK51; r4 += c;
+	c = (u64)(r4 >> 51); h[4] = (u64)r4 & FE_MASK51;
+	h[0] += 19 * c;
+	c = h[0] >> 51; h[0] &= FE_MASK51; h[1] += c;
+}
+
+static void fe_mul(fe h, const fe f, const fe g) {
+	u64 f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+	u64 g0 = g[0], g1 = g[1], g2 = g[2], g3 = g[3], g4 = g[4];
+	u64 g1_19 = 19 * g1, g2_19 = 19 * g2, g3_19 = 19 * g3, g4_19 = 19 * g4;
+	u128 r0, r1, r2, r3, r4;
+
+	r0 = (u128)f0 * g0 + (u128)f1 * g4_19 + (u128)f2 * g3_19
+		+ (u128)f3 * g2_19 + (u128)f4 * g1_19;
+	r1 = (u128)f0 * g1 + (u128)f1 * g0 + (u128)f2 * g4_19
+		+ (u128)f3 * g3_19 + (u128)f4 * g2_19;
+	r2 = (u128)f0 * g2 + (u128)f1 * g1 + (u128)f2 * g0
+		+ (u128)f3 * g4_19 + (u128)f4 * g3_19;
+	r3 = (u128)f0 * g3 + (u128)f1 * g2 + (u128)f2 * g1
+		+ (u128)f3 * g0 + (u128)f4 * g4_19;
+	r4 = (u128)f0 * g4 + (u128)f1 * g3 + (u128)f2 * g2
+		+ (u128)f3 * g1 + (u128)f4 * g0;
+	fe_reduce128(h, r0, r1, r2, r3, r4);
+}
+
+static void fe_sq(fe h, const fe f) {
+	u64 f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+	u64 f0_2 = 2 * f0, f1_2 = 2 * f1;
+	u64 f1_38 = 38 * f1, f2_38 = 38 * f2, f3_38 = 38 * f3;
+	u64 f3_19 = 19 * f3, f4_19 = 19 * f4;
+	u128 r0, r1, r2, r3, r4;
+
+	r0 = (u128)f0 * f0 + (u128)f1_38 * f4 + (u128)f2_38 * f3;
+	r1 = (u128)f0_2 * f1 + (u128)f2_38 * f4 + (u128)f3_19 * f3;
+	r2 = (u128)f0_2 * f2 + (u128)f1 * f1 + (u128)f3_38 * f4;
+	r3 = (u128)f0_2 * f3 + (u128)f1_2 * f2 + (u128)f4_19 * f4;
+	r4 = (u128)f0_2 * f4 + (u128)f1_2 * f3 + (u128)f2 * f2;
+	fe_reduce128(h, r0, r1, r2, r3, r4);
+}
 
 #if DROPBEAR_CURVE25519_DEP
-static const gf
+static void fe_mul121665(fe h, const fe f) {
+	fe_reduce128(h, (u128)f[0] * 121665, (u128)f[1] * 121665,
+		(u128)f[2] * 121665, (u128)f[3] * 121665, (u128)f[4] * 121665);
+}
+#endif /* DROPBEAR_CURVE25519_DEP */
+
+static u64 load64_le(const u8 *s) {
+	return (u64)s[0] | ((u64)s[1] << 8) | ((u64)s[2] << 16) | ((u64)s[3] << 24)
+		| ((u64)s[4] << 32) | ((u64)s[5] << 40) | ((u64)s[6] << 48)
+		| ((u64)s[7] << 56);
+}
+
+static void store64_le(u8 *s, u64 v) {
+	int i;
+	FOR(i,8) {
+		s[i] = v & 0xff;
+		v >>= 8;
+	}
+}
+
+/* The top bit is ignored */
+static void fe_frombytes(fe h, const u8 *s) {
+	h[0] = load64_le(s) & FE_MASK51;
+	h[1] = (load64_le(s + 6) >> 3) & FE_MASK51;
+	h[2] = (load64_le(s + 12) >> 6) & FE_MASK51;
+	h[3] = (load64_le(s + 19) >> 1) & FE_MASK51;
+	h[4] = (load64_le(s + 24) >> 12) & FE_MASK51;
+}
+
+/* Fully reduced mod p */
+static void fe_tobytes(u8 *s, const fe h) {
+	fe t;
+	u64 q;
+
+	fe_copy(t, h);
+	fe_carry(t);
+	/* t < 2*p now, q = 1 if t >= p */
+	q = (t[0] + 19) >> 51;
+	q = (t[1] + q) >> 51;
+	q = (t[2] + q) >> 51;
+	q = (t[3] + q) >> 51;
+	q = (t[4] + q) >> 51;
+
+	/* subtract q*p as adding 19*q and dropping bit 255 */
+	t[0] += 19 * q;
+	t[1] += t[0] >> 51; t[0] &= FE_MASK51;
+	t[2] += t[1] >> 51; t[1] &= FE_MASK51;
+	t[3] += t[2] >> 51; t[2] &= FE_MASK51;
+	t[4] += t[3] >> 51; t[3] &= FE_MASK51;
+	t[4] &= FE_MASK51;
+
+	store64_le(s, t[0] | (t[1] << 51));
+	store64_le(s + 8, (t[1] >> 13) | (t[2] << 38));
+	store64_le(s + 16, (t[2] >> 26) | (t[3] << 25));
+	store64_le(s + 24, (t[3] >> 39) | (t[4] << 12));
+}
+
+/* Swaps f and g if b is 1, b must be 0 or 1 */
+FE_INLINE void fe_cswap(fe f, fe g, unsigned int b) {
+	u64 mask = 0 - (u64)b, x;
+	int i;
+	FOR(i,5) {
+		x = mask & (f[i] ^ g[i]);
+		f[i] ^= x;
+		g[i] ^= x;
+	}
+}
+
+/* Sets f to g if b is 1, b must be 0 or 1 */
+FE_INLINE void fe_cmov(fe f, const fe g, unsigned int b) {
+	u64 mask = 0 - (u64)b;
+	int i;
+	FOR(i,5) {
+		f[i] ^= mask & (f[i] ^ g[i]);
+	}
+}
+
+#else /* no 128 bit integers */
+
+typedef i64 fe[16];
+
+#if DROPBEAR_CURVE25519_DEP
+static const fe
   _121665 = {0xDB41,1};
 #endif /* DROPBEAR_CURVE25519_DEP */
-#if DROPBEAR_ED25519
-static const gf
-  gf0,
-  gf1 = {1},
-  D2 = {0xf159, 0x26b2, 0x9b94, 0xebd6, 0xb156, 0x8283, 0x149a, 0x00e0, 0xd130, 0xeef3, 0x80f2, 0x198e, 0xfce7, 0x56df, 0xd9dc, 0x2406},
-  X = {0xd51a, 0x8f25, 0x2d60, 0xc956, 0xa7b2, 0x9525, 0xc760, 0x692c, 0xdc5c, 0xfdd6, 0xe231, 0xc0a4, 0x53fe, 0xcd6e, 0x36d3, 0x2169},
-  Y = {0x6658, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666};
-#if DROPBEAR_SIGNKEY_VERIFY
-static const gf
-  D = {0x78a3, 0x1359, 0x4dca, 0x75eb, 0xd8ab, 0x4141, 0x0a4d, 0x0070, 0xe898, 0x7779, 0x4079, 0x8cc7, 0xfe73, 0x2b6f, 0x6cee, 0x5203},
-  I = {0xa0b0, 0x4a0e, 0x1b27, 0xc4ee, 0xe478, 0xad2f, 0x1806, 0x2f43, 0xd7a7, 0x3dfb, 0x0099, 0x2b4d, 0xdf0b, 0x4fc1, 0x2480, 0x2b83};
-#endif /* DROPBEAR_SIGNKEY_VERIFY */
-#endif /* DROPBEAR_ED25519 */
 
-#if DROPBEAR_ED25519
-#if DROPBEAR_SIGNKEY_VERIFY
-static int vn(const u8 *x,const u8 *y,u32 n)
+sv fe_0(fe r)
 {
-  u32 i,d = 0;
-  FOR(i,n) d |= x[i]^y[i];
-  return (1 & ((d - 1) >> 8)) - 1;
+  int i;
+  FOR(i,16) r[i]=0;
 }
 
-static int crypto_verify_32(const u8 *x,const u8 *y)
+sv fe_1(fe r)
 {
-  return vn(x,y,32);
+  fe_0(r);
+  r[0]=1;
 }
-#endif /* DROPBEAR_SIGNKEY_VERIFY */
 
-sv set25519(gf r, const gf a)
+sv fe_copy(fe r, const fe a)
 {
   int i;
   FOR(i,16) r[i]=a[i];
 }
-#endif /* DROPBEAR_ED25519 */
 
-sv car25519(gf o)
+sv fe_carry(fe o)
 {
   int i;
   i64 c;
@@ -92,9 +279,9 @@ sv car25519(gf o)
   }
 }
 
-sv sel25519(gf p,gf q,int b)
+sv fe_cswap(fe p,fe q,unsigned int b)
 {
-  i64 t,i,c=~(b-1);
+  i64 t,i,c=~((i64)b-1);
   FOR(i,16) {
     t= c&(p[i]^q[i]);
     p[i]^=t;
@@ -102,14 +289,20 @@ sv sel25519(gf p,gf q,int b)
   }
 }
 
-sv pack25519(u8 *o,const gf n)
+sv fe_cmov(fe p,const fe q,unsigned int b)
+{
+  i64 i,c=~((i64)b-1);
+  FOR(i,16) p[i]^=c&(p[i]^q[i]);
+}
+
+sv fe_tobytes(u8 *o,const fe n)
 {
   int i,j,b;
-  gf m,t;
+  fe m,t;
   FOR(i,16) t[i]=n[i];
-  car25519(t);
-  car25519(t);
-  car25519(t);
+  fe_carry(t);
+  fe_carry(t);
+  fe_carry(t);
   FOR(j,2) {
     m[0]=t[0]-0xffed;
     for(i=1;i<15;i++) {
@@ -119,7 +312,7 @@ sv pack25519(u8 *o,const gf n)
     m[15]=t[15]-0x7fff-((m[14]>>16)&1);
     b=(m[15]>>16)&1;
     m[14]&=0xffff;
-    sel25519(t,m,1-b);
+    fe_cswap(t,m,1-b);
   }
   FOR(i,16) {
     o[2*i]=t[i]&0xff;
@@ -127,135 +320,412 @@ sv pack25519(u8 *o,const gf n)
   }
 }
 
-#if DROPBEAR_ED25519
-#if DROPBEAR_SIGNKEY_VERIFY
-static int neq25519(const gf a, const gf b)
-{
-  u8 c[32],d[32];
-  pack25519(c,a);
-  pack25519(d,b);
-  return crypto_verify_32(c,d);
-}
-#endif /* DROPBEAR_SIGNKEY_VERIFY */
-
-static u8 par25519(const gf a)
-{
-  u8 d[32];
-  pack25519(d,a);
-  return d[0]&1;
-}
-#endif /* DROPBEAR_ED25519 */
-
-sv unpack25519(gf o, const u8 *n)
+sv fe_frombytes(fe o, const u8 *n)
 {
   int i;
   FOR(i,16) o[i]=n[2*i]+((i64)n[2*i+1]<<8);
   o[15]&=0x7fff;
 }
 
-sv A(gf o,const gf a,const gf b)
+sv fe_add(fe o,const fe a,const fe b)
 {
   int i;
   FOR(i,16) o[i]=a[i]+b[i];
 }
 
-sv Z(gf o,const gf a,const gf b)
+sv fe_sub(fe o,const fe a,const fe b)
 {
   int i;
   FOR(i,16) o[i]=a[i]-b[i];
 }
 
-sv M(gf o,const gf a,const gf b)
+sv fe_mul(fe o,const fe a,const fe b)
 {
   i64 i,j,t[31];
   FOR(i,31) t[i]=0;
   FOR(i,16) FOR(j,16) t[i+j]+=a[i]*b[j];
   FOR(i,15) t[i]+=38*t[i+16];
   FOR(i,16) o[i]=t[i];
-  car25519(o);
-  car25519(o);
+  fe_carry(o);
+  fe_carry(o);
 }
 
-sv S(gf o,const gf a)
+sv fe_sq(fe o,const fe a)
 {
-  M(o,a,a);
+  fe_mul(o,a,a);
 }
 
-sv inv25519(gf o,const gf i)
+#if DROPBEAR_CURVE25519_DEP
+sv fe_mul121665(fe o,const fe a)
 {
-  gf c;
-  int a;
-  FOR(a,16) c[a]=i[a];
-  for(a=253;a>=0;a--) {
-    S(c,c);
-    if(a!=2&&a!=4) M(c,c,i);
-  }
-  FOR(a,16) o[a]=c[a];
+  fe_mul(o,a,_121665);
 }
+#endif /* DROPBEAR_CURVE25519_DEP */
 
-#if DROPBEAR_ED25519 && DROPBEAR_SIGNKEY_VERIFY
-sv pow2523(gf o,const gf i)
+#endif /* __SIZEOF_INT128__ */
+
+/* h = f^(2^n) */
+static void fe_sqn(fe h, const fe f, int n) {
+	fe_sq(h, f);
+	while (--n > 0) {
+		fe_sq(h, h);
+	}
+}
+
+/* z^(p-2), with the addition chain from curve25519-donna */
+static void fe_invert(fe out, const fe z) {
+	fe t0, t1, t2, t3;
+
+	fe_sq(t0, z);               /* 2 */
+	fe_sqn(t1, t0, 2);          /* 8 */
+	fe_mul(t1, z, t1);          /* 9 */
+	fe_mul(t0, t0, t1);         /* 11 */
+	fe_sq(t2, t0);              /* 22 */
+	fe_mul(t1, t1, t2);         /* 2^5 - 1 */
+	fe_sqn(t2, t1, 5);
+	fe_mul(t1, t2, t1);         /* 2^10 - 1 */
+	fe_sqn(t2, t1, 10);
+	fe_mul(t2, t2, t1);         /* 2^20 - 1 */
+	fe_sqn(t3, t2, 20);
+	fe_mul(t2, t3, t2);         /* 2^40 - 1 */
+	fe_sqn(t2, t2, 10);
+	fe_mul(t1, t2, t1);         /* 2^50 - 1 */
+	fe_sqn(t2, t1, 50);
+	fe_mul(t2, t2, t1);         /* 2^100 - 1 */
+	fe_sqn(t3, t2, 100);
+	fe_mul(t2, t3, t2);         /* 2^200 - 1 */
+	fe_sqn(t2, t2, 50);
+	fe_mul(t1, t2, t1);         /* 2^250 - 1 */
+	fe_sqn(t1, t1, 5);          /* 2^255 - 32 */
+	fe_mul(out, t1, t0);        /* 2^255 - 21 */
+}
+
+#if DROPBEAR_CURVE25519_DEP
+void dropbear_curve25519_scalarmult(u8 *q,const u8 *n,const u8 *p)
 {
-  gf c;
-  int a;
-  FOR(a,16) c[a]=i[a];
-  for(a=250;a>=0;a--) {
-    S(c,c);
-    if(a!=1) M(c,c,i);
-  }
-  FOR(a,16) o[a]=c[a];
+	u8 z[32];
+	fe x1, x2, z2, x3, z3, a, aa, b, bb, e, c, d;
+	unsigned int swap = 0, bit;
+	int i;
+
+	memcpy(z, n, 32);
+	z[31] = (n[31] & 127) | 64;
+	z[0] &= 248;
+
+	/* Montgomery ladder from RFC 7748 section 5 */
+	fe_frombytes(x1, p);
+	fe_1(x2);
+	fe_0(z2);
+	fe_copy(x3, x1);
+	fe_1(z3);
+	for (i = 254; i >= 0; i--) {
+		bit = (z[i >> 3] >> (i & 7)) & 1;
+		swap ^= bit;
+		fe_cswap(x2, x3, swap);
+		fe_cswap(z2, z3, swap);
+		swap = bit;
+
+		fe_add(a, x2, z2);
+		fe_sq(aa, a);
+		fe_sub(b, x2, z2);
+		fe_sq(bb, b);
+		fe_sub(e, aa, bb);
+		fe_add(c, x3, z3);
+		fe_sub(d, x3, z3);
+		fe_mul(d, d, a);            /* DA */
+		fe_mul(c, c, b);            /* CB */
+		fe_add(x3, d, c);
+		fe_sq(x3, x3);
+		fe_sub(z3, d, c);
+		fe_sq(z3, z3);
+		fe_mul(z3, z3, x1);
+		fe_mul(x2, aa, bb);
+		fe_mul121665(z2, e);
+		fe_add(z2, z2, aa);
+		fe_mul(z2, z2, e);
+	}
+	fe_cswap(x2, x3, swap);
+	fe_cswap(z2, z3, swap);
+
+	fe_invert(z2, z2);
+	fe_mul(x2, x2, z2);
+	fe_tobytes(q, x2);
+	m_burn(z, sizeof(z));
 }
+#endif /* DROPBEAR_CURVE25519_DEP */
+
+/* Ed25519 points (X:Y:Z:T) with x = X/Z, y = Y/Z, x*y = T/Z */
+typedef struct {
+	fe X, Y, Z, T;
+} ge_p3;
+
+/* Affine point as (y+x, y-x, 2*d*x*y), for mixed addition */
+typedef struct {
+	fe ypx, ymx, xy2d;
+} ge_precomp;
+
+/* Comb table for fixed base multiplication, base_comb[t][b] is the sum of
+ * 2^(32*(r+4*t))*B for each bit r set in b. Generated by curve25519-comb.py */
+static const u8 base_comb[2][16][96] = {
+	{
+		{0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+		{0x85, 0x3b, 0x8c, 0xf5, 0xc6, 0x93, 0xbc, 0x2f, 0x19, 0x0e, 0x8c, 0xfb, 0xc6, 0x2d, 0x93, 0xcf, 0xc2, 0x42, 0x3d, 0x64, 0x98, 0x48, 0x0b, 0x27, 0x65, 0xba, 0xd4, 0x33, 0x3a, 0x9d, 0xcf, 0x07,
+		 0x3e, 0x91, 0x40, 0xd7, 0x05, 0x39, 0x10, 0x9d, 0xb3, 0xbe, 0x40, 0xd1, 0x05, 0x9f, 0x39, 0xfd, 0x09, 0x8a, 0x8f, 0x68, 0x34, 0x84, 0xc1, 0xa5, 0x67, 0x12, 0xf8, 0x98, 0x92, 0x2f, 0xfd, 0x44,
+		 0x68, 0xaa, 0x7a, 0x87, 0x05, 0x12, 0xc9, 0xab, 0x9e, 0xc4, 0xaa, 0xcc, 0x23, 0xe8, 0xd9, 0x26, 0x8c, 0x59, 0x43, 0xdd, 0xcb, 0x7d, 0x1b, 0x5a, 0xa8, 0x65, 0x0c, 0x9f, 0x68, 0x7b, 0x11, 0x6f},
+		{0xe8, 0xc5, 0x85, 0x7b, 0x9f, 0xb6, 0x65, 0x87, 0xb2, 0xba, 0x68, 0xd1, 0x8b, 0x67, 0xf0, 0x6f, 0x9b, 0x0f, 0x33, 0x1d, 0x7c, 0xe7, 0x70, 0x3a, 0x7c, 0x8e, 0xaf, 0xb0, 0x51, 0x6d, 0x5f, 0x3a,
+		 0x5f, 0xac, 0x0d, 0xa6, 0x56, 0x87, 0x36, 0x61, 0x57, 0xdc, 0xab, 0xeb, 0x6a, 0x2f, 0xe0, 0x17, 0x7d, 0x0f, 0xce, 0x4c, 0x2d, 0x3f, 0x19, 0x7f, 0xf0, 0xdc, 0xec, 0x89, 0x77, 0x4a, 0x23, 0x20,
+		 0x52, 0xb2, 0x78, 0x71, 0xb6, 0x0d, 0xd2, 0x76, 0x60, 0xd1, 0x1e, 0xd5, 0xf9, 0x34, 0x1c, 0x07, 0x70, 0x11, 0xe4, 0xb3, 0x20, 0x4a, 0x2a, 0xf6, 0x66, 0xe3, 0xff, 0x3c, 0x35, 0x82, 0xd6, 0x7c},
+		{0x1f, 0x97, 0x6c, 0xa7, 0x74, 0x6a, 0x2d, 0x81, 0x4d, 0xf8, 0x39, 0x07, 0x5f, 0xa2, 0xec, 0x1c, 0x10, 0xb8, 0x02, 0x41, 0x3c, 0x6c, 0xd0, 0x27, 0xf7, 0x06, 0x19, 0x03, 0xc6, 0x1c, 0xdc, 0x7e,
+		 0x2a, 0x11, 0xba, 0x43, 0xad, 0x19, 0x05, 0x50, 0xd9, 0x3a, 0xbd, 0xae, 0x43, 0x0d, 0xda, 0xeb, 0xf0, 0xf3, 0x2c, 0x3e, 0x0c, 0xb9, 0xf6, 0xf3, 0xf5, 0xd4, 0x0c, 0xa6, 0x9b, 0x82, 0xe1, 0x0d,
+		 0x4b, 0x03, 0xb6, 0x2a, 0x0e, 0x2c, 0x47, 0xf5, 0x42, 0xf3, 0x80, 0xe4, 0x55, 0xbf, 0x4d, 0xbd, 0x66, 0xd2, 0xce, 0x0c, 0x71, 0xd2, 0x43, 0xd4, 0xf7, 0xb4, 0x2d, 0x9c, 0x42, 0xca, 0xe5, 0x4f},
+		{0x15, 0xf5, 0xd1, 0x77, 0xe7, 0x65, 0x2a, 0xcd, 0xf1, 0x60, 0xaa, 0x8f, 0x87, 0x91, 0x89, 0x54, 0xe5, 0x06, 0xbc, 0xda, 0xbc, 0x3b, 0xb7, 0xb1, 0xfb, 0xc9, 0x7c, 0xa9, 0xcb, 0x78, 0x48, 0x65,
+		 0xfe, 0xb0, 0xf6, 0x8d, 0xc7, 0x8e, 0x13, 0x51, 0x1b, 0xf5, 0x75, 0xe5, 0x89, 0xda, 0x97, 0x53, 0xb9, 0xf1, 0x7a, 0x71, 0x1d, 0x7a, 0x20, 0x09, 0x50, 0xd6, 0x20, 0x2b, 0xba, 0xfd, 0x02, 0x21,
+		 0xa1, 0xe6, 0x5c, 0x05, 0x05, 0xe4, 0x9e, 0x96, 0x29, 0xad, 0x51, 0x12, 0x68, 0xa7, 0xbc, 0x36, 0x15, 0xa4, 0x7d, 0xaa, 0x17, 0xf5, 0x1a, 0x3a, 0xba, 0xb2, 0xec, 0x29, 0xdb, 0x25, 0xd7, 0x0a},
+		{0xe8, 0x59, 0x1e, 0x60, 0x85, 0xc5, 0x55, 0x00, 0x60, 0x0e, 0x48, 0x66, 0x2b, 0x34, 0x93, 0x87, 0x4c, 0xe4, 0x45, 0xfe, 0xd0, 0xaa, 0x14, 0x3e, 0x2b, 0xcf, 0x13, 0x48, 0xe6, 0xd8, 0xea, 0x26,
+		 0xa4, 0x62, 0x84, 0x9c, 0xb6, 0xb8, 0x75, 0xcb, 0xd7, 0x1c, 0xd3, 0x67, 0xc5, 0x6f, 0xd8, 0x2d, 0xf6, 0x42, 0x13, 0x88, 0xec, 0x72, 0x19, 0xcd, 0x2f, 0x2f, 0xc1, 0x0f, 0x97, 0xb5, 0x75, 0x09,
+		 0x43, 0xa7, 0x5b, 0xda, 0x03, 0x23, 0xcf, 0x63, 0x6e, 0xba, 0xf1, 0x52, 0x81, 0x9d, 0xbf, 0x04, 0xda, 0x67, 0x73, 0xaa, 0xd0, 0x90, 0x37, 0x33, 0xea, 0xc5, 0xf6, 0x9d, 0x47, 0x70, 0x46, 0x53},
+		{0x7c, 0x65, 0x38, 0x77, 0x3c, 0x99, 0xf0, 0x0a, 0xd2, 0x1b, 0x18, 0x47, 0x47, 0x4a, 0xfb, 0xa9, 0x4a, 0xc1, 0x9e, 0x3e, 0xab, 0xe7, 0xdd, 0x55, 0x1c, 0x32, 0xc8, 0x37, 0xf6, 0xc7, 0x9e, 0x0b,
+		 0x53, 0x56, 0x03, 0x88, 0x7d, 0x7f, 0xe9, 0x0a, 0x8e, 0x06, 0x25, 0x8d, 0x10, 0x7b, 0xfb, 0x17, 0x9a, 0x8c, 0x1e, 0x3c, 0x0e, 0xfc, 0x28, 0x63, 0x9b, 0x21, 0xfe, 0x50, 0x5e, 0x58, 0x41, 0x54,
+		 0x46, 0x01, 0x0f, 0x64, 0x4c, 0x86, 0x52, 0xcb, 0xd3, 0xf0, 0x7e, 0x31, 0x66, 0x22, 0x56, 0x94, 0x5d, 0xbb, 0x95, 0x15, 0xc4, 0xf4, 0x76, 0xb8, 0x13, 0x77, 0x7f, 0xaf, 0x74, 0xf8, 0xd2, 0x4e},
+		{0xa7, 0xcd, 0xd2, 0x74, 0xd8, 0x87, 0xb6, 0xfe, 0x22, 0xfb, 0x27, 0xae, 0xc1, 0x2d, 0x04, 0xb8, 0xcc, 0xad, 0x93, 0x2c, 0x6d, 0x55, 0x64, 0x15, 0x16, 0x78, 0xa1, 0xe3, 0x28, 0x2d, 0x44, 0x11,
+		 0xd4, 0xc5, 0xf0, 0x07, 0x85, 0x35, 0xc3, 0xce, 0x20, 0x1c, 0xb0, 0x95, 0xf9, 0x7e, 0x9e, 0xfb, 0x43, 0x31, 0xa1, 0xde, 0x83, 0x93, 0x86, 0x0a, 0x9b, 0xc5, 0xf8, 0xf5, 0x61, 0x3a, 0xc6, 0x16,
+		 0x46, 0xd5, 0xfe, 0xd6, 0x8c, 0x63, 0xd6, 0xde, 0x0e, 0x19, 0x03, 0x38, 0x0b, 0xb6, 0xbd, 0x1a, 0xa3, 0x4d, 0x61, 0x6a, 0x15, 0x6f, 0xc5, 0xe0, 0x88, 0x6e, 0xdc, 0x9e, 0x56, 0x48, 0xc5, 0x04},
+		{0xa4, 0xb0, 0xdd, 0x12, 0x9c, 0x63, 0x98, 0xd5, 0x6b, 0x86, 0x24, 0xc0, 0x30, 0x9f, 0xd1, 0xa5, 0x60, 0xe4, 0xfc, 0x58, 0x03, 0x2f, 0x7c, 0xd1, 0x8a, 0x5e, 0x09, 0x2e, 0x15, 0x95, 0xa1, 0x07,
+		 0xde, 0xc4, 0x2e, 0x9c, 0xc5, 0xa9, 0x6f, 0x29, 0xcb, 0xf3, 0x84, 0x4f, 0xbf, 0x61, 0x8b, 0xbc, 0x08, 0xf9, 0xa8, 0x17, 0xd9, 0x06, 0x77, 0x1c, 0x5d, 0x25, 0xd3, 0x7a, 0xfc, 0x95, 0xb7, 0x63,
+		 0xc8, 0x5f, 0x9e, 0x38, 0x02, 0x8f, 0x36, 0xa8, 0x3b, 0xe4, 0x8d, 0xcf, 0x02, 0x3b, 0x43, 0x90, 0x43, 0x26, 0x41, 0xc5, 0x5d, 0xfd, 0xa1, 0xaf, 0x37, 0x01, 0x2f, 0x03, 0x3d, 0xe8, 0x8f, 0x3e},
+		{0x39, 0xa3, 0xd3, 0x17, 0x9a, 0xf6, 0xf7, 0xb5, 0x1e, 0x1f, 0xa0, 0x36, 0x45, 0x61, 0x5e, 0x80, 0x21, 0xa2, 0x01, 0x9b, 0x6d, 0x2b, 0xe6, 0x08, 0x8f, 0x89, 0xf1, 0x38, 0x50, 0x32, 0xf8, 0x0a,
+		 0x71, 0x1e, 0xf0, 0xbd, 0x89, 0xbe, 0xc2, 0xbc, 0x0f, 0x0d, 0x28, 0xc3, 0xe1, 0xf9, 0x58, 0x67, 0x58, 0x6c, 0xf3, 0xcc, 0xde, 0x6c, 0xa5, 0xf2, 0xc0, 0xac, 0xfa, 0x80, 0x7e, 0xbf, 0xdf, 0x1c,
+		 0xb2, 0xb3, 0xbf, 0x39, 0xfb, 0x88, 0x06, 0x73, 0x81, 0x6f, 0xc0, 0x07, 0x76, 0xc3, 0x93, 0xf4, 0x83, 0xba, 0xb1, 0x8d, 0xc2, 0x08, 0xa6, 0xbd, 0x60, 0xca, 0xec, 0x63, 0xa2, 0xe0, 0x90, 0x29},
+		{0x91, 0x47, 0xdc, 0x59, 0x41, 0xea, 0xa8, 0xfc, 0x58, 0xa0, 0x3a, 0x8b, 0xab, 0x3d, 0xae, 0x0f, 0xeb, 0x96, 0xe9, 0x4e, 0x6f, 0x39, 0x13, 0xbe, 0x6f, 0x6c, 0x93, 0x51, 0xbb, 0x09, 0x9d, 0x37,
+		 0xfb, 0xaf, 0x14, 0xf6, 0x1b, 0x1a, 0x60, 0xb6, 0xea, 0x92, 0x03, 0x21, 0x86, 0xc8, 0x60, 0x83, 0x98, 0x91, 0x34, 0x56, 0x3c, 0x33, 0x67, 0x48, 0x2c, 0xc4, 0x49, 0xf0, 0x6f, 0x4a, 0x22, 0x03,
+		 0x74, 0x89, 0xb8, 0x6f, 0x30, 0x7a, 0x26, 0x5e, 0x90, 0xb9, 0x8f, 0x4f, 0x82, 0x4f, 0xb8, 0xbe, 0x0d, 0x7b, 0xc5, 0x18, 0xb9, 0xb7, 0x29, 0x60, 0xf1, 0x7d, 0x35, 0xa2, 0xbe, 0x0b, 0x67, 0x60},
+		{0xd8, 0xdc, 0x02, 0xec, 0x58, 0x75, 0xe9, 0xc8, 0xb0, 0x15, 0x42, 0x73, 0x2d, 0xd5, 0xe6, 0x70, 0xcc, 0x37, 0x7f, 0xc9, 0x83, 0x46, 0xd0, 0x5a, 0xab, 0x85, 0xd6, 0xc1, 0xb3, 0x0a, 0x61, 0x2c,
+		 0x4f, 0x02, 0x0c, 0xe1, 0xf4, 0x33, 0xc3, 0xab, 0xcc, 0x86, 0x23, 0x67, 0xe4, 0x49, 0x81, 0x4f, 0x04, 0xf2, 0x7b, 0x4e, 0x1c, 0x17, 0xad, 0x3b, 0x67, 0x50, 0x8f, 0xe7, 0x0b, 0x19, 0xea, 0x4c,
+		 0x5f, 0x32, 0xf3, 0x02, 0x79, 0x3a, 0x8d, 0x8d, 0xe9, 0xbd, 0x8a, 0xbf, 0x48, 0xbd, 0x9c, 0x54, 0x0c, 0x9a, 0xd1, 0x11, 0xf6, 0xa0, 0xa1, 0x9d, 0x7c, 0x81, 0x2c, 0x37, 0x18, 0xf5, 0x8b, 0x71},
+		{0x37, 0xad, 0x81, 0x23, 0xf3, 0xe9, 0xc5, 0x21, 0x50, 0xd0, 0x6c, 0xb9, 0x3e, 0x28, 0x40, 0xc3, 0xca, 0xab, 0x50, 0x31, 0x71, 0xe4, 0xde, 0xfb, 0xb7, 0x9d, 0xfc, 0xc8, 0xee, 0x4d, 0xb2, 0x31,
+		 0xbb, 0xcc, 0x76, 0x2b, 0xed, 0x0e, 0x16, 0x2c, 0x75, 0x27, 0xd8, 0x54, 0x6b, 0xc3, 0xd5, 0x6d, 0xe9, 0xa5, 0xe0, 0xd5, 0x10, 0x82, 0x27, 0x7f, 0x40, 0xf5, 0x9c, 0xc5, 0x7c, 0xc4, 0x6f, 0x07,
+		 0x81, 0xdf, 0x61, 0x5f, 0xd8, 0x61, 0xf6, 0xbd, 0xbd, 0xc5, 0xae, 0x4e, 0xe5, 0x7f, 0xb5, 0xfb, 0x6e, 0xf8, 0x7c, 0xe9, 0x5e, 0x10, 0xa7, 0x5a, 0x95, 0xcd, 0xd3, 0xd8, 0xb6, 0x48, 0xa4, 0x00},
+		{0xb6, 0x52, 0x29, 0x97, 0xa6, 0x44, 0x44, 0x58, 0x7c, 0x52, 0xba, 0xf3, 0xf7, 0x4a, 0x2e, 0x1a, 0x75, 0xed, 0xe4, 0xc1, 0xf4, 0xff, 0xd4, 0x5a, 0x6f, 0xba, 0x78, 0x3e, 0x4b, 0xa2, 0x05, 0x4c,
+		 0x2e, 0x6a, 0x34, 0xbf, 0xb2, 0x55, 0x4c, 0x12, 0x65, 0xe3, 0x35, 0x39, 0x3d, 0xa4, 0x03, 0xd1, 0xfa, 0x95, 0x14, 0xcb, 0xbc, 0xc4, 0x7e, 0x05, 0xed, 0xba, 0x15, 0x27, 0x78, 0x10, 0xed, 0x00,
+		 0x22, 0x61, 0x1a, 0xd5, 0x33, 0xdb, 0xac, 0xa0, 0x2c, 0x63, 0x37, 0x16, 0xb6, 0xc5, 0x1b, 0x37, 0xa1, 0x94, 0x0d, 0xb0, 0x01, 0xd7, 0x34, 0x8e, 0xfa, 0x03, 0xf6, 0x7a, 0xb2, 0x68, 0xa7, 0x55},
+		{0xe1, 0x99, 0x64, 0xb2, 0xd8, 0x85, 0x89, 0xa1, 0x96, 0x59, 0xeb, 0x3c, 0x08, 0x62, 0xbc, 0xc1, 0x44, 0xf2, 0xf6, 0x5d, 0xb3, 0xda, 0x1c, 0x83, 0x3c, 0x20, 0x0b, 0x63, 0xaf, 0x54, 0x97, 0x64,
+		 0xc9, 0x44, 0x1e, 0xb8, 0x0e, 0xd8, 0xfb, 0xa3, 0x0a, 0xb7, 0xfb, 0xfc, 0xef, 0x98, 0xcb, 0xf7, 0x56, 0x4f, 0xf9, 0xcf, 0x2a, 0x5e, 0xaa, 0xf4, 0xae, 0x04, 0x6d, 0x12, 0x81, 0x59, 0x8d, 0x68,
+		 0xfe, 0x0f, 0xbd, 0x8c, 0x90, 0x9f, 0xb2, 0xb3, 0xdb, 0x99, 0x9a, 0x26, 0xb6, 0x3f, 0x62, 0xfa, 0x34, 0x7d, 0x0e, 0xf7, 0x97, 0x5b, 0xb9, 0xb4, 0x50, 0xe6, 0x21, 0x2a, 0xa0, 0x47, 0x42, 0x0d},
+		{0xd9, 0xce, 0x2e, 0x31, 0x38, 0x11, 0xa8, 0x9e, 0x9d, 0x57, 0x0e, 0xfd, 0xd4, 0xd4, 0xe9, 0x85, 0x7c, 0x8e, 0xd6, 0x23, 0x50, 0xba, 0x08, 0x23, 0x2f, 0x3f, 0x98, 0xf6, 0x2b, 0x63, 0xb2, 0x36,
+		 0x71, 0x7d, 0x7a, 0xf8, 0xf1, 0xf3, 0xa9, 0x19, 0x2d, 0xd7, 0xb0, 0x78, 0x68, 0x7d, 0x07, 0x60, 0xbf, 0x9b, 0xa5, 0x01, 0x61, 0xd7, 0x21, 0x89, 0x91, 0x73, 0x40, 0xf8, 0xe2, 0x84, 0x2e, 0x26,
+		 0x53, 0x52, 0x28, 0xd3, 0x36, 0x01, 0xc7, 0xcd, 0xe2, 0x24, 0x41, 0x01, 0xa4, 0x27, 0xff, 0x7f, 0xf9, 0x2d, 0x2a, 0xdb, 0x13, 0xc9, 0x9a, 0xe2, 0x30, 0x87, 0x33, 0x66, 0x38, 0xdc, 0x3b, 0x1d}
+	},
+	{
+		{0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+		{0xa2, 0x8e, 0xad, 0xac, 0xbf, 0x04, 0x3b, 0x58, 0x84, 0xe8, 0x8b, 0x14, 0xe8, 0x43, 0xb7, 0x29, 0xdb, 0xc5, 0x10, 0x08, 0x3b, 0x58, 0x1e, 0x2b, 0xaa, 0xbb, 0xb3, 0x8e, 0xe5, 0x49, 0x54, 0x2b,
+		 0x47, 0xbe, 0x3d, 0xeb, 0x62, 0x75, 0x3a, 0x5f, 0xb8, 0xa0, 0xbd, 0x8e, 0x54, 0x38, 0xea, 0xf7, 0x99, 0x72, 0x74, 0x45, 0x31, 0xe5, 0xc3, 0x00, 0x51, 0xd5, 0x27, 0x16, 0xe7, 0xe9, 0x04, 0x13,
+		 0xfe, 0x9c, 0xdc, 0x6a, 0xd2, 0x14, 0x98, 0x78, 0x0b, 0xdd, 0x48, 0x8b, 0x3f, 0xab, 0x1b, 0x3c, 0x0a, 0xc6, 0x79, 0xf9, 0xff, 0xe1, 0x0f, 0xda, 0x93, 0xd6, 0x2d, 0x7c, 0x2d, 0xde, 0x68, 0x44},
+		{0x51, 0x2f, 0x5b, 0x30, 0xfb, 0xbf, 0xee, 0x96, 0xb8, 0x96, 0x95, 0x88, 0xad, 0x38, 0xf9, 0xd3, 0x25, 0xdd, 0xd5, 0x46, 0xc7, 0x2d, 0xf5, 0xf0, 0x95, 0x00, 0x3a, 0xbb, 0x90, 0x82, 0x96, 0x57,
+		 0xdc, 0xae, 0x58, 0x8c, 0x4e, 0x97, 0x37, 0x46, 0xa4, 0x41, 0xf0, 0xab, 0xfb, 0x22, 0xef, 0xb9, 0x8a, 0x71, 0x80, 0xe9, 0x56, 0xd9, 0x85, 0xe1, 0xa6, 0xa8, 0x43, 0xb1, 0xfa, 0x78, 0x1b, 0x2f,
+		 0x01, 0xe1, 0x20, 0x0a, 0x43, 0xb8, 0x1a, 0xf7, 0x47, 0xec, 0xf0, 0x24, 0x8d, 0x65, 0x93, 0xf3, 0xd1, 0xee, 0xe2, 0x6e, 0xa8, 0x09, 0x75, 0xcf, 0xe1, 0xa3, 0x2a, 0xdc, 0x35, 0x3e, 0xc4, 0x7d},
+		{0x51, 0x47, 0x78, 0x7b, 0x7c, 0xb2, 0xa6, 0x9a, 0xa4, 0xba, 0x8e, 0x47, 0x2c, 0xec, 0x4b, 0x32, 0x8f, 0x06, 0xec, 0x6a, 0xe6, 0x08, 0xed, 0xe9, 0x7f, 0xea, 0x89, 0x12, 0x38, 0xf3, 0x01, 0x22,
+		 0xe5, 0xd9, 0x82, 0x1d, 0x3f, 0xf9, 0xb6, 0x88, 0xb8, 0x97, 0xaf, 0x38, 0x55, 0xdb, 0x53, 0xc7, 0x79, 0xc8, 0x90, 0x23, 0x61, 0xb1, 0xf3, 0x1b, 0x25, 0xed, 0x33, 0x36, 0xb3, 0x33, 0x8e, 0x13,
+		 0x13, 0xd2, 0x9c, 0x7b, 0x37, 0x5f, 0xb5, 0xb6, 0x09, 0x61, 0x63, 0x20, 0x8f, 0xd1, 0x98, 0x28, 0x35, 0x19, 0x0d, 0xc1, 0xee, 0x07, 0x55, 0x0b, 0x1c, 0x5b, 0x91, 0xe7, 0x6a, 0xa0, 0xf8, 0x09},
+		{0xc0, 0x1a, 0x0c, 0xc8, 0x9d, 0xcc, 0x6d, 0xa6, 0x36, 0xa4, 0x38, 0x1b, 0xf4, 0x5c, 0xa0, 0x97, 0xc6, 0xd7, 0xdb, 0x95, 0xbe, 0xf3, 0xeb, 0xa7, 0xab, 0x7d, 0x7e, 0x8d, 0xf6, 0xb8, 0xa0, 0x7d,
+		 0xa6, 0x75, 0x56, 0x38, 0x14, 0x20, 0x78, 0xef, 0xe8, 0xa9, 0xfd, 0xaa, 0x30, 0x9f, 0x64, 0xa2, 0xcb, 0xa8, 0xdf, 0x5c, 0x50, 0xeb, 0xd1, 0x4c, 0xb3, 0xc0, 0x4d, 0x1d, 0xba, 0x5a, 0x11, 0x46,
+		 0x76, 0xda, 0xb5, 0xc3, 0x53, 0x19, 0x0f, 0xd4, 0x9b, 0x9e, 0x11, 0x21, 0x73, 0x6f, 0xac, 0x1d, 0x60, 0x59, 0xb2, 0xfe, 0x21, 0x60, 0xcc, 0x03, 0x4b, 0x4b, 0x67, 0x83, 0x7e, 0x88, 0x5f, 0x5a},
+		{0xdf, 0x15, 0x63, 0x0e, 0xad, 0x11, 0xe8, 0x23, 0x90, 0xb2, 0xae, 0xe2, 0x05, 0x0d, 0x65, 0x0b, 0x6c, 0x58, 0x5d, 0xa7, 0x59, 0x0f, 0xba, 0xb7, 0xee, 0x4d, 0x1f, 0x5e, 0xd4, 0xed, 0x3e, 0x04,
+		 0x17, 0x32, 0x07, 0xc7, 0xf2, 0x47, 0xc1, 0xf6, 0x0c, 0xd2, 0xaf, 0xf3, 0x19, 0xb9, 0x51, 0xc6, 0x02, 0xf8, 0x41, 0x70, 0xfd, 0xdb, 0x8f, 0x25, 0x3e, 0x07, 0x45, 0x4f, 0xa9, 0x4f, 0x3c, 0x17,
+		 0xc4, 0xf9, 0x8d, 0x92, 0x60, 0xea, 0x71, 0x3d, 0x2d, 0x56, 0x73, 0x33, 0x06, 0x78, 0x7e, 0x5b, 0xb2, 0x52, 0x95, 0xa2, 0x4c, 0x51, 0xb0, 0xd9, 0x72, 0xc4, 0x3c, 0x99, 0x24, 0x70, 0x2a, 0x1e},
+		{0xdf, 0x51, 0x49, 0x2f, 0x89, 0xaf, 0xd7, 0x79, 0x6d, 0xeb, 0xa6, 0xaf, 0xb5, 0x6e, 0xa0, 0x88, 0xe4, 0x68, 0xc5, 0x24, 0x3c, 0x56, 0x31, 0x58, 0xed, 0x6c, 0xb2, 0xae, 0x19, 0x7a, 0x70, 0x66,
+		 0xe1, 0x96, 0x73, 0x74, 0xe2, 0x10, 0x13, 0x6c, 0xce, 0xe7, 0xed, 0x4c, 0x62, 0x00, 0xe4, 0x0e, 0x9b, 0xe2, 0x45, 0x2d, 0x02, 0x76, 0x3d, 0x9a, 0x48, 0xf6, 0x0c, 0x3f, 0x04, 0xbd, 0x4c, 0x20,
+		 0xae, 0x42, 0x9e, 0x37, 0xe8, 0x54, 0x24, 0x2b, 0x64, 0x77, 0x2c, 0xf1, 0x8c, 0x75, 0xc8, 0x90, 0xe6, 0xc6, 0xe7, 0x65, 0xcf, 0xd2, 0x5f, 0x6c, 0x0e, 0xa5, 0x80, 0xcf, 0x37, 0x7f, 0x9e, 0x28},
+		{0xe9, 0x23, 0xc9, 0x01, 0x0a, 0xdb, 0x69, 0xcd, 0x51, 0x7a, 0xec, 0xb2, 0xcb, 0xfc, 0x95, 0xc0, 0x43, 0x80, 0x51, 0x15, 0x78, 0xc7, 0xd7, 0x6b, 0x53, 0xe8, 0xbd, 0xb6, 0x93, 0x3c, 0xa3, 0x0d,
+		 0xcd, 0x03, 0x99, 0x34, 0x0a, 0xfb, 0xbf, 0xf3, 0xf5, 0x68, 0x4c, 0x66, 0xbd, 0xf6, 0x62, 0x03, 0x8e, 0xce, 0x7a, 0x7d, 0xe1, 0x72, 0x5c, 0xb7, 0x03, 0xe3, 0x6d, 0xc2, 0x06, 0x32, 0x81, 0x12,
+		 0x37, 0xfb, 0x21, 0x4d, 0x86, 0xeb, 0x82, 0x8e, 0xa0, 0xfc, 0x06, 0xd7, 0xa7, 0x6a, 0x4e, 0x78, 0x43, 0xf3, 0x86, 0x79, 0x19, 0x50, 0x5c, 0xce, 0x9a, 0x2c, 0x22, 0x86, 0xcb, 0x29, 0x9a, 0x74},
+		{0x7f, 0x87, 0x3b, 0x19, 0xc9, 0x00, 0x2e, 0xbb, 0x6b, 0x50, 0xdc, 0xe0, 0x90, 0xa8, 0xe3, 0xec, 0x9f, 0x64, 0xde, 0x36, 0xc0, 0xb7, 0xf3, 0xec, 0x1a, 0x9e, 0xde, 0x98, 0x08, 0x04, 0x46, 0x5f,
+		 0xdb, 0xce, 0x2f, 0x83, 0x45, 0x88, 0x9d, 0x73, 0x63, 0xf8, 0x6b, 0xae, 0xc9, 0xd6, 0x38, 0xfa, 0xf7, 0xfe, 0x4f, 0xb7, 0xca, 0x0d, 0xbc, 0x32, 0x5e, 0xe4, 0xbc, 0x14, 0x88, 0x7e, 0x93, 0x73,
+		 0x8d, 0xf4, 0x7b, 0x29, 0x16, 0x71, 0x03, 0xb9, 0x34, 0x68, 0xf0, 0xd4, 0x22, 0x3b, 0xd1, 0xa9, 0xc6, 0xbd, 0x96, 0x46, 0x57, 0x15, 0x97, 0xe1, 0x35, 0xe8, 0xd5, 0x91, 0xe8, 0xa4, 0xf8, 0x2c},
+		{0x71, 0xba, 0xcd, 0xfd, 0xa4, 0x56, 0x9f, 0x08, 0xbe, 0x39, 0x39, 0x92, 0x10, 0x26, 0x03, 0xdd, 0xde, 0xec, 0x3f, 0xcd, 0x03, 0x18, 0xfd, 0x2f, 0x33, 0xb2, 0x52, 0x28, 0x55, 0xc3, 0x08, 0x35,
+		 0xc2, 0x04, 0x68, 0x0c, 0x14, 0xa0, 0x6a, 0x97, 0x0a, 0x2d, 0xb1, 0x04, 0x03, 0x08, 0xc4, 0x37, 0xff, 0x73, 0x04, 0x1f, 0x28, 0x7e, 0x28, 0x10, 0x40, 0x7f, 0x48, 0xdc, 0xdd, 0x10, 0x29, 0x3d,
+		 0x80, 0x27, 0x0e, 0x8c, 0x4e, 0x6e, 0x15, 0xe0, 0xad, 0x72, 0x7b, 0x14, 0x76, 0x34, 0x96, 0x96, 0x23, 0xd2, 0xf7, 0x15, 0xbe, 0xe9, 0xd6, 0x35, 0xbc, 0x5b, 0x2f, 0x73, 0x44, 0xe3, 0x8c, 0x7a},
+		{0xe3, 0xdf, 0xfd, 0xf3, 0x49, 0x27, 0x10, 0x77, 0x52, 0xac, 0xbe, 0x79, 0x17, 0x13, 0x3b, 0x09, 0xc7, 0x54, 0xba, 0xba, 0xc1, 0x5c, 0x1a, 0x2c, 0xf9, 0x20, 0xed, 0x82, 0xfd, 0xef, 0xc2, 0x7c,
+		 0x1c, 0x7b, 0x7c, 0x62, 0xfe, 0x30, 0x5e, 0xfe, 0x2f, 0xfc, 0x82, 0x8d, 0x0d, 0xe3, 0x6d, 0x7d, 0x94, 0xf3, 0x1b, 0x1c, 0xb1, 0x81, 0x79, 0x6b, 0xef, 0x90, 0x56, 0x95, 0x37, 0x95, 0xf7, 0x6e,
+		 0x9d, 0x1d, 0xac, 0x38, 0xc9, 0xd4, 0x7b, 0x31, 0xc8, 0x48, 0x3a, 0xd4, 0xab, 0x22, 0x0b, 0x12, 0xc7, 0x47, 0xba, 0x25, 0x1a, 0x69, 0x73, 0xd3, 0x2d, 0x9e, 0xe7, 0xdd, 0xeb, 0x44, 0x4f, 0x44},
+		{0x77, 0xc7, 0x2f, 0xc2, 0x8d, 0x03, 0x58, 0x85, 0xde, 0x72, 0x60, 0x9d, 0xd5, 0xee, 0xd4, 0xf1, 0x86, 0x54, 0x00, 0xe6, 0xfb, 0x0f, 0x29, 0x08, 0x81, 0x46, 0xa2, 0x3d, 0xc2, 0x9a, 0x3a, 0x4a,
+		 0xf2, 0x18, 0x15, 0x2f, 0xfd, 0x97, 0xc7, 0xdc, 0x13, 0x3f, 0x96, 0xb7, 0x39, 0x3a, 0x9d, 0x61, 0xb8, 0xa3, 0xa7, 0xf4, 0x8c, 0x1a, 0xee, 0xff, 0xbc, 0xc1, 0x5f, 0xb0, 0xfe, 0xad, 0xb6, 0x35,
+		 0xab, 0xa6, 0xc5, 0x94, 0xaa, 0xed, 0x52, 0x42, 0xed, 0xc3, 0x51, 0xa2, 0xba, 0x48, 0x3c, 0xf4, 0x37, 0x70, 0xae, 0xf4, 0x31, 0x98, 0x2e, 0xf6, 0x2f, 0xb2, 0x85, 0xb1, 0x9d, 0x3b, 0x5e, 0x0f},
+		{0x12, 0xcc, 0x52, 0xcd, 0x73, 0xf9, 0xf4, 0x8e, 0xba, 0x31, 0xfd, 0x02, 0xe3, 0xf0, 0x0d, 0xbb, 0x51, 0x7a, 0xf4, 0x6f, 0x02, 0xdf, 0x14, 0x5e, 0x12, 0xd9, 0x09, 0xbe, 0x30, 0x73, 0x86, 0x09,
+		 0xc3, 0x6a, 0x3f, 0xd6, 0xd2, 0xec, 0x1c, 0x47, 0xe5, 0xf7, 0x06, 0xe0, 0x50, 0x9e, 0x18, 0x0d, 0x0d, 0x49, 0x53, 0x7c, 0xd7, 0x53, 0xd6, 0xc5, 0x58, 0x1d, 0x0a, 0x72, 0x87, 0x45, 0x99, 0x11,
+		 0xc3, 0x30, 0x28, 0x04, 0xa8, 0x56, 0x94, 0x15, 0xee, 0x8c, 0x96, 0xec, 0xba, 0xe4, 0xdd, 0x4a, 0x6f, 0x26, 0x1f, 0xea, 0x25, 0xbe, 0xec, 0x1e, 0xc2, 0x64, 0xb5, 0x3c, 0x85, 0xfd, 0xb6, 0x28},
+		{0x6b, 0xf8, 0x28, 0x81, 0x90, 0x1b, 0xe5, 0x98, 0x30, 0x7e, 0xdd, 0xe6, 0xe5, 0x13, 0x3f, 0x26, 0x11, 0xb8, 0x89, 0x96, 0x31, 0xce, 0x6a, 0xd0, 0x94, 0xee, 0x23, 0x4f, 0x48, 0x93, 0x32, 0x57,
+		 0xd4, 0x56, 0x47, 0x1a, 0xf5, 0xcf, 0x4f, 0x02, 0x91, 0x2e, 0x88, 0x6b, 0x0a, 0x63, 0x20, 0xb0, 0x33, 0xf5, 0x75, 0x20, 0x03, 0xf7, 0xd5, 0xb5, 0xe6, 0x4d, 0xb9, 0x78, 0xd0, 0x09, 0x45, 0x32,
+		 0xa0, 0x0e, 0x14, 0x62, 0x99, 0xcd, 0x75, 0x67, 0xf0, 0x3e, 0x5b, 0x36, 0x77, 0xd3, 0x42, 0xd6, 0x56, 0xcb, 0x65, 0x3f, 0xba, 0x01, 0x19, 0x60, 0x5b, 0xf0, 0x83, 0xcf, 0x09, 0x95, 0x93, 0x2b},
+		{0xab, 0x8a, 0x1f, 0x92, 0x68, 0xe7, 0x34, 0x3d, 0x95, 0x47, 0xee, 0x6e, 0xa3, 0xbe, 0x46, 0x37, 0xf7, 0x3c, 0xfa, 0x59, 0xaa, 0xd1, 0x02, 0xee, 0x6b, 0x12, 0xef, 0xda, 0x34, 0xe2, 0x73, 0x32,
+		 0xcd, 0x83, 0x5a, 0xd3, 0x72, 0xca, 0x40, 0x57, 0x1b, 0xea, 0xab, 0x01, 0x60, 0x01, 0xde, 0x0c, 0x16, 0x1b, 0xc2, 0xec, 0x6a, 0x7f, 0x7a, 0xfb, 0x23, 0xac, 0x48, 0xb0, 0x13, 0x2d, 0xbf, 0x01,
+		 0xb2, 0x9a, 0xce, 0x71, 0xba, 0x8b, 0x4a, 0x3c, 0x08, 0x72, 0x1c, 0xb6, 0xb3, 0x2e, 0x3c, 0xf7, 0x11, 0xe2, 0xf9, 0xb8, 0xf5, 0x9e, 0x85, 0x73, 0xf1, 0x0c, 0x31, 0x6d, 0x74, 0x1b, 0x32, 0x6a},
+		{0xdc, 0xa8, 0x91, 0xf1, 0xfa, 0x8e, 0x78, 0x26, 0x90, 0x35, 0x26, 0xe7, 0xfc, 0xcc, 0xdf, 0xe8, 0xd1, 0x26, 0x20, 0xaa, 0x62, 0x93, 0x7c, 0x15, 0x4f, 0x14, 0x5d, 0x4a, 0xad, 0xca, 0x32, 0x4e,
+		 0x50, 0xdb, 0x3a, 0x56, 0x1d, 0x89, 0x9b, 0xec, 0xce, 0x1d, 0x67, 0x1f, 0xdb, 0xb1, 0x78, 0x8d, 0x7c, 0x19, 0x2d, 0x28, 0x15, 0x71, 0x61, 0x69, 0x78, 0xa9, 0x73, 0x55, 0x3a, 0x64, 0xe2, 0x1a,
+		 0x34, 0x24, 0xcf, 0x4f, 0xb7, 0x6f, 0x63, 0x09, 0x40, 0x5a, 0x99, 0xaf, 0x20, 0x1e, 0x88, 0xdd, 0xb7, 0xc2, 0x91, 0x5f, 0x89, 0x1a, 0x21, 0xce, 0xaa, 0x00, 0x49, 0xfd, 0x9c, 0x99, 0x50, 0x6a}
+	}
+};
+
+static int curve25519_ready;
+static ge_precomp base_table[2][16];
+
+#if DROPBEAR_ED25519 && DROPBEAR_SIGNKEY_VERIFY
+static const u8 d_bytes[32] = {
+	0xa3, 0x78, 0x59, 0x13, 0xca, 0x4d, 0xeb, 0x75,
+	0xab, 0xd8, 0x41, 0x41, 0x4d, 0x0a, 0x70, 0x00,
+	0x98, 0xe8, 0x79, 0x77, 0x79, 0x40, 0xc7, 0x8c,
+	0x73, 0xfe, 0x6f, 0x2b, 0xee, 0x6c, 0x03, 0x52
+};
+
+static const u8 d2_bytes[32] = {
+	0x59, 0xf1, 0xb2, 0x26, 0x94, 0x9b, 0xd6, 0xeb,
+	0x56, 0xb1, 0x83, 0x82, 0x9a, 0x14, 0xe0, 0x00,
+	0x30, 0xd1, 0xf3, 0xee, 0xf2, 0x80, 0x8e, 0x19,
+	0xe7, 0xfc, 0xdf, 0x56, 0xdc, 0xd9, 0x06, 0x24
+};
+
+static const u8 sqrtm1_bytes[32] = {
+	0xb0, 0xa0, 0x0e, 0x4a, 0x27, 0x1b, 0xee, 0xc4,
+	0x78, 0xe4, 0x2f, 0xad, 0x06, 0x18, 0x43, 0x2f,
+	0xa7, 0xd7, 0xfb, 0x3d, 0x99, 0x00, 0x4d, 0x2b,
+	0x0b, 0xdf, 0xc1, 0x4f, 0x80, 0x24, 0x83, 0x2b
+};
+
+static fe fe_d, fe_d2, fe_sqrtm1;
 #endif /* DROPBEAR_ED25519 && DROPBEAR_SIGNKEY_VERIFY */
 
+/* Converts the constants to field elements on first use */
+static void curve25519_init(void) {
+	int t, b;
+
+	if (curve25519_ready) {
+		return;
+	}
+	FOR(t,2) FOR(b,16) {
+		fe_frombytes(base_table[t][b].ypx, base_comb[t][b]);
+		fe_frombytes(base_table[t][b].ymx, base_comb[t][b] + 32);
+		fe_frombytes(base_table[t][b].xy2d, base_comb[t][b] + 64);
+	}
+#if DROPBEAR_ED25519 && DROPBEAR_SIGNKEY_VERIFY
+	fe_frombytes(fe_d, d_bytes);
+	fe_frombytes(fe_d2, d2_bytes);
+	fe_frombytes(fe_sqrtm1, sqrtm1_bytes);
+#endif
+	curve25519_ready = 1;
+}
+
+static void ge_p3_0(ge_p3 *h) {
+	fe_0(h->X);
+	fe_1(h->Y);
+	fe_1(h->Z);
+	fe_0(h->T);
+}
+
+/* r = 2*p, "dbl-2008-hwcd" with a = -1. Some intermediate values are
+ * negated, which cancels out in the products */
+static void ge_dbl(ge_p3 *r, const ge_p3 *p) {
+	fe a, b, c, e, f, g, h;
+
+	fe_sq(a, p->X);
+	fe_sq(b, p->Y);
+	fe_sq(c, p->Z);
+	fe_add(c, c, c);
+	fe_add(h, a, b);            /* -H */
+	fe_add(e, p->X, p->Y);
+	fe_sq(e, e);
+	fe_sub(e, h, e);            /* -E */
+	fe_sub(g, a, b);            /* -G */
+	fe_add(f, c, g);            /* -F */
+	fe_mul(r->X, e, f);
+	fe_mul(r->Y, g, h);
+	fe_mul(r->T, e, h);
+	fe_mul(r->Z, f, g);
+}
+
+/* r = p + q, "madd-2008-hwcd-3" with a = -1. The formulas are complete,
+ * q may be the identity or equal to p */
+static void ge_madd(ge_p3 *r, const ge_p3 *p, const ge_precomp *q) {
+	fe a, b, c, d, e, f, g, h;
+
+	fe_sub(a, p->Y, p->X);
+	fe_mul(a, a, q->ymx);
+	fe_add(b, p->Y, p->X);
+	fe_mul(b, b, q->ypx);
+	fe_mul(c, p->T, q->xy2d);
+	fe_add(d, p->Z, p->Z);
+	fe_sub(e, b, a);
+	fe_sub(f, d, c);
+	fe_add(g, d, c);
+	fe_add(h, b, a);
+	fe_mul(r->X, e, f);
+	fe_mul(r->Y, g, h);
+	fe_mul(r->T, e, h);
+	fe_mul(r->Z, f, g);
+}
+
+/* Constant time t = table[idx] */
+static void ge_select(ge_precomp *t, const ge_precomp table[16], unsigned int idx) {
+	unsigned int i, eq;
+
+	fe_copy(t->ypx, table[0].ypx);
+	fe_copy(t->ymx, table[0].ymx);
+	fe_copy(t->xy2d, table[0].xy2d);
+	for (i = 1; i < 16; i++) {
+		eq = ((i ^ idx) - 1) >> 31;
+		fe_cmov(t->ypx, table[i].ypx, eq);
+		fe_cmov(t->ymx, table[i].ymx, eq);
+		fe_cmov(t->xy2d, table[i].xy2d, eq);
+	}
+}
+
+/* h = a*B for a 256 bit little endian scalar a, in constant time.
+ * The scalar is split into 8 rows of 32 bits, each step doubles once and
+ * adds the column of bits from rows 0-3 and rows 4-7 */
+static void ge_scalarmult_base(ge_p3 *h, const u8 *a) {
+	ge_precomp t;
+	unsigned int i, r, idx0, idx1;
+
+	curve25519_init();
+	ge_p3_0(h);
+	for (i = 32; i-- > 0;) {
+		idx0 = idx1 = 0;
+		FOR(r,4) {
+			idx0 |= ((a[4 * r + (i >> 3)] >> (i & 7)) & 1) << r;
+			idx1 |= ((a[4 * (r + 4) + (i >> 3)] >> (i & 7)) & 1) << r;
+		}
+		ge_dbl(h, h);
+		ge_select(&t, base_table[0], idx0);
+		ge_madd(h, h, &t);
+		ge_select(&t, base_table[1], idx1);
+		ge_madd(h, h, &t);
+	}
+	m_burn(&t, sizeof(t));
+}
+
 #if DROPBEAR_CURVE25519_DEP
-void dropbear_curve25519_scalarmult(u8 *q,const u8 *n,const u8 *p)
+/* Same as dropbear_curve25519_scalarmult() with p = 9, computed on the
+ * birationally equivalent Edwards curve with the comb table */
+void dropbear_curve25519_scalarmult_base(u8 *q, const u8 *n)
 {
-  u8 z[32];
-  i64 x[80],r,i;
-  gf a,b,c,d,e,f;
-  FOR(i,31) z[i]=n[i];
-  z[31]=(n[31]&127)|64;
-  z[0]&=248;
-  unpack25519(x,p);
-  FOR(i,16) {
-    b[i]=x[i];
-    d[i]=a[i]=c[i]=0;
-  }
-  a[0]=d[0]=1;
-  for(i=254;i>=0;--i) {
-    r=(z[i>>3]>>(i&7))&1;
-    sel25519(a,b,r);
-    sel25519(c,d,r);
-    A(e,a,c);
-    Z(a,a,c);
-    A(c,b,d);
-    Z(b,b,d);
-    S(d,e);
-    S(f,a);
-    M(a,c,a);
-    M(c,b,e);
-    A(e,a,c);
-    Z(a,a,c);
-    S(b,a);
-    Z(c,d,f);
-    M(a,c,_121665);
-    A(a,a,d);
-    M(c,c,a);
-    M(a,d,f);
-    M(d,b,x);
-    S(b,e);
-    sel25519(a,b,r);
-    sel25519(c,d,r);
-  }
-  FOR(i,16) {
-    x[i+16]=a[i];
-    x[i+32]=c[i];
-    x[i+48]=b[i];
-    x[i+64]=d[i];
-  }
-  inv25519(x+32,x+32);
-  M(x+16,x+16,x+32);
-  pack25519(q,x+16);
+	u8 z[32];
+	ge_p3 p;
+	fe a, b;
+
+	memcpy(z, n, 32);
+	z[31] = (n[31] & 127) | 64;
+	z[0] &= 248;
+
+	ge_scalarmult_base(&p, z);
+	/* u = (1+y)/(1-y) */
+	fe_add(a, p.Z, p.Y);
+	fe_sub(b, p.Z, p.Y);
+	fe_invert(b, b);
+	fe_mul(a, a, b);
+	fe_tobytes(q, a);
+	m_burn(z, sizeof(z));
 }
 #endif /* DROPBEAR_CURVE25519_DEP */
 
@@ -269,78 +739,26 @@ static int crypto_hash(u8 *out,const u8 *m,u64 n)
   return sha512_done(&hs, out);
 }
 
-sv add(gf p[4],gf q[4])
-{
-  gf a,b,c,d,t,e,f,g,h;
-
-  Z(a, p[1], p[0]);
-  Z(t, q[1], q[0]);
-  M(a, a, t);
-  A(b, p[0], p[1]);
-  A(t, q[0], q[1]);
-  M(b, b, t);
-  M(c, p[3], q[3]);
-  M(c, c, D2);
-  M(d, p[2], q[2]);
-  A(d, d, d);
-  Z(e, b, a);
-  Z(f, d, c);
-  A(g, d, c);
-  A(h, b, a);
-
-  M(p[0], e, f);
-  M(p[1], h, g);
-  M(p[2], g, f);
-  M(p[3], e, h);
-}
-
-sv cswap(gf p[4],gf q[4],u8 b)
-{
-  int i;
-  FOR(i,4)
-    sel25519(p[i],q[i],b);
-}
-
-sv pack(u8 *r,gf p[4])
-{
-  gf tx, ty, zi;
-  inv25519(zi, p[2]);
-  M(tx, p[0], zi);
-  M(ty, p[1], zi);
-  pack25519(r, ty);
-  r[31] ^= par25519(tx) << 7;
+static int fe_isnegative(const fe f) {
+	u8 s[32];
+	fe_tobytes(s, f);
+	return s[0] & 1;
 }
 
-sv scalarmult(gf p[4],gf q[4],const u8 *s)
-{
-  int i;
-  set25519(p[0],gf0);
-  set25519(p[1],gf1);
-  set25519(p[2],gf1);
-  set25519(p[3],gf0);
-  for (i = 255;i >= 0;--i) {
-    u8 b = (s[i/8]>>(i&7))&1;
-    cswap(p,q,b);
-    add(q,p);
-    add(p,p);
-    cswap(p,q,b);
-  }
-}
+static void ge_tobytes(u8 *s, const ge_p3 *p) {
+	fe recip, x, y;
 
-sv scalarbase(gf p[4],const u8 *s)
-{
-  gf q[4];
-  set25519(q[0],X);
-  set25519(q[1],Y);
-  set25519(q[2],gf1);
-  M(q[3],X,Y);
-  scalarmult(p,q,s);
+	fe_invert(recip, p->Z);
+	fe_mul(x, p->X, recip);
+	fe_mul(y, p->Y, recip);
+	fe_tobytes(s, y);
+	s[31] ^= fe_isnegative(x) << 7;
 }
 
 void dropbear_ed25519_make_key(u8 *pk,u8 *sk)
 {
   u8 d[64];
-  gf p[4];
+  ge_p3 p;
 
   genrandom(sk, 32);
 
@@ -349,8 +767,9 @@ void dropbear_ed25519_make_key(u8 *pk,u8 *sk)
   d[31] &= 127;
   d[31] |= 64;
 
-  scalarbase(p,d);
-  pack(pk,p);
+  ge_scalarmult_base(&p,d);
+  ge_tobytes(pk,&p);
+  m_burn(d, sizeof(d));
 }
 
 static const u64 L[32] = {0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x10};
@@ -394,7 +813,7 @@ void dropbear_ed25519_sign(const u8 *m,u32 mlen,u8 *s,u32 *slen,const u8 *sk, co
   hash_state hs;
   u8 d[64],h[64],r[64];
   i64 x[64];
-  gf p[4];
+  ge_p3 p;
   u32 i,j;
 
   crypto_hash(d, sk, 32);
@@ -409,8 +828,8 @@ void dropbear_ed25519_sign(const u8 *m,u32 mlen,u8 *s,u32 *slen,const u8 *sk, co
   sha512_process(&hs,m,mlen);
   sha512_done(&hs,r);
   reduce(r);
-  scalarbase(p,r);
-  pack(s,p);
+  ge_scalarmult_base(&p,r);
+  ge_tobytes(s,&p);
 
   sha512_init(&hs);
   sha512_process(&hs,s,32);
@@ -423,54 +842,170 @@ void dropbear_ed25519_sign(const u8 *m,u32 mlen,u8 *s,u32 *slen,const u8 *sk, co
   FOR(i,32) x[i] = (u64) r[i];
   FOR(i,32) FOR(j,32) x[i+j] += h[i] * (u64) d[j];
   modL(s + 32,x);
+
+  m_burn(d, sizeof(d));
+  m_burn(r, sizeof(r));
+  m_burn(x, sizeof(x));
 }
 
 #if DROPBEAR_SIGNKEY_VERIFY
-static int unpackneg(gf r[4],const u8 p[32])
+static int vn(const u8 *x,const u8 *y,u32 n)
 {
-  gf t, chk, num, den, den2, den4, den6;
-  set25519(r[2],gf1);
-  unpack25519(r[1],p);
-  S(num,r[1]);
-  M(den,num,D);
-  Z(num,num,r[2]);
-  A(den,r[2],den);
-
-  S(den2,den);
-  S(den4,den2);
-  M(den6,den4,den2);
-  M(t,den6,num);
-  M(t,t,den);
-
-  pow2523(t,t);
-  M(t,t,num);
-  M(t,t,den);
-  M(t,t,den);
-  M(r[0],t,den);
-
-  S(chk,r[0]);
-  M(chk,chk,den);
-  if (neq25519(chk, num)) M(r[0],r[0],I);
-
-  S(chk,r[0]);
-  M(chk,chk,den);
-  if (neq25519(chk, num)) return -1;
-
-  if (par25519(r[0]) == (p[31]>>7)) Z(r[0],gf0,r[0]);
-
-  M(r[3],r[0],r[1]);
-  return 0;
+  u32 i,d = 0;
+  FOR(i,n) d |= x[i]^y[i];
+  return (1 & ((d - 1) >> 8)) - 1;
+}
+
+static int crypto_verify_32(const u8 *x,const u8 *y)
+{
+  return vn(x,y,32);
+}
+
+static int fe_neq(const fe a, const fe b)
+{
+  u8 c[32],d[32];
+  fe_tobytes(c,a);
+  fe_tobytes(d,b);
+  return crypto_verify_32(c,d);
+}
+
+/* z^((p-5)/8) */
+static void fe_pow22523(fe out, const fe z) {
+	fe t0, t1, t2;
+
+	fe_sq(t0, z);               /* 2 */
+	fe_sqn(t1, t0, 2);          /* 8 */
+	fe_mul(t1, z, t1);          /* 9 */
+	fe_mul(t0, t0, t1);         /* 11 */
+	fe_sq(t0, t0);              /* 22 */
+	fe_mul(t0, t1, t0);         /* 2^5 - 1 */
+	fe_sqn(t1, t0, 5);
+	fe_mul(t0, t1, t0);         /* 2^10 - 1 */
+	fe_sqn(t1, t0, 10);
+	fe_mul(t1, t1, t0);         /* 2^20 - 1 */
+	fe_sqn(t2, t1, 20);
+	fe_mul(t1, t2, t1);         /* 2^40 - 1 */
+	fe_sqn(t1, t1, 10);
+	fe_mul(t0, t1, t0);         /* 2^50 - 1 */
+	fe_sqn(t1, t0, 50);
+	fe_mul(t1, t1, t0);         /* 2^100 - 1 */
+	fe_sqn(t2, t1, 100);
+	fe_mul(t1, t2, t1);         /* 2^200 - 1 */
+	fe_sqn(t1, t1, 50);
+	fe_mul(t0, t1, t0);         /* 2^250 - 1 */
+	fe_sqn(t0, t0, 2);          /* 2^252 - 4 */
+	fe_mul(out, t0, z);         /* 2^252 - 3 */
+}
+
+/* r = p + q, "add-2008-hwcd-3" with a = -1 */
+static void ge_add(ge_p3 *r, const ge_p3 *p, const ge_p3 *q) {
+	fe a, b, c, d, e, f, g, h, t;
+
+	fe_sub(a, p->Y, p->X);
+	fe_sub(t, q->Y, q->X);
+	fe_mul(a, a, t);
+	fe_add(b, p->Y, p->X);
+	fe_add(t, q->Y, q->X);
+	fe_mul(b, b, t);
+	fe_mul(c, p->T, q->T);
+	fe_mul(c, c, fe_d2);
+	fe_mul(d, p->Z, q->Z);
+	fe_add(d, d, d);
+	fe_sub(e, b, a);
+	fe_sub(f, d, c);
+	fe_add(g, d, c);
+	fe_add(h, b, a);
+	fe_mul(r->X, e, f);
+	fe_mul(r->Y, g, h);
+	fe_mul(r->T, e, h);
+	fe_mul(r->Z, f, g);
+}
+
+/* r = s*p with a 4 bit window. Variable time, only for public values */
+static void ge_scalarmult_vartime(ge_p3 *r, const ge_p3 *p, const u8 *s) {
+	ge_p3 tbl[16];
+	int i, nibble;
+
+	ge_p3_0(&tbl[0]);
+	tbl[1] = *p;
+	for (i = 2; i < 16; i++) {
+		if (i % 2 == 0) {
+			ge_dbl(&tbl[i], &tbl[i / 2]);
+		} else {
+			ge_add(&tbl[i], &tbl[i - 1], p);
+		}
+	}
+
+	ge_p3_0(r);
+	for (i = 63; i >= 0; i--) {
+		nibble = (s[i >> 1] >> (4 * (i & 1))) & 15;
+		if (i != 63) {
+			ge_dbl(r, r);
+			ge_dbl(r, r);
+			ge_dbl(r, r);
+			ge_dbl(r, r);
+		}
+		if (nibble) {
+			ge_add(r, r, &tbl[nibble]);
+		}
+	}
+}
+
+/* Decodes the negation of point p */
+static int unpackneg(ge_p3 *r,const u8 p[32])
+{
+	fe t, chk, num, den, den2, den4, den6;
+
+	fe_1(r->Z);
+	fe_frombytes(r->Y, p);
+	fe_sq(num, r->Y);
+	fe_mul(den, num, fe_d);
+	fe_sub(num, num, r->Z);
+	fe_add(den, r->Z, den);
+
+	fe_sq(den2, den);
+	fe_sq(den4, den2);
+	fe_mul(den6, den4, den2);
+	fe_mul(t, den6, num);
+	fe_mul(t, t, den);
+
+	fe_pow22523(t, t);
+	fe_mul(t, t, num);
+	fe_mul(t, t, den);
+	fe_mul(t, t, den);
+	fe_mul(r->X, t, den);
+
+	fe_sq(chk, r->X);
+	fe_mul(chk, chk, den);
+	if (fe_neq(chk, num)) {
+		fe_mul(r->X, r->X, fe_sqrtm1);
+	}
+
+	fe_sq(chk, r->X);
+	fe_mul(chk, chk, den);
+	if (fe_neq(chk, num)) {
+		return -1;
+	}
+
+	if (fe_isnegative(r->X) == (p[31] >> 7)) {
+		fe_0(t);
+		fe_sub(r->X, t, r->X);
+	}
+
+	fe_mul(r->T, r->X, r->Y);
+	return 0;
 }
 
 int dropbear_ed25519_verify(const u8 *m,u32 mlen,const u8 *s,u32 slen,const u8 *pk)
 {
   hash_state hs;
   u8 t[32],h[64];
-  gf p[4],q[4];
+  ge_p3 p,q;
 
   if (slen < 64) return -1;
 
-  if (unpackneg(q,pk)) return -1;
+  curve25519_init();
+  if (unpackneg(&q,pk)) return -1;
 
   sha512_init(&hs);
   sha512_process(&hs,s,32);
@@ -479,11 +1014,11 @@ int dropbear_ed25519_verify(const u8 *m,u32 mlen,const u8 *s,u32 slen,const u8 *
   sha512_done(&hs,h);
 
   reduce(h);
-  scalarmult(p,q,h);
+  ge_scalarmult_vartime(&p,&q,h);
 
-  scalarbase(q,s + 32);
-  add(p,q);
-  pack(t,p);
+  ge_scalarmult_base(&q,s + 32);
+  ge_add(&p,&p,&q);
+  ge_tobytes(t,&p);
 
   if (crypto_verify_32(s, t))
     return -1;
@@ -28,26 +28,50 @@
 #include "bignum.h"
 #include "dbrandom.h"
 #include "runopts.h"
+#include "chacha-accel.h"
 
-/* this is used to generate unique output from the same hashpool */
-static uint32_t counter = 0;
-/* the max value for the counter, so it won't integer overflow */
-#define MAX_COUNTER (1<<30)
+#include <sys/mman.h>
 
 static unsigned char hashpool[SHA256_HASH_SIZE] = {0};
 static int donerandinit = 0;
 
 #define INIT_SEED_SIZE 32 /* 256 bits */
 
+#define DRBG_KEY_LEN 32
+/* Keystream generated at a time for small requests, larger requests are
+ * generated directly. A multiple of the 64 byte ChaCha20 block */
+#define DRBG_BUF_LEN 1024
+/* Fresh entropy is added after this much output */
+#define DRBG_RESEED_BYTES (1UL<<30)
+
 /* The basic setup is we read some data from /dev/(u)random or prngd and hash it
- * into hashpool. To read data, we hash together current hashpool contents,
- * and a counter. We feed more data in by hashing the current pool and new
+ * into hashpool. We feed more data in by hashing the current pool and new
  * data into the pool.
  *
- * It is important to ensure that counter doesn't wrap around before we
- * feed in new entropy.
+ * Output comes from a ChaCha20 generator keyed from the hashpool each time
+ * it changes. It uses "fast key erasure": each use of the key begins by
+ * generating the next key, which overwrites it, so that output already
+ * given out can't be recovered from the state later. Unused keystream is
+ * buffered for small requests and erased as it is used.
  *
+ * The state is in memory that is zeroed in a forked child where the
+ * platform supports it (otherwise the pid is checked), so that a child
+ * reseeds instead of repeating its parent's output.
  */
+struct drbg_state {
+	unsigned char key[DRBG_KEY_LEN];
+	unsigned char buf[DRBG_BUF_LEN];
+	unsigned int pos; /* next unused byte of buf */
+	unsigned long outcount; /* output since fresh entropy was added */
+	pid_t pid;
+	int keyed;
+};
+
+static struct drbg_state drbg_static;
+static struct drbg_state *drbg = NULL;
+static int drbg_wipeonfork = 0;
+
+static void reseed_fresh(void);
 
 /* Pass wantlen=0 to hash an entire file */
 static int
@@ -109,6 +133,85 @@ out:
 	return ret;
 }
 
+static void drbg_alloc(void) {
+#if defined(MADV_WIPEONFORK) && defined(MAP_ANONYMOUS)
+	void *p;
+#endif
+
+	if (drbg) {
+		return;
+	}
+
+#if defined(MADV_WIPEONFORK) && defined(MAP_ANONYMOUS)
+	p = mmap(NULL, sizeof(struct drbg_state), PROT_READ|PROT_WRITE,
+			MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+	if (p != MAP_FAILED) {
+		if (madvise(p, sizeof(struct drbg_state), MADV_WIPEONFORK) == 0) {
+			drbg = p;
+			drbg_wipeonfork = 1;
+			return;
+		}
+		munmap(p, sizeof(struct drbg_state));
+	}
+#endif
+	drbg = &drbg_static;
+}
+
+/* Whether this is a forked child using its parent's state */
+static int drbg_forked(void) {
+	if (drbg_wipeonfork) {
+		return !drbg->keyed;
+	}
+	return drbg->pid != getpid();
+}
+
+/* Keys the generator from the hashpool, mixed with its previous key.
+ * Buffered output is discarded */
+static void drbg_rekey(void) {
+	hash_state hs;
+
+	drbg_alloc();
+
+	sha256_init(&hs);
+	sha256_process(&hs, (void*)hashpool, sizeof(hashpool));
+	sha256_process(&hs, drbg->key, sizeof(drbg->key));
+	sha256_done(&hs, drbg->key);
+
+	m_burn(drbg->buf, sizeof(drbg->buf));
+	drbg->pos = sizeof(drbg->buf);
+	drbg->pid = getpid();
+	drbg->keyed = 1;
+}
+
+/* Fills out with ChaCha20 keystream, after replacing the key with the
+ * start of it */
+static void drbg_generate(unsigned char *out, unsigned long len) {
+	static const unsigned char zero_iv[8] = {0};
+	unsigned char block[64];
+	chacha_state st;
+	unsigned long done = 0;
+
+	if (chacha_setup(&st, drbg->key, sizeof(drbg->key), 20) != CRYPT_OK
+		|| chacha_ivctr64(&st, zero_iv, sizeof(zero_iv), 0) != CRYPT_OK
+		|| chacha_keystream(&st, block, sizeof(block)) != CRYPT_OK) {
+		dropbear_exit("Error generating random");
+	}
+	memcpy(drbg->key, block, sizeof(drbg->key));
+	m_burn(block, sizeof(block));
+
+#if DROPBEAR_CHACHA_ACCEL
+	/* keystream is the encryption of zeroes */
+	memset(out, 0x0, len);
+	done = chacha_accel_crypt(&st, out, out, len);
+#endif
+	if (done < len && chacha_keystream(&st, out + done, len - done) != CRYPT_OK) {
+		dropbear_exit("Error generating random");
+	}
+	m_burn(&st, sizeof(st));
+
+	drbg->outcount += len;
+}
+
 void addrandom(const unsigned char * buf, unsigned int len)
 {
 	hash_state hs;
@@ -127,6 +230,14 @@ void addrandom(const unsigned char * buf, unsigned int len)
 	/* new */
 	sha256_process(&hs, buf, len);
 	sha256_done(&hs, hashpool);
+
+	if (donerandinit) {
+		if (drbg_forked()) {
+			reseed_fresh();
+		} else {
+			drbg_rekey();
+		}
+	}
 }
 
 static void write_urandom()
@@ -149,6 +260,25 @@ static void write_urandom()
 #endif
 }
 
+#if DROPBEAR_BENCH
+/* Replaces the random state with one that depends only on seed, so the
+ * output that follows can be reproduced by calling it again. For the
+ * benchmarks' self checks, seedrandom() afterwards mixes fresh entropy
+ * back in */
+void seedrandom_fixed(const unsigned char* seed, unsigned int len) {
+	hash_state hs;
+
+	sha256_init(&hs);
+	sha256_process(&hs, seed, len);
+	sha256_done(&hs, hashpool);
+	drbg_alloc();
+	memset(drbg->key, 0x0, sizeof(drbg->key));
+	drbg_rekey();
+	drbg->outcount = 0;
+	donerandinit = 1;
+}
+#endif
+
 #if DROPBEAR_FUZZ
 void fuzz_seed(const unsigned char* dat, unsigned int len) {
 	hash_state hs;
@@ -156,7 +286,9 @@ void fuzz_seed(const unsigned char* dat, unsigned int len) {
 	sha256_process(&hs, "fuzzfuzzfuzz", strlen("fuzzfuzzfuzz"));
 	sha256_process(&hs, dat, len);
 	sha256_done(&hs, hashpool);
-	counter = 0;
+	drbg_alloc();
+	memset(drbg->key, 0x0, sizeof(drbg->key));
+	drbg_rekey();
 	donerandinit = 1;
 }
 #endif
@@ -218,6 +350,41 @@ static int process_getrandom(hash_state *hs) {
 }
 #endif /* HAVE_GETRANDOM */
 
+/* Mixes new entropy into the hashpool and rekeys, without the slower
+ * extra sources that seedrandom() reads. Used after a fork or when
+ * much output has been generated */
+static void reseed_fresh() {
+	hash_state hs;
+	pid_t pid;
+	int seeded = 0;
+
+	sha256_init(&hs);
+	sha256_process(&hs, (void*)hashpool, sizeof(hashpool));
+
+	pid = getpid();
+	sha256_process(&hs, (void*)&pid, sizeof(pid));
+
+#ifdef HAVE_GETRANDOM
+	if (process_getrandom(&hs) == DROPBEAR_SUCCESS) {
+		seeded = 1;
+	}
+#endif
+	if (!seeded) {
+#if DROPBEAR_USE_PRNGD
+		seeded = process_file(&hs, DROPBEAR_PRNGD_SOCKET, INIT_SEED_SIZE, 1);
+#else
+		seeded = process_file(&hs, DROPBEAR_URANDOM_DEV, INIT_SEED_SIZE, 0);
+#endif
+		if (seeded != DROPBEAR_SUCCESS) {
+			dropbear_exit("Failure reseeding random");
+		}
+	}
+
+	sha256_done(&hs, hashpool);
+	drbg_rekey();
+	drbg->outcount = 0;
+}
+
 /* Initialise the prng from /dev/urandom or prngd. This function can
  * be called multiple times */
 void seedrandom() {
@@ -301,7 +468,8 @@ void seedrandom() {
 
 	sha256_done(&hs, hashpool);
 
-	counter = 0;
+	drbg_rekey();
+	drbg->outcount = 0;
 	donerandinit = 1;
 
 	/* Feed it all back into /dev/urandom - this might help if Dropbear
@@ -312,31 +480,39 @@ void seedrandom() {
 /* return len bytes of pseudo-random data */
 void genrandom(unsigned char* buf, unsigned int len) {
 
-	hash_state hs;
-	unsigned char hash[SHA256_HASH_SIZE];
 	unsigned int copylen;
 
 	if (!donerandinit) {
 		dropbear_exit("seedrandom not done");
 	}
 
-	while (len > 0) {
-		sha256_init(&hs);
-		sha256_process(&hs, (void*)hashpool, sizeof(hashpool));
-		sha256_process(&hs, (void*)&counter, sizeof(counter));
-		sha256_done(&hs, hash);
-
-		counter++;
-		if (counter > MAX_COUNTER) {
-			seedrandom();
+#if DROPBEAR_FUZZ
+	if (!fuzz.fuzzing)
+#endif
+	{
+		if (drbg_forked() || drbg->outcount >= DRBG_RESEED_BYTES) {
+			reseed_fresh();
 		}
+	}
 
-		copylen = MIN(len, SHA256_HASH_SIZE);
-		memcpy(buf, hash, copylen);
+	if (len > DRBG_BUF_LEN / 2) {
+		/* large requests such as key generation don't go through buf */
+		drbg_generate(buf, len);
+		return;
+	}
+
+	while (len > 0) {
+		if (drbg->pos == DRBG_BUF_LEN) {
+			drbg_generate(drbg->buf, DRBG_BUF_LEN);
+			drbg->pos = 0;
+		}
+		copylen = MIN(len, DRBG_BUF_LEN - drbg->pos);
+		memcpy(buf, &drbg->buf[drbg->pos], copylen);
+		m_burn(&drbg->buf[drbg->pos], copylen);
+		drbg->pos += copylen;
 		len -= copylen;
 		buf += copylen;
 	}
-	m_burn(hash, sizeof(hash));
 }
 
 /* Generates a random mp_int.
@@ -31,5 +31,8 @@ void seedrandom(void);
 void genrandom(unsigned char* buf, unsigned int len);
 void addrandom(const unsigned char * buf, unsigned int len);
 void gen_random_mpint(const mp_int *max, mp_int *rand);
+#if DROPBEAR_BENCH
+void seedrandom_fixed(const unsigned char* seed, unsigned int len);
+#endif
 
 #endif /* DROPBEAR_RANDOM_H_ */
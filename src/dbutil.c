@@ -66,6 +66,7 @@
 #include "buffer.h"
 #include "session.h"
 #include "atomicio.h"
+#include "eventloop.h"
 
 #define MAX_FMT 100
 
@@ -569,6 +570,8 @@ void m_close(int fd) {
 		return;
 	}
 
+	evloop_forget(fd);
+
 	do {
 		val = close(fd);
 	} while (val < 0 && errno == EINTR);
@@ -48,6 +48,11 @@ IMPORTANT: Some options will require "make clean" after changes */
    This option is ignored on non-Linux platforms at present */
 #define DROPBEAR_REEXEC 1
 
+/* Use epoll() rather than select() for the session main loop. This scales
+   better with many channels or forwarded connections.
+   This option is ignored on non-Linux platforms */
+#define DROPBEAR_EPOLL 1
+
 /* Include verbose debug output, enabled with -v at runtime (repeat to increase).
  * define which level of debug output you compile in
  * Level 0 = disabled
@@ -122,6 +127,14 @@ IMPORTANT: Some options will require "make clean" after changes */
  * Compiling in will add ~6kB to binary size on x86-64 */
 #define DROPBEAR_ENABLE_GCM_MODE 0
 
+/* Use the CPU's AES instructions (x86 AES-NI and PCLMULQDQ, or the ARMv8
+ * crypto extensions) for AES and GCM, SIMD (SSE2, AVX2 or NEON) for
+ * ChaCha20 and sntrup761, and SHA instructions (SHA-NI or ARMv8 SHA2) for
+ * SHA-256, when they are detected at runtime.
+ * This is several times faster than the portable code and avoids its
+ * table lookups. Adds ~16kB on x86-64 */
+#define DROPBEAR_CRYPTO_ACCEL 1
+
 /* Message integrity. sha2-256 is recommended as a default,
    sha1 for compatibility */
 #define DROPBEAR_SHA1_HMAC 0
@@ -151,6 +164,11 @@ IMPORTANT: Some options will require "make clean" after changes */
  * on x86-64.
  * See: ECDSA_PRIV_FILENAME  */
 #define DROPBEAR_ECDSA 1
+/* Use dedicated constant time code for nistp256 and nistp384 point
+ * multiplication, in ECDH and ECDSA, rather than libtomcrypt's generic
+ * code. It is several times faster, with precomputed tables for the base
+ * point. Adds ~40kB on x86-64 */
+#define DROPBEAR_NISTP_FAST 1
 
 /* Ed25519 is faster than ECDSA. Compiling in Ed25519 code increases
  * binary size - around 7,5kB on x86-64.
@@ -252,6 +270,11 @@ group1 in Dropbear server too */
  * authorized_keys file into account */
 #define DROPBEAR_SVR_PUBKEY_OPTIONS 1
 
+/* Index authorized_keys by key for the session, so that checking each key a
+ * client offers doesn't decode every line of the file again. Worthwhile with
+ * large authorized_keys files, costs memory the size of the file. */
+#define DROPBEAR_SVR_PUBKEY_INDEX 1
+
 /* Set this to 0 if your system does not have multiple user support.
    (Linux kernel CONFIG_MULTIUSER option)
    The resulting binary will not run on a normal system. */
@@ -299,6 +322,20 @@ group1 in Dropbear server too */
  * come from many IPs */
 #define MAX_UNAUTH_CLIENTS 30
 
+/* Number of server processes started ahead of time to wait for new
+ * connections. A waiting process has already re-executed itself, loaded
+ * hostkeys and seeded its random generator, so new connections start with
+ * less latency. Each process still handles only one connection.
+ * The -N server option overrides, 0 disables */
+#define DEFAULT_PREFORK_WORKERS 0
+
+/* Number of processes accepting connections. With more than one, each
+ * listens on its own sockets using SO_REUSEPORT where the platform has
+ * it, so that the kernel spreads new connections across them, otherwise
+ * they share sockets. Unauthenticated connection limits above apply to
+ * each process. The -L server option overrides */
+#define DEFAULT_LISTENERS 1
+
 /* Default maximum number of failed authentication tries (server option) */
 /* -T server option overrides */
 #define MAX_AUTH_TRIES 10
@@ -315,6 +352,13 @@ group1 in Dropbear server too */
  */
 #define DROPBEAR_PIDFILE "/var/run/dropbear.pid"
 
+/* Keep counters and latency histograms (key exchange and auth times,
+ * packet encryption times, bytes sent etc) for each session. The listening
+ * server adds up its sessions' metrics, and writes them to
+ * DROPBEAR_METRICS_FILE when sent SIGUSR1 */
+#define DROPBEAR_METRICS 1
+#define DROPBEAR_METRICS_FILE "/var/run/dropbear.metrics"
+
 /* The command to invoke for xauth when using X11 forwarding.
  * "-q" for quiet */
 #define XAUTH_COMMAND "/usr/bin/xauth -q"
@@ -345,12 +389,18 @@ group1 in Dropbear server too */
    chosen for a 100mbit ethernet network. The value can be altered at
    runtime with the -W argument. */
 #define DEFAULT_RECV_WINDOW 24576
+/* Channel receive windows grow from the -W size while the data received
+   per round trip approaches the window, so long fast links aren't limited
+   by it. This is the largest size a window grows to, each channel using a
+   receive buffer of that size once it has. 0 keeps windows at the -W size. */
+#define RECV_WINDOW_AUTOTUNE_MAX (8*1024*1024)
 /* Maximum size of a received SSH data packet - this _MUST_ be >= 32768
    in order to interoperate with other implementations */
 #define RECV_MAX_PAYLOAD_LEN 32768
-/* Maximum size of a transmitted data packet - this can be any value,
-   though increasing it may not make a significant difference. */
-#define TRANS_MAX_PAYLOAD_LEN 16384
+/* Maximum size of a transmitted data packet. Channel data is sent in
+   packets up to the smaller of this and the peer's maximum packet size,
+   32768 is the largest every implementation must accept. */
+#define TRANS_MAX_PAYLOAD_LEN 32768
 
 /* Ensure that data is transmitted every KEEPALIVE seconds. This can
 be overridden at runtime with -K. 0 disables keepalives */
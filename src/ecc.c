@@ -2,6 +2,9 @@
 #include "ecc.h"
 #include "dbutil.h"
 #include "bignum.h"
+#include "dbrandom.h"
+#include "crypto_desc.h"
+#include "nistp.h"
 
 #if DROPBEAR_ECC
 
@@ -210,6 +213,78 @@ ecc_key * buf_get_ecc_raw_pubkey(buffer *buf, const struct dropbear_ecc_curve *c
 
 }
 
+/* As libtomcrypt's ecc_make_key_ex(), with the nistp code for the curves
+   it handles. Returns a CRYPT_ error code */
+int dropbear_ecc_make_key(ecc_key *key, const ltc_ecc_set_type *dp) {
+#if DROPBEAR_NISTP
+	const struct nistp_curve *nc = nistp_curve_for_size(dp->size);
+	unsigned char k[NISTP_MAX_BYTES], point[2*NISTP_MAX_BYTES];
+	void *order = NULL;
+	int err = CRYPT_ERROR;
+
+	if (nc == NULL) {
+		return ecc_make_key_ex(NULL, dropbear_ltc_prng, key, dp);
+	}
+
+	if (ltc_init_multi(&key->pubkey.x, &key->pubkey.y, &key->pubkey.z,
+			&key->k, &order, NULL) != CRYPT_OK) {
+		return CRYPT_MEM;
+	}
+	if (mp_read_radix(order, dp->order, 16) != MP_OKAY) {
+		goto out;
+	}
+
+	/* 0 < k < n, so k*G isn't the point at infinity */
+	gen_random_mpint(order, key->k);
+	mp_to_fixed_bytes(key->k, k, dp->size);
+	if (nistp_mul_base(nc, k, point) != DROPBEAR_SUCCESS) {
+		goto out;
+	}
+	bytes_to_mp(key->pubkey.x, point, dp->size);
+	bytes_to_mp(key->pubkey.y, &point[dp->size], dp->size);
+	mp_set(key->pubkey.z, 1);
+
+	key->type = PK_PRIVATE;
+	key->idx = -1;
+	key->dp = dp;
+	err = CRYPT_OK;
+
+out:
+	m_burn(k, sizeof(k));
+	ltc_deinit_multi(order, NULL);
+	if (err != CRYPT_OK) {
+		ltc_deinit_multi(key->pubkey.x, key->pubkey.y, key->pubkey.z, key->k, NULL);
+	}
+	return err;
+#else
+	return ecc_make_key_ex(NULL, dropbear_ltc_prng, key, dp);
+#endif
+}
+
+#if DROPBEAR_NISTP
+static mp_int * nistp_shared_secret(const struct nistp_curve *nc,
+		const ecc_key *public_key, const ecc_key *private_key) {
+	unsigned char k[NISTP_MAX_BYTES], point[2*NISTP_MAX_BYTES];
+	unsigned char out[2*NISTP_MAX_BYTES];
+	const unsigned int size = private_key->dp->size;
+	mp_int *shared_secret = NULL;
+
+	/* the public key has been checked to be on the curve */
+	mp_to_fixed_bytes(private_key->k, k, size);
+	mp_to_fixed_bytes(public_key->pubkey.x, point, size);
+	mp_to_fixed_bytes(public_key->pubkey.y, &point[size], size);
+	if (nistp_mul(nc, k, point, out) == DROPBEAR_SUCCESS) {
+		shared_secret = m_malloc(sizeof(*shared_secret));
+		m_mp_init(shared_secret);
+		bytes_to_mp(shared_secret, out, size);
+	}
+
+	m_burn(k, sizeof(k));
+	m_burn(out, sizeof(out));
+	return shared_secret;
+}
+#endif
+
 /* a modified version of libtomcrypt's "ecc_shared_secret" to output
    a mp_int instead. */
 mp_int * dropbear_ecc_shared_secret(ecc_key *public_key, const ecc_key *private_key)
@@ -217,6 +292,9 @@ mp_int * dropbear_ecc_shared_secret(ecc_key *public_key, const ecc_key *private_
 	ecc_point *result = NULL;
 	mp_int *prime = NULL, *shared_secret = NULL;
 	int err = DROPBEAR_FAILURE;
+#if DROPBEAR_NISTP
+	const struct nistp_curve *nc = NULL;
+#endif
 
    /* type valid? */
 	if (private_key->type != PK_PRIVATE) {
@@ -227,6 +305,17 @@ mp_int * dropbear_ecc_shared_secret(ecc_key *public_key, const ecc_key *private_
 		goto out;
 	}
 
+#if DROPBEAR_NISTP
+	nc = nistp_curve_for_size(private_key->dp->size);
+	if (nc) {
+		shared_secret = nistp_shared_secret(nc, public_key, private_key);
+		if (shared_secret) {
+			err = DROPBEAR_SUCCESS;
+		}
+		goto out;
+	}
+#endif
+
    /* make new point */
 	result = ltc_ecc_new_point();
 	if (result == NULL) {
@@ -4,6 +4,8 @@
 #include "ecc.h"
 #include "ecdsa.h"
 #include "signkey.h"
+#include "bignum.h"
+#include "nistp.h"
 
 #if DROPBEAR_ECDSA
 
@@ -68,7 +70,7 @@ ecc_key *gen_ecdsa_priv_key(unsigned int bit_size) {
 	}
 
 	new_key = m_malloc(sizeof(*new_key));
-	if (ecc_make_key_ex(NULL, dropbear_ltc_prng, new_key, dp) != CRYPT_OK) {
+	if (dropbear_ecc_make_key(new_key, dp) != CRYPT_OK) {
 		dropbear_exit("ECC error");
 	}
 	return new_key;
@@ -191,7 +193,7 @@ void buf_put_ecdsa_sign(buffer *buf, const ecc_key *key, const buffer *data_buf)
 
 	for (;;) {
 		ecc_key R_key; /* ephemeral key */
-		if (ecc_make_key_ex(NULL, dropbear_ltc_prng, &R_key, key->dp) != CRYPT_OK) {
+		if (dropbear_ecc_make_key(&R_key, key->dp) != CRYPT_OK) {
 			goto out;
 		}
 		if (ltc_mp.mpdiv(R_key.pubkey.x, p, NULL, r) != CRYPT_OK) {
@@ -278,6 +280,95 @@ out:
 }
 
 
+#if DROPBEAR_NISTP
+static int ecdsa_mul2_nistp(const struct nistp_curve *nc, const ecc_key *key,
+		void *u1, void *u2, void *out_x) {
+	unsigned char u1_bytes[NISTP_MAX_BYTES], u2_bytes[NISTP_MAX_BYTES];
+	unsigned char point[2*NISTP_MAX_BYTES], x[NISTP_MAX_BYTES];
+	const unsigned int size = key->dp->size;
+
+	mp_to_fixed_bytes(u1, u1_bytes, size);
+	mp_to_fixed_bytes(u2, u2_bytes, size);
+	mp_to_fixed_bytes(key->pubkey.x, point, size);
+	mp_to_fixed_bytes(key->pubkey.y, &point[size], size);
+	if (nistp_mul2(nc, u1_bytes, u2_bytes, point, x) != DROPBEAR_SUCCESS) {
+		return DROPBEAR_FAILURE;
+	}
+	bytes_to_mp(out_x, x, size);
+	return DROPBEAR_SUCCESS;
+}
+#endif
+
+/* mG = u1*G + u2*Q, with mG's x coordinate affine.
+   m is the curve's modulus */
+static int ecdsa_mul2(const ecc_key *key, void *u1, void *u2, void *m,
+		ecc_point *mG, ecc_point *mQ) {
+	int ret = DROPBEAR_FAILURE;
+	void *mp = NULL;
+#if DROPBEAR_NISTP
+	const struct nistp_curve *nc = nistp_curve_for_size(key->dp->size);
+
+	if (nc) {
+		return ecdsa_mul2_nistp(nc, key, u1, u2, mG->x);
+	}
+#endif
+
+   /* find mG and mQ */
+	if (ltc_mp.read_radix(mG->x, (char *)key->dp->Gx, 16) != CRYPT_OK) {
+		goto out;
+	}
+	if (ltc_mp.read_radix(mG->y, (char *)key->dp->Gy, 16) != CRYPT_OK) {
+		goto out;
+	}
+	if (ltc_mp.set_int(mG->z, 1) != CRYPT_OK) {
+		goto out;
+	}
+
+	if (ltc_mp.copy(key->pubkey.x, mQ->x) != CRYPT_OK
+		|| ltc_mp.copy(key->pubkey.y, mQ->y) != CRYPT_OK
+		|| ltc_mp.copy(key->pubkey.z, mQ->z) != CRYPT_OK) {
+		goto out;
+	}
+
+   /* compute u1*mG + u2*mQ = mG */
+	if (ltc_mp.ecc_mul2add == NULL) {
+		if (ltc_mp.ecc_ptmul(u1, mG, mG, m, 0) != CRYPT_OK) {
+			goto out;
+		}
+		if (ltc_mp.ecc_ptmul(u2, mQ, mQ, m, 0) != CRYPT_OK) {
+			goto out;
+		}
+
+		/* find the montgomery mp */
+		if (ltc_mp.montgomery_setup(m, &mp) != CRYPT_OK) {
+			goto out;
+		}
+
+		/* add them */
+		if (ltc_mp.ecc_ptadd(mQ, mG, mG, m, mp) != CRYPT_OK) {
+			goto out;
+		}
+
+		/* reduce */
+		if (ltc_mp.ecc_map(mG, m, mp) != CRYPT_OK) {
+			goto out;
+		}
+	} else {
+		/* use Shamir's trick to compute u1*mG + u2*mQ using half of the doubles */
+		if (ltc_mp.ecc_mul2add(mG, u1, mQ, u2, mG, m) != CRYPT_OK) {
+			goto out;
+		}
+	}
+
+	ret = DROPBEAR_SUCCESS;
+
+out:
+	if (mp != NULL) {
+		ltc_mp.montgomery_deinit(mp);
+	}
+	return ret;
+}
+
 int buf_ecdsa_verify(buffer *buf, const ecc_key *key, const buffer *data_buf) {
 	/* Based on libtomcrypt's ecc_verify_hash but without the asn1 */
 	int ret = DROPBEAR_FAILURE;
@@ -287,7 +378,6 @@ int buf_ecdsa_verify(buffer *buf, const ecc_key *key, const buffer *data_buf) {
 	ecc_point *mG = NULL, *mQ = NULL;
 	void *r = NULL, *s = NULL, *v = NULL, *w = NULL, *u1 = NULL, *u2 = NULL,
 		*e = NULL, *p = NULL, *m = NULL;
-	void *mp = NULL;
 
 	/* verify
 	 *
@@ -355,53 +445,10 @@ int buf_ecdsa_verify(buffer *buf, const ecc_key *key, const buffer *data_buf) {
 		goto out;
 	}
 
-   /* find mG and mQ */
-	if (ltc_mp.read_radix(mG->x, (char *)key->dp->Gx, 16) != CRYPT_OK) {
-		goto out;
-	}
-	if (ltc_mp.read_radix(mG->y, (char *)key->dp->Gy, 16) != CRYPT_OK) {
-		goto out;
-	}
-	if (ltc_mp.set_int(mG->z, 1) != CRYPT_OK) {
-		goto out;
-	}
-
-	if (ltc_mp.copy(key->pubkey.x, mQ->x) != CRYPT_OK
-		|| ltc_mp.copy(key->pubkey.y, mQ->y) != CRYPT_OK
-		|| ltc_mp.copy(key->pubkey.z, mQ->z) != CRYPT_OK) {
+	if (ecdsa_mul2(key, u1, u2, m, mG, mQ) != DROPBEAR_SUCCESS) {
 		goto out;
 	}
 
-   /* compute u1*mG + u2*mQ = mG */
-	if (ltc_mp.ecc_mul2add == NULL) {
-		if (ltc_mp.ecc_ptmul(u1, mG, mG, m, 0) != CRYPT_OK) {
-			goto out;
-		}
-		if (ltc_mp.ecc_ptmul(u2, mQ, mQ, m, 0) != CRYPT_OK) {
-			goto out;
-		}
-
-		/* find the montgomery mp */
-		if (ltc_mp.montgomery_setup(m, &mp) != CRYPT_OK) {
-			goto out;
-		}
-
-		/* add them */
-		if (ltc_mp.ecc_ptadd(mQ, mG, mG, m, mp) != CRYPT_OK) {
-			goto out;
-		}
-
-		/* reduce */
-		if (ltc_mp.ecc_map(mG, m, mp) != CRYPT_OK) {
-			goto out;
-		}
-	} else {
-		/* use Shamir's trick to compute u1*mG + u2*mQ using half of the doubles */
-		if (ltc_mp.ecc_mul2add(mG, u1, mQ, u2, mG, m) != CRYPT_OK) {
-			goto out;
-		}
-	}
-
    /* v = X_x1 mod n */
 	if (ltc_mp.mpdiv(mG->x, p, NULL, v) != CRYPT_OK) {
 		goto out;
@@ -416,9 +463,6 @@ out:
 	ltc_ecc_del_point(mG);
 	ltc_ecc_del_point(mQ);
 	ltc_deinit_multi(r, s, v, w, u1, u2, p, e, m, NULL);
-	if (mp != NULL) {
-		ltc_mp.montgomery_deinit(mp);
-	}
 	return ret;
 }
 
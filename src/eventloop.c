@@ -0,0 +1,456 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "eventloop.h"
+
+#if DROPBEAR_DO_EPOLL
+#include <sys/epoll.h>
+#endif
+
+#define EVLOOP_INIT_SIZE 16
+
+struct evloop_fd {
+	unsigned int gen; /* iteration that "want" was last set, 0 for none */
+	unsigned char want; /* interest for this iteration */
+	unsigned char ready; /* result of the last wait */
+	unsigned char registered; /* interest currently held by epoll */
+	unsigned char nopoll; /* epoll refused it (eg a regular file), treat
+							 as always ready like select() does */
+	unsigned char listed; /* present in evloop.reg */
+	unsigned char kind;
+	unsigned int index;
+};
+
+static struct {
+	int initialised;
+	pid_t pid; /* forked children mustn't alter the parent's epoll set */
+	unsigned int gen;
+	long wake_ms; /* from evloop_wake_within(), -1 for none */
+
+	/* indexed by fd */
+	struct evloop_fd *fds;
+	unsigned int fdsize;
+
+	/* fds wanted this iteration */
+	int *wanted;
+	unsigned int nwanted, wantedsize;
+
+	/* fds ready from the last wait */
+	int *ready;
+	unsigned int nready, readysize;
+
+#if DROPBEAR_DO_EPOLL
+	int epfd;
+	/* fds registered with epoll (or nopoll) */
+	int *reg;
+	unsigned int nreg, regsize;
+	struct epoll_event *events;
+	unsigned int eventsize;
+#endif
+} evloop;
+
+static void grow_int_array(int **arr, unsigned int *size, unsigned int need) {
+	if (need <= *size) {
+		return;
+	}
+	*size = MAX(need, *size * 2);
+	*arr = m_realloc(*arr, *size * sizeof(int));
+}
+
+static struct evloop_fd* get_fd(int fd) {
+	dropbear_assert(fd >= 0);
+	if ((unsigned int)fd >= evloop.fdsize) {
+		unsigned int newsize = MAX((unsigned int)fd + 1, evloop.fdsize * 2);
+		evloop.fds = m_realloc(evloop.fds, newsize * sizeof(struct evloop_fd));
+		memset(&evloop.fds[evloop.fdsize], 0x0,
+			(newsize - evloop.fdsize) * sizeof(struct evloop_fd));
+		evloop.fdsize = newsize;
+	}
+	return &evloop.fds[fd];
+}
+
+void evloop_init() {
+	if (evloop.initialised) {
+		return;
+	}
+	memset(&evloop, 0x0, sizeof(evloop));
+	evloop.pid = getpid();
+	evloop.gen = 1;
+	evloop.fdsize = EVLOOP_INIT_SIZE;
+	evloop.fds = m_malloc(evloop.fdsize * sizeof(struct evloop_fd));
+	evloop.wantedsize = EVLOOP_INIT_SIZE;
+	evloop.wanted = m_malloc(evloop.wantedsize * sizeof(int));
+	evloop.readysize = EVLOOP_INIT_SIZE;
+	evloop.ready = m_malloc(evloop.readysize * sizeof(int));
+
+#if DROPBEAR_DO_EPOLL
+	evloop.regsize = EVLOOP_INIT_SIZE;
+	evloop.reg = m_malloc(evloop.regsize * sizeof(int));
+	evloop.eventsize = EVLOOP_INIT_SIZE;
+	evloop.events = m_malloc(evloop.eventsize * sizeof(struct epoll_event));
+	evloop.epfd = epoll_create1(EPOLL_CLOEXEC);
+	if (evloop.epfd < 0) {
+		TRACE(("epoll_create1 failed, using select: %s", strerror(errno)))
+	}
+#endif
+	evloop.initialised = 1;
+	TRACE(("evloop_init: %s", evloop_backend_name()))
+}
+
+void evloop_cleanup() {
+	if (!evloop.initialised) {
+		return;
+	}
+	/* Mark as uninitialised first since m_close() calls evloop_forget() */
+	evloop.initialised = 0;
+#if DROPBEAR_DO_EPOLL
+	m_close(evloop.epfd);
+	m_free(evloop.reg);
+	m_free(evloop.events);
+#endif
+	m_free(evloop.fds);
+	m_free(evloop.wanted);
+	m_free(evloop.ready);
+	memset(&evloop, 0x0, sizeof(evloop));
+}
+
+const char* evloop_backend_name() {
+#if DROPBEAR_DO_EPOLL
+	if (evloop.epfd >= 0) {
+		return "epoll";
+	}
+#endif
+	return "select";
+}
+
+void evloop_begin() {
+	unsigned int i;
+
+	for (i = 0; i < evloop.nready; i++) {
+		evloop.fds[evloop.ready[i]].ready = 0;
+	}
+	evloop.nready = 0;
+	evloop.nwanted = 0;
+	evloop.wake_ms = -1;
+	evloop.gen++;
+	if (evloop.gen == 0) {
+		/* wrapped, 0 is reserved for "not wanted" */
+		for (i = 0; i < evloop.fdsize; i++) {
+			evloop.fds[i].gen = 0;
+		}
+		evloop.gen = 1;
+	}
+}
+
+void evloop_wake_within(long msec) {
+	msec = MAX(msec, 0);
+	if (evloop.wake_ms < 0 || msec < evloop.wake_ms) {
+		evloop.wake_ms = msec;
+	}
+}
+
+/* The wait timeout in milliseconds, for a timeout in seconds */
+static long wait_timeout_ms(long timeout) {
+	long timeout_ms;
+
+	if (timeout > INT_MAX / 1000) {
+		timeout_ms = INT_MAX;
+	} else {
+		timeout_ms = timeout * 1000;
+	}
+	if (evloop.wake_ms >= 0) {
+		timeout_ms = MIN(timeout_ms, evloop.wake_ms);
+	}
+	return timeout_ms;
+}
+
+void evloop_want(int fd, int events, enum evloop_kind kind, unsigned int index) {
+	struct evloop_fd *e = NULL;
+
+	if (fd < 0 || events == 0) {
+		return;
+	}
+	e = get_fd(fd);
+	if (e->gen != evloop.gen) {
+		e->gen = evloop.gen;
+		e->want = 0;
+		grow_int_array(&evloop.wanted, &evloop.wantedsize, evloop.nwanted+1);
+		evloop.wanted[evloop.nwanted] = fd;
+		evloop.nwanted++;
+	}
+	e->want |= events;
+	e->kind = kind;
+	e->index = index;
+}
+
+static void add_ready(int fd, int events) {
+	struct evloop_fd *e = &evloop.fds[fd];
+
+	if (e->gen != evloop.gen) {
+		/* not wanted this iteration */
+		return;
+	}
+	events &= e->want;
+	if (events == 0) {
+		return;
+	}
+	if (e->ready == 0) {
+		evloop.ready[evloop.nready] = fd;
+		evloop.nready++;
+	}
+	e->ready |= events;
+}
+
+#if DROPBEAR_DO_EPOLL
+static unsigned int to_epoll_events(int events) {
+	unsigned int ret = 0;
+	if (events & EVLOOP_READ) {
+		ret |= EPOLLIN;
+	}
+	if (events & EVLOOP_WRITE) {
+		ret |= EPOLLOUT;
+	}
+	return ret;
+}
+
+/* Brings the epoll set in line with this iteration's interest. Only fds
+ * that changed need a syscall. */
+static void epoll_update() {
+	unsigned int i;
+	struct epoll_event ev;
+
+	/* Remove interest that wasn't renewed */
+	for (i = 0; i < evloop.nreg; ) {
+		int fd = evloop.reg[i];
+		struct evloop_fd *e = &evloop.fds[fd];
+		if (e->gen == evloop.gen) {
+			i++;
+			continue;
+		}
+		if (e->registered) {
+			if (epoll_ctl(evloop.epfd, EPOLL_CTL_DEL, fd, NULL) < 0) {
+				TRACE(("epoll DEL %d failed: %s", fd, strerror(errno)))
+			}
+		}
+		e->registered = 0;
+		e->nopoll = 0;
+		e->listed = 0;
+		/* swap with the last entry */
+		evloop.nreg--;
+		evloop.reg[i] = evloop.reg[evloop.nreg];
+	}
+
+	for (i = 0; i < evloop.nwanted; i++) {
+		int fd = evloop.wanted[i];
+		struct evloop_fd *e = &evloop.fds[fd];
+		int op;
+
+		if (e->nopoll || e->want == e->registered) {
+			continue;
+		}
+
+		memset(&ev, 0x0, sizeof(ev));
+		ev.events = to_epoll_events(e->want);
+		ev.data.fd = fd;
+		op = e->registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+		if (epoll_ctl(evloop.epfd, op, fd, &ev) < 0) {
+			if (op == EPOLL_CTL_ADD && errno == EEXIST) {
+				/* Shouldn't happen unless a fd was closed without
+				 * m_close(), recover */
+				op = EPOLL_CTL_MOD;
+				if (epoll_ctl(evloop.epfd, op, fd, &ev) == 0) {
+					goto done;
+				}
+			}
+			if (errno == EPERM) {
+				/* Regular files can't be polled */
+				TRACE(("epoll can't poll fd %d", fd))
+				e->nopoll = 1;
+			} else {
+				dropbear_exit("Error in epoll_ctl: %s", strerror(errno));
+			}
+		}
+done:
+		if (!e->nopoll) {
+			e->registered = e->want;
+		}
+		if (!e->listed) {
+			grow_int_array(&evloop.reg, &evloop.regsize, evloop.nreg+1);
+			evloop.reg[evloop.nreg] = fd;
+			evloop.nreg++;
+			e->listed = 1;
+		}
+	}
+}
+
+static int epoll_wait_events(long timeout) {
+	int timeout_ms;
+	int i, n;
+	unsigned int j;
+	int nopoll = 0;
+
+	epoll_update();
+
+	for (j = 0; j < evloop.nwanted; j++) {
+		if (evloop.fds[evloop.wanted[j]].nopoll) {
+			nopoll = 1;
+			break;
+		}
+	}
+
+	if (nopoll) {
+		timeout_ms = 0;
+	} else {
+		timeout_ms = wait_timeout_ms(timeout);
+	}
+
+	if (evloop.eventsize < evloop.nreg) {
+		evloop.eventsize = evloop.nreg;
+		evloop.events = m_realloc(evloop.events,
+			evloop.eventsize * sizeof(struct epoll_event));
+	}
+
+	n = epoll_wait(evloop.epfd, evloop.events, evloop.eventsize, timeout_ms);
+	if (n < 0) {
+		return -1;
+	}
+
+	for (i = 0; i < n; i++) {
+		unsigned int ev = evloop.events[i].events;
+		int events = 0;
+		if (ev & (EPOLLIN|EPOLLHUP|EPOLLERR)) {
+			events |= EVLOOP_READ;
+		}
+		if (ev & (EPOLLOUT|EPOLLHUP|EPOLLERR)) {
+			events |= EVLOOP_WRITE;
+		}
+		add_ready(evloop.events[i].data.fd, events);
+	}
+
+	if (nopoll) {
+		for (j = 0; j < evloop.nwanted; j++) {
+			int fd = evloop.wanted[j];
+			if (evloop.fds[fd].nopoll) {
+				add_ready(fd, EVLOOP_READ|EVLOOP_WRITE);
+			}
+		}
+	}
+
+	return evloop.nready;
+}
+#endif /* DROPBEAR_DO_EPOLL */
+
+static int select_wait_events(long timeout) {
+	fd_set readfds, writefds;
+	struct timeval tv;
+	long timeout_ms;
+	unsigned int i;
+	int maxfd = -1;
+	int val;
+
+	DROPBEAR_FD_ZERO(&readfds);
+	DROPBEAR_FD_ZERO(&writefds);
+
+	for (i = 0; i < evloop.nwanted; i++) {
+		int fd = evloop.wanted[i];
+		struct evloop_fd *e = &evloop.fds[fd];
+		if (fd >= FD_SETSIZE) {
+			dropbear_exit("fd %d too large for select()", fd);
+		}
+		if (e->want & EVLOOP_READ) {
+			FD_SET(fd, &readfds);
+		}
+		if (e->want & EVLOOP_WRITE) {
+			FD_SET(fd, &writefds);
+		}
+		maxfd = MAX(maxfd, fd);
+	}
+
+	timeout_ms = wait_timeout_ms(timeout);
+	tv.tv_sec = timeout_ms / 1000;
+	tv.tv_usec = (timeout_ms % 1000) * 1000;
+	val = select(maxfd+1, &readfds, &writefds, NULL, &tv);
+	if (val <= 0) {
+		return val;
+	}
+
+	for (i = 0; i < evloop.nwanted; i++) {
+		int fd = evloop.wanted[i];
+		int events = 0;
+		if (FD_ISSET(fd, &readfds)) {
+			events |= EVLOOP_READ;
+		}
+		if (FD_ISSET(fd, &writefds)) {
+			events |= EVLOOP_WRITE;
+		}
+		add_ready(fd, events);
+	}
+	return evloop.nready;
+}
+
+int evloop_wait(long timeout) {
+	/* at most every wanted fd can be ready */
+	grow_int_array(&evloop.ready, &evloop.readysize, evloop.nwanted);
+
+#if DROPBEAR_DO_EPOLL
+	if (evloop.epfd >= 0) {
+		return epoll_wait_events(timeout);
+	}
+#endif
+	return select_wait_events(timeout);
+}
+
+int evloop_ready(int fd, int events) {
+	if (fd < 0 || (unsigned int)fd >= evloop.fdsize) {
+		return 0;
+	}
+	return evloop.fds[fd].ready & events;
+}
+
+int evloop_take(int fd, int events) {
+	int ret = evloop_ready(fd, events);
+	if (ret) {
+		evloop.fds[fd].ready &= ~ret;
+	}
+	return ret;
+}
+
+int evloop_next_ready(unsigned int *iter, enum evloop_kind kind, unsigned int *index) {
+	while (*iter < evloop.nready) {
+		struct evloop_fd *e = &evloop.fds[evloop.ready[*iter]];
+		(*iter)++;
+		if (e->ready && e->kind == kind) {
+			*index = e->index;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+void evloop_forget(int fd) {
+	struct evloop_fd *e = NULL;
+
+	if (!evloop.initialised || fd < 0 || (unsigned int)fd >= evloop.fdsize) {
+		return;
+	}
+	if (getpid() != evloop.pid) {
+		return;
+	}
+
+	e = &evloop.fds[fd];
+#if DROPBEAR_DO_EPOLL
+	/* Must be removed before close, epoll registrations belong to the
+	 * underlying file which may outlive this fd if it was dup()ed */
+	if (e->registered) {
+		if (epoll_ctl(evloop.epfd, EPOLL_CTL_DEL, fd, NULL) < 0) {
+			TRACE(("epoll DEL %d failed: %s", fd, strerror(errno)))
+		}
+	}
+	e->registered = 0;
+	e->nopoll = 0;
+#endif
+	e->ready = 0;
+	e->want = 0;
+	/* Leaves it in evloop.reg, the next update will drop it
+	 * unless the fd number is reused and wanted again */
+	e->gen = 0;
+}
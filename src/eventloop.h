@@ -0,0 +1,53 @@
+#ifndef DROPBEAR_EVENTLOOP_H_
+#define DROPBEAR_EVENTLOOP_H_
+
+#include "includes.h"
+
+/* Wraps the main session wait. Each loop iteration callers register the fds
+ * they are interested in with evloop_want(), then evloop_wait() blocks and
+ * evloop_ready() tests the result, much like FD_SET/select/FD_ISSET.
+ *
+ * The epoll backend keeps registrations in the kernel between iterations
+ * and only calls epoll_ctl() for fds whose interest changed, so the wait
+ * costs in proportion to the number of ready fds rather than open fds, and
+ * isn't limited by FD_SETSIZE. select() is the fallback. */
+
+#define EVLOOP_READ 1
+#define EVLOOP_WRITE 2
+
+/* Owner of a fd, lets ready fds be dispatched without iterating
+ * every channel */
+enum evloop_kind {
+	EVLOOP_KIND_OTHER = 0,
+	EVLOOP_KIND_CHANNEL,
+};
+
+void evloop_init(void);
+void evloop_cleanup(void);
+const char* evloop_backend_name(void);
+
+/* Starts a new iteration, clearing previous interest and readiness */
+void evloop_begin(void);
+/* Adds interest in events (EVLOOP_READ|EVLOOP_WRITE) for fd. index is an
+ * owner-specific value, the channel index for EVLOOP_KIND_CHANNEL */
+void evloop_want(int fd, int events, enum evloop_kind kind, unsigned int index);
+/* Limits this iteration's wait to msec milliseconds, for timers finer
+ * than the session's one second timeouts */
+void evloop_wake_within(long msec);
+/* Waits up to timeout seconds. Returns the number of ready fds, 0 on
+ * timeout, or -1 with errno set */
+int evloop_wait(long timeout);
+/* Returns the subset of events that fd was ready for in the last wait */
+int evloop_ready(int fd, int events);
+/* As evloop_ready() but also clears them, so that each readiness
+ * is handled once */
+int evloop_take(int fd, int events);
+/* Iterates ready fds of a given kind that haven't been taken yet.
+ * *iter should start at 0. Returns 1 and sets *index while there are more */
+int evloop_next_ready(unsigned int *iter, enum evloop_kind kind, unsigned int *index);
+
+/* Must be called before closing a fd that may have been registered,
+ * m_close() does so. Safe to call in a forked child */
+void evloop_forget(int fd);
+
+#endif /* DROPBEAR_EVENTLOOP_H_ */
@@ -27,6 +27,7 @@
 #include "algo.h"
 #include "dbutil.h"
 #include "gcm.h"
+#include "aes-accel.h"
 
 #if DROPBEAR_ENABLE_GCM_MODE
 
@@ -51,18 +52,12 @@ static int dropbear_gcm_start(int cipher, const unsigned char *IV,
 	return CRYPT_OK;
 }
 
-static int dropbear_gcm_crypt(unsigned int UNUSED(seq),
-			const unsigned char *in, unsigned char *out,
-			unsigned long len, unsigned long taglen,
+/* Processes a packet with libtomcrypt's gcm, the tag is written to tag */
+static int dropbear_gcm_ltc(const unsigned char *in, unsigned char *out,
+			unsigned long len, unsigned char *tag,
 			dropbear_gcm_state *state, int direction) {
-	unsigned char *iv, tag[GHASH_LEN];
-	int i, err;
-
-	TRACE2(("enter dropbear_gcm_crypt"))
-
-	if (len < 4 || taglen != GHASH_LEN) {
-		return CRYPT_ERROR;
-	}
+	unsigned long taglen = GHASH_LEN;
+	int err;
 
 	gcm_reset(&state->gcm);
 
@@ -80,13 +75,40 @@ static int dropbear_gcm_crypt(unsigned int UNUSED(seq),
 		return err;
 	}
 
-	if (direction == LTC_ENCRYPT) {
-		gcm_done(&state->gcm, out + len, &taglen);
-	} else {
-		gcm_done(&state->gcm, tag, &taglen);
-		if (constant_time_memcmp(in + len, tag, taglen) != 0) {
-			return CRYPT_ERROR;
-		}
+	return gcm_done(&state->gcm, tag, &taglen);
+}
+
+static int dropbear_gcm_crypt(unsigned int UNUSED(seq),
+			const unsigned char *in, unsigned char *out,
+			unsigned long len, unsigned long taglen,
+			dropbear_gcm_state *state, int direction) {
+	unsigned char *iv, tag[GHASH_LEN], *calc_tag;
+	int i, err = CRYPT_NOP;
+
+	TRACE2(("enter dropbear_gcm_crypt"))
+
+	if (len < 4 || taglen != GHASH_LEN) {
+		return CRYPT_ERROR;
+	}
+
+	/* encrypting appends the tag, decrypting checks it */
+	calc_tag = direction == LTC_ENCRYPT ? out + len : tag;
+
+#if DROPBEAR_AES_ACCEL
+	err = aes_accel_gcm_crypt(state->gcm.cipher, &state->gcm.K,
+			state->gcm.H, state->iv, in, 4, in + 4, out + 4, len - 4,
+			calc_tag, direction);
+#endif
+	if (err == CRYPT_NOP) {
+		err = dropbear_gcm_ltc(in, out, len, calc_tag, state, direction);
+	}
+	if (err != CRYPT_OK) {
+		return err;
+	}
+
+	if (direction == LTC_DECRYPT
+			&& constant_time_memcmp(in + len, tag, taglen) != 0) {
+		return CRYPT_ERROR;
 	}
 
 	/* increment invocation counter */
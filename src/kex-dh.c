@@ -9,10 +9,120 @@
 #include "kex.h"
 
 #if DROPBEAR_NORMAL_DH
-static void load_dh_p(mp_int * dh_p)
+/* The group's prime and values derived from it, parsed once per process.
+ * Only the last used group is kept, they are rarely mixed */
+struct dh_group_cache {
+    const unsigned char *p_bytes; /* NULL until first use */
+    mp_int p;
+    mp_int q; /* (p-1)/2 */
+    mp_int mont_one; /* R mod p, 1 in Montgomery form */
+    mp_digit rho;
+};
+
+static struct dh_group_cache dh_group;
+
+static const struct dh_group_cache* load_dh_group(void)
 {
-    bytes_to_mp(dh_p, ses.newkeys->algo_kex->dh_p_bytes,
-        ses.newkeys->algo_kex->dh_p_len);
+    const struct dropbear_kex *kex = ses.newkeys->algo_kex;
+
+    if (dh_group.p_bytes == kex->dh_p_bytes) {
+        return &dh_group;
+    }
+
+    if (dh_group.p_bytes == NULL) {
+        m_mp_init_multi(&dh_group.p, &dh_group.q, &dh_group.mont_one, NULL);
+    }
+    bytes_to_mp(&dh_group.p, kex->dh_p_bytes, kex->dh_p_len);
+
+    /* calculate q = (p-1)/2 */
+    if (mp_sub_d(&dh_group.p, 1, &dh_group.q) != MP_OKAY
+            || mp_div_2(&dh_group.q, &dh_group.q) != MP_OKAY
+            || mp_montgomery_setup(&dh_group.p, &dh_group.rho) != MP_OKAY
+            || mp_montgomery_calc_normalization(&dh_group.mont_one, &dh_group.p)
+                != MP_OKAY) {
+        dropbear_exit("Diffie-Hellman error");
+    }
+    dh_group.p_bytes = kex->dh_p_bytes;
+    return &dh_group;
+}
+
+/* out = 2^e mod p, for the generator 2. Like mp_exptmod() each bit of e
+ * costs a Montgomery squaring, but multiplying by the generator is just a
+ * doubling, rather than a multiplication for every window of e.
+ * e is secret, so every bit position up to the length of q is processed the
+ * same way: the doubling and its reduction are always computed and the
+ * result is selected with a mask. */
+static void dh_pow2(const struct dh_group_cache *group, const mp_int *e,
+        mp_int *out)
+{
+    DEF_MP_INT(sq);
+    DEF_MP_INT(ebits);
+    const mp_digit *p = group->p.dp;
+    const int n = group->p.used;
+    mp_digit *dbl = NULL, *red = NULL;
+    mp_digit d, carry, borrow, bit, sel, mask;
+    int i, j;
+
+    /* ebits is zero padded up to the length of q, so reading any bit
+     * doesn't depend on the magnitude of e */
+    if (mp_init_size(&sq, 2 * n + 1) != MP_OKAY
+            || mp_init_size(&ebits, group->q.used) != MP_OKAY
+            || mp_copy(e, &ebits) != MP_OKAY
+            || mp_copy(&group->mont_one, out) != MP_OKAY) {
+        dropbear_exit("Diffie-Hellman error");
+    }
+    dbl = m_malloc((n + 1) * sizeof(mp_digit));
+    red = m_malloc(n * sizeof(mp_digit));
+
+    for (i = mp_count_bits(&group->q) - 1; i >= 0; i--) {
+        if (mp_sqr(out, &sq) != MP_OKAY
+                || mp_montgomery_reduce(&sq, &group->p, group->rho) != MP_OKAY
+                || mp_grow(&sq, n) != MP_OKAY) {
+            dropbear_exit("Diffie-Hellman error");
+        }
+        mp_exch(&sq, out);
+        for (j = out->used; j < n; j++) {
+            out->dp[j] = 0;
+        }
+
+        /* dbl = 2*out, red = dbl - p. out < p, so one of them is
+         * the reduced doubling */
+        carry = 0;
+        for (j = 0; j < n; j++) {
+            d = (out->dp[j] << 1) | carry;
+            carry = d >> MP_DIGIT_BIT;
+            dbl[j] = d & MP_MASK;
+        }
+        dbl[n] = carry;
+        borrow = 0;
+        for (j = 0; j < n; j++) {
+            d = dbl[j] - p[j] - borrow;
+            borrow = d >> (sizeof(mp_digit) * CHAR_BIT - 1);
+            red[j] = d & MP_MASK;
+        }
+        borrow = (dbl[n] - borrow) >> (sizeof(mp_digit) * CHAR_BIT - 1);
+
+        /* keep dbl if red went negative, then out unless the bit is set */
+        bit = (ebits.dp[i / MP_DIGIT_BIT] >> (i % MP_DIGIT_BIT)) & 1;
+        mask = (mp_digit)0 - bit;
+        for (j = 0; j < n; j++) {
+            sel = red[j] ^ (((mp_digit)0 - borrow) & (red[j] ^ dbl[j]));
+            out->dp[j] ^= mask & (out->dp[j] ^ sel);
+        }
+        out->used = n;
+        mp_clamp(out);
+    }
+
+    /* out of Montgomery form */
+    if (mp_montgomery_reduce(out, &group->p, group->rho) != MP_OKAY) {
+        dropbear_exit("Diffie-Hellman error");
+    }
+    m_burn(dbl, (n + 1) * sizeof(mp_digit));
+    m_burn(red, n * sizeof(mp_digit));
+    m_free(dbl);
+    m_free(red);
+    mp_clear(&sq);
+    mp_clear(&ebits);
 }
 
 /* Initialises and generate one side of the diffie-hellman key exchange values.
@@ -20,38 +130,31 @@ static void load_dh_p(mp_int * dh_p)
 /* dh_pub and dh_priv MUST be already initialised */
 struct kex_dh_param *gen_kexdh_param() {
     struct kex_dh_param *param = NULL;
+    const struct dh_group_cache *group = NULL;
 
-    DEF_MP_INT(dh_p);
-    DEF_MP_INT(dh_q);
     DEF_MP_INT(dh_g);
 
     TRACE(("enter gen_kexdh_vals"))
 
     param = m_malloc(sizeof(*param));
-    m_mp_init_multi(&param->pub, &param->priv, &dh_g, &dh_p, &dh_q, NULL);
+    m_mp_init_multi(&param->pub, &param->priv, NULL);
 
-    /* read the prime and generator*/
-    load_dh_p(&dh_p);
-
-    mp_set_ul(&dh_g, DH_G_VAL);
-
-    /* calculate q = (p-1)/2 */
-    /* dh_priv is just a temp var here */
-    if (mp_sub_d(&dh_p, 1, &param->priv) != MP_OKAY) {
-        dropbear_exit("Diffie-Hellman error");
-    }
-    if (mp_div_2(&param->priv, &dh_q) != MP_OKAY) {
-        dropbear_exit("Diffie-Hellman error");
-    }
+    group = load_dh_group();
 
     /* Generate a private portion 0 < dh_priv < dh_q */
-    gen_random_mpint(&dh_q, &param->priv);
+    gen_random_mpint(&group->q, &param->priv);
 
     /* f = g^y mod p */
-    if (mp_exptmod(&dh_g, &param->priv, &dh_p, &param->pub) != MP_OKAY) {
-        dropbear_exit("Diffie-Hellman error");
+    if (DH_G_VAL == 2) {
+        dh_pow2(group, &param->priv, &param->pub);
+    } else {
+        m_mp_init(&dh_g);
+        mp_set_ul(&dh_g, DH_G_VAL);
+        if (mp_exptmod(&dh_g, &param->priv, &group->p, &param->pub) != MP_OKAY) {
+            dropbear_exit("Diffie-Hellman error");
+        }
+        mp_clear(&dh_g);
     }
-    mp_clear_multi(&dh_g, &dh_p, &dh_q, NULL);
     return param;
 }
 
@@ -68,14 +171,14 @@ void free_kexdh_param(struct kex_dh_param *param)
 void kexdh_comb_key(struct kex_dh_param *param, mp_int *dh_pub_them,
         sign_key *hostkey) {
 
-    DEF_MP_INT(dh_p);
+    const struct dh_group_cache *group = NULL;
     DEF_MP_INT(dh_p_min1);
     mp_int *dh_e = NULL, *dh_f = NULL;
 
-    m_mp_init_multi(&dh_p, &dh_p_min1, NULL);
-    load_dh_p(&dh_p);
+    m_mp_init(&dh_p_min1);
+    group = load_dh_group();
 
-    if (mp_sub_d(&dh_p, 1, &dh_p_min1) != MP_OKAY) {
+    if (mp_sub_d(&group->p, 1, &dh_p_min1) != MP_OKAY) {
         dropbear_exit("Diffie-Hellman error");
     }
 
@@ -87,12 +190,12 @@ void kexdh_comb_key(struct kex_dh_param *param, mp_int *dh_pub_them,
 
     /* K = e^y mod p = f^x mod p */
     m_mp_alloc_init_multi(&ses.dh_K, NULL);
-    if (mp_exptmod(dh_pub_them, &param->priv, &dh_p, ses.dh_K) != MP_OKAY) {
+    if (mp_exptmod(dh_pub_them, &param->priv, &group->p, ses.dh_K) != MP_OKAY) {
         dropbear_exit("Diffie-Hellman error");
     }
 
     /* clear no longer needed vars */
-    mp_clear_multi(&dh_p, &dh_p_min1, NULL);
+    mp_clear(&dh_p_min1);
 
     /* From here on, the code needs to work with the _same_ vars on each side,
      * not vice-versaing for client/server */
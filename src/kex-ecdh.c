@@ -11,8 +11,7 @@
 struct kex_ecdh_param *gen_kexecdh_param() {
     struct kex_ecdh_param *param = m_malloc(sizeof(*param));
     const struct dropbear_ecc_curve *curve = ses.newkeys->algo_kex->details;
-    if (ecc_make_key_ex(NULL, dropbear_ltc_prng,
-        &param->key, curve->dp) != CRYPT_OK) {
+    if (dropbear_ecc_make_key(&param->key, curve->dp) != CRYPT_OK) {
         dropbear_exit("ECC error");
     }
     return param;
@@ -14,10 +14,9 @@
 struct kex_curve25519_param *gen_kexcurve25519_param() {
     /* Per http://cr.yp.to/ecdh.html */
     struct kex_curve25519_param *param = m_malloc(sizeof(*param));
-    const unsigned char basepoint[32] = {9};
 
     genrandom(param->priv, CURVE25519_LEN);
-    dropbear_curve25519_scalarmult(param->pub, param->priv, basepoint);
+    dropbear_curve25519_scalarmult_base(param->pub, param->priv);
 
     return param;
 }
@@ -0,0 +1,328 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "metrics.h"
+
+#if DROPBEAR_METRICS
+
+#include <sys/mman.h>
+
+#ifdef HAVE_ATOMIC_BUILTINS_64
+#define SHARED_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define SHARED_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#else
+/* Concurrent flushes may rarely lose an update */
+#define SHARED_ADD(p, v) (*(p) += (v))
+#define SHARED_LOAD(p) (*(p))
+#endif
+
+static const char *counter_names[METRIC_COUNTERS] = {
+	"sessions",
+	"auth_success",
+	"auth_failure",
+	"kex",
+	"packets_in",
+	"bytes_in",
+	"packets_out",
+	"bytes_out",
+	"channels",
+	"channel_packets",
+	"channel_bytes",
+	"loops",
+	"writebuf_allocs",
+	"writebuf_reuses",
+	"writebuf_copies",
+};
+
+static const struct {
+	const char *name;
+	unsigned int divisor; /* from nanoseconds for metrics_time() */
+} hist_info[METRIC_HISTS] = {
+	{ "kex_usec", 1000 },
+	{ "auth_usec", 1000 },
+	{ "encrypt_nsec", 1 },
+	{ "decrypt_nsec", 1 },
+	{ "channelio_nsec", 1 },
+	{ "writequeue_bytes", 1 },
+	{ "channel_sent_bytes", 1 },
+	{ "channel_queue_avg_bytes", 1 },
+	{ "channel_queue_max_bytes", 1 },
+};
+
+static struct {
+	/* this session's totals, and what of them has been added to shared */
+	struct dropbear_metrics session;
+	struct dropbear_metrics flushed;
+	unsigned long long event_start[METRIC_HISTS];
+	pid_t pid; /* forked children mustn't flush the session's metrics */
+	time_t last_flush;
+
+	struct dropbear_metrics *shared;
+	int shared_fd;
+} metrics = { .shared_fd = -1 };
+
+static unsigned int hist_bucket(unsigned long long value) {
+	unsigned int top = METRICS_HIST_SUB_BITS;
+
+	if (value < METRICS_HIST_SUB) {
+		return value;
+	}
+	if (value > 0xffffffffULL) {
+		value = 0xffffffffULL;
+	}
+	while (value >> (top + 1)) {
+		top++;
+	}
+	return (top - METRICS_HIST_SUB_BITS + 1) * METRICS_HIST_SUB
+		+ ((value >> (top - METRICS_HIST_SUB_BITS)) & (METRICS_HIST_SUB - 1));
+}
+
+/* The largest value that falls in a bucket */
+static unsigned long long bucket_limit(unsigned int bucket) {
+	unsigned int shift;
+
+	if (bucket < METRICS_HIST_SUB) {
+		return bucket;
+	}
+	shift = bucket / METRICS_HIST_SUB - 1;
+	return ((unsigned long long)(METRICS_HIST_SUB + bucket % METRICS_HIST_SUB + 1)
+		<< shift) - 1;
+}
+
+void metrics_session_start() {
+	memset(&metrics.session, 0x0, sizeof(metrics.session));
+	memset(&metrics.flushed, 0x0, sizeof(metrics.flushed));
+	memset(metrics.event_start, 0x0, sizeof(metrics.event_start));
+	metrics.pid = getpid();
+	metrics.last_flush = monotonic_now();
+	metrics_add(METRIC_SESSIONS, 1);
+}
+
+void metrics_add(enum metrics_counter counter, unsigned long long n) {
+	metrics.session.counters[counter] += n;
+}
+
+void metrics_hist_add(enum metrics_hist hist, unsigned long long value) {
+	struct metrics_histogram *h = &metrics.session.hists[hist];
+
+	h->count++;
+	h->sum += value;
+	h->max = MAX(h->max, value);
+	h->buckets[hist_bucket(value)]++;
+}
+
+unsigned long long metrics_now() {
+	struct timespec ts;
+	gettime_wrapper(&ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void metrics_time(enum metrics_hist hist, unsigned long long start) {
+	metrics_hist_add(hist, (metrics_now() - start) / hist_info[hist].divisor);
+}
+
+void metrics_event_start(enum metrics_hist hist) {
+	if (metrics.event_start[hist] == 0) {
+		metrics.event_start[hist] = metrics_now();
+	}
+}
+
+void metrics_event_done(enum metrics_hist hist) {
+	if (metrics.event_start[hist] != 0) {
+		metrics_time(hist, metrics.event_start[hist]);
+		metrics.event_start[hist] = 0;
+	}
+}
+
+static void shared_max(unsigned long long *p, unsigned long long value) {
+#ifdef HAVE_ATOMIC_BUILTINS_64
+	unsigned long long cur = __atomic_load_n(p, __ATOMIC_RELAXED);
+	while (value > cur && !__atomic_compare_exchange_n(p, &cur, value, 1,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+		/* cur has been reloaded */
+	}
+#else
+	if (value > *p) {
+		*p = value;
+	}
+#endif
+}
+
+/* Adds what this session has recorded since the last flush to the
+ * listening server's totals */
+void metrics_flush() {
+	struct dropbear_metrics *cur = &metrics.session, *old = &metrics.flushed;
+	struct metrics_histogram *h, *oldh;
+	unsigned int i, b;
+
+	if (metrics.shared == NULL || metrics.pid != getpid()) {
+		return;
+	}
+
+	for (i = 0; i < METRIC_COUNTERS; i++) {
+		if (cur->counters[i] != old->counters[i]) {
+			SHARED_ADD(&metrics.shared->counters[i],
+				cur->counters[i] - old->counters[i]);
+		}
+	}
+
+	for (i = 0; i < METRIC_HISTS; i++) {
+		h = &cur->hists[i];
+		oldh = &old->hists[i];
+		if (h->count == oldh->count) {
+			continue;
+		}
+		SHARED_ADD(&metrics.shared->hists[i].count, h->count - oldh->count);
+		SHARED_ADD(&metrics.shared->hists[i].sum, h->sum - oldh->sum);
+		shared_max(&metrics.shared->hists[i].max, h->max);
+		for (b = 0; b < METRICS_HIST_BUCKETS; b++) {
+			if (h->buckets[b] != oldh->buckets[b]) {
+				SHARED_ADD(&metrics.shared->hists[i].buckets[b],
+					h->buckets[b] - oldh->buckets[b]);
+			}
+		}
+	}
+
+	*old = *cur;
+}
+
+void metrics_check_flush(time_t now) {
+	if (now - metrics.last_flush >= METRICS_FLUSH_INTERVAL) {
+		metrics.last_flush = now;
+		metrics_flush();
+	}
+}
+
+/* Returns the time of the last flush if packets have been sent or received
+ * since, for the session to wake up for the next one. 0 otherwise */
+time_t metrics_unflushed_since() {
+	if (metrics.shared == NULL
+		|| (metrics.session.counters[METRIC_PACKETS_IN]
+			== metrics.flushed.counters[METRIC_PACKETS_IN]
+		&& metrics.session.counters[METRIC_PACKETS_OUT]
+			== metrics.flushed.counters[METRIC_PACKETS_OUT])) {
+		return 0;
+	}
+	return metrics.last_flush;
+}
+
+/* Sets up the region sessions add their metrics to. It is backed by a
+ * memfd where possible so that re-executed sessions can map it */
+void metrics_shared_init() {
+	void *p = MAP_FAILED;
+	int fd = -1;
+
+#ifdef HAVE_MEMFD_CREATE
+	fd = memfd_create("dropbear-metrics", MFD_CLOEXEC);
+	if (fd >= 0 && ftruncate(fd, sizeof(struct dropbear_metrics)) == 0) {
+		p = mmap(NULL, sizeof(struct dropbear_metrics), PROT_READ|PROT_WRITE,
+				MAP_SHARED, fd, 0);
+	}
+	if (p == MAP_FAILED && fd >= 0) {
+		m_close(fd);
+		fd = -1;
+	}
+#endif
+#ifdef MAP_ANONYMOUS
+	if (p == MAP_FAILED) {
+		/* only shared with sessions that aren't re-executed */
+		p = mmap(NULL, sizeof(struct dropbear_metrics), PROT_READ|PROT_WRITE,
+				MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+	}
+#endif
+	if (p == MAP_FAILED) {
+		dropbear_log(LOG_WARNING, "Couldn't set up metrics: %s", strerror(errno));
+		return;
+	}
+
+	memset(p, 0x0, sizeof(struct dropbear_metrics));
+	metrics.shared = p;
+	metrics.shared_fd = fd;
+}
+
+/* For a re-executed session, fd is from metrics_shared_fd() in the
+ * listening server */
+void metrics_shared_attach(int fd) {
+	void *p;
+
+	p = mmap(NULL, sizeof(struct dropbear_metrics), PROT_READ|PROT_WRITE,
+			MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED) {
+		TRACE(("metrics mmap failed: %s", strerror(errno)))
+	} else {
+		metrics.shared = p;
+	}
+	/* not needed once mapped, and mustn't leak to user processes */
+	m_close(fd);
+}
+
+int metrics_shared_fd() {
+	return metrics.shared_fd;
+}
+
+static void dump_histogram(FILE *f, const char *name,
+		const struct metrics_histogram *h) {
+	static const unsigned int percentiles[] = { 50, 90, 99 };
+	unsigned long long count, seen = 0, n;
+	unsigned int b, p = 0;
+
+	count = SHARED_LOAD(&h->count);
+	fprintf(f, "hist %s count %llu sum %llu max %llu", name, count,
+		SHARED_LOAD(&h->sum), SHARED_LOAD(&h->max));
+	for (b = 0; b < METRICS_HIST_BUCKETS && count > 0; b++) {
+		seen += SHARED_LOAD(&h->buckets[b]);
+		while (p < sizeof(percentiles)/sizeof(percentiles[0])
+				&& seen * 100 >= count * percentiles[p]) {
+			fprintf(f, " p%u %llu", percentiles[p],
+				MIN(bucket_limit(b), SHARED_LOAD(&h->max)));
+			p++;
+		}
+	}
+	fprintf(f, "\n");
+
+	for (b = 0; b < METRICS_HIST_BUCKETS; b++) {
+		n = SHARED_LOAD(&h->buckets[b]);
+		if (n > 0) {
+			fprintf(f, "bucket %s %llu %llu\n", name, bucket_limit(b), n);
+		}
+	}
+}
+
+/* Writes the totals from all sessions to path, replacing it atomically.
+ * Each line is "counter <name> <value>", "hist <name> count <n> sum <n> max
+ * <n> p50 <n> p90 <n> p99 <n>", or "bucket <name> <upper limit> <count>"
+ * for non-empty histogram buckets */
+void metrics_dump(const char *path) {
+	char tmppath[PATH_MAX];
+	FILE *f = NULL;
+	unsigned int i;
+
+	if (metrics.shared == NULL) {
+		return;
+	}
+
+	snprintf(tmppath, sizeof(tmppath), "%s.tmp", path);
+	f = fopen(tmppath, "w");
+	if (f == NULL) {
+		dropbear_log(LOG_WARNING, "Couldn't write metrics to %s: %s",
+			tmppath, strerror(errno));
+		return;
+	}
+
+	for (i = 0; i < METRIC_COUNTERS; i++) {
+		fprintf(f, "counter %s %llu\n", counter_names[i],
+			SHARED_LOAD(&metrics.shared->counters[i]));
+	}
+	for (i = 0; i < METRIC_HISTS; i++) {
+		dump_histogram(f, hist_info[i].name, &metrics.shared->hists[i]);
+	}
+
+	if (fclose(f) != 0 || rename(tmppath, path) < 0) {
+		dropbear_log(LOG_WARNING, "Couldn't write metrics to %s: %s",
+			path, strerror(errno));
+		unlink(tmppath);
+		return;
+	}
+	dropbear_log(LOG_INFO, "Wrote metrics to %s", path);
+}
+
+#endif /* DROPBEAR_METRICS */
@@ -0,0 +1,103 @@
+#ifndef DROPBEAR_METRICS_H_
+#define DROPBEAR_METRICS_H_
+
+#include "includes.h"
+
+/* Counters and latency histograms for a session. Each session process
+ * keeps its own totals, which are added periodically to a region shared
+ * with the listening server so that it can report on all sessions. */
+
+enum metrics_counter {
+	METRIC_SESSIONS,
+	METRIC_AUTH_SUCCESS,
+	METRIC_AUTH_FAILURE,
+	METRIC_KEX,
+	METRIC_PACKETS_IN,
+	METRIC_BYTES_IN,
+	METRIC_PACKETS_OUT,
+	METRIC_BYTES_OUT,
+	METRIC_CHANNELS,
+	METRIC_CHANNEL_PACKETS,
+	METRIC_CHANNEL_BYTES, /* wire bytes of channel data packets */
+	METRIC_LOOPS,
+	/* wire buffers for outgoing packets, allocated or reused from the pool */
+	METRIC_WRITEBUF_ALLOCS,
+	METRIC_WRITEBUF_REUSES,
+	METRIC_WRITEBUF_COPIES, /* small packets moved out of a full buffer */
+	METRIC_COUNTERS /* count of the above */
+};
+
+enum metrics_hist {
+	METRIC_KEX_USEC,
+	METRIC_AUTH_USEC,
+	METRIC_ENCRYPT_NSEC,
+	METRIC_DECRYPT_NSEC,
+	METRIC_CHANNELIO_NSEC,
+	METRIC_WRITEQUEUE_BYTES, /* queued ahead of each packet sent */
+	/* per channel when it closes, the data sent and the average and
+	 * largest write queue its packets joined */
+	METRIC_CHANNEL_SENT_BYTES,
+	METRIC_CHANNEL_QUEUE_AVG_BYTES,
+	METRIC_CHANNEL_QUEUE_MAX_BYTES,
+	METRIC_HISTS /* count of the above */
+};
+
+/* Histogram buckets are exact below METRICS_HIST_SUB, then each power of
+ * two is split into METRICS_HIST_SUB buckets, so a bucket's values are
+ * within 1/METRICS_HIST_SUB of each other. Values are clamped to 32 bits */
+#define METRICS_HIST_SUB_BITS 3
+#define METRICS_HIST_SUB (1 << METRICS_HIST_SUB_BITS)
+#define METRICS_HIST_BUCKETS ((32 - METRICS_HIST_SUB_BITS + 1) * METRICS_HIST_SUB)
+
+struct metrics_histogram {
+	unsigned long long count;
+	unsigned long long sum;
+	unsigned long long max;
+	unsigned long long buckets[METRICS_HIST_BUCKETS];
+};
+
+struct dropbear_metrics {
+	unsigned long long counters[METRIC_COUNTERS];
+	struct metrics_histogram hists[METRIC_HISTS];
+};
+
+#if DROPBEAR_METRICS
+
+void metrics_session_start(void);
+void metrics_add(enum metrics_counter counter, unsigned long long n);
+void metrics_hist_add(enum metrics_hist hist, unsigned long long value);
+/* Monotonic time in nanoseconds, for metrics_time() */
+unsigned long long metrics_now(void);
+/* Records the time since start in the histogram's unit */
+void metrics_time(enum metrics_hist hist, unsigned long long start);
+/* Times an event spanning several packets, eg a key exchange. Starting an
+ * event that is already underway has no effect */
+void metrics_event_start(enum metrics_hist hist);
+void metrics_event_done(enum metrics_hist hist);
+
+void metrics_flush(void);
+void metrics_check_flush(time_t now);
+time_t metrics_unflushed_since(void);
+
+/* For the listening server */
+void metrics_shared_init(void);
+void metrics_shared_attach(int fd);
+int metrics_shared_fd(void);
+void metrics_dump(const char *path);
+
+#else
+
+#define metrics_session_start()
+#define metrics_add(counter, n)
+#define metrics_hist_add(hist, value)
+#define metrics_now() 0
+#define metrics_time(hist, start) ((void)(start))
+#define metrics_event_start(hist)
+#define metrics_event_done(hist)
+#define metrics_flush()
+#define metrics_check_flush(now)
+#define metrics_unflushed_since() 0
+
+#endif /* DROPBEAR_METRICS */
+
+#endif /* DROPBEAR_METRICS_H_ */
@@ -4,6 +4,7 @@
 #include "session.h"
 #include "debug.h"
 #include "runopts.h"
+#include "eventloop.h"
 
 struct dropbear_progress_connection {
 	struct addrinfo *res;
@@ -17,24 +18,377 @@ struct dropbear_progress_connection {
 	struct Queue *writequeue; /* A queue of encrypted packets to send with TCP fastopen,
 								or NULL. */
 
-	int sock;
+	/* Attempts in progress. Further addresses are tried in parallel
+	 * every CONNECT_ATTEMPT_DELAY_MS (RFC 8305), the first to connect
+	 * is used */
+	int socks[CONNECT_MAX_ATTEMPTS];
+	unsigned int nsocks;
+	struct timespec last_attempt;
 
 	char* errstring;
 	char *bind_address, *bind_port;
 	enum dropbear_prio prio;
+
+	/* Reading the result of a lookup when resolve_fd >= 0 */
+	int resolve_fd;
+	buffer *resolve_buf;
 };
 
-/* Deallocate a progress connection. Removes from the pending list if iter!=NULL.
-Does not close sockets */
-static void remove_connect(struct dropbear_progress_connection *c, m_list_elem *iter) {
-	if (c->res) {
-		/* Only call freeaddrinfo if connection is not AF_UNIX. */
-		if (c->res->ai_family != AF_UNIX) {
-			freeaddrinfo(c->res);
+/* Address lists are copied out of getaddrinfo() results so they can be
+ * passed back from the resolver process and kept in the cache. Each entry
+ * is a single allocation holding its address, as for AF_UNIX. */
+static void addrlist_free(struct addrinfo *res) {
+	while (res) {
+		struct addrinfo *next = res->ai_next;
+		m_free(res);
+		res = next;
+	}
+}
+
+static struct addrinfo *addrlist_add(struct addrinfo **tail, int family,
+		int socktype, int protocol, const void *addr, socklen_t addrlen) {
+	struct addrinfo *r = m_malloc(sizeof(*r) + addrlen);
+
+	r->ai_family = family;
+	r->ai_socktype = socktype;
+	r->ai_protocol = protocol;
+	r->ai_addrlen = addrlen;
+	r->ai_addr = (struct sockaddr *)(r + 1);
+	memcpy(r->ai_addr, addr, addrlen);
+	*tail = r;
+	return r;
+}
+
+static struct addrinfo *addrlist_copy(const struct addrinfo *src) {
+	struct addrinfo *res = NULL, **tail = &res;
+
+	for (; src; src = src->ai_next) {
+		tail = &addrlist_add(tail, src->ai_family, src->ai_socktype,
+			src->ai_protocol, src->ai_addr, src->ai_addrlen)->ai_next;
+	}
+	return res;
+}
+
+/* Reorders addresses to alternate between address families, keeping the
+ * resolver's preferred family first (RFC 8305 section 4) so a blackholed
+ * family only delays the other by CONNECT_ATTEMPT_DELAY_MS */
+static struct addrinfo *addrlist_interleave(struct addrinfo *res) {
+	struct addrinfo *first = NULL, **first_tail = &first;
+	struct addrinfo *other = NULL, **other_tail = &other;
+	struct addrinfo *out = NULL, **tail = &out;
+	int family;
+
+	if (res == NULL) {
+		return NULL;
+	}
+
+	family = res->ai_family;
+	while (res) {
+		struct addrinfo *next = res->ai_next;
+		res->ai_next = NULL;
+		if (res->ai_family == family) {
+			*first_tail = res;
+			first_tail = &res->ai_next;
 		} else {
-			m_free(c->res);
+			*other_tail = res;
+			other_tail = &res->ai_next;
+		}
+		res = next;
+	}
+
+	while (first || other) {
+		if (first) {
+			*tail = first;
+			tail = &first->ai_next;
+			first = first->ai_next;
+		}
+		if (other) {
+			*tail = other;
+			tail = &other->ai_next;
+			other = other->ai_next;
+		}
+	}
+	return out;
+}
+
+/* Recent lookups, so that repeated connections to a destination
+ * don't wait for the resolver each time */
+struct resolve_cache_entry {
+	char *host, *port;
+	time_t expires;
+	int err; /* getaddrinfo() result */
+	struct addrinfo *res;
+};
+
+static struct resolve_cache_entry resolve_cache[RESOLVE_CACHE_SIZE];
+
+static struct resolve_cache_entry *resolve_cache_find(const char *host,
+		const char *port) {
+	time_t now = monotonic_now();
+	unsigned int i;
+
+	for (i = 0; i < RESOLVE_CACHE_SIZE; i++) {
+		struct resolve_cache_entry *e = &resolve_cache[i];
+		if (e->host && e->expires > now
+				&& strcmp(e->host, host) == 0 && strcmp(e->port, port) == 0) {
+			return e;
+		}
+	}
+	return NULL;
+}
+
+static void resolve_cache_store(const char *host, const char *port,
+		int err, const struct addrinfo *res) {
+	struct resolve_cache_entry *e = NULL;
+	time_t ttl;
+	unsigned int i;
+
+	if (err == 0) {
+		ttl = RESOLVE_CACHE_TTL;
+	} else if (err == EAI_NONAME
+#ifdef EAI_NODATA
+			|| err == EAI_NODATA
+#endif
+			) {
+		ttl = RESOLVE_CACHE_NEGATIVE_TTL;
+	} else {
+		/* temporary failures aren't cached */
+		return;
+	}
+	if (ttl <= 0) {
+		return;
+	}
+
+	/* replace an entry for the same destination, otherwise the one
+	 * expiring soonest */
+	for (i = 0; i < RESOLVE_CACHE_SIZE; i++) {
+		struct resolve_cache_entry *cand = &resolve_cache[i];
+		if (cand->host && strcmp(cand->host, host) == 0
+				&& strcmp(cand->port, port) == 0) {
+			e = cand;
+			break;
+		}
+		if (e == NULL || cand->expires < e->expires) {
+			e = cand;
 		}
 	}
+
+	m_free(e->host);
+	m_free(e->port);
+	addrlist_free(e->res);
+	e->host = m_strdup(host);
+	e->port = m_strdup(port);
+	e->expires = monotonic_now() + ttl;
+	e->err = err;
+	e->res = addrlist_copy(res);
+}
+
+static void set_resolve_error(struct dropbear_progress_connection *c, int err) {
+	int len = 100 + strlen(gai_strerror(err));
+	m_free(c->errstring);
+	c->errstring = (char*)m_malloc(len);
+	snprintf(c->errstring, len, "Error resolving '%s' port '%s'. %s",
+			c->remotehost, c->remoteport, gai_strerror(err));
+	TRACE(("Error resolving: %s", gai_strerror(err)))
+}
+
+/* Sets the connection's address list, or its error, from a lookup */
+static void resolve_done(struct dropbear_progress_connection *c, int err,
+		struct addrinfo *res) {
+	if (err) {
+		set_resolve_error(c, err);
+		addrlist_free(res);
+	} else {
+		c->res = addrlist_interleave(res);
+		c->res_iter = c->res;
+	}
+}
+
+/* Blocking lookup, used for numeric addresses or if the resolver process
+ * can't be started */
+static int resolve_now(const char *host, const char *port, int flags,
+		struct addrinfo **ret) {
+	struct addrinfo hints, *res = NULL;
+	int err;
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_flags = flags;
+
+	err = getaddrinfo(host, port, &hints, &res);
+	if (err == 0) {
+		*ret = addrlist_copy(res);
+		freeaddrinfo(res);
+	}
+	return err;
+}
+
+/* Runs in the resolver process. Writes the getaddrinfo() result followed
+ * by each address as family, socktype, protocol, string address */
+static void resolve_child(int fd, const char *host, const char *port) {
+	struct addrinfo *res = NULL, *r;
+	buffer *buf = NULL;
+	unsigned int len;
+	int i, err;
+
+	/* Don't hold the session's sockets open while waiting for DNS */
+	for (i = 0; i <= MAX(ses.maxfd, fd); i++) {
+		if (i != fd) {
+			close(i);
+		}
+	}
+
+	buf = buf_new(RESOLVE_MAX_RESPONSE);
+	err = resolve_now(host, port, 0, &res);
+	buf_putint(buf, err);
+	for (r = res; r; r = r->ai_next) {
+		if (buf->size - buf->len < 16 + r->ai_addrlen) {
+			break;
+		}
+		buf_putint(buf, r->ai_family);
+		buf_putint(buf, r->ai_socktype);
+		buf_putint(buf, r->ai_protocol);
+		buf_putstring(buf, (const char*)r->ai_addr, r->ai_addrlen);
+	}
+
+	buf_setpos(buf, 0);
+	while (buf->pos < buf->len) {
+		len = buf->len - buf->pos;
+		len = write(fd, buf_getptr(buf, len), len);
+		if ((int)len <= 0) {
+			break;
+		}
+		buf_incrpos(buf, len);
+	}
+}
+
+/* Starts a lookup in a separate process so that a slow DNS server doesn't
+ * stall the session. The result is read from resolve_fd once it's readable.
+ * The process is double-forked so that it is never seen by the session's
+ * SIGCHLD handling. Returns DROPBEAR_FAILURE if it couldn't be started. */
+static int resolve_start(struct dropbear_progress_connection *c) {
+	int fds[2];
+	int status;
+	pid_t pid;
+
+	if (pipe(fds) < 0) {
+		return DROPBEAR_FAILURE;
+	}
+
+	pid = fork();
+	if (pid == 0) {
+		/* child */
+		close(fds[0]);
+		pid = fork();
+		if (pid == 0) {
+			resolve_child(fds[1], c->remotehost, c->remoteport);
+			_exit(0);
+		}
+		_exit(pid < 0 ? 1 : 0);
+	}
+
+	close(fds[1]);
+	if (pid < 0) {
+		close(fds[0]);
+		return DROPBEAR_FAILURE;
+	}
+	while (waitpid(pid, &status, 0) < 0) {
+		if (errno != EINTR) {
+			/* shouldn't happen */
+			status = 0;
+			break;
+		}
+	}
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		close(fds[0]);
+		return DROPBEAR_FAILURE;
+	}
+
+	setnonblocking(fds[0]);
+	ses.maxfd = MAX(ses.maxfd, fds[0]);
+	c->resolve_fd = fds[0];
+	c->resolve_buf = buf_new(RESOLVE_MAX_RESPONSE);
+	return DROPBEAR_SUCCESS;
+}
+
+/* Parses the resolver process's output */
+static int resolve_parse(buffer *buf, struct addrinfo **ret) {
+	struct addrinfo *res = NULL, **tail = &res;
+	int err = EAI_FAIL;
+
+	buf_setpos(buf, 0);
+	if (buf->len < 4) {
+		return EAI_FAIL;
+	}
+	err = buf_getint(buf);
+	while (err == 0 && buf->len - buf->pos >= 16) {
+		int family = buf_getint(buf);
+		int socktype = buf_getint(buf);
+		int protocol = buf_getint(buf);
+		unsigned int addrlen = buf_getint(buf);
+		if (addrlen > sizeof(struct sockaddr_storage)
+				|| addrlen > buf->len - buf->pos) {
+			break;
+		}
+		tail = &addrlist_add(tail, family, socktype, protocol,
+			buf_getptr(buf, addrlen), addrlen)->ai_next;
+		buf_incrpos(buf, addrlen);
+	}
+	if (err == 0 && res == NULL) {
+		err = EAI_FAIL;
+	}
+	*ret = res;
+	return err;
+}
+
+/* Reads from a readable resolve_fd, completing the lookup at EOF */
+static void resolve_read(struct dropbear_progress_connection *c) {
+	struct addrinfo *res = NULL;
+	buffer *buf = c->resolve_buf;
+	ssize_t len;
+	int err;
+
+	len = read(c->resolve_fd, buf_getwriteptr(buf, buf->size - buf->len),
+			buf->size - buf->len);
+	if (len < 0 && (errno == EINTR || errno == EAGAIN)) {
+		return;
+	}
+	if (len > 0) {
+		buf_incrwritepos(buf, len);
+		if (buf->len < buf->size) {
+			return;
+		}
+	}
+
+	/* EOF, error, or a full buffer */
+	m_close(c->resolve_fd);
+	c->resolve_fd = -1;
+
+	err = resolve_parse(buf, &res);
+	buf_free(c->resolve_buf);
+	c->resolve_buf = NULL;
+
+	resolve_cache_store(c->remotehost, c->remoteport, err, res);
+	resolve_done(c, err, res);
+}
+
+/* Deallocate a progress connection. Removes from the pending list if iter!=NULL.
+Closes any connection attempts still in progress */
+static void remove_connect(struct dropbear_progress_connection *c, m_list_elem *iter) {
+	unsigned int i;
+
+	for (i = 0; i < c->nsocks; i++) {
+		m_close(c->socks[i]);
+	}
+	addrlist_free(c->res);
+	if (c->resolve_fd >= 0) {
+		/* the resolver process will exit when it finds the pipe closed */
+		m_close(c->resolve_fd);
+	}
+	if (c->resolve_buf) {
+		buf_free(c->resolve_buf);
+	}
 	m_free(c->remotehost);
 	m_free(c->remoteport);
 	m_free(c->errstring);
@@ -61,6 +415,7 @@ void cancel_connect(struct dropbear_progress_connection *c) {
 
 static void connect_try_next(struct dropbear_progress_connection *c) {
 	struct addrinfo *r;
+	int sock = -1;
 	int err;
 	int res = 0;
 	int fastopen = 0;
@@ -71,10 +426,8 @@ static void connect_try_next(struct dropbear_progress_connection *c) {
 
 	for (r = c->res_iter; r; r = r->ai_next)
 	{
-		dropbear_assert(c->sock == -1);
-
-		c->sock = socket(r->ai_family, r->ai_socktype, r->ai_protocol);
-		if (c->sock < 0) {
+		sock = socket(r->ai_family, r->ai_socktype, r->ai_protocol);
+		if (sock < 0) {
 			continue;
 		}
 
@@ -100,11 +453,11 @@ static void connect_try_next(struct dropbear_progress_connection *c) {
 				snprintf(c->errstring, len, "Error resolving bind address '%s' (port %s). %s",
 						c->bind_address, c->bind_port, gai_strerror(err));
 				TRACE(("Error resolving bind: %s", gai_strerror(err)))
-				close(c->sock);
-				c->sock = -1;
+				close(sock);
+				sock = -1;
 				continue;
 			}
-			res = bind(c->sock, bindaddr->ai_addr, bindaddr->ai_addrlen);
+			res = bind(sock, bindaddr->ai_addr, bindaddr->ai_addrlen);
 			freeaddrinfo(bindaddr);
 			bindaddr = NULL;
 			if (res < 0) {
@@ -115,16 +468,16 @@ static void connect_try_next(struct dropbear_progress_connection *c) {
 				c->errstring = m_malloc(len);
 				snprintf(c->errstring, len, "Error binding local address '%s' (port %s). %s",
 						c->bind_address, c->bind_port, strerror(keep_errno));
-				close(c->sock);
-				c->sock = -1;
+				close(sock);
+				sock = -1;
 				continue;
 			}
 		}
 
-		ses.maxfd = MAX(ses.maxfd, c->sock);
-		set_sock_nodelay(c->sock);
-		set_sock_priority(c->sock, c->prio);
-		setnonblocking(c->sock);
+		ses.maxfd = MAX(ses.maxfd, sock);
+		set_sock_nodelay(sock);
+		set_sock_priority(sock, c->prio);
+		setnonblocking(sock);
 
 #if DROPBEAR_CLIENT_TCP_FAST_OPEN
 		fastopen = (c->writequeue != NULL && r->ai_family != AF_UNIX);
@@ -139,7 +492,7 @@ static void connect_try_next(struct dropbear_progress_connection *c) {
 			packet_queue_to_iovec(c->writequeue, iov, &iovlen);
 			message.msg_iov = iov;
 			message.msg_iovlen = iovlen;
-			res = sendmsg(c->sock, &message, MSG_FASTOPEN);
+			res = sendmsg(sock, &message, MSG_FASTOPEN);
 			/* Returns EINPROGRESS if FASTOPEN wasn't available */
 			if (res < 0) {
 				if (errno != EINPROGRESS) {
@@ -161,15 +514,15 @@ static void connect_try_next(struct dropbear_progress_connection *c) {
 
 		/* Normal connect(), used as fallback for TCP fastopen too */
 		if (!fastopen) {
-			res = connect(c->sock, r->ai_addr, r->ai_addrlen);
+			res = connect(sock, r->ai_addr, r->ai_addrlen);
 		}
 
 		if (res < 0 && errno != retry_errno) {
 			/* failure */
 			m_free(c->errstring);
 			c->errstring = m_strdup(strerror(errno));
-			close(c->sock);
-			c->sock = -1;
+			close(sock);
+			sock = -1;
 			continue;
 		} else {
 			/* new connection was successful, wait for it to complete */
@@ -179,6 +532,8 @@ static void connect_try_next(struct dropbear_progress_connection *c) {
 
 	if (r) {
 		c->res_iter = r->ai_next;
+		c->socks[c->nsocks++] = sock;
+		gettime_wrapper(&c->last_attempt);
 	} else {
 		c->res_iter = NULL;
 	}
@@ -190,19 +545,27 @@ struct dropbear_progress_connection *connect_remote(const char* remotehost, cons
 	const char* bind_address, const char* bind_port, enum dropbear_prio prio)
 {
 	struct dropbear_progress_connection *c = NULL;
+	struct resolve_cache_entry *cached = NULL;
+	struct addrinfo *res = NULL;
 	int err;
-	struct addrinfo hints;
 
 	c = m_malloc(sizeof(*c));
 	c->remotehost = m_strdup(remotehost);
 	c->remoteport = m_strdup(remoteport);
-	c->sock = -1;
+	c->resolve_fd = -1;
 	c->cb = cb;
 	c->cb_data = cb_data;
 	c->prio = prio;
 
 	list_append(&ses.conn_pending, c);
 
+	if (bind_address) {
+		c->bind_address = m_strdup(bind_address);
+	}
+	if (bind_port) {
+		c->bind_port = m_strdup(bind_port);
+	}
+
 #if DROPBEAR_FUZZ
 	if (fuzz.fuzzing) {
 		c->errstring = m_strdup("fuzzing connect_remote always fails");
@@ -210,27 +573,26 @@ struct dropbear_progress_connection *connect_remote(const char* remotehost, cons
 	}
 #endif
 
-	memset(&hints, 0, sizeof(hints));
-	hints.ai_socktype = SOCK_STREAM;
-	hints.ai_family = AF_UNSPEC;
-
-	err = getaddrinfo(remotehost, remoteport, &hints, &c->res);
-	if (err) {
-		int len;
-		len = 100 + strlen(gai_strerror(err));
-		c->errstring = (char*)m_malloc(len);
-		snprintf(c->errstring, len, "Error resolving '%s' port '%s'. %s",
-				remotehost, remoteport, gai_strerror(err));
-		TRACE(("Error resolving: %s", gai_strerror(err)))
-	} else {
-		c->res_iter = c->res;
+	cached = resolve_cache_find(remotehost, remoteport);
+	if (cached) {
+		TRACE(("connect_remote: cached lookup for %s port %s", remotehost, remoteport))
+		resolve_done(c, cached->err, addrlist_copy(cached->res));
+		return c;
 	}
-	
-	if (bind_address) {
-		c->bind_address = m_strdup(bind_address);
+
+	/* Numeric addresses don't need the resolver */
+	err = resolve_now(remotehost, remoteport, AI_NUMERICHOST, &res);
+	if (err != EAI_NONAME) {
+		resolve_done(c, err, res);
+		return c;
 	}
-	if (bind_port) {
-		c->bind_port = m_strdup(bind_port);
+
+	if (resolve_start(c) == DROPBEAR_FAILURE) {
+		TRACE(("connect_remote: resolver process failed, resolving inline"))
+		res = NULL;
+		err = resolve_now(remotehost, remoteport, 0, &res);
+		resolve_cache_store(remotehost, remoteport, err, res);
+		resolve_done(c, err, res);
 	}
 
 	return c;
@@ -247,7 +609,7 @@ struct dropbear_progress_connection *connect_streamlocal(const char* localpath,
 	c = m_malloc(sizeof(*c));
 	c->remotehost = m_strdup(localpath);
 	c->remoteport = NULL;
-	c->sock = -1;
+	c->resolve_fd = -1;
 	c->cb = cb;
 	c->cb_data = cb_data;
 	c->prio = prio;
@@ -267,11 +629,7 @@ struct dropbear_progress_connection *connect_streamlocal(const char* localpath,
 		return c;
 	}
 
-	/*
-	 * Fake up a struct addrinfo for AF_UNIX connections.
-	 * remove_connect() must check ai_family
-	 * and use m_free() not freeaddirinfo() for AF_UNIX.
-	 */
+	/* Fake up a struct addrinfo for AF_UNIX connections */
 	c->res = m_malloc(sizeof(*c->res) + sizeof(*sunaddr));
 	c->res->ai_addr = (struct sockaddr *)(c->res + 1);
 	c->res->ai_addrlen = sizeof(*sunaddr);
@@ -296,18 +654,54 @@ void remove_connect_pending() {
 }
 
 
-void set_connect_fds(fd_set *writefd) {
+/* Milliseconds until the next staggered attempt may start, 0 if it can
+ * start now or -1 if no more attempts will be started in parallel */
+static long connect_next_delay(const struct dropbear_progress_connection *c) {
+	struct timespec now;
+	long since;
+
+	if (c->res_iter == NULL || c->nsocks >= CONNECT_MAX_ATTEMPTS
+			|| (c->nsocks > 0 && c->writequeue != NULL)) {
+		/* TCP fast open data is sent with the first attempt, so it
+		 * can't be raced */
+		return -1;
+	}
+	if (c->nsocks == 0) {
+		return 0;
+	}
+	gettime_wrapper(&now);
+	since = (now.tv_sec - c->last_attempt.tv_sec) * 1000
+		+ (now.tv_nsec - c->last_attempt.tv_nsec) / 1000000;
+	return MAX(CONNECT_ATTEMPT_DELAY_MS - since, 0);
+}
+
+void set_connect_fds() {
 	m_list_elem *iter;
 	iter = ses.conn_pending.first;
 	while (iter) {
 		m_list_elem *next_iter = iter->next;
 		struct dropbear_progress_connection *c = iter->item;
-		/* Set one going */
-		while (c->res_iter && c->sock < 0) {
+		unsigned int i;
+		long delay;
+
+		if (c->resolve_fd >= 0) {
+			/* Still resolving */
+			evloop_want(c->resolve_fd, EVLOOP_READ, EVLOOP_KIND_OTHER, 0);
+			iter = next_iter;
+			continue;
+		}
+		/* Set one going, or another one if the others haven't
+		 * completed within the attempt delay */
+		while ((delay = connect_next_delay(c)) == 0) {
 			connect_try_next(c);
 		}
-		if (c->sock >= 0) {
-			FD_SET(c->sock, writefd);
+		if (c->nsocks > 0) {
+			for (i = 0; i < c->nsocks; i++) {
+				evloop_want(c->socks[i], EVLOOP_WRITE, EVLOOP_KIND_OTHER, 0);
+			}
+			if (delay > 0) {
+				evloop_wake_within(delay);
+			}
 		} else {
 			/* Final failure */
 			if (!c->errstring) {
@@ -320,39 +714,56 @@ void set_connect_fds(fd_set *writefd) {
 	}
 }
 
-void handle_connect_fds(const fd_set *writefd) {
+void handle_connect_fds() {
 	m_list_elem *iter;
 	for (iter = ses.conn_pending.first; iter; iter = iter->next) {
-		int val;
-		socklen_t vallen = sizeof(val);
 		struct dropbear_progress_connection *c = iter->item;
+		unsigned int i;
 
-		if (c->sock < 0 || !FD_ISSET(c->sock, writefd)) {
+		if (c->resolve_fd >= 0) {
+			if (evloop_ready(c->resolve_fd, EVLOOP_READ)) {
+				resolve_read(c);
+			}
 			continue;
 		}
 
-		TRACE(("handling %s port %s socket %d", c->remotehost, c->remoteport, c->sock));
+		for (i = 0; i < c->nsocks; ) {
+			int sock = c->socks[i];
+			int val;
+			socklen_t vallen = sizeof(val);
 
-		if (getsockopt(c->sock, SOL_SOCKET, SO_ERROR, &val, &vallen) != 0) {
-			TRACE(("handle_connect_fds getsockopt(%d) SO_ERROR failed: %s", c->sock, strerror(errno)))
-			/* This isn't expected to happen - Unix has surprises though, continue gracefully. */
-			m_close(c->sock);
-			c->sock = -1;
-		} else if (val != 0) {
-			/* Connect failed */
-			TRACE(("connect to %s port %s failed.", c->remotehost, c->remoteport))
-			m_close(c->sock);
-			c->sock = -1;
+			if (!evloop_ready(sock, EVLOOP_WRITE)) {
+				i++;
+				continue;
+			}
 
-			m_free(c->errstring);
-			c->errstring = m_strdup(strerror(val));
-		} else {
-			/* New connection has been established */
-			c->cb(DROPBEAR_SUCCESS, c->sock, c->cb_data, NULL);
-			remove_connect(c, iter);
-			TRACE(("leave handle_connect_fds - success"))
-			/* Must return here - remove_connect() invalidates iter */
-			return;
+			TRACE(("handling %s port %s socket %d", c->remotehost, c->remoteport, sock));
+
+			if (getsockopt(sock, SOL_SOCKET, SO_ERROR, &val, &vallen) != 0) {
+				TRACE(("handle_connect_fds getsockopt(%d) SO_ERROR failed: %s", sock, strerror(errno)))
+				/* This isn't expected to happen - Unix has surprises though, continue gracefully. */
+				val = errno;
+			}
+			if (val != 0) {
+				/* Connect failed, the next address can be tried
+				 * straight away */
+				TRACE(("connect to %s port %s failed.", c->remotehost, c->remoteport))
+				m_close(sock);
+				c->socks[i] = c->socks[--c->nsocks];
+				memset(&c->last_attempt, 0x0, sizeof(c->last_attempt));
+
+				m_free(c->errstring);
+				c->errstring = m_strdup(strerror(val));
+			} else {
+				/* New connection has been established, the
+				 * other attempts are closed by remove_connect() */
+				c->socks[i] = c->socks[--c->nsocks];
+				c->cb(DROPBEAR_SUCCESS, sock, c->cb_data, NULL);
+				remove_connect(c, iter);
+				TRACE(("leave handle_connect_fds - success"))
+				/* Must return here - remove_connect() invalidates iter */
+				return;
+			}
 		}
 	}
 }
@@ -362,7 +773,6 @@ void connect_set_writequeue(struct dropbear_progress_connection *c, struct Queue
 }
 
 void packet_queue_to_iovec(const struct Queue *queue, struct iovec *iov, unsigned int *iov_count) {
-	struct Link *l;
 	unsigned int i;
 	int len;
 	buffer *writebuf;
@@ -379,9 +789,9 @@ void packet_queue_to_iovec(const struct Queue *queue, struct iovec *iov, unsigne
 
 	*iov_count = MIN(MIN(queue->count, IOV_MAX), *iov_count);
 
-	for (l = queue->head, i = 0; i < *iov_count; l = l->link, i++)
+	for (i = 0; i < *iov_count; i++)
 	{
-		writebuf = (buffer*)l->item;
+		writebuf = (buffer*)examine_nth(queue, i);
 		len = writebuf->len - writebuf->pos;
 		dropbear_assert(len > 0);
 		TRACE2(("write_packet writev #%d len %d/%d", i,
@@ -404,7 +814,7 @@ void packet_queue_consume(struct Queue *queue, ssize_t written) {
 		} else {
 			written -= len;
 			dequeue(queue);
-			buf_free(writebuf);
+			writebuf_release(writebuf);
 		}
 	}
 }
@@ -526,11 +936,14 @@ int get_sock_port(int sock) {
 /* Listen on address:port.
  * Special cases are address of "" listening on everything,
  * and address of NULL listening on localhost only.
+ * With reuseport, SO_REUSEPORT is set so that other processes can listen
+ * on the same address, where supported.
  * Returns the number of sockets bound on success, or -1 on failure. On
  * failure, if errstring wasn't NULL, it'll be a newly malloced error
  * string.*/
 int dropbear_listen(const char* address, const char* port,
-		int *socks, unsigned int sockcount, char **errstring, int *maxfd, const char* interface) {
+		int *socks, unsigned int sockcount, char **errstring, int *maxfd,
+		const char* interface, int reuseport) {
 
 	struct addrinfo hints, *res = NULL, *res0 = NULL;
 	int err;
@@ -617,6 +1030,14 @@ int dropbear_listen(const char* address, const char* port,
 		val = 1;
 		/* set to reuse, quick timeout */
 		setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (void*) &val, sizeof(val));
+#ifdef SO_REUSEPORT
+		if (reuseport && setsockopt(sock, SOL_SOCKET, SO_REUSEPORT,
+					(void*) &val, sizeof(val)) < 0) {
+			dropbear_log(LOG_WARNING, "Couldn't set SO_REUSEPORT");
+		}
+#else
+		(void)reuseport;
+#endif
 
 #ifdef SO_BINDTODEVICE
 		if(interface && setsockopt(sock, SOL_SOCKET, SO_BINDTODEVICE, interface, strlen(interface)) < 0) {
@@ -19,7 +19,8 @@ void get_socket_address(int fd, char **local_host, char **local_port,
 void getaddrstring(struct sockaddr_storage* addr,
 		char **ret_host, char **ret_port, int host_lookup);
 int dropbear_listen(const char* address, const char* port,
-		int *socks, unsigned int sockcount, char **errstring, int *maxfd, const char* interface);
+		int *socks, unsigned int sockcount, char **errstring, int *maxfd,
+		const char* interface, int reuseport);
 
 struct dropbear_progress_connection;
 
@@ -38,9 +39,9 @@ struct dropbear_progress_connection * connect_streamlocal (const char* localpath
 	enum dropbear_prio prio);
 
 /* Sets up for select() */
-void set_connect_fds(fd_set *writefd);
+void set_connect_fds(void);
 /* Handles ready sockets after select() */
-void handle_connect_fds(const fd_set *writefd);
+void handle_connect_fds(void);
 /* Cleanup */
 void remove_connect_pending(void);
 
@@ -0,0 +1,1154 @@
+/* Base point tables for the comb multiplication in nistp.c. Entry j-1 is
+ * the affine point x || y (big endian) of the sum of 2^(i*d) G over the bits
+ * i that are set in j, for j from 1 to 2^NISTP_COMB_TEETH - 1. d is the
+ * curve's comb spacing, ceil(bits / NISTP_COMB_TEETH). Generated by
+ * nistp-tables.py */
+
+#ifndef DROPBEAR_NISTP_TABLES_H_
+#define DROPBEAR_NISTP_TABLES_H_
+
+#if DROPBEAR_ECC_256
+static const unsigned char nistp256_comb[(1 << NISTP_COMB_TEETH) - 1][64] = {
+	{
+		0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc, 0xe6, 0xe5,
+		0x63, 0xa4, 0x40, 0xf2, 0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0,
+		0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96, 0x4f, 0xe3, 0x42, 0xe2,
+		0xfe, 0x1a, 0x7f, 0x9b, 0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+		0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce, 0xcb, 0xb6, 0x40, 0x68,
+		0x37, 0xbf, 0x51, 0xf5
+	},
+	{
+		0x98, 0x7f, 0x25, 0x6d, 0x58, 0xcf, 0xf9, 0x37, 0x3b, 0xe7, 0x19, 0x69,
+		0xfc, 0x3a, 0x93, 0x01, 0xe8, 0xf9, 0x25, 0x7a, 0xe5, 0x7f, 0xdc, 0x00,
+		0xcd, 0x01, 0x3f, 0x88, 0xb0, 0x49, 0xe7, 0xcd, 0x8e, 0x92, 0x69, 0x56,
+		0x94, 0xec, 0x50, 0x5c, 0xe8, 0x60, 0xeb, 0xd6, 0x00, 0x07, 0xe3, 0x9e,
+		0x47, 0xb4, 0x60, 0x52, 0x07, 0xaa, 0xff, 0xdb, 0xb7, 0x25, 0x4b, 0xbc,
+		0x6e, 0xfa, 0x35, 0xd6
+	},
+	{
+		0xef, 0xcc, 0x2c, 0x43, 0x6e, 0xd1, 0xb2, 0xaf, 0x2d, 0xf1, 0xc4, 0x1e,
+		0xd2, 0xbc, 0x2f, 0xa6, 0x98, 0xb3, 0xce, 0x2a, 0xbf, 0x31, 0x8e, 0xb2,
+		0x59, 0xdb, 0x16, 0x7c, 0x5a, 0x1c, 0x3f, 0xb1, 0xf3, 0x68, 0x4f, 0x9c,
+		0x8d, 0x9f, 0x38, 0x63, 0xa5, 0x38, 0x4a, 0x77, 0xed, 0x34, 0xf5, 0x43,
+		0x46, 0x82, 0x45, 0x33, 0x37, 0x34, 0xa5, 0x89, 0x17, 0xfe, 0x07, 0xf1,
+		0x97, 0xb2, 0x55, 0x13
+	},
+	{
+		0x6e, 0xec, 0x95, 0x67, 0x0d, 0x54, 0x65, 0x0c, 0xc1, 0x4b, 0x66, 0xdd,
+		0x02, 0x43, 0x68, 0x93, 0xff, 0xdc, 0x67, 0x94, 0x2d, 0x66, 0x68, 0x17,
+		0xfd, 0xc7, 0x3e, 0x83, 0xbf, 0x78, 0x0c, 0x2c, 0x14, 0xbb, 0x53, 0x50,
+		0x99, 0x77, 0x32, 0xc2, 0xfc, 0x28, 0x1d, 0xe0, 0x65, 0xea, 0x01, 0x05,
+		0x79, 0xab, 0x66, 0x15, 0x3a, 0x07, 0xff, 0x89, 0x08, 0x9e, 0xc1, 0xa1,
+		0xed, 0xbf, 0xcd, 0x32
+	},
+	{
+		0x13, 0xcc, 0xca, 0x34, 0x55, 0xfa, 0x62, 0x5c, 0xbf, 0x66, 0x4d, 0x2f,
+		0x09, 0x9c, 0x20, 0x2b, 0x41, 0x0b, 0xec, 0x28, 0xca, 0x16, 0x70, 0x99,
+		0xae, 0xc9, 0x02, 0x64, 0x73, 0x18, 0x18, 0x8e, 0x4b, 0x5b, 0xa5, 0xa5,
+		0xaf, 0x46, 0x89, 0x3d, 0xe9, 0x04, 0x46, 0xb1, 0xfb, 0x21, 0x6a, 0x5e,
+		0x6b, 0x64, 0x75, 0x21, 0x6c, 0xdb, 0x0d, 0x71, 0xaa, 0x84, 0xc2, 0x31,
+		0x05, 0x42, 0x1c, 0x0c
+	},
+	{
+		0xf8, 0x6a, 0x90, 0x78, 0x98, 0x03, 0x30, 0xf5, 0xab, 0x83, 0x9a, 0x14,
+		0xe4, 0xe0, 0x9f, 0xd2, 0xdd, 0xff, 0xc2, 0x22, 0xa1, 0x71, 0x7f, 0x8a,
+		0xac, 0xa2, 0xfa, 0x08, 0x48, 0x62, 0xc5, 0xdb, 0x20, 0x34, 0x7d, 0x0c,
+		0x25, 0x68, 0x65, 0x3c, 0xba, 0x26, 0x12, 0xb8, 0xff, 0x9a, 0x09, 0x3b,
+		0xf7, 0x5d, 0xcc, 0xfa, 0xea, 0x6e, 0xfd, 0x98, 0x68, 0x90, 0xf2, 0x4c,
+		0xc1, 0xdd, 0x7d, 0xcc
+	},
+	{
+		0x0f, 0x74, 0x34, 0x2a, 0x40, 0xe7, 0xe7, 0xe7, 0xb6, 0xe2, 0x87, 0x40,
+		0xbf, 0xe8, 0x0f, 0x8b, 0x55, 0x91, 0xc8, 0xeb, 0x30, 0xf6, 0xcd, 0xa4,
+		0xd3, 0xb2, 0x28, 0x09, 0xcb, 0xdb, 0x1c, 0x78, 0x53, 0x1c, 0x0b, 0x00,
+		0xf5, 0xc1, 0xec, 0x07, 0x6f, 0x58, 0xf0, 0x2a, 0x9d, 0x99, 0x4e, 0x2e,
+		0x65, 0xc5, 0xc5, 0x81, 0xf5, 0xe1, 0x7b, 0x5e, 0xd2, 0x96, 0x8e, 0x87,
+		0x35, 0x1c, 0x51, 0xf2
+	},
+	{
+		0xa2, 0x63, 0x91, 0x9b, 0x49, 0x45, 0xa1, 0xd4, 0x47, 0x50, 0x1f, 0x2a,
+		0x3c, 0x08, 0x04, 0xc3, 0x80, 0x2f, 0x77, 0x9e, 0xa7, 0xf6, 0x80, 0x3a,
+		0xeb, 0x04, 0x21, 0x21, 0x1a, 0x6b, 0x66, 0x5e, 0x87, 0x32, 0x00, 0xbd,
+		0x2a, 0xed, 0x20, 0xfc, 0x2e, 0x9d, 0x3c, 0x9d, 0xe6, 0x0d, 0x60, 0xc5,
+		0xac, 0x3f, 0x83, 0xdf, 0x4c, 0x00, 0xef, 0xe2, 0x9e, 0xe4, 0x04, 0x00,
+		0x30, 0xbc, 0xdc, 0xfb
+	},
+	{
+		0x27, 0xd6, 0x45, 0x1e, 0xc4, 0x02, 0xe0, 0x50, 0xba, 0xa9, 0x28, 0x14,
+		0x88, 0xb4, 0x51, 0x27, 0x0f, 0x50, 0x36, 0x29, 0x5a, 0x7e, 0x87, 0x0d,
+		0x2b, 0x52, 0xc4, 0x7d, 0x8b, 0x21, 0xaa, 0x51, 0x2a, 0x58, 0xfa, 0x5e,
+		0x1b, 0xe9, 0xe5, 0x83, 0x5d, 0x91, 0x74, 0x0c, 0xcd, 0xee, 0xf5, 0x66,
+		0xcd, 0xeb, 0x98, 0x29, 0x0f, 0x41, 0x50, 0xc7, 0x5c, 0x96, 0xec, 0x14,
+		0x55, 0x67, 0x43, 0x2d
+	},
+	{
+		0x78, 0x5b, 0x7e, 0x91, 0x09, 0x90, 0x4e, 0x3f, 0x5c, 0x97, 0x1d, 0xdb,
+		0x14, 0xe2, 0x28, 0x0f, 0x89, 0xbf, 0x52, 0x29, 0x24, 0x7f, 0xde, 0x25,
+		0xd8, 0x14, 0x2d, 0xff, 0x57, 0x88, 0xc0, 0xf6, 0x6b, 0x44, 0x05, 0x9d,
+		0xfa, 0x3e, 0xa3, 0x2d, 0x96, 0xb8, 0x4f, 0x57, 0xc7, 0x97, 0xbe, 0x30,
+		0x87, 0x89, 0x44, 0x0e, 0x4c, 0xe2, 0x93, 0xdd, 0x44, 0x5e, 0x45, 0x19,
+		0x2e, 0x7e, 0x6f, 0x0b
+	},
+	{
+		0xdc, 0x90, 0xd9, 0x75, 0xa2, 0xbd, 0x0e, 0xd8, 0xc0, 0xb9, 0xec, 0xd2,
+		0xe1, 0x04, 0xe9, 0xac, 0x2d, 0x7e, 0xd4, 0x74, 0xb8, 0xdd, 0x58, 0x13,
+		0x73, 0xb7, 0xc5, 0x50, 0x21, 0x95, 0xa9, 0x79, 0xc8, 0x7c, 0xe2, 0x32,
+		0x81, 0x53, 0x74, 0xc4, 0x4c, 0xfd, 0x32, 0x77, 0xf0, 0x97, 0x7a, 0x30,
+		0x50, 0xd5, 0x54, 0xbb, 0xc0, 0x1d, 0xfd, 0xe8, 0x9f, 0xb5, 0x52, 0x03,
+		0x4d, 0xd6, 0xeb, 0x2e
+	},
+	{
+		0xbd, 0xdc, 0x23, 0xac, 0x5c, 0x30, 0x12, 0x77, 0xb9, 0x5f, 0x91, 0xb3,
+		0xf5, 0x52, 0x64, 0x1e, 0x1c, 0x65, 0x05, 0x87, 0x08, 0xb4, 0x9b, 0x2f,
+		0xe4, 0xb5, 0x41, 0xb6, 0xcf, 0x9a, 0x3c, 0xa9, 0x7d, 0x0c, 0xa9, 0x42,
+		0x5b, 0x04, 0xf7, 0x61, 0x73, 0xa1, 0xc8, 0xf5, 0x4e, 0x48, 0xef, 0xde,
+		0xc0, 0x03, 0xdc, 0xc3, 0x84, 0x50, 0xcf, 0xa2, 0x51, 0x9d, 0x07, 0x00,
+		0x04, 0xda, 0xba, 0x43
+	},
+	{
+		0xaf, 0xb1, 0x8d, 0x2f, 0xad, 0x6b, 0x22, 0x5f, 0x11, 0x23, 0x21, 0xeb,
+		0x29, 0xf0, 0x28, 0x78, 0x4f, 0xd3, 0xaf, 0xc9, 0x75, 0xda, 0xc5, 0x4c,
+		0xcb, 0x4d, 0xc3, 0x5b, 0x17, 0x03, 0x40, 0x6d, 0x5e, 0xd8, 0x1c, 0x10,
+		0xfc, 0xca, 0x48, 0x77, 0x31, 0xa8, 0xd6, 0x63, 0x22, 0x20, 0x8f, 0xfb,
+		0x96, 0x88, 0x97, 0x55, 0xf6, 0xb9, 0x6c, 0x2f, 0xdd, 0xf5, 0x82, 0x73,
+		0xf1, 0x77, 0x6a, 0x67
+	},
+	{
+		0xed, 0x6e, 0x13, 0xe0, 0x38, 0x92, 0xdd, 0xc5, 0x10, 0xeb, 0x19, 0x4a,
+		0x01, 0x5a, 0x21, 0x1b, 0x0d, 0x59, 0xb6, 0xae, 0x1c, 0x4a, 0xb2, 0x36,
+		0xff, 0x0e, 0x1f, 0x34, 0xe8, 0x34, 0xa3, 0xc4, 0x02, 0xf3, 0x22, 0xe5,
+		0x80, 0xd9, 0xa8, 0xcc, 0xcd, 0xe8, 0xcd, 0x7a, 0x61, 0x9c, 0xec, 0xba,
+		0x6f, 0x0f, 0xbf, 0x44, 0x54, 0x40, 0x26, 0xa9, 0xac, 0x88, 0xdf, 0x04,
+		0xfb, 0x3f, 0x67, 0x8d
+	},
+	{
+		0x46, 0x0f, 0xa9, 0xcf, 0x23, 0x41, 0xf4, 0x99, 0x2f, 0xb3, 0x20, 0x23,
+		0x65, 0x11, 0xb3, 0x70, 0x89, 0x7e, 0x87, 0xbd, 0x42, 0x51, 0xf5, 0xb7,
+		0x2d, 0xc6, 0x1e, 0x1b, 0x33, 0x6a, 0xaf, 0x40, 0x18, 0xd6, 0xf6, 0x3a,
+		0x41, 0x77, 0x5e, 0x62, 0x9d, 0x59, 0x22, 0x6e, 0x80, 0x9e, 0x4a, 0x1a,
+		0x93, 0x7e, 0x12, 0x3f, 0x44, 0x15, 0x74, 0x34, 0x03, 0xe6, 0x3b, 0x79,
+		0xcb, 0xaf, 0x01, 0xa7
+	},
+	{
+		0x45, 0xa5, 0x11, 0xc9, 0x7f, 0x60, 0x8b, 0xf7, 0x6d, 0xbc, 0x41, 0x89,
+		0xd9, 0x91, 0xec, 0xe6, 0x18, 0xc4, 0x52, 0xb1, 0xb4, 0x2a, 0x62, 0x7f,
+		0x3c, 0xd5, 0xf4, 0xe4, 0xa9, 0xaa, 0x52, 0xdf, 0x73, 0xbe, 0x0e, 0xc7,
+		0x73, 0xea, 0x9b, 0x6d, 0x3f, 0xe3, 0x33, 0x7f, 0xcb, 0x62, 0x5a, 0xd2,
+		0x5a, 0x91, 0x9b, 0x27, 0xd2, 0x29, 0x55, 0xce, 0x7b, 0x52, 0xbd, 0x12,
+		0x12, 0x5e, 0xc1, 0x6c
+	},
+	{
+		0xdf, 0x6b, 0x47, 0x2f, 0xb5, 0x2a, 0xcd, 0x25, 0x19, 0x75, 0xb7, 0x1e,
+		0xcb, 0xe4, 0x90, 0xd2, 0x71, 0xb9, 0xa7, 0xe5, 0xd4, 0xec, 0x25, 0x10,
+		0xc6, 0xe4, 0xb6, 0xd0, 0x01, 0x64, 0x76, 0xea, 0xb4, 0x26, 0x39, 0xe1,
+		0xa8, 0x8f, 0xd5, 0x93, 0x3c, 0x9a, 0x13, 0x37, 0x1b, 0xb5, 0x11, 0x19,
+		0xcc, 0xc7, 0xb0, 0xb3, 0xb8, 0x7d, 0x39, 0x9e, 0xf1, 0x73, 0x87, 0x16,
+		0x78, 0x40, 0x55, 0xeb
+	},
+	{
+		0xd9, 0x49, 0xca, 0xa2, 0x24, 0xce, 0x0e, 0x94, 0xf4, 0xcf, 0x87, 0x97,
+		0x72, 0x09, 0x66, 0x38, 0xaf, 0xcd, 0xd2, 0xca, 0xb5, 0x0a, 0x47, 0x33,
+		0x86, 0xa3, 0x8d, 0x54, 0xc2, 0x19, 0xc2, 0x0b, 0x67, 0x3e, 0xd5, 0x00,
+		0x57, 0xdb, 0x92, 0x4d, 0x62, 0x2a, 0xbc, 0x7f, 0x8d, 0x54, 0x95, 0x67,
+		0x00, 0xef, 0x5b, 0xa9, 0xc9, 0x84, 0xde, 0x46, 0x67, 0x86, 0x64, 0xae,
+		0x96, 0xf9, 0xae, 0x13
+	},
+	{
+		0xff, 0xcb, 0x7d, 0xdc, 0xa5, 0x62, 0x1c, 0x63, 0xf1, 0x1e, 0xb0, 0xa7,
+		0x76, 0x02, 0x2c, 0x38, 0xa1, 0x0f, 0xd0, 0xd9, 0x29, 0xfa, 0x0d, 0xf9,
+		0x41, 0xe9, 0x42, 0x06, 0x20, 0xb4, 0xd6, 0x97, 0xd3, 0x98, 0x51, 0x29,
+		0x5a, 0x9c, 0x77, 0x8e, 0x86, 0x2d, 0xe7, 0x5e, 0x90, 0x7f, 0x3f, 0x85,
+		0x8d, 0x9f, 0xc1, 0x02, 0xbd, 0x2c, 0x19, 0x9e, 0x24, 0xe3, 0x7b, 0x1b,
+		0x09, 0x27, 0x96, 0x5a
+	},
+	{
+		0x4f, 0xb6, 0xe5, 0x62, 0x41, 0xf4, 0x2b, 0xf6, 0xda, 0x24, 0xeb, 0x0b,
+		0x66, 0x4e, 0xc1, 0x9c, 0x05, 0x44, 0xde, 0x81, 0xa9, 0x39, 0x44, 0x0a,
+		0x48, 0xd6, 0x37, 0x48, 0xb5, 0x6b, 0xc4, 0x51, 0xa9, 0x23, 0x27, 0x76,
+		0x4d, 0x6d, 0x91, 0xd8, 0x6f, 0x95, 0xf5, 0xf2, 0xbc, 0xe2, 0xd4, 0x18,
+		0xa4, 0x12, 0x39, 0x24, 0xd2, 0x5b, 0xd4, 0x1b, 0x21, 0xb2, 0xc8, 0x0e,
+		0x66, 0xbb, 0x5d, 0x6b
+	},
+	{
+		0x57, 0xa4, 0x62, 0x57, 0xa8, 0x6a, 0x91, 0x16, 0x0a, 0x89, 0x61, 0x32,
+		0x45, 0x9f, 0x70, 0xb4, 0x03, 0xb7, 0xd5, 0x23, 0x8a, 0xfc, 0x69, 0x6a,
+		0x54, 0x6a, 0x08, 0xe7, 0xf1, 0x19, 0xb8, 0xcc, 0x7c, 0x4b, 0x12, 0x7d,
+		0x66, 0x21, 0xec, 0x11, 0x1a, 0x3c, 0x56, 0x52, 0x43, 0x78, 0x50, 0xd6,
+		0xf4, 0xe6, 0x1f, 0x40, 0x74, 0x79, 0x5c, 0x6d, 0xfa, 0xa5, 0x6f, 0xef,
+		0xbb, 0x31, 0x4c, 0x65
+	},
+	{
+		0x7c, 0x48, 0xf6, 0x0d, 0xfc, 0xd7, 0x98, 0xca, 0xb7, 0xb6, 0x7b, 0x02,
+		0x12, 0x17, 0x33, 0xfa, 0x61, 0xe4, 0x4d, 0xa0, 0x1f, 0xf3, 0xbd, 0xdc,
+		0x6d, 0xd2, 0x5e, 0x26, 0xe8, 0x3c, 0xfa, 0x35, 0xa8, 0xa9, 0x47, 0xa8,
+		0xa8, 0x01, 0xe8, 0x6e, 0x15, 0x8b, 0xf2, 0xf6, 0x42, 0x6d, 0x15, 0x16,
+		0x93, 0xb7, 0xf2, 0xfb, 0x8c, 0xae, 0x33, 0xbb, 0x24, 0x4d, 0x23, 0x4a,
+		0x09, 0x0f, 0x51, 0x54
+	},
+	{
+		0x15, 0x82, 0x62, 0xfb, 0x35, 0xb7, 0xf6, 0x06, 0x77, 0x91, 0xeb, 0x36,
+		0xfe, 0xfa, 0xfb, 0xf5, 0xba, 0xf6, 0x47, 0xe3, 0x7d, 0x37, 0xa2, 0xf1,
+		0xf4, 0x1e, 0x03, 0x07, 0x56, 0xc8, 0x81, 0x5e, 0x4c, 0x28, 0x1a, 0xa3,
+		0xc9, 0x8e, 0x62, 0x4a, 0xe5, 0xbe, 0x5e, 0x70, 0x3f, 0x85, 0x28, 0x8f,
+		0x6c, 0x7c, 0xd4, 0xce, 0x36, 0x1b, 0x47, 0x80, 0xf6, 0xc3, 0x22, 0x55,
+		0x32, 0xdc, 0xe9, 0xe5
+	},
+	{
+		0x6f, 0xd3, 0xf5, 0x4d, 0x5f, 0x2d, 0x64, 0x3b, 0xb5, 0xc0, 0x51, 0x27,
+		0x4f, 0x5a, 0xb5, 0xb7, 0xc7, 0x8b, 0xa2, 0x63, 0x37, 0xea, 0x57, 0xa2,
+		0x9d, 0x7f, 0x74, 0x9e, 0x7f, 0xd5, 0x8a, 0xe5, 0x0a, 0x5f, 0xd0, 0x98,
+		0x64, 0xf4, 0x97, 0x98, 0x87, 0xf7, 0x0b, 0xe9, 0x82, 0x99, 0x42, 0x1f,
+		0xc5, 0x2d, 0x1d, 0x24, 0x71, 0xb2, 0x89, 0x87, 0x34, 0x28, 0xe3, 0x11,
+		0x21, 0x16, 0xb8, 0xce
+	},
+	{
+		0xbf, 0xc4, 0x99, 0x34, 0x4b, 0xbf, 0x5c, 0xf4, 0xee, 0x74, 0x8a, 0x6f,
+		0xe3, 0x6e, 0x7d, 0x64, 0x4b, 0xed, 0xd0, 0x7c, 0xb9, 0x60, 0x08, 0xf1,
+		0x5b, 0x29, 0x11, 0xdd, 0x4d, 0x6a, 0x3d, 0xef, 0x27, 0x43, 0xae, 0x8a,
+		0xed, 0x51, 0xaa, 0x40, 0xfa, 0x01, 0xaa, 0x94, 0x95, 0x8a, 0x24, 0x8f,
+		0x22, 0x63, 0x9f, 0x87, 0x48, 0x91, 0x99, 0x02, 0x55, 0xc6, 0xf6, 0x2d,
+		0x8e, 0x74, 0x75, 0x0f
+	},
+	{
+		0x8e, 0x4c, 0x7b, 0x10, 0xbe, 0x6d, 0x6d, 0xba, 0xa7, 0x20, 0xd4, 0xc6,
+		0xaf, 0x2b, 0xff, 0x4c, 0xc9, 0x73, 0x60, 0x51, 0xa7, 0x62, 0xde, 0xb7,
+		0x75, 0xea, 0x69, 0xcb, 0xe7, 0x6c, 0xcb, 0xc0, 0xb5, 0xb0, 0x9c, 0xf6,
+		0x71, 0x7a, 0x53, 0x40, 0xd3, 0x21, 0xc5, 0xa6, 0x26, 0x85, 0xf0, 0x18,
+		0x83, 0x4c, 0xbf, 0x1f, 0xa1, 0xfe, 0x85, 0xec, 0xaf, 0x5c, 0x0e, 0xfe,
+		0x2f, 0x12, 0x84, 0x33
+	},
+	{
+		0x0f, 0x3f, 0x29, 0xff, 0x48, 0x8f, 0x73, 0x0c, 0x8b, 0xce, 0x1f, 0xab,
+		0x91, 0xb5, 0x77, 0xf5, 0x8c, 0x00, 0x36, 0x12, 0xce, 0x41, 0x32, 0x65,
+		0x9c, 0xdd, 0xa8, 0x21, 0x86, 0xeb, 0x78, 0x15, 0x08, 0xf0, 0x0e, 0xa5,
+		0x81, 0x38, 0x29, 0x96, 0x6b, 0x15, 0x64, 0xa4, 0x4c, 0xe5, 0x76, 0x1b,
+		0x1a, 0x96, 0x99, 0xe2, 0xae, 0xcb, 0xf4, 0x67, 0xeb, 0xb0, 0x80, 0x63,
+		0xe6, 0x96, 0x0d, 0x55
+	},
+	{
+		0x91, 0x25, 0xca, 0xed, 0xfa, 0x1f, 0x86, 0x4b, 0xba, 0x92, 0x26, 0xc3,
+		0x46, 0x44, 0x2d, 0x00, 0xe2, 0x8c, 0x48, 0x8a, 0xe8, 0xcd, 0x86, 0x8f,
+		0x6c, 0x10, 0xcd, 0xd2, 0x96, 0xbf, 0x8e, 0xa5, 0xf4, 0x92, 0x5b, 0xde,
+		0x07, 0xbc, 0x6b, 0x60, 0xd9, 0xb8, 0x51, 0x23, 0xe5, 0x35, 0x30, 0x44,
+		0x12, 0xdc, 0x55, 0x37, 0x68, 0xdb, 0xe5, 0x8c, 0xf3, 0x3b, 0xd6, 0x6e,
+		0x2e, 0x21, 0xb4, 0xaf
+	},
+	{
+		0xb9, 0xe1, 0x56, 0xd0, 0x1d, 0x57, 0xc1, 0xde, 0x94, 0x1e, 0x33, 0xc3,
+		0x81, 0x26, 0xc8, 0xc4, 0xd2, 0xa7, 0xb5, 0xba, 0xda, 0xdd, 0x80, 0xee,
+		0x0d, 0x17, 0xff, 0x39, 0x70, 0x51, 0x4a, 0x21, 0x50, 0x6a, 0xb6, 0xaa,
+		0x45, 0x21, 0x42, 0xc3, 0x45, 0x00, 0x56, 0xab, 0x3d, 0xc9, 0x63, 0x56,
+		0x6a, 0x2a, 0xa4, 0x62, 0x02, 0x02, 0xf3, 0xae, 0x22, 0x0d, 0x50, 0x0d,
+		0xea, 0x81, 0x05, 0xad
+	},
+	{
+		0x93, 0xba, 0xb5, 0x90, 0x79, 0xc8, 0x26, 0x39, 0x7d, 0x5f, 0xb3, 0x2b,
+		0x04, 0x00, 0x77, 0x13, 0x7b, 0x1e, 0xd8, 0x3d, 0x10, 0xa5, 0xfb, 0xa0,
+		0xe0, 0xcb, 0x10, 0x29, 0x1b, 0x20, 0xd5, 0x99, 0x36, 0xab, 0xa9, 0x35,
+		0xe3, 0x02, 0x6e, 0x2c, 0x8f, 0x27, 0x73, 0x88, 0xa9, 0xf7, 0xa3, 0xeb,
+		0xa3, 0x59, 0x23, 0x33, 0x35, 0x51, 0x25, 0x4a, 0x97, 0x7f, 0xa5, 0xa6,
+		0x49, 0xb9, 0x7d, 0x9d
+	},
+	{
+		0xaa, 0x14, 0x4c, 0x82, 0x13, 0x2c, 0x26, 0x14, 0xdb, 0xf2, 0xb1, 0x89,
+		0xf7, 0xf5, 0x5b, 0x1f, 0x05, 0x65, 0x07, 0x68, 0x22, 0xbe, 0xb5, 0x67,
+		0xf1, 0x97, 0x73, 0x5b, 0xc0, 0x51, 0x31, 0xcd, 0xc1, 0xd8, 0x9f, 0xe3,
+		0x92, 0x37, 0x39, 0xb8, 0x01, 0xa1, 0x4d, 0x18, 0x84, 0x47, 0x43, 0xfa,
+		0xb1, 0xce, 0x72, 0xb2, 0xff, 0xd0, 0xaf, 0xbe, 0xf4, 0x1c, 0xbe, 0x14,
+		0xb3, 0x82, 0x22, 0x51
+	},
+	{
+		0x28, 0x00, 0x04, 0x3a, 0xda, 0x09, 0x82, 0xe2, 0x2d, 0xdb, 0x6c, 0x3d,
+		0xdc, 0x7f, 0x43, 0xd5, 0x37, 0x19, 0xa8, 0xb6, 0x6b, 0xb1, 0x9b, 0xe6,
+		0xf0, 0xf6, 0x79, 0xf1, 0x0b, 0x79, 0x84, 0x7d, 0x0f, 0x99, 0x17, 0x46,
+		0x67, 0xe8, 0x29, 0x09, 0xb6, 0xc0, 0x79, 0x65, 0x84, 0xa4, 0xdc, 0x3b,
+		0xa8, 0x70, 0x58, 0xdb, 0xb8, 0x51, 0x3a, 0xe9, 0xfe, 0x5b, 0x00, 0x83,
+		0x90, 0x8d, 0x9e, 0xda
+	},
+	{
+		0xb2, 0x03, 0x5c, 0xf8, 0x7a, 0x15, 0x2c, 0x2b, 0x18, 0xcc, 0x80, 0xf1,
+		0x42, 0x91, 0x86, 0x7e, 0x58, 0xe9, 0x03, 0xdb, 0xda, 0x52, 0x24, 0x22,
+		0x12, 0x41, 0x6a, 0x5c, 0x5f, 0x3f, 0x5b, 0x80, 0xf1, 0x2f, 0x35, 0x9c,
+		0x74, 0x96, 0x80, 0xde, 0x60, 0x3e, 0x1d, 0xc5, 0x8a, 0x14, 0xe4, 0x93,
+		0xbf, 0xe0, 0x25, 0x68, 0xaf, 0x97, 0xc5, 0xb0, 0x71, 0x12, 0x56, 0x91,
+		0x95, 0xc8, 0x0e, 0xde
+	},
+	{
+		0x99, 0x8c, 0xd5, 0xf9, 0xdb, 0x6b, 0xdf, 0x96, 0x6a, 0x5e, 0xa5, 0xa8,
+		0x57, 0xea, 0x12, 0x0f, 0x6a, 0x75, 0xa7, 0x68, 0x6f, 0x7f, 0xc5, 0x02,
+		0x1c, 0xaa, 0xb0, 0xba, 0x6a, 0xa2, 0xb4, 0x9d, 0x32, 0x56, 0xa8, 0xa0,
+		0x7b, 0x7d, 0x9f, 0xb3, 0x6b, 0xfc, 0x17, 0x07, 0xbc, 0x38, 0x9e, 0xf3,
+		0xbe, 0x17, 0x8e, 0x54, 0x25, 0xc0, 0x37, 0x23, 0xd2, 0xd7, 0xba, 0x4c,
+		0x46, 0x71, 0x84, 0xa9
+	},
+	{
+		0x90, 0xea, 0x77, 0x67, 0x84, 0xbf, 0x61, 0x2d, 0x89, 0x00, 0xaa, 0xb1,
+		0xe7, 0x12, 0x69, 0x3a, 0x46, 0x51, 0xa4, 0xdc, 0x59, 0x5e, 0x9a, 0x31,
+		0x40, 0x42, 0x9d, 0x1b, 0xfe, 0xa7, 0x7b, 0x0c, 0xd1, 0xa3, 0x21, 0xd3,
+		0x10, 0x1e, 0x86, 0xf4, 0x75, 0x75, 0x44, 0x62, 0x5b, 0xa7, 0xb6, 0xa1,
+		0xf5, 0x58, 0x3b, 0xcc, 0xfb, 0x4d, 0x59, 0x4f, 0xbd, 0xd1, 0x04, 0x25,
+		0x0d, 0x02, 0xf2, 0xb6
+	},
+	{
+		0xa0, 0x3e, 0x1d, 0x52, 0x0a, 0x3f, 0x2c, 0xa8, 0xb4, 0xb2, 0x93, 0x9b,
+		0xe6, 0xb0, 0xb0, 0x1a, 0xe6, 0xde, 0xff, 0xa0, 0xf0, 0xb9, 0x89, 0x28,
+		0x7a, 0x2f, 0x10, 0xb2, 0x5a, 0xc0, 0xb3, 0xdb, 0xea, 0x1a, 0xd2, 0x2f,
+		0xeb, 0xb8, 0x2e, 0x0a, 0x6f, 0x29, 0xd6, 0xf4, 0xf2, 0x3b, 0x00, 0xbb,
+		0xe8, 0x36, 0x29, 0x08, 0xd3, 0x0f, 0xa3, 0xf9, 0xfc, 0x77, 0x95, 0x31,
+		0x2c, 0xbe, 0xad, 0x24
+	},
+	{
+		0xa6, 0x65, 0x03, 0xf5, 0xa0, 0x7d, 0x98, 0x93, 0xe6, 0x4e, 0x19, 0xbf,
+		0x86, 0x56, 0x72, 0xab, 0xa5, 0x70, 0x23, 0x19, 0x7c, 0x58, 0x62, 0x65,
+		0x68, 0x90, 0xb2, 0x6c, 0xe6, 0x2d, 0xa0, 0x69, 0xad, 0xba, 0x60, 0xec,
+		0x32, 0x0a, 0xfc, 0x60, 0x17, 0x69, 0xfc, 0xa7, 0xe1, 0x7b, 0x1d, 0x29,
+		0x3b, 0xae, 0x84, 0x7d, 0x7d, 0x71, 0x00, 0xbe, 0xe4, 0xde, 0xb7, 0xc0,
+		0x21, 0xfe, 0x47, 0x43
+	},
+	{
+		0x94, 0x3d, 0xe3, 0xb7, 0x67, 0x40, 0xa2, 0x84, 0x0e, 0xe6, 0x60, 0xa6,
+		0x09, 0xaf, 0xd2, 0x5b, 0x91, 0x35, 0xfc, 0x8d, 0xf9, 0xec, 0x85, 0xde,
+		0x74, 0x81, 0x4e, 0x1c, 0x89, 0x80, 0x6e, 0x19, 0xaf, 0xa3, 0xb6, 0x5f,
+		0xe4, 0x25, 0x4a, 0x7e, 0x21, 0x7f, 0xb7, 0x79, 0x71, 0x34, 0x58, 0x1a,
+		0xa5, 0x24, 0xc6, 0xd6, 0xd4, 0xc4, 0x86, 0xe8, 0xdb, 0xa0, 0x32, 0x7f,
+		0x62, 0x22, 0x27, 0xd9
+	},
+	{
+		0xbe, 0x9c, 0xf5, 0x96, 0xdb, 0x27, 0x1f, 0xcd, 0x44, 0xef, 0x8b, 0xe0,
+		0x38, 0xb6, 0x8e, 0x18, 0xb2, 0x6b, 0x4a, 0x98, 0xae, 0x8f, 0xc5, 0x08,
+		0xa3, 0xc9, 0xd6, 0x14, 0xc4, 0xe4, 0x81, 0x58, 0xa1, 0xf3, 0x35, 0xe5,
+		0x66, 0xc6, 0x7e, 0x8a, 0x4b, 0x77, 0x2a, 0x8c, 0xa4, 0x13, 0x9f, 0x59,
+		0x73, 0xdb, 0xe6, 0xff, 0x9b, 0x9e, 0x4d, 0x0a, 0x73, 0x7b, 0x65, 0x3e,
+		0x8e, 0x6f, 0x95, 0xad
+	},
+	{
+		0x75, 0x88, 0xdf, 0x7f, 0x23, 0xc0, 0x95, 0x67, 0x41, 0x99, 0xb6, 0x59,
+		0x00, 0x66, 0x9e, 0x85, 0xf3, 0xf6, 0x5d, 0xc1, 0xc8, 0x29, 0x7b, 0x47,
+		0x0a, 0xbf, 0xa3, 0xee, 0x2d, 0x00, 0x71, 0x5b, 0xbb, 0x03, 0x57, 0xa4,
+		0x6d, 0x5b, 0xf0, 0x3b, 0x33, 0x61, 0xb9, 0xc0, 0x3b, 0xab, 0xbc, 0x72,
+		0xa0, 0x84, 0x4d, 0x34, 0x80, 0x99, 0xa8, 0xfc, 0xab, 0xdf, 0x62, 0xfa,
+		0x86, 0x8d, 0x32, 0x27
+	},
+	{
+		0x5a, 0x61, 0xa2, 0x86, 0xc3, 0x49, 0x99, 0xae, 0xb1, 0xb4, 0xa2, 0xd0,
+		0x05, 0x0e, 0x20, 0xdf, 0x24, 0x3c, 0x4f, 0xed, 0x8c, 0xe3, 0x00, 0x43,
+		0xc0, 0xb1, 0x61, 0xfb, 0xf7, 0x7c, 0xf1, 0x52, 0xe8, 0xcf, 0xaa, 0xad,
+		0xa1, 0x38, 0x0d, 0x38, 0x03, 0xc6, 0xdf, 0x31, 0x1e, 0xd9, 0x1a, 0xe8,
+		0x97, 0x5b, 0xca, 0x7d, 0xf2, 0xc2, 0x61, 0xfe, 0x8c, 0x7b, 0xaf, 0x68,
+		0x70, 0x21, 0x4e, 0xb7
+	},
+	{
+		0x00, 0x45, 0x6c, 0x5c, 0x84, 0x64, 0x2d, 0xd4, 0xad, 0x80, 0xf0, 0x35,
+		0xf8, 0xbe, 0x76, 0xb4, 0xae, 0x5c, 0xe0, 0x38, 0xc2, 0xec, 0x4e, 0x56,
+		0xa6, 0xbc, 0xc8, 0x4d, 0x01, 0x6f, 0x61, 0x3c, 0xfd, 0x39, 0xb0, 0xf2,
+		0x91, 0xd6, 0x5c, 0x88, 0xa8, 0x5c, 0x96, 0xb8, 0x56, 0xc6, 0x84, 0xe3,
+		0x7b, 0xf0, 0xb3, 0xab, 0x68, 0xd0, 0xa1, 0x70, 0x0e, 0xf7, 0x07, 0x9f,
+		0xde, 0x36, 0x48, 0xc8
+	},
+	{
+		0x2d, 0x2b, 0x42, 0x73, 0xe0, 0x84, 0x7f, 0x7d, 0xaf, 0x1f, 0x9c, 0x6d,
+		0x4a, 0xcf, 0x8d, 0x42, 0x67, 0xba, 0x86, 0x86, 0x89, 0xf8, 0xa2, 0xc1,
+		0xc7, 0x9e, 0x31, 0x78, 0x96, 0x6d, 0x28, 0xdd, 0x37, 0xea, 0xeb, 0x10,
+		0x1e, 0xe4, 0xea, 0x49, 0x73, 0x43, 0x8a, 0x26, 0x44, 0xcc, 0x71, 0xae,
+		0x95, 0xcb, 0x10, 0xfd, 0x93, 0x83, 0xe7, 0xb5, 0x1d, 0x9e, 0x1a, 0x90,
+		0x69, 0x13, 0x0c, 0xec
+	},
+	{
+		0xf1, 0x1a, 0x11, 0x3e, 0xd8, 0xa1, 0xb5, 0xf8, 0x3c, 0xf6, 0xa1, 0xcd,
+		0x48, 0xa3, 0x5e, 0x9b, 0xf1, 0x23, 0x5f, 0x08, 0x5a, 0xe6, 0x59, 0x8e,
+		0x2a, 0x67, 0x5b, 0x54, 0x62, 0x0c, 0x76, 0x7b, 0x64, 0xa1, 0xa6, 0x6d,
+		0x1f, 0x12, 0xfb, 0xb6, 0x3c, 0x73, 0x07, 0xa0, 0x82, 0x73, 0x60, 0x67,
+		0x3f, 0x83, 0xbd, 0x07, 0xb6, 0xa7, 0x3d, 0x9b, 0xa4, 0x01, 0x98, 0x5d,
+		0x17, 0x42, 0xa8, 0x87
+	},
+	{
+		0x17, 0xbe, 0x9c, 0x2d, 0xe4, 0x0f, 0xaf, 0x48, 0x85, 0x2b, 0xe4, 0x20,
+		0x2c, 0xe3, 0x1e, 0x9a, 0x56, 0xd6, 0x6d, 0xb4, 0xc7, 0xb1, 0xea, 0x1a,
+		0x1c, 0x12, 0xb5, 0xcb, 0xd8, 0x4a, 0x37, 0xde, 0x69, 0x14, 0xbf, 0x94,
+		0x3f, 0xdb, 0xe6, 0x97, 0xd8, 0xcc, 0x6e, 0x86, 0xe7, 0x5b, 0x81, 0xc0,
+		0x1f, 0x8d, 0x9d, 0x80, 0x34, 0xb1, 0x09, 0x3e, 0x73, 0x5b, 0x3c, 0xcb,
+		0x38, 0xcc, 0x87, 0x97
+	},
+	{
+		0x82, 0x66, 0xe2, 0xfe, 0xd5, 0xba, 0xb1, 0x33, 0xca, 0x4a, 0xb7, 0x50,
+		0x8e, 0x0a, 0x6a, 0x28, 0x7f, 0x5f, 0x96, 0x10, 0x8d, 0xab, 0x39, 0x36,
+		0x42, 0x26, 0x18, 0xc9, 0x0c, 0xcf, 0x39, 0x81, 0x08, 0x9c, 0xfd, 0x68,
+		0x28, 0x71, 0x78, 0xce, 0x0a, 0x5b, 0x19, 0x4b, 0x67, 0xfb, 0x46, 0x2d,
+		0xa9, 0x1e, 0xda, 0xeb, 0x5d, 0x99, 0x4d, 0x86, 0xfa, 0xa7, 0x54, 0x5b,
+		0xab, 0x55, 0x00, 0xf6
+	},
+	{
+		0xae, 0xf8, 0x41, 0x69, 0x7f, 0x71, 0x0d, 0xe4, 0x25, 0x6f, 0xe1, 0xeb,
+		0xd0, 0x49, 0x4f, 0x94, 0x59, 0x98, 0x8e, 0xf3, 0x00, 0x2d, 0x57, 0x07,
+		0x54, 0xb4, 0x4d, 0x33, 0x00, 0xb1, 0x6f, 0x35, 0x75, 0xb8, 0xb0, 0xfa,
+		0x16, 0x0e, 0x8f, 0xff, 0x15, 0x51, 0x36, 0x5e, 0x64, 0x2c, 0xf6, 0xdd,
+		0xae, 0xc9, 0xda, 0xae, 0xbf, 0xa0, 0xb1, 0x5c, 0xca, 0x38, 0xfb, 0x1f,
+		0x8b, 0xd4, 0x96, 0x04
+	},
+	{
+		0x7d, 0xe7, 0x45, 0x4a, 0x1c, 0xc4, 0x7d, 0xab, 0x8d, 0x71, 0xea, 0xba,
+		0x78, 0x6a, 0xac, 0xeb, 0xea, 0x17, 0xf5, 0x80, 0x31, 0x7c, 0x61, 0xf1,
+		0xb2, 0x46, 0x60, 0x27, 0x01, 0xfe, 0xea, 0x35, 0x22, 0x34, 0x0f, 0xec,
+		0xe8, 0xc8, 0x5f, 0x85, 0x9a, 0x57, 0xe4, 0x3f, 0x42, 0xb2, 0xd4, 0x41,
+		0xe2, 0x2c, 0xc5, 0x9b, 0xb9, 0xab, 0x07, 0x9c, 0x10, 0xb6, 0x9d, 0x62,
+		0xff, 0x1b, 0x12, 0x66
+	},
+	{
+		0x58, 0x93, 0xf6, 0xf9, 0x3f, 0x98, 0xa5, 0x08, 0x93, 0x43, 0x62, 0x36,
+		0xe4, 0xd6, 0x5a, 0x03, 0x1d, 0xf8, 0x7b, 0xa3, 0xe6, 0x9d, 0x45, 0xee,
+		0x60, 0x33, 0xd1, 0x13, 0xed, 0xab, 0x9c, 0xb9, 0x26, 0xe4, 0x71, 0xbc,
+		0xd4, 0xe9, 0x38, 0x4d, 0xe8, 0x30, 0x11, 0x18, 0x20, 0x0c, 0x4f, 0xb8,
+		0x32, 0x77, 0xff, 0x0d, 0x6b, 0xc7, 0x36, 0x5e, 0xb3, 0x83, 0x2e, 0x15,
+		0xaa, 0xd5, 0x4f, 0xab
+	},
+	{
+		0xee, 0x74, 0x00, 0xba, 0xe7, 0x87, 0x3a, 0x25, 0x77, 0xb4, 0x0a, 0xbd,
+		0x51, 0xab, 0xb7, 0x43, 0xfa, 0x49, 0x43, 0x34, 0xf3, 0x56, 0x69, 0xca,
+		0x1c, 0x1d, 0xd9, 0x1a, 0x68, 0xc2, 0x8f, 0x39, 0x19, 0x6c, 0x1b, 0xa4,
+		0xca, 0xe9, 0xed, 0x81, 0x7e, 0x4f, 0xb9, 0x6c, 0x1b, 0xe8, 0xb6, 0x7d,
+		0x8a, 0x90, 0xd1, 0x3f, 0x3d, 0xa8, 0x78, 0x5a, 0xf1, 0x5d, 0x9b, 0xf5,
+		0xed, 0x23, 0x09, 0xd9
+	},
+	{
+		0x43, 0xe3, 0x39, 0x27, 0xc6, 0xe9, 0xe6, 0x3f, 0x04, 0x16, 0x67, 0x98,
+		0xf3, 0x6e, 0x0d, 0x92, 0x66, 0x95, 0x82, 0x43, 0xf5, 0xa3, 0x4b, 0x64,
+		0x32, 0x76, 0xc5, 0xa4, 0xc5, 0x24, 0x27, 0xd8, 0xe2, 0x10, 0xda, 0xa4,
+		0x28, 0x41, 0x30, 0x43, 0x80, 0x5e, 0xa2, 0x1e, 0x59, 0x51, 0xe1, 0x3b,
+		0x43, 0xb8, 0x9c, 0xde, 0x0a, 0xf5, 0x0d, 0xd8, 0x89, 0x9a, 0xed, 0x76,
+		0xf0, 0xca, 0x8d, 0x2b
+	},
+	{
+		0x5e, 0xa5, 0x9a, 0x09, 0x31, 0x88, 0xba, 0x78, 0xc9, 0x5f, 0xe2, 0x3d,
+		0x54, 0xc5, 0xf9, 0x25, 0x5e, 0xbc, 0xe1, 0xff, 0x4d, 0xfa, 0x28, 0x5e,
+		0xe1, 0x7f, 0x62, 0x7b, 0x98, 0xa1, 0x74, 0xfc, 0xb9, 0x94, 0xca, 0x42,
+		0xd1, 0x42, 0x93, 0x1d, 0xc5, 0x1b, 0x56, 0x92, 0x4f, 0xc4, 0x77, 0x62,
+		0x37, 0xbe, 0x4a, 0x1e, 0x5d, 0xb0, 0x3d, 0x95, 0x66, 0x15, 0xbb, 0x54,
+		0x2d, 0x2d, 0x81, 0x63
+	},
+	{
+		0x1c, 0xba, 0x62, 0x57, 0xf0, 0xf1, 0x6e, 0xd0, 0xbf, 0x01, 0xfb, 0x38,
+		0x68, 0x69, 0x34, 0xc9, 0xb3, 0x3d, 0xf1, 0xad, 0xe0, 0x70, 0xa0, 0xc9,
+		0xce, 0x46, 0xa1, 0x65, 0x07, 0x58, 0x03, 0x5b, 0x4a, 0xde, 0x1f, 0x8e,
+		0x89, 0x1d, 0x76, 0x58, 0x14, 0x88, 0x77, 0x0d, 0xa5, 0xc2, 0x15, 0xb1,
+		0xd8, 0x24, 0x29, 0xa1, 0x4a, 0x6b, 0x38, 0xda, 0xe5, 0x38, 0xa9, 0xb6,
+		0xee, 0x93, 0x40, 0x9c
+	},
+	{
+		0xfe, 0x1a, 0x63, 0x75, 0xbc, 0xed, 0x72, 0x6e, 0x0a, 0xa4, 0xc4, 0xc3,
+		0xfa, 0x1c, 0x97, 0xa1, 0xb1, 0x4f, 0x4a, 0x60, 0x7b, 0xe4, 0x33, 0xed,
+		0xbf, 0x93, 0xcd, 0xa8, 0x51, 0xa0, 0x31, 0x05, 0xe6, 0xb2, 0xe8, 0x72,
+		0x3f, 0xb7, 0xcc, 0x37, 0x67, 0x70, 0x03, 0xec, 0xf6, 0xab, 0xdf, 0xf4,
+		0x08, 0xfb, 0x96, 0x22, 0xeb, 0xf3, 0x7a, 0xf4, 0x4d, 0xb6, 0x82, 0x87,
+		0x04, 0x09, 0xc3, 0x04
+	},
+	{
+		0xa7, 0xbb, 0x42, 0xf5, 0x85, 0x5b, 0xb2, 0x09, 0x0d, 0x33, 0xcb, 0x80,
+		0xa3, 0x62, 0xb9, 0xce, 0x5d, 0xf1, 0x1a, 0x33, 0xa1, 0x05, 0x67, 0x3a,
+		0xfe, 0x70, 0x2b, 0x4b, 0x27, 0xad, 0xe6, 0x3f, 0x2c, 0xaa, 0x2d, 0xae,
+		0x89, 0xf7, 0xa2, 0xab, 0xa3, 0x32, 0x3f, 0xf5, 0xbb, 0x6a, 0x5b, 0x28,
+		0xff, 0x0e, 0x08, 0xd7, 0x23, 0x51, 0xde, 0xc6, 0xfd, 0xcc, 0x60, 0x96,
+		0xc9, 0x5f, 0xe5, 0x75
+	},
+	{
+		0x18, 0x78, 0x18, 0xec, 0x31, 0x21, 0xdb, 0xd5, 0xfb, 0xcd, 0x5a, 0x09,
+		0xd8, 0x3f, 0x2c, 0xc2, 0x45, 0x3c, 0x33, 0x3e, 0xdb, 0x97, 0x3d, 0xdc,
+		0x25, 0x25, 0x66, 0xb6, 0x51, 0xff, 0x89, 0xbb, 0xee, 0x05, 0x65, 0x0d,
+		0x0a, 0xe0, 0xc8, 0xd7, 0xd5, 0x9a, 0xb0, 0x0b, 0xb0, 0x99, 0x91, 0xfa,
+		0x42, 0x31, 0x46, 0x23, 0x55, 0xf7, 0x53, 0xe0, 0xae, 0xa1, 0xb4, 0x5f,
+		0x3b, 0x46, 0xb9, 0x49
+	},
+	{
+		0xe6, 0xdb, 0x6c, 0xca, 0xde, 0x0c, 0x90, 0xf6, 0xc3, 0x34, 0x9c, 0x3d,
+		0xaf, 0x24, 0xf7, 0x6c, 0x6e, 0x04, 0x76, 0x8e, 0xfb, 0x77, 0x5e, 0x41,
+		0x20, 0x96, 0xd6, 0x76, 0x2d, 0xa7, 0xeb, 0x49, 0xeb, 0x90, 0xfe, 0x3c,
+		0x65, 0x4b, 0xf7, 0x35, 0x37, 0x68, 0x0f, 0x04, 0x02, 0x10, 0x34, 0xb2,
+		0x84, 0xc3, 0x27, 0x0b, 0x78, 0x1e, 0xc4, 0x27, 0x98, 0xaa, 0x01, 0xf5,
+		0xa4, 0x16, 0xfd, 0x87
+	},
+	{
+		0x32, 0x65, 0xea, 0xd8, 0xb1, 0x13, 0x25, 0xe9, 0x78, 0x15, 0x8e, 0xcd,
+		0x64, 0x5c, 0xec, 0x2a, 0x92, 0x52, 0x8b, 0x1a, 0xe2, 0x9b, 0xd0, 0xb4,
+		0xea, 0xf7, 0x62, 0x3c, 0xe4, 0x97, 0x6d, 0xd8, 0x7c, 0x4d, 0x96, 0xbc,
+		0x5d, 0x87, 0x30, 0xe9, 0xb4, 0x5c, 0x18, 0x87, 0x2f, 0xee, 0xfe, 0x38,
+		0x14, 0xef, 0x08, 0x45, 0x24, 0x65, 0x86, 0x7d, 0x1c, 0xa2, 0x7a, 0xf8,
+		0xc0, 0x47, 0x80, 0xb7
+	},
+	{
+		0x31, 0x57, 0xcf, 0x6f, 0x70, 0xb3, 0x5a, 0x98, 0x2b, 0x7b, 0x57, 0xe0,
+		0x7e, 0x9b, 0x6c, 0x7f, 0xe2, 0xeb, 0x0c, 0x63, 0x34, 0x68, 0x64, 0xe7,
+		0x8e, 0x35, 0xbf, 0x16, 0xb3, 0x57, 0x19, 0x76, 0xb4, 0xc9, 0x65, 0x5d,
+		0x40, 0x77, 0x47, 0x5f, 0xea, 0xef, 0x7b, 0x4e, 0x34, 0x5f, 0xa3, 0x35,
+		0xc2, 0x0c, 0x56, 0x90, 0x6b, 0x1a, 0x32, 0xae, 0xfe, 0xc2, 0x4c, 0x14,
+		0x5a, 0xc4, 0x9e, 0xa5
+	},
+	{
+		0x81, 0xa2, 0x5a, 0x61, 0xd1, 0x2c, 0xbb, 0x2c, 0xfe, 0x68, 0xab, 0x07,
+		0xe2, 0x9e, 0x54, 0x2a, 0x80, 0x81, 0x83, 0x02, 0x75, 0x44, 0x33, 0xe3,
+		0x3c, 0x3d, 0x8c, 0x9b, 0x6c, 0x38, 0xb3, 0xda, 0xf4, 0x9d, 0x83, 0x8f,
+		0x08, 0x92, 0xce, 0x93, 0x1a, 0x60, 0x66, 0x32, 0x7a, 0x77, 0xdb, 0x0f,
+		0xe1, 0x4e, 0xbc, 0xf6, 0x83, 0xa5, 0x65, 0x74, 0x55, 0x99, 0x48, 0xa7,
+		0x8f, 0x68, 0x56, 0x47
+	},
+	{
+		0x41, 0xd7, 0xe9, 0x2b, 0xda, 0xdd, 0x00, 0x6f, 0x2e, 0xc4, 0xc7, 0x06,
+		0x1b, 0x9b, 0x2e, 0x7b, 0x15, 0x2a, 0x08, 0x07, 0xe1, 0x8b, 0x0a, 0xd5,
+		0xf3, 0xf4, 0xe3, 0xfe, 0xfc, 0xf8, 0x66, 0xb9, 0x4c, 0xe6, 0xbb, 0x77,
+		0xc1, 0xbc, 0x85, 0xf4, 0x17, 0x26, 0xd7, 0x04, 0x35, 0x7a, 0x06, 0x81,
+		0x02, 0x34, 0x4d, 0xff, 0xb2, 0xaa, 0x2f, 0x47, 0xff, 0x0a, 0x8a, 0x79,
+		0x1d, 0x4b, 0x6e, 0xf7
+	},
+	{
+		0xc3, 0xff, 0x8d, 0x75, 0x10, 0xac, 0x6e, 0xdf, 0x5f, 0x2b, 0x68, 0xe6,
+		0x16, 0x84, 0xfc, 0xb0, 0xba, 0x4d, 0x2d, 0xa9, 0x00, 0x1e, 0x90, 0x8d,
+		0x65, 0x1e, 0xbb, 0x86, 0x89, 0x16, 0xa0, 0x0d, 0x2a, 0xcc, 0xb4, 0xf4,
+		0x9d, 0x10, 0xf7, 0x61, 0xbe, 0xa7, 0xce, 0x04, 0xc9, 0x5c, 0x2d, 0xb2,
+		0x8f, 0x4f, 0xf3, 0x72, 0xb1, 0xa4, 0xdc, 0x68, 0x69, 0x97, 0xe3, 0xea,
+		0xf5, 0xc4, 0x9a, 0x61
+	},
+	{
+		0x25, 0x18, 0x37, 0x34, 0x33, 0xc7, 0x54, 0x6d, 0xe6, 0xc0, 0xe1, 0x2d,
+		0xbb, 0x58, 0x0c, 0x9a, 0x4f, 0x1f, 0xb2, 0xd6, 0x3a, 0xda, 0x2b, 0x53,
+		0xb9, 0xe4, 0x37, 0xf4, 0xaf, 0xcc, 0x2b, 0xef, 0x53, 0x1f, 0x30, 0x7f,
+		0xb4, 0x8f, 0x21, 0xf2, 0x2a, 0x0c, 0x7a, 0x7e, 0x9c, 0xe6, 0xf4, 0x9f,
+		0x2c, 0xb9, 0xb9, 0xb3, 0xa1, 0x85, 0xae, 0x46, 0xab, 0x12, 0xd9, 0x0f,
+		0xbf, 0xd9, 0x2f, 0xb9
+	}
+};
+#endif
+
+#if DROPBEAR_ECC_384
+static const unsigned char nistp384_comb[(1 << NISTP_COMB_TEETH) - 1][96] = {
+	{
+		0xaa, 0x87, 0xca, 0x22, 0xbe, 0x8b, 0x05, 0x37, 0x8e, 0xb1, 0xc7, 0x1e,
+		0xf3, 0x20, 0xad, 0x74, 0x6e, 0x1d, 0x3b, 0x62, 0x8b, 0xa7, 0x9b, 0x98,
+		0x59, 0xf7, 0x41, 0xe0, 0x82, 0x54, 0x2a, 0x38, 0x55, 0x02, 0xf2, 0x5d,
+		0xbf, 0x55, 0x29, 0x6c, 0x3a, 0x54, 0x5e, 0x38, 0x72, 0x76, 0x0a, 0xb7,
+		0x36, 0x17, 0xde, 0x4a, 0x96, 0x26, 0x2c, 0x6f, 0x5d, 0x9e, 0x98, 0xbf,
+		0x92, 0x92, 0xdc, 0x29, 0xf8, 0xf4, 0x1d, 0xbd, 0x28, 0x9a, 0x14, 0x7c,
+		0xe9, 0xda, 0x31, 0x13, 0xb5, 0xf0, 0xb8, 0xc0, 0x0a, 0x60, 0xb1, 0xce,
+		0x1d, 0x7e, 0x81, 0x9d, 0x7a, 0x43, 0x1d, 0x7c, 0x90, 0xea, 0x0e, 0x5f
+	},
+	{
+		0x07, 0x9d, 0xc5, 0x66, 0x51, 0x0c, 0xc7, 0x18, 0xff, 0x34, 0x87, 0x97,
+		0xe2, 0xcf, 0xe6, 0x7c, 0x2f, 0xce, 0x93, 0xbf, 0x5f, 0x6f, 0x39, 0xbf,
+		0x74, 0xc1, 0xac, 0x3d, 0x8c, 0xba, 0xe3, 0xef, 0x92, 0xdd, 0x9c, 0xde,
+		0xdf, 0xa0, 0xf5, 0x6d, 0x06, 0xba, 0x59, 0x18, 0xd7, 0x4d, 0x96, 0x42,
+		0xa6, 0x4d, 0xa0, 0x9a, 0x5d, 0x90, 0x87, 0xbc, 0x89, 0xa8, 0x43, 0x7e,
+		0x5c, 0x80, 0x6f, 0x88, 0x62, 0x63, 0x77, 0x70, 0x84, 0x84, 0xb5, 0xf1,
+		0x36, 0x27, 0x55, 0x38, 0x89, 0x24, 0x59, 0xa9, 0x29, 0xf4, 0x9d, 0x50,
+		0xcc, 0x51, 0xc4, 0x2f, 0xa0, 0xec, 0xd5, 0xd0, 0xc1, 0x6b, 0xb5, 0x23
+	},
+	{
+		0xbd, 0xa8, 0xcb, 0xb3, 0x52, 0xe8, 0x56, 0x54, 0xac, 0x84, 0x76, 0xf6,
+		0x41, 0x78, 0x9d, 0xe5, 0x85, 0x2c, 0xc3, 0xab, 0xa3, 0x7b, 0x75, 0x52,
+		0xe7, 0x53, 0xed, 0xd8, 0xcf, 0x2c, 0xbc, 0x3d, 0xbc, 0xb6, 0xf7, 0x06,
+		0xb7, 0xeb, 0xf3, 0x17, 0x37, 0x1f, 0xdb, 0x78, 0x2c, 0x00, 0x92, 0x46,
+		0x23, 0xbc, 0x95, 0xbe, 0x59, 0xee, 0xa2, 0xc2, 0xd9, 0x07, 0xb0, 0x6a,
+		0x9b, 0x9b, 0x80, 0x5f, 0x94, 0x60, 0x99, 0x01, 0x8a, 0x2d, 0x49, 0xd1,
+		0x7a, 0xd4, 0xc7, 0x4d, 0xe6, 0x90, 0xeb, 0x4c, 0x4c, 0x50, 0xf6, 0x7c,
+		0x1c, 0xce, 0x0f, 0x01, 0xda, 0x1b, 0x89, 0xb6, 0xa4, 0xae, 0xf2, 0x6d
+	},
+	{
+		0xe1, 0x0c, 0xb3, 0x6d, 0x11, 0xcd, 0x50, 0x6e, 0x23, 0xa4, 0x2e, 0xa4,
+		0x85, 0xd5, 0xa5, 0x24, 0x11, 0xc2, 0xdf, 0x65, 0x2b, 0x7b, 0x03, 0xe9,
+		0x2b, 0xb6, 0x4e, 0x18, 0x28, 0x7c, 0x9b, 0x53, 0xea, 0x2b, 0x1d, 0xf4,
+		0x19, 0xbf, 0x5f, 0x49, 0x84, 0xa2, 0xae, 0x35, 0x00, 0x20, 0x36, 0x2e,
+		0xd7, 0xe6, 0x79, 0x72, 0x46, 0x97, 0xd3, 0x63, 0x52, 0xec, 0x80, 0x6a,
+		0x31, 0xd6, 0xab, 0x0b, 0x42, 0x5d, 0x78, 0x17, 0x06, 0xcc, 0x84, 0xc0,
+		0x77, 0x68, 0xfb, 0x7f, 0xe9, 0x0e, 0xd2, 0xa4, 0x64, 0x66, 0x6b, 0x55,
+		0x36, 0xad, 0xb5, 0x3e, 0xe5, 0xf5, 0x0b, 0xfe, 0x2a, 0xda, 0xef, 0xc2
+	},
+	{
+		0xde, 0x3e, 0x77, 0xfb, 0xc2, 0x01, 0x04, 0x34, 0xc7, 0x9c, 0xf8, 0x24,
+		0x50, 0xb9, 0x21, 0x55, 0x7e, 0x6e, 0xe5, 0xf4, 0x84, 0x9e, 0x29, 0x9f,
+		0x67, 0xfc, 0x32, 0x94, 0x08, 0xa7, 0x08, 0x30, 0x58, 0x6e, 0xa8, 0x87,
+		0x80, 0x91, 0xac, 0xcf, 0x98, 0x1f, 0xfb, 0x59, 0xae, 0x56, 0x9d, 0xe6,
+		0xe3, 0x0d, 0xf4, 0xb8, 0x4d, 0xb8, 0x10, 0xd9, 0x00, 0xd1, 0x9c, 0xe0,
+		0x32, 0x57, 0x69, 0x92, 0xe1, 0xc2, 0x86, 0x45, 0x17, 0xeb, 0xe7, 0x1c,
+		0x75, 0x7e, 0x49, 0x3b, 0xf8, 0x43, 0xca, 0xe9, 0x8e, 0x5e, 0x92, 0xfa,
+		0x43, 0xcf, 0x88, 0xb6, 0xa6, 0xec, 0x9d, 0xc7, 0xe3, 0xee, 0x38, 0x00
+	},
+	{
+		0x2d, 0x35, 0x0f, 0xa2, 0x0d, 0x6a, 0xc8, 0x98, 0x3b, 0x23, 0x84, 0xc0,
+		0x23, 0x8e, 0x76, 0x43, 0x1c, 0x92, 0xab, 0xa0, 0x58, 0xee, 0x4d, 0xdc,
+		0x52, 0x92, 0x2d, 0xe8, 0xe3, 0x83, 0xbf, 0x0d, 0xfd, 0x5f, 0x2f, 0xb0,
+		0xaf, 0x4d, 0x27, 0x66, 0xf6, 0xda, 0x53, 0xe1, 0x78, 0x0e, 0x56, 0xf3,
+		0xf1, 0x57, 0x79, 0xe6, 0x68, 0x9d, 0xe2, 0xfa, 0x80, 0xcc, 0xbc, 0xe7,
+		0x0b, 0x8f, 0x32, 0xee, 0x8c, 0xf8, 0xb3, 0xc9, 0xe0, 0xe2, 0xf3, 0x4d,
+		0x67, 0xf4, 0x17, 0x4c, 0xc5, 0x25, 0xc5, 0x26, 0xa8, 0x74, 0x36, 0x94,
+		0xa6, 0xe5, 0x47, 0x97, 0x29, 0x29, 0x92, 0x9e, 0xfb, 0x35, 0xaa, 0x8b
+	},
+	{
+		0xad, 0xd3, 0xb7, 0xe9, 0xc4, 0x24, 0x59, 0x00, 0x58, 0x1b, 0x7c, 0xfa,
+		0x41, 0x7c, 0x18, 0xa3, 0xef, 0x8d, 0x50, 0xa1, 0x43, 0x1e, 0xf8, 0x4d,
+		0x5a, 0x2a, 0x19, 0xfa, 0x40, 0x19, 0xbd, 0x55, 0xa3, 0x0c, 0x60, 0x4d,
+		0x3b, 0xe4, 0x71, 0x4f, 0x16, 0x27, 0x39, 0x79, 0xb2, 0x9a, 0xdc, 0x60,
+		0x6f, 0xb0, 0x07, 0x0f, 0x52, 0x3c, 0x7d, 0xda, 0x30, 0x40, 0xaf, 0x18,
+		0xba, 0x61, 0x74, 0xf4, 0xfe, 0x37, 0x1b, 0x18, 0x5d, 0xb1, 0x18, 0x6c,
+		0x71, 0x1a, 0x52, 0x92, 0x18, 0x87, 0x02, 0x84, 0x34, 0x42, 0x1d, 0x86,
+		0xa3, 0x19, 0xb2, 0x7b, 0xb7, 0x6f, 0x45, 0x54, 0x63, 0x3d, 0x01, 0xbb
+	},
+	{
+		0xc1, 0x9e, 0x0b, 0x4c, 0x80, 0x01, 0x19, 0xc4, 0x40, 0xf7, 0xf9, 0xe7,
+		0x06, 0x42, 0x12, 0x79, 0xb4, 0x2a, 0x31, 0xaf, 0x8a, 0x3e, 0x29, 0x7d,
+		0xdb, 0x29, 0x87, 0x89, 0x4d, 0x10, 0xdd, 0xea, 0xba, 0x06, 0x54, 0x58,
+		0xa4, 0xf5, 0x2d, 0x78, 0xa6, 0x28, 0xb0, 0x9a, 0xaa, 0x03, 0xbd, 0x53,
+		0x16, 0xf3, 0xfd, 0xbf, 0x03, 0x56, 0xb3, 0x01, 0xe5, 0xa0, 0x19, 0x1d,
+		0x1f, 0x5b, 0x77, 0xf6, 0x57, 0x7a, 0x30, 0xea, 0xe3, 0x56, 0x7a, 0xf9,
+		0xc1, 0xc7, 0xca, 0xd1, 0x35, 0xf6, 0xeb, 0xf2, 0xaf, 0x68, 0xaa, 0x6d,
+		0xe6, 0x39, 0xd8, 0x58, 0x82, 0x2d, 0x0f, 0xc5, 0xe6, 0xc8, 0x8c, 0x41
+	},
+	{
+		0xaa, 0xb8, 0xbb, 0x9f, 0x0f, 0xdc, 0x30, 0x88, 0x56, 0x7a, 0x62, 0x33,
+		0xcd, 0x6c, 0xe3, 0xa3, 0x9b, 0xb1, 0x83, 0xb2, 0x70, 0xb3, 0x75, 0xdd,
+		0xd3, 0x7d, 0xe4, 0x24, 0xb8, 0x60, 0xfa, 0xe6, 0x90, 0x97, 0xdb, 0xb1,
+		0xc6, 0xcb, 0x00, 0x17, 0x30, 0x99, 0x15, 0x60, 0xaa, 0x13, 0x39, 0x09,
+		0x48, 0x94, 0x2f, 0x81, 0x31, 0x4f, 0x6d, 0x28, 0xf0, 0xaf, 0x01, 0xd1,
+		0x28, 0x20, 0x50, 0xb5, 0xf6, 0x00, 0x5f, 0xc8, 0x15, 0xeb, 0x04, 0xac,
+		0x6d, 0x95, 0x5b, 0xb3, 0xc9, 0x74, 0x7b, 0xf3, 0xeb, 0xdf, 0x73, 0xf2,
+		0xd6, 0x2f, 0xaa, 0x44, 0x16, 0xc5, 0xb9, 0x81, 0x60, 0x0a, 0xd5, 0xa6
+	},
+	{
+		0x8b, 0x71, 0x44, 0x79, 0xaa, 0xda, 0xf8, 0x29, 0x5b, 0xdb, 0xfa, 0x1b,
+		0x49, 0x05, 0xed, 0xeb, 0xc4, 0x9d, 0xc5, 0x52, 0xab, 0x00, 0xb0, 0x39,
+		0xa5, 0x98, 0x02, 0xab, 0x47, 0x2a, 0xbc, 0xbe, 0x03, 0xd4, 0x2b, 0xfa,
+		0x4f, 0x89, 0x0f, 0x56, 0xf5, 0xb4, 0x35, 0x0f, 0x4a, 0xb0, 0x18, 0xd9,
+		0xd6, 0x7b, 0x41, 0x41, 0x5e, 0x7e, 0x1a, 0x8e, 0x33, 0x0a, 0x33, 0x6c,
+		0x27, 0xd7, 0xaa, 0x39, 0xc2, 0x31, 0x5c, 0xa2, 0x44, 0xfa, 0x53, 0x9f,
+		0x19, 0x4b, 0xef, 0xcc, 0x12, 0xb7, 0xd6, 0xf0, 0xff, 0xcf, 0x31, 0x03,
+		0xca, 0xa1, 0x70, 0x43, 0xb6, 0x9f, 0x61, 0x21, 0x10, 0x90, 0x35, 0x77
+	},
+	{
+		0x1a, 0x2f, 0x72, 0x08, 0x51, 0xac, 0x4a, 0xe9, 0x4f, 0xb3, 0x48, 0xa8,
+		0x94, 0x93, 0xf9, 0x92, 0x23, 0x33, 0xe9, 0xa7, 0x66, 0x2d, 0x47, 0x82,
+		0x38, 0x7b, 0xce, 0xad, 0x46, 0xb8, 0x02, 0x10, 0xde, 0x63, 0x37, 0xd9,
+		0x14, 0xb9, 0x8c, 0xd9, 0x50, 0xe9, 0x7c, 0x63, 0xb6, 0xd8, 0x2f, 0x46,
+		0x08, 0xd8, 0xda, 0xb3, 0xdc, 0x69, 0x9d, 0x11, 0xec, 0x7e, 0x6e, 0x4e,
+		0xee, 0x57, 0x8a, 0x55, 0xb7, 0xe0, 0x09, 0x19, 0x4b, 0x12, 0x96, 0x83,
+		0x2d, 0x7d, 0x5d, 0x5a, 0x7a, 0x7b, 0x31, 0x34, 0x17, 0x1a, 0x79, 0xba,
+		0xd8, 0x63, 0x9a, 0x3a, 0x97, 0x78, 0xe1, 0x81, 0xf9, 0xa0, 0xad, 0xda
+	},
+	{
+		0xf8, 0xb8, 0x38, 0xb2, 0x86, 0x6f, 0x2b, 0x6e, 0xb9, 0x42, 0xf7, 0x65,
+		0x58, 0xe0, 0x04, 0x08, 0x78, 0xbb, 0x66, 0x5f, 0x8f, 0x79, 0x29, 0x2b,
+		0xbe, 0x61, 0x7a, 0x0f, 0xd5, 0xa6, 0xbd, 0x1f, 0xb5, 0xea, 0x6c, 0x18,
+		0x01, 0xc8, 0x4d, 0xea, 0x50, 0x93, 0x8b, 0x9b, 0x09, 0x33, 0x1e, 0xe2,
+		0xac, 0xd2, 0x8a, 0xfa, 0x7e, 0xde, 0x12, 0x44, 0xe7, 0x5c, 0xd2, 0x8d,
+		0xaa, 0xab, 0xa8, 0x4b, 0x97, 0xdd, 0xed, 0x6d, 0x15, 0x80, 0x2f, 0x8f,
+		0x48, 0xf5, 0x10, 0xfa, 0x8e, 0xb9, 0x6e, 0xb4, 0x2a, 0x58, 0x62, 0x7f,
+		0x5f, 0x9f, 0xcb, 0x09, 0x2a, 0x51, 0x8d, 0x48, 0x37, 0x80, 0xed, 0xa2
+	},
+	{
+		0x5f, 0x63, 0x46, 0x1a, 0x23, 0x14, 0x5a, 0xb8, 0xf5, 0x73, 0x71, 0xce,
+		0x69, 0x51, 0x9c, 0x83, 0x5d, 0x1b, 0x88, 0x4b, 0xd0, 0xfd, 0xfc, 0x4e,
+		0x3b, 0x64, 0x0d, 0xec, 0xa8, 0xb1, 0x92, 0x8e, 0xfb, 0x4d, 0xf3, 0x8c,
+		0x05, 0xa7, 0xdb, 0x5d, 0x4a, 0x28, 0x6f, 0x33, 0x03, 0x03, 0x49, 0x68,
+		0x74, 0x9a, 0xbc, 0xda, 0x2b, 0x1b, 0x5d, 0x04, 0x8c, 0x5a, 0x79, 0xb4,
+		0x4a, 0xfb, 0xfa, 0x16, 0x3e, 0x54, 0x7a, 0x0c, 0x65, 0x4f, 0xe0, 0x6d,
+		0x2c, 0xd6, 0x3f, 0xd0, 0x09, 0x7c, 0x32, 0xa2, 0x92, 0x4d, 0x7e, 0x7e,
+		0x64, 0xdd, 0x49, 0xc2, 0xed, 0xef, 0xcd, 0x18, 0x44, 0x70, 0x4c, 0xbc
+	},
+	{
+		0x69, 0xf7, 0xb6, 0x5f, 0x07, 0x74, 0xea, 0x13, 0x1b, 0xbc, 0xc1, 0xe0,
+		0x69, 0x0b, 0x01, 0xa1, 0x0a, 0xd3, 0x5e, 0x83, 0xe9, 0xbc, 0xbe, 0xbb,
+		0x4b, 0x2f, 0xdf, 0x35, 0x68, 0x59, 0x2f, 0xf1, 0x31, 0x5f, 0xc1, 0x6f,
+		0x4b, 0x77, 0x2c, 0x5b, 0x06, 0xf6, 0xcf, 0xf7, 0x4f, 0xee, 0x70, 0x5e,
+		0x1d, 0x8d, 0x9c, 0x44, 0x3d, 0xf7, 0x83, 0x87, 0xce, 0xbe, 0x19, 0x59,
+		0x64, 0xcb, 0xed, 0xc0, 0x50, 0xf5, 0x2c, 0xde, 0x02, 0x05, 0x25, 0xcc,
+		0xcf, 0x3a, 0xf2, 0x79, 0xcb, 0xbd, 0xfc, 0x33, 0x74, 0x9f, 0xa4, 0x69,
+		0x4c, 0x78, 0xbc, 0xf9, 0xea, 0xa6, 0x8f, 0xc8, 0x68, 0xfb, 0xc2, 0x42
+	},
+	{
+		0x03, 0xc2, 0x59, 0x2c, 0xe6, 0x58, 0x0e, 0xf1, 0xe4, 0x15, 0xdf, 0xc4,
+		0xd8, 0x4b, 0x80, 0x9e, 0xee, 0xfa, 0x67, 0x58, 0x23, 0x28, 0x0e, 0xfa,
+		0xcb, 0xba, 0x88, 0xd2, 0xe6, 0xc5, 0xf5, 0xb7, 0x03, 0xac, 0x4e, 0x13,
+		0xbc, 0x1d, 0xe0, 0xc6, 0x0b, 0x68, 0x51, 0x5f, 0xf7, 0x56, 0xac, 0x51,
+		0xeb, 0x3e, 0xbb, 0x50, 0xd7, 0x13, 0x1d, 0xaa, 0x01, 0xea, 0x1f, 0x89,
+		0x33, 0x8b, 0x42, 0x95, 0xb5, 0x38, 0x49, 0xc1, 0x2d, 0xcd, 0x57, 0x08,
+		0x1b, 0x3c, 0x9e, 0xfe, 0x3d, 0x83, 0x2e, 0xfc, 0x38, 0xfc, 0x9b, 0x2a,
+		0xc3, 0x8f, 0xf3, 0xba, 0x0b, 0x22, 0x2b, 0x16, 0x99, 0x27, 0x26, 0x9b
+	},
+	{
+		0xe7, 0xb3, 0xf4, 0x2d, 0xca, 0xd3, 0xd1, 0x09, 0x23, 0xea, 0xf4, 0xcd,
+		0xed, 0xfb, 0x89, 0x8d, 0x39, 0xac, 0xb8, 0xf2, 0x2a, 0xaa, 0x34, 0x51,
+		0x1a, 0xf0, 0x00, 0xf8, 0xcd, 0x3d, 0x04, 0x97, 0xda, 0x74, 0xbd, 0xf2,
+		0xbb, 0x0f, 0x6c, 0xa7, 0x31, 0xef, 0xc1, 0x32, 0x1a, 0x9b, 0xb0, 0xaa,
+		0x5a, 0x5d, 0x5c, 0x5f, 0xfc, 0x21, 0x29, 0x20, 0xb1, 0x8e, 0x3f, 0xba,
+		0x86, 0x15, 0xe7, 0xa5, 0xbb, 0xb2, 0x5c, 0x8f, 0xc4, 0x63, 0xe3, 0xb8,
+		0x80, 0xa9, 0x3e, 0xc7, 0x21, 0x6b, 0x71, 0xd5, 0x6f, 0x59, 0x11, 0x02,
+		0x0e, 0x70, 0xa6, 0x33, 0x98, 0xca, 0x61, 0xb5, 0x5e, 0x69, 0x53, 0x94
+	},
+	{
+		0xaf, 0x08, 0x53, 0x11, 0x76, 0x0d, 0x24, 0xbf, 0x90, 0xd0, 0x59, 0x05,
+		0xef, 0x39, 0x47, 0xc1, 0xfe, 0xea, 0x91, 0x03, 0xab, 0xa4, 0x2b, 0x33,
+		0xb8, 0x83, 0x15, 0x40, 0x16, 0x7e, 0x35, 0x5a, 0xc5, 0x50, 0x87, 0xd9,
+		0xed, 0x6e, 0x33, 0xe0, 0xf2, 0x97, 0x7c, 0x54, 0xd2, 0x52, 0x9a, 0xd2,
+		0x97, 0x46, 0x28, 0xaa, 0x2a, 0x25, 0x7f, 0xfa, 0x2d, 0x06, 0x22, 0x4d,
+		0xe6, 0xd8, 0x83, 0xae, 0x3b, 0x95, 0x41, 0xca, 0x65, 0xe2, 0x11, 0xe7,
+		0x04, 0xc7, 0xf6, 0xaf, 0xa6, 0x3e, 0x5e, 0xd9, 0xf6, 0xeb, 0x14, 0x78,
+		0x55, 0x84, 0x1c, 0x80, 0xe5, 0xb1, 0x48, 0x50, 0xbd, 0xdd, 0x2f, 0x1f
+	},
+	{
+		0xf2, 0x77, 0xb4, 0xbc, 0x9d, 0xf0, 0x4a, 0x3c, 0x57, 0xd0, 0x10, 0x6c,
+		0xd7, 0xc4, 0x28, 0xdb, 0x0b, 0x23, 0x0b, 0x2a, 0x26, 0x13, 0xa7, 0x70,
+		0x86, 0xd4, 0x1f, 0x81, 0xf5, 0xb0, 0xb2, 0xa7, 0x4b, 0x71, 0x09, 0x1f,
+		0x48, 0x5b, 0x3a, 0x1f, 0x1d, 0x12, 0xee, 0x6d, 0x45, 0xf5, 0xb0, 0x90,
+		0x0c, 0xc6, 0x5d, 0x74, 0x27, 0xe0, 0x42, 0xea, 0x77, 0x2d, 0x38, 0xd7,
+		0x2f, 0x49, 0xed, 0x16, 0xef, 0x86, 0x0b, 0xec, 0x97, 0x18, 0x2d, 0xb4,
+		0xce, 0xb4, 0xd1, 0x15, 0xcc, 0x39, 0x4c, 0x36, 0x84, 0x6c, 0xe2, 0x85,
+		0xd3, 0x17, 0x04, 0x7c, 0xfc, 0x50, 0x6e, 0x66, 0x0a, 0x32, 0xa7, 0xe5
+	},
+	{
+		0x71, 0xa9, 0x82, 0x1e, 0xd0, 0x05, 0x51, 0x1c, 0xbb, 0xd2, 0x0e, 0x23,
+		0x21, 0x81, 0x38, 0xc5, 0xc0, 0xa0, 0x21, 0x32, 0xe0, 0x53, 0xad, 0x7d,
+		0x07, 0xd5, 0x13, 0x7c, 0x1a, 0xd0, 0x62, 0xe6, 0x9e, 0xd4, 0xf5, 0xc9,
+		0x08, 0x0e, 0xdb, 0x56, 0x56, 0xc0, 0xcb, 0x84, 0x56, 0x15, 0xdb, 0x79,
+		0xd5, 0x7e, 0xe5, 0x6d, 0x82, 0x5e, 0xe6, 0x6d, 0x99, 0x05, 0xc2, 0x8c,
+		0x99, 0xd7, 0xf1, 0xbc, 0xb8, 0x48, 0xd7, 0xe9, 0x63, 0x6c, 0x29, 0x88,
+		0x1c, 0xca, 0x5d, 0xb1, 0xb2, 0x3f, 0x38, 0xf5, 0x46, 0x17, 0x46, 0xb9,
+		0xdf, 0x45, 0x65, 0xcb, 0xb9, 0xb7, 0xaa, 0xc6, 0xbf, 0x27, 0xc3, 0xa7
+	},
+	{
+		0x14, 0xe4, 0xe4, 0xd0, 0x56, 0x89, 0x9a, 0x2c, 0x08, 0xf0, 0x1b, 0xe4,
+		0x45, 0x6f, 0x32, 0x5c, 0x7f, 0x98, 0x03, 0xea, 0x4c, 0xff, 0xcb, 0xdf,
+		0xe4, 0xc0, 0x33, 0xa6, 0x85, 0x68, 0x05, 0xe7, 0x1d, 0x08, 0x2a, 0x02,
+		0xc4, 0xaa, 0x70, 0x3d, 0xcd, 0x81, 0x27, 0xfd, 0xab, 0xe8, 0x6f, 0x94,
+		0x99, 0x7c, 0x7d, 0xaa, 0x8e, 0x12, 0xb7, 0xe4, 0x98, 0x3e, 0x3b, 0xaf,
+		0xda, 0x5a, 0x3a, 0xb7, 0x6d, 0x1b, 0x51, 0xf8, 0x5c, 0x2d, 0xb9, 0xe8,
+		0x42, 0x73, 0x4e, 0x23, 0x26, 0x0e, 0xb1, 0x2a, 0x71, 0x00, 0x59, 0x5d,
+		0x34, 0x8c, 0x7c, 0x8a, 0xc2, 0x20, 0xc4, 0xe3, 0x68, 0x45, 0x0d, 0x6a
+	},
+	{
+		0x91, 0xda, 0x6c, 0x57, 0xc5, 0x92, 0xad, 0xc7, 0x8a, 0xd8, 0x36, 0xae,
+		0x17, 0xd5, 0xf5, 0xbb, 0xf4, 0x68, 0xa5, 0x3c, 0x3f, 0xc6, 0x8c, 0xda,
+		0xd8, 0xaa, 0xcd, 0x08, 0x80, 0x7a, 0x5a, 0x47, 0x23, 0x82, 0xc6, 0xf4,
+		0x39, 0x58, 0xc6, 0x11, 0x63, 0xb6, 0xdb, 0x01, 0x7d, 0xfa, 0x61, 0x7b,
+		0xe5, 0x90, 0x41, 0x8f, 0x48, 0xcf, 0x4b, 0x36, 0x03, 0x05, 0x16, 0x7e,
+		0x43, 0xcc, 0xdd, 0x66, 0xa8, 0xe8, 0xe3, 0x43, 0x17, 0x41, 0xf9, 0x27,
+		0x67, 0xa0, 0x64, 0x72, 0x3e, 0x42, 0xdb, 0x96, 0xb2, 0x7e, 0x5c, 0xda,
+		0xaa, 0xf4, 0x9f, 0x7e, 0x84, 0x8c, 0x78, 0x40, 0xc0, 0x17, 0x67, 0xe8
+	},
+	{
+		0xa2, 0xb3, 0xac, 0xa7, 0x48, 0x66, 0x48, 0x03, 0x0c, 0xad, 0x33, 0x05,
+		0x40, 0x36, 0x09, 0x44, 0xe7, 0xe2, 0xee, 0xf3, 0x23, 0xad, 0x2f, 0x18,
+		0xbf, 0x08, 0xa7, 0x3c, 0x30, 0x9a, 0x7d, 0x39, 0xfd, 0x4f, 0x93, 0xf5,
+		0x7e, 0x74, 0x54, 0x58, 0xbb, 0x31, 0xf6, 0x03, 0x87, 0x66, 0x7e, 0x11,
+		0xc2, 0x21, 0x74, 0xf5, 0x96, 0x42, 0x95, 0xdf, 0x8c, 0xa5, 0x2d, 0xd3,
+		0x27, 0x1a, 0xb0, 0xfe, 0x31, 0xd8, 0x5e, 0xbc, 0x74, 0x14, 0x26, 0x6b,
+		0x0f, 0x13, 0xe3, 0xe4, 0xde, 0x11, 0x7c, 0x49, 0xbb, 0x40, 0x9f, 0xf6,
+		0x4d, 0x64, 0xd1, 0xcd, 0x87, 0x67, 0x5c, 0xe3, 0xba, 0x1f, 0xce, 0x75
+	},
+	{
+		0x15, 0x53, 0x44, 0xc5, 0x05, 0x85, 0x2b, 0x1b, 0x45, 0x3f, 0x88, 0xb8,
+		0x87, 0x71, 0x44, 0x1c, 0x50, 0x6b, 0xf4, 0x33, 0xa0, 0x64, 0x14, 0xfc,
+		0x74, 0x7f, 0x91, 0xb8, 0x02, 0x3f, 0x67, 0x29, 0xde, 0x8a, 0x0e, 0x6a,
+		0x2f, 0x79, 0x63, 0x86, 0x5c, 0xbc, 0x04, 0x22, 0x9d, 0x6b, 0x0c, 0x98,
+		0x98, 0x49, 0x5d, 0x67, 0x71, 0x9d, 0x78, 0xfa, 0x8d, 0x1d, 0x54, 0x24,
+		0x20, 0x93, 0x2f, 0xdd, 0x45, 0x3a, 0xb0, 0x57, 0x5c, 0x90, 0x74, 0xaf,
+		0x04, 0x94, 0x1b, 0xae, 0xb6, 0xba, 0x5a, 0xe0, 0xd2, 0x9d, 0x1c, 0x69,
+		0xd3, 0xa1, 0x33, 0x66, 0x2e, 0xe3, 0x73, 0x1c, 0xd1, 0xfe, 0x2b, 0x3e
+	},
+	{
+		0x9c, 0x05, 0x08, 0x15, 0x72, 0xf7, 0xfc, 0x70, 0x60, 0xd6, 0x6a, 0x8a,
+		0x5d, 0xad, 0x58, 0xfc, 0x2e, 0x31, 0xcf, 0x2a, 0x73, 0x55, 0x03, 0xef,
+		0x7b, 0xa9, 0x92, 0x51, 0x03, 0xfd, 0x29, 0xc7, 0xad, 0xcb, 0xca, 0x0f,
+		0xfb, 0x28, 0x3b, 0xa5, 0xad, 0x7f, 0x8a, 0xec, 0x9e, 0x33, 0x03, 0xa4,
+		0x1c, 0xf3, 0x97, 0xcd, 0xdb, 0x05, 0xf5, 0xaa, 0x21, 0x85, 0x49, 0x1f,
+		0x8b, 0x0c, 0x75, 0x1c, 0x50, 0xe7, 0xbd, 0x15, 0xfd, 0xef, 0x99, 0x16,
+		0x8d, 0x19, 0xa6, 0x21, 0x82, 0x8c, 0x22, 0xd7, 0xbb, 0x04, 0xba, 0x18,
+		0x4c, 0xaf, 0xb0, 0xe7, 0x35, 0xf5, 0xc4, 0xf6, 0xc7, 0x6b, 0xfe, 0x85
+	},
+	{
+		0x3f, 0x92, 0xde, 0xeb, 0x74, 0x55, 0x1c, 0xfc, 0xf2, 0x88, 0x50, 0x89,
+		0x1d, 0xbb, 0xee, 0xb0, 0x17, 0xb9, 0x71, 0x41, 0x1b, 0xc4, 0xc2, 0x2a,
+		0x96, 0xee, 0xbb, 0x12, 0x3c, 0x83, 0xe1, 0x88, 0xb1, 0xbc, 0xb7, 0x5f,
+		0x6c, 0x79, 0x7f, 0x59, 0x69, 0x8f, 0xe0, 0x8d, 0x11, 0x0e, 0xc8, 0x12,
+		0x10, 0x08, 0xa9, 0x19, 0x2d, 0xe7, 0x15, 0x4f, 0x30, 0xb6, 0xfe, 0x07,
+		0xad, 0x95, 0x4e, 0x6c, 0x96, 0x4b, 0x64, 0xb7, 0x49, 0xe7, 0xad, 0xaf,
+		0x8f, 0x24, 0x26, 0xb6, 0xc3, 0xfd, 0xfc, 0x75, 0x81, 0xc1, 0xe2, 0x5f,
+		0xa3, 0x26, 0x99, 0x2a, 0xb2, 0xb3, 0xd0, 0x19, 0x06, 0x92, 0x38, 0x9c
+	},
+	{
+		0xfc, 0x45, 0xac, 0xb0, 0xc3, 0x3a, 0x23, 0xe5, 0x05, 0x5f, 0x14, 0xe6,
+		0x03, 0x6e, 0x1c, 0xf2, 0x3d, 0x98, 0x1f, 0x00, 0x54, 0x54, 0x0a, 0x3f,
+		0xd4, 0xcd, 0x49, 0x91, 0x04, 0x33, 0x83, 0x9b, 0x50, 0x5d, 0x7d, 0x43,
+		0x1a, 0xc6, 0x71, 0x53, 0xb5, 0x40, 0x6a, 0xeb, 0xff, 0xdc, 0xde, 0xce,
+		0xce, 0x94, 0x9a, 0x4c, 0x5f, 0x0e, 0x60, 0xe7, 0xba, 0x48, 0x28, 0x74,
+		0x01, 0x34, 0xa1, 0xd2, 0x13, 0x9c, 0xcd, 0xbf, 0xb9, 0x6d, 0x52, 0x65,
+		0xae, 0xbc, 0xf8, 0xa0, 0x40, 0xae, 0xcc, 0xee, 0x08, 0x60, 0x62, 0xf1,
+		0xbb, 0x8b, 0x42, 0xc8, 0x04, 0xb8, 0xd1, 0x6b, 0x1d, 0x12, 0x99, 0x97
+	},
+	{
+		0xf1, 0x34, 0x20, 0x94, 0x6d, 0xbb, 0x1d, 0xe3, 0x6f, 0x03, 0x48, 0x17,
+		0xa6, 0x20, 0x21, 0x91, 0x01, 0xee, 0xb5, 0x80, 0x90, 0x19, 0xb8, 0xda,
+		0x2b, 0x96, 0x18, 0xd8, 0xbb, 0x71, 0xb0, 0xf2, 0x71, 0x1d, 0x70, 0xd9,
+		0x14, 0x74, 0xe4, 0xe0, 0xfa, 0xff, 0x6b, 0x3f, 0x0a, 0xac, 0xbd, 0xbe,
+		0xb0, 0x8d, 0xc4, 0xb8, 0xd4, 0x0a, 0xec, 0x5d, 0x1b, 0xe4, 0x3d, 0xe1,
+		0x4d, 0x28, 0x0e, 0xa6, 0x04, 0xad, 0xba, 0x39, 0x0b, 0xb8, 0x0c, 0xd0,
+		0x51, 0x74, 0x2d, 0x35, 0x25, 0xde, 0x02, 0x5c, 0x2d, 0x2b, 0x55, 0x23,
+		0xf8, 0x77, 0xda, 0xbe, 0xe2, 0xbe, 0x4e, 0x8e, 0x4b, 0x67, 0x82, 0x59
+	},
+	{
+		0x86, 0xd1, 0xbd, 0xcf, 0x09, 0x2e, 0xe0, 0xc5, 0x10, 0x4c, 0x10, 0x28,
+		0xab, 0xb3, 0x8e, 0xac, 0xff, 0x21, 0xcf, 0x57, 0x3b, 0x71, 0xcd, 0xbf,
+		0xe8, 0x80, 0x16, 0x3d, 0x59, 0x6c, 0x7e, 0x37, 0xd4, 0x64, 0xf8, 0xba,
+		0xbe, 0x30, 0x74, 0xcf, 0xd1, 0x65, 0xcd, 0x21, 0x9c, 0x8e, 0x42, 0x78,
+		0xf9, 0x57, 0xda, 0xeb, 0xea, 0x5b, 0x86, 0xc3, 0x80, 0x52, 0xfb, 0x31,
+		0x8f, 0xcf, 0x76, 0x88, 0x05, 0x8d, 0xf5, 0x86, 0x38, 0x6a, 0xae, 0x10,
+		0xd0, 0x16, 0x00, 0x20, 0x40, 0x24, 0x5e, 0xe6, 0xcb, 0xdd, 0xa0, 0x9f,
+		0xc9, 0xb5, 0x64, 0xe6, 0x48, 0xf6, 0xc5, 0x54, 0xcd, 0x61, 0x92, 0x24
+	},
+	{
+		0xac, 0x3b, 0xec, 0x82, 0x5d, 0x44, 0xfb, 0x41, 0x4b, 0xfa, 0x26, 0x08,
+		0x66, 0x25, 0x25, 0x0f, 0xbf, 0xf1, 0x3c, 0xa6, 0x83, 0xc3, 0x97, 0xed,
+		0xae, 0x73, 0xeb, 0x9e, 0x43, 0xab, 0x78, 0xdd, 0x47, 0xae, 0xd6, 0x90,
+		0x32, 0x93, 0x20, 0x9b, 0x6d, 0x0c, 0x4d, 0x55, 0xc2, 0xce, 0x68, 0x3e,
+		0xe6, 0xd7, 0x90, 0x9e, 0x14, 0x13, 0x74, 0x09, 0x50, 0xb3, 0x10, 0xf0,
+		0x4f, 0xaa, 0x1e, 0xa1, 0x1d, 0x5c, 0x41, 0x77, 0x6a, 0xa4, 0xbb, 0x27,
+		0x5b, 0xee, 0xfa, 0xfc, 0x32, 0x81, 0xa4, 0x5d, 0x87, 0x45, 0xfd, 0xeb,
+		0xa0, 0x22, 0xf2, 0x4a, 0x69, 0xd0, 0x99, 0x04, 0xb5, 0xea, 0x90, 0x58
+	},
+	{
+		0x86, 0xdc, 0x3f, 0xa0, 0xeb, 0x2c, 0xfb, 0x46, 0x39, 0xe8, 0x20, 0x32,
+		0x6d, 0x15, 0xc9, 0x13, 0xb4, 0x09, 0xff, 0x5b, 0xfa, 0xab, 0x06, 0x98,
+		0xff, 0x0b, 0x96, 0xfa, 0x74, 0x69, 0xad, 0xf5, 0x9f, 0xc7, 0x53, 0x06,
+		0x5f, 0x93, 0x53, 0x41, 0x98, 0x57, 0xf3, 0x21, 0xb0, 0x02, 0x66, 0x7c,
+		0x10, 0x7a, 0x3b, 0xd9, 0x11, 0x90, 0xc0, 0x1c, 0xf8, 0xd1, 0x80, 0x7f,
+		0x18, 0xb7, 0x42, 0x23, 0x1d, 0x4e, 0x2d, 0x20, 0x73, 0x84, 0x02, 0x24,
+		0x22, 0x3f, 0xa0, 0x9f, 0xc1, 0xb1, 0x37, 0x17, 0x2c, 0xdb, 0xf9, 0x9d,
+		0x66, 0xc6, 0x10, 0x37, 0x69, 0xbe, 0xe6, 0x9d, 0x3e, 0x1e, 0x3f, 0xd2
+	},
+	{
+		0x3a, 0x9e, 0x39, 0xa8, 0x88, 0x69, 0xd0, 0xcb, 0x7c, 0x6d, 0x9e, 0x03,
+		0xb7, 0xa8, 0x1a, 0x4f, 0x93, 0x22, 0xe2, 0x05, 0x9f, 0x6b, 0x87, 0x39,
+		0xeb, 0xc2, 0x5f, 0xf2, 0xed, 0x75, 0x53, 0x60, 0x50, 0xfa, 0x35, 0xfc,
+		0x68, 0x2e, 0x4e, 0x19, 0x2c, 0x06, 0xd1, 0xa8, 0x4f, 0x70, 0xbd, 0xdb,
+		0x53, 0xd9, 0x81, 0x4d, 0x80, 0xb6, 0x06, 0xdf, 0xac, 0xb7, 0x73, 0x3f,
+		0xdf, 0x8d, 0xee, 0xcd, 0xd3, 0xd6, 0xbb, 0xce, 0x4f, 0x4f, 0x63, 0xc3,
+		0x45, 0xe4, 0x4a, 0xa0, 0x1a, 0xdd, 0xf4, 0x3e, 0x74, 0x34, 0xb7, 0x0d,
+		0x92, 0x4b, 0x06, 0xa1, 0x15, 0x08, 0x24, 0xec, 0xfe, 0x68, 0xef, 0xf8
+	},
+	{
+		0x38, 0x17, 0x4a, 0x00, 0x6b, 0xfc, 0xf2, 0x1e, 0x5f, 0x54, 0x49, 0xe7,
+		0x5c, 0x7a, 0x9b, 0xa1, 0x85, 0xdf, 0xb3, 0x83, 0x30, 0x07, 0xa4, 0x82,
+		0x89, 0xac, 0xc4, 0xc0, 0xb1, 0x66, 0x6e, 0xaa, 0x13, 0x23, 0xfe, 0xff,
+		0xba, 0x0f, 0x8b, 0x3d, 0x11, 0x01, 0x62, 0xf2, 0x96, 0x8b, 0x4a, 0x5f,
+		0xd6, 0x37, 0xfb, 0xf6, 0x92, 0xee, 0x7c, 0x2e, 0xe0, 0xbc, 0xd7, 0xaf,
+		0x20, 0x55, 0xee, 0x90, 0x9b, 0x79, 0x5d, 0x80, 0x16, 0x05, 0x97, 0x6d,
+		0xe6, 0x09, 0x1c, 0x18, 0x3a, 0x45, 0xad, 0x17, 0x13, 0xf3, 0x90, 0xd7,
+		0x40, 0xcb, 0x71, 0x8b, 0x9f, 0x7d, 0xc2, 0x54, 0x4f, 0x04, 0x74, 0xfc
+	},
+	{
+		0xcc, 0x24, 0x91, 0x48, 0x3d, 0xb8, 0x5f, 0x16, 0x28, 0xa0, 0xde, 0xd9,
+		0x57, 0x15, 0xac, 0x43, 0x2f, 0x1c, 0x95, 0x64, 0xa1, 0x25, 0x48, 0x09,
+		0x0e, 0x76, 0x43, 0x23, 0x16, 0x39, 0xfc, 0xf5, 0xfe, 0x21, 0x82, 0x66,
+		0x33, 0xb3, 0xf9, 0x08, 0x94, 0x97, 0x19, 0x13, 0xdf, 0x13, 0xf5, 0x15,
+		0x85, 0x9f, 0x78, 0x1e, 0x4a, 0x01, 0x57, 0xba, 0x98, 0x2a, 0xbc, 0x37,
+		0xb8, 0x30, 0xe8, 0x3c, 0x1d, 0xde, 0x41, 0xe1, 0xb2, 0x10, 0x25, 0x6f,
+		0x2d, 0x25, 0xac, 0x66, 0x6c, 0xbb, 0xc3, 0x4f, 0x20, 0xf4, 0xd8, 0x9d,
+		0xaa, 0xf0, 0x3b, 0x8a, 0xc4, 0xbd, 0x32, 0xd1, 0x54, 0xc8, 0xf2, 0x2d
+	},
+	{
+		0xf1, 0x6c, 0xae, 0xc4, 0xdd, 0x13, 0x10, 0x05, 0x2b, 0xb8, 0x22, 0x5a,
+		0x62, 0xeb, 0x53, 0xa5, 0x89, 0xd0, 0x3a, 0x28, 0x61, 0xaa, 0x03, 0x3d,
+		0x84, 0xd7, 0x6e, 0x8e, 0x42, 0x09, 0xb8, 0xbb, 0x4f, 0x89, 0xc2, 0x56,
+		0x19, 0x49, 0xdc, 0xa9, 0x37, 0x41, 0xa3, 0xd0, 0xda, 0xf7, 0x0c, 0xc5,
+		0xbe, 0xfe, 0xb4, 0x74, 0x76, 0x26, 0xb6, 0x88, 0x83, 0x6e, 0x28, 0x86,
+		0x17, 0xcc, 0xd6, 0xd8, 0x27, 0x5b, 0x8d, 0xc4, 0x60, 0x9d, 0xe2, 0x17,
+		0xd3, 0xc4, 0x77, 0xf5, 0xb6, 0xe5, 0x22, 0x55, 0xa8, 0x94, 0xe8, 0x51,
+		0x97, 0x05, 0xc6, 0x12, 0xfb, 0x3d, 0xa6, 0x05, 0xb3, 0xf8, 0x58, 0x50
+	},
+	{
+		0x23, 0x4f, 0xf1, 0x91, 0x79, 0x9f, 0x7c, 0xab, 0xee, 0x06, 0xb3, 0x02,
+		0x75, 0x05, 0x16, 0x86, 0x4c, 0x29, 0x2e, 0xd9, 0xa5, 0xb4, 0xb9, 0x8c,
+		0x01, 0x7c, 0x75, 0x2e, 0x59, 0xd3, 0xeb, 0xac, 0x05, 0x59, 0x16, 0xa4,
+		0x24, 0x3d, 0x4b, 0x30, 0x56, 0x4f, 0x51, 0x0b, 0x12, 0xcd, 0x19, 0xbd,
+		0xf3, 0xb9, 0x74, 0x0f, 0xa2, 0xee, 0x80, 0x9b, 0x1d, 0xaf, 0xb1, 0xae,
+		0xb6, 0xd9, 0x99, 0x57, 0x48, 0x24, 0xd1, 0x15, 0x60, 0x0a, 0x30, 0x0e,
+		0x57, 0x24, 0xc2, 0xc4, 0x3f, 0x87, 0x65, 0x69, 0xcd, 0xbd, 0x40, 0x55,
+		0x5f, 0xc2, 0xe2, 0x71, 0x77, 0x30, 0xff, 0xe1, 0x84, 0x7c, 0x98, 0x65
+	},
+	{
+		0xc3, 0x81, 0x97, 0x02, 0x5c, 0x98, 0xfd, 0xf6, 0xd9, 0xf2, 0x61, 0x2f,
+		0x50, 0x54, 0x6b, 0x32, 0x38, 0xdf, 0x4f, 0x70, 0xfc, 0xa6, 0xaa, 0x42,
+		0x72, 0xbd, 0x5e, 0x91, 0x27, 0x34, 0x0d, 0x10, 0xd3, 0x5f, 0xbd, 0xc6,
+		0xa1, 0xa2, 0x3a, 0x44, 0x0a, 0x28, 0x93, 0x21, 0xae, 0x3c, 0x5c, 0x76,
+		0x63, 0x4c, 0xd1, 0x41, 0xad, 0x07, 0x90, 0xea, 0x3b, 0xe9, 0xab, 0xf2,
+		0x51, 0xc4, 0xa7, 0xd1, 0xcb, 0xf8, 0xcd, 0xa2, 0x3a, 0x8c, 0x0e, 0x3e,
+		0x45, 0x22, 0xf4, 0x08, 0xea, 0xd8, 0xf1, 0x8c, 0x5d, 0xf6, 0xec, 0xff,
+		0x9a, 0x39, 0x6e, 0x7f, 0x6a, 0x25, 0x44, 0xdf, 0x74, 0x76, 0xa5, 0x66
+	},
+	{
+		0xc6, 0x5d, 0x02, 0x59, 0xdd, 0x1a, 0x12, 0xb5, 0x2d, 0x74, 0xe5, 0xbf,
+		0xdf, 0x14, 0xcf, 0xba, 0x32, 0xa7, 0xa0, 0x5a, 0xce, 0xcb, 0x60, 0x6c,
+		0xeb, 0x38, 0x20, 0x9d, 0x2a, 0x10, 0x0f, 0xb0, 0xfe, 0xa6, 0x01, 0x80,
+		0x5d, 0x9d, 0xad, 0x61, 0x1e, 0x99, 0x10, 0xc1, 0x37, 0x0f, 0xe6, 0x03,
+		0x67, 0x62, 0x56, 0x61, 0x9d, 0xc0, 0x26, 0xbd, 0x0c, 0xf0, 0x46, 0xa2,
+		0x35, 0x24, 0xf0, 0x0e, 0x59, 0x0a, 0x59, 0xbc, 0x80, 0x65, 0x50, 0x87,
+		0xcc, 0x9c, 0x29, 0xe6, 0xf7, 0xcf, 0xf6, 0x74, 0xdc, 0x79, 0xa2, 0xb3,
+		0x93, 0xb1, 0x45, 0xed, 0x7b, 0x4d, 0x13, 0xb6, 0xf5, 0xf8, 0xc9, 0xc8
+	},
+	{
+		0x14, 0x8a, 0xc3, 0xc9, 0xac, 0x1b, 0x42, 0xf6, 0xc6, 0x5a, 0xee, 0xc0,
+		0x7e, 0xa2, 0x5c, 0x0b, 0x64, 0x0d, 0x40, 0xa5, 0x13, 0xbe, 0x9d, 0x9d,
+		0xc2, 0xf3, 0x12, 0x0a, 0x51, 0x89, 0xf1, 0xd9, 0xd0, 0xf3, 0xda, 0x4a,
+		0xd7, 0x39, 0x6b, 0x2b, 0x21, 0x7a, 0xff, 0xc5, 0x53, 0x5b, 0x98, 0x74,
+		0x16, 0x65, 0x21, 0x5e, 0x09, 0x5c, 0x11, 0xe2, 0x9f, 0x3a, 0xb9, 0x3d,
+		0x51, 0xbb, 0xae, 0xad, 0x3e, 0x06, 0x6e, 0x81, 0x2a, 0x18, 0xaa, 0xfd,
+		0xba, 0xa8, 0x5b, 0xfc, 0xfa, 0x27, 0x9b, 0x86, 0x4c, 0x25, 0xd7, 0xa6,
+		0x75, 0xb6, 0x29, 0xe8, 0x94, 0x9c, 0x94, 0xd4, 0x7c, 0x4c, 0x23, 0xe0
+	},
+	{
+		0xdc, 0xaf, 0xab, 0x6e, 0xc7, 0xdd, 0x2e, 0x7d, 0xfb, 0x9e, 0xd4, 0x1c,
+		0x2d, 0x5d, 0x3f, 0x66, 0x22, 0x0b, 0x12, 0xa8, 0xea, 0x0f, 0x3b, 0xb8,
+		0x6b, 0x9d, 0x76, 0x4a, 0xd5, 0x96, 0x34, 0x75, 0x3f, 0xf3, 0x77, 0xfc,
+		0x35, 0xce, 0xf7, 0x8a, 0x54, 0x37, 0x2e, 0x43, 0x24, 0xc2, 0xbb, 0x10,
+		0xaa, 0x5f, 0x97, 0x88, 0x87, 0x20, 0xa5, 0xd8, 0xe3, 0xa8, 0x95, 0x9d,
+		0x9e, 0x2b, 0x7d, 0xe0, 0x81, 0x9d, 0x41, 0x50, 0xde, 0x21, 0x50, 0x7b,
+		0x8f, 0xa5, 0x2c, 0xcf, 0xd0, 0xf9, 0x89, 0xee, 0xc3, 0x19, 0x32, 0x79,
+		0x92, 0x90, 0x51, 0x30, 0x59, 0x8e, 0x83, 0x9a, 0x0c, 0x7b, 0xb2, 0x8c
+	},
+	{
+		0x74, 0x0a, 0x16, 0xf9, 0x86, 0x1c, 0xc4, 0x48, 0x40, 0x8b, 0x82, 0x31,
+		0x88, 0x4b, 0x0b, 0x69, 0xf4, 0x61, 0x15, 0xf6, 0x95, 0xe4, 0xca, 0x40,
+		0xea, 0xa8, 0xfd, 0xc7, 0xd1, 0xfa, 0x56, 0xcb, 0xac, 0x24, 0x66, 0x78,
+		0xca, 0xb2, 0xf9, 0x70, 0x69, 0xfe, 0x6d, 0xe0, 0xf2, 0x18, 0x59, 0x61,
+		0xd2, 0x5b, 0x20, 0xd6, 0x19, 0xf5, 0xf2, 0x97, 0x91, 0x69, 0x82, 0xea,
+		0x35, 0x21, 0x32, 0x2c, 0x0e, 0x01, 0x85, 0x9a, 0x35, 0xdb, 0xb8, 0x62,
+		0x3a, 0x25, 0xef, 0xb9, 0xe9, 0x93, 0xcc, 0xad, 0x43, 0x39, 0x95, 0x55,
+		0x15, 0xb8, 0xbc, 0x28, 0x7c, 0x20, 0x24, 0xcd, 0xe6, 0x3b, 0x89, 0xdd
+	},
+	{
+		0xae, 0x61, 0xe4, 0x4c, 0x31, 0x1c, 0x2d, 0x54, 0x2c, 0x18, 0x93, 0x4b,
+		0xfa, 0xab, 0x60, 0x1e, 0x6b, 0xb0, 0x0d, 0x35, 0x13, 0xc7, 0x26, 0x5a,
+		0x2e, 0x07, 0x83, 0x13, 0xa3, 0x49, 0x97, 0x82, 0xda, 0xc9, 0xd9, 0xad,
+		0xb2, 0x7e, 0x5c, 0xa5, 0x60, 0x5a, 0xe8, 0x7e, 0x66, 0xb4, 0x59, 0x64,
+		0x05, 0x03, 0x94, 0xc3, 0x5e, 0xb0, 0x46, 0xf5, 0xee, 0xf9, 0xe1, 0xb3,
+		0x96, 0x13, 0xe9, 0x5e, 0xbc, 0x6a, 0xc8, 0x8b, 0xc9, 0x95, 0xb7, 0x42,
+		0xc5, 0x33, 0x27, 0x78, 0xc7, 0x56, 0xa8, 0x18, 0x60, 0xcc, 0x36, 0xed,
+		0x51, 0x4d, 0x54, 0x38, 0xc5, 0x91, 0x6e, 0x59, 0x51, 0x1e, 0x4d, 0xde
+	},
+	{
+		0x85, 0x10, 0xfd, 0x43, 0x61, 0x2d, 0xb2, 0xa9, 0xb3, 0x8a, 0xcd, 0x7a,
+		0xe7, 0x05, 0x5f, 0x43, 0xba, 0x45, 0x75, 0xe3, 0x46, 0xe3, 0xfe, 0x2c,
+		0xcf, 0xf0, 0xe3, 0x62, 0xb2, 0x72, 0xde, 0xdf, 0x0d, 0x03, 0xe7, 0x6f,
+		0xfb, 0x3f, 0x71, 0xa7, 0xa7, 0x33, 0x6b, 0x4c, 0x29, 0x2d, 0xb8, 0xd6,
+		0x3f, 0x00, 0xc9, 0x8a, 0x66, 0xf6, 0x3c, 0x3e, 0x68, 0x7b, 0xea, 0xb1,
+		0x62, 0xd4, 0xbf, 0x9f, 0x05, 0x69, 0x8e, 0xbc, 0x70, 0x2c, 0x08, 0x28,
+		0x5b, 0x91, 0x5b, 0x8e, 0x37, 0xef, 0x7c, 0x9a, 0xdb, 0x5d, 0x78, 0x2b,
+		0xcb, 0xfb, 0x86, 0x8a, 0x18, 0x9c, 0x8d, 0xcd, 0x9b, 0xc4, 0xaa, 0xd3
+	},
+	{
+		0xba, 0x0b, 0xb1, 0x40, 0x2d, 0x02, 0x58, 0x7c, 0x2c, 0x47, 0x5a, 0x8e,
+		0xfd, 0xa5, 0x0f, 0xf0, 0x18, 0x3c, 0xa5, 0x97, 0x5d, 0xc2, 0x84, 0xcf,
+		0x89, 0x31, 0x64, 0x4d, 0x44, 0x50, 0x41, 0x21, 0x42, 0xcb, 0xa7, 0x5b,
+		0x31, 0x83, 0xca, 0x76, 0xb6, 0x9e, 0x1a, 0x41, 0x30, 0x29, 0x5b, 0x6d,
+		0xef, 0x62, 0x70, 0xa8, 0x48, 0x89, 0xb1, 0x05, 0x69, 0xd8, 0x00, 0x1a,
+		0xdf, 0x1d, 0x90, 0x4b, 0x31, 0xc4, 0x00, 0x73, 0x69, 0x75, 0xf2, 0x7c,
+		0x18, 0x63, 0x88, 0x50, 0xa4, 0xd9, 0xc1, 0xae, 0x2a, 0x5b, 0x1f, 0x44,
+		0x72, 0x47, 0x53, 0x84, 0x99, 0x43, 0x23, 0xce, 0x67, 0x8c, 0x33, 0xda
+	},
+	{
+		0x2d, 0x42, 0x9b, 0x8f, 0x32, 0x2c, 0x4c, 0xc3, 0xd1, 0xbb, 0xf0, 0x1d,
+		0x0b, 0x9a, 0xf7, 0x31, 0xfd, 0x61, 0x6c, 0xc2, 0xb0, 0xce, 0xb4, 0x76,
+		0xf7, 0x61, 0x5a, 0x8b, 0xfe, 0x66, 0x65, 0xb4, 0x82, 0xdf, 0xbf, 0x8d,
+		0x7f, 0xa5, 0x0c, 0x45, 0x9c, 0xb2, 0x62, 0x05, 0x1d, 0x80, 0x8b, 0xf2,
+		0x8a, 0x6c, 0x52, 0x3c, 0xed, 0x47, 0x6d, 0x14, 0x42, 0x36, 0x04, 0x9c,
+		0x91, 0xc5, 0xa8, 0x0c, 0xe7, 0xc9, 0x50, 0x92, 0x32, 0x5e, 0x0b, 0x06,
+		0x61, 0x61, 0x3d, 0x73, 0x7d, 0xb9, 0x14, 0xfc, 0x93, 0x1b, 0x07, 0x90,
+		0x26, 0x85, 0x7e, 0x49, 0x8b, 0x87, 0x7c, 0xc0, 0x94, 0x3b, 0x6f, 0xfb
+	},
+	{
+		0x63, 0xaf, 0x0d, 0xa1, 0x85, 0x53, 0x93, 0xc4, 0xcb, 0x5c, 0x8a, 0x68,
+		0x6d, 0xe0, 0x2a, 0x66, 0x49, 0x9f, 0xff, 0xfb, 0x84, 0xc3, 0x38, 0x25,
+		0x9a, 0xc7, 0x9b, 0x24, 0x3c, 0x54, 0x04, 0x0d, 0xb6, 0x91, 0x63, 0x23,
+		0x48, 0x23, 0x1b, 0xfe, 0x3c, 0x8a, 0xef, 0x7b, 0x50, 0x55, 0x8a, 0x7e,
+		0xb1, 0x5b, 0x7d, 0xc3, 0xcb, 0x56, 0x17, 0xc1, 0x77, 0xc1, 0x91, 0xcc,
+		0x64, 0x86, 0x9e, 0x35, 0x0a, 0xb4, 0x21, 0x5e, 0x3f, 0x77, 0xa4, 0x90,
+		0xca, 0x87, 0x43, 0x88, 0x09, 0x53, 0x76, 0x75, 0xe0, 0xb4, 0xc8, 0xa2,
+		0x49, 0x8d, 0xaf, 0x92, 0x51, 0x06, 0xd0, 0x0b, 0x4c, 0x95, 0x88, 0x1b
+	},
+	{
+		0x28, 0x27, 0xbf, 0x67, 0xb5, 0x1d, 0x6a, 0x88, 0xdc, 0xb4, 0x0a, 0x65,
+		0xa3, 0x73, 0x07, 0x12, 0x4d, 0xf5, 0x6f, 0xbc, 0xdf, 0x65, 0xae, 0x68,
+		0x26, 0x90, 0xc7, 0x84, 0x1a, 0xe6, 0xdf, 0xc8, 0x7b, 0xc9, 0x18, 0x61,
+		0xcb, 0xba, 0xff, 0x21, 0x94, 0xdc, 0x66, 0x4c, 0xef, 0x74, 0xf7, 0x23,
+		0xca, 0x2e, 0x18, 0xbd, 0x98, 0xea, 0xbb, 0xc9, 0xed, 0x4e, 0x6d, 0x4e,
+		0x18, 0x78, 0x05, 0xae, 0xba, 0x00, 0x16, 0x80, 0x66, 0x9f, 0x2b, 0xc7,
+		0x5c, 0x9b, 0xac, 0x55, 0x09, 0x13, 0x90, 0x3c, 0x45, 0xb4, 0x7c, 0x9c,
+		0xc9, 0xc0, 0x48, 0x8c, 0xd7, 0xac, 0xb3, 0x74, 0x83, 0xdf, 0xac, 0x3c
+	},
+	{
+		0x6d, 0x0b, 0x35, 0x4e, 0xc6, 0x80, 0x23, 0x65, 0x55, 0x99, 0x86, 0xd9,
+		0xb9, 0xaa, 0xc9, 0xff, 0xb5, 0x42, 0x1e, 0xce, 0x77, 0x8c, 0x4b, 0xb1,
+		0x1f, 0x65, 0x72, 0xbc, 0xb2, 0xbe, 0x31, 0xe0, 0xc1, 0xaf, 0x45, 0xef,
+		0x11, 0xe1, 0xed, 0x1e, 0x1c, 0xb1, 0x21, 0x91, 0xb5, 0x9f, 0x74, 0x64,
+		0x1d, 0x88, 0x0f, 0xc4, 0x95, 0xa5, 0x76, 0x0a, 0x96, 0xf5, 0xc7, 0xab,
+		0xf4, 0x21, 0x08, 0xdb, 0xc8, 0xa5, 0x8b, 0xdd, 0x8f, 0x47, 0x01, 0x62,
+		0x01, 0xbc, 0x8e, 0x70, 0xaa, 0x7c, 0xf1, 0x8d, 0x05, 0x4a, 0x9a, 0x12,
+		0xf1, 0x86, 0xc8, 0x61, 0x23, 0x1d, 0x32, 0x39, 0x0a, 0xa2, 0xd8, 0x47
+	},
+	{
+		0x66, 0xc8, 0xe6, 0x52, 0x85, 0x12, 0x11, 0x57, 0xfb, 0x9f, 0xd3, 0xce,
+		0x88, 0x11, 0x35, 0x86, 0xeb, 0x1c, 0x24, 0xab, 0xc9, 0x83, 0xdf, 0xc7,
+		0xa2, 0xb8, 0xe9, 0xaa, 0x5b, 0x8c, 0xd3, 0xf8, 0x5b, 0x93, 0x07, 0x38,
+		0x5a, 0x42, 0x7d, 0x95, 0x2f, 0xdc, 0xb3, 0x13, 0x9d, 0xe8, 0xa8, 0x7c,
+		0x1e, 0xea, 0x69, 0x97, 0x52, 0xb5, 0xe8, 0x90, 0x93, 0xa6, 0x03, 0xc9,
+		0xe2, 0x2c, 0xd7, 0xbe, 0xba, 0xb7, 0xa9, 0xa8, 0x60, 0x31, 0x47, 0x51,
+		0x18, 0xca, 0xf8, 0x47, 0x84, 0x06, 0x1f, 0x0e, 0x59, 0x03, 0x40, 0x61,
+		0x95, 0x35, 0xd2, 0x85, 0xd8, 0x3b, 0xe6, 0x56, 0x84, 0xa0, 0x21, 0x0f
+	},
+	{
+		0xef, 0xd0, 0xfd, 0xb5, 0xaf, 0x14, 0xee, 0x70, 0xd6, 0xea, 0xb7, 0x09,
+		0x16, 0xa8, 0x8b, 0xb6, 0xc6, 0xd3, 0x05, 0x19, 0xa2, 0xc6, 0x59, 0x76,
+		0x30, 0xb5, 0x83, 0x07, 0x13, 0x16, 0xee, 0x5c, 0xef, 0xc6, 0x44, 0x2b,
+		0x04, 0xe5, 0x36, 0x90, 0x49, 0x51, 0x75, 0xcd, 0x52, 0x2a, 0x42, 0x3f,
+		0x71, 0x68, 0x21, 0xc6, 0x85, 0x42, 0x57, 0x12, 0x24, 0xe8, 0xcd, 0x38,
+		0xfc, 0x1a, 0x5b, 0x28, 0x66, 0xee, 0xef, 0xf3, 0x03, 0x02, 0x1f, 0x01,
+		0x2b, 0x58, 0x37, 0x95, 0x3e, 0xc2, 0x3d, 0x8e, 0x7f, 0xc4, 0x91, 0xe5,
+		0x3f, 0x0e, 0x31, 0xbe, 0x75, 0x66, 0x6e, 0x3e, 0x71, 0xca, 0x7c, 0x18
+	},
+	{
+		0x3b, 0xd5, 0x30, 0xa3, 0xe2, 0xa4, 0x0f, 0xaa, 0x78, 0xfb, 0xb9, 0x53,
+		0xaf, 0xf5, 0x4c, 0x16, 0x53, 0x12, 0x01, 0x34, 0xda, 0x4a, 0x51, 0x3c,
+		0x0d, 0xa6, 0xb7, 0xa8, 0x75, 0x47, 0x64, 0x90, 0xd2, 0xe2, 0x2e, 0xc0,
+		0xd0, 0xff, 0x81, 0x40, 0xe5, 0xb1, 0xa0, 0xd5, 0x78, 0x52, 0xa8, 0xb0,
+		0xd8, 0xb9, 0x04, 0x0a, 0x7a, 0xae, 0x42, 0x8a, 0xed, 0x86, 0xab, 0xe0,
+		0x20, 0xdb, 0xf9, 0xbe, 0xe0, 0xd8, 0xb0, 0x28, 0xee, 0x1c, 0x8c, 0x08,
+		0x68, 0xc4, 0x94, 0x4f, 0xca, 0x91, 0x7d, 0x28, 0xc4, 0x7f, 0x32, 0x9c,
+		0x7c, 0xe1, 0xbc, 0x46, 0xa4, 0x6d, 0x27, 0x42, 0x08, 0x7f, 0x83, 0xd8
+	},
+	{
+		0x0b, 0x4b, 0x5e, 0xea, 0xcb, 0x46, 0xab, 0x57, 0x82, 0xe3, 0x6d, 0xc1,
+		0xac, 0x5b, 0x72, 0xae, 0x42, 0xe2, 0x1e, 0x34, 0x27, 0x48, 0x78, 0x74,
+		0x55, 0x30, 0xb3, 0xb2, 0xca, 0x40, 0x03, 0xad, 0xce, 0xb2, 0x99, 0x5e,
+		0x9d, 0x94, 0x0c, 0x86, 0xc0, 0xe6, 0x0a, 0xb1, 0x66, 0x4a, 0xa2, 0x8d,
+		0x2f, 0xc3, 0x85, 0x4a, 0xea, 0x65, 0x14, 0x5c, 0x28, 0x34, 0x21, 0x77,
+		0xec, 0xa4, 0xe5, 0xd1, 0x17, 0x42, 0xd2, 0x5f, 0x4e, 0x23, 0xa7, 0x30,
+		0x7c, 0xd9, 0x10, 0x8b, 0xe0, 0x26, 0x76, 0xd8, 0x02, 0xdd, 0xcf, 0xd6,
+		0x4c, 0x7d, 0x5c, 0x68, 0x52, 0x2a, 0x9f, 0x51, 0x4e, 0xad, 0x08, 0xfc
+	},
+	{
+		0xa0, 0x12, 0xe8, 0xcb, 0x12, 0x09, 0x5c, 0xf4, 0x89, 0xa2, 0xa4, 0xfd,
+		0x1d, 0x99, 0xdf, 0xe4, 0x26, 0xe0, 0x86, 0x8d, 0x1a, 0x71, 0xa7, 0xe6,
+		0xa6, 0xcc, 0xfb, 0x9b, 0xd2, 0xa6, 0x4c, 0x9b, 0x24, 0xbd, 0xf9, 0x41,
+		0x18, 0x8e, 0x23, 0x07, 0x25, 0x3e, 0x8c, 0x05, 0x19, 0x3f, 0x48, 0x9a,
+		0x76, 0x3a, 0xbf, 0xc4, 0x94, 0xc8, 0xb1, 0xbb, 0x12, 0x61, 0xf1, 0x41,
+		0xcd, 0xa1, 0x81, 0xa2, 0xd4, 0x29, 0xd1, 0x28, 0xed, 0x4e, 0x5b, 0x27,
+		0x10, 0x0f, 0xb6, 0x0f, 0x7d, 0x1a, 0x99, 0x6e, 0x42, 0x94, 0x11, 0xf5,
+		0x21, 0x2c, 0x5b, 0x5b, 0x42, 0x5a, 0x5c, 0x1b, 0x1b, 0xd5, 0xee, 0x20
+	},
+	{
+		0x3e, 0xd6, 0x21, 0xac, 0xdd, 0xd6, 0x08, 0x8a, 0x21, 0xd2, 0xe7, 0x0e,
+		0x1e, 0xc3, 0xb2, 0x15, 0x5c, 0x97, 0xac, 0x7e, 0x49, 0x2b, 0x73, 0x9c,
+		0x04, 0x5e, 0x5a, 0xef, 0x73, 0x19, 0x37, 0xea, 0xd4, 0xc8, 0x40, 0x0f,
+		0x7e, 0x53, 0xbb, 0xf6, 0x65, 0x7e, 0x15, 0x73, 0x27, 0x40, 0xd8, 0x19,
+		0xf2, 0x9d, 0x6b, 0xcd, 0xa4, 0x1c, 0x83, 0x65, 0x0b, 0x54, 0x15, 0xfc,
+		0x0d, 0xb7, 0x21, 0xdd, 0xb2, 0xe9, 0x97, 0x8b, 0x8b, 0xf6, 0xe4, 0x2a,
+		0x5a, 0x30, 0xc2, 0xd2, 0xf5, 0xc6, 0x99, 0xc3, 0x89, 0x3a, 0x50, 0x49,
+		0xa7, 0x31, 0x6c, 0x08, 0x3f, 0x38, 0xf2, 0x6d, 0x6d, 0xbe, 0x26, 0xa9
+	},
+	{
+		0xeb, 0xda, 0x14, 0xbf, 0x9c, 0x39, 0x0a, 0x58, 0x12, 0x8b, 0x81, 0x3d,
+		0x27, 0x62, 0x54, 0x4e, 0x14, 0x9f, 0x1f, 0x4a, 0xe7, 0xf8, 0xd0, 0xe0,
+		0xbe, 0xf7, 0xd9, 0x24, 0x9e, 0x7f, 0x13, 0x5a, 0x78, 0xde, 0xbe, 0x84,
+		0xe1, 0x45, 0x2d, 0xf2, 0xfa, 0xf2, 0x4e, 0x1d, 0x21, 0x22, 0x8a, 0xb2,
+		0xf2, 0xb4, 0xaf, 0x6d, 0x2d, 0x23, 0xca, 0xfe, 0x3f, 0xdf, 0x45, 0x33,
+		0x73, 0x41, 0x15, 0xcd, 0x8f, 0x9d, 0xdd, 0x40, 0x5e, 0x63, 0xe1, 0x31,
+		0x68, 0xe8, 0x1b, 0x1e, 0x9b, 0x76, 0x38, 0x9a, 0xae, 0x8c, 0xfc, 0x1c,
+		0xb3, 0xf2, 0x4f, 0x5e, 0xf4, 0xc4, 0x56, 0x1f, 0x2d, 0x14, 0xfe, 0x1b
+	},
+	{
+		0xf7, 0x38, 0x98, 0xfd, 0x5f, 0xd7, 0x47, 0xfa, 0xf0, 0x83, 0x97, 0x1b,
+		0x14, 0x44, 0x3d, 0x32, 0x84, 0x56, 0x4d, 0x23, 0x74, 0xaf, 0xd8, 0x8c,
+		0x5c, 0x46, 0x13, 0xcf, 0xa5, 0x30, 0xe7, 0x6f, 0x7b, 0x1a, 0x96, 0x37,
+		0xfc, 0x27, 0x7a, 0x27, 0x93, 0x69, 0xaa, 0xe4, 0x48, 0x4c, 0xe8, 0xd6,
+		0x21, 0xce, 0x35, 0x95, 0x01, 0x04, 0xf8, 0xac, 0xb1, 0xa6, 0xda, 0x80,
+		0x43, 0x32, 0xff, 0xd7, 0x53, 0x49, 0x61, 0xf7, 0x1b, 0xb9, 0x6c, 0xfa,
+		0x04, 0x65, 0xc8, 0x06, 0xac, 0x30, 0xe9, 0x51, 0x2d, 0x89, 0x94, 0x47,
+		0xd2, 0x32, 0x5d, 0xea, 0x15, 0xc1, 0x7b, 0xfd, 0x36, 0x64, 0x73, 0xa3
+	},
+	{
+		0x59, 0xbc, 0xd3, 0x46, 0x7a, 0x41, 0xc6, 0x4c, 0xf3, 0x59, 0xaf, 0xab,
+		0x84, 0xa4, 0x76, 0x88, 0x2c, 0xd1, 0xc9, 0x8f, 0x8d, 0x1e, 0x02, 0x03,
+		0xd0, 0xc3, 0x89, 0xc4, 0xeb, 0x47, 0x55, 0x04, 0xa0, 0xea, 0x60, 0x92,
+		0x64, 0x63, 0x4b, 0x7e, 0x81, 0xa5, 0x5f, 0xa1, 0x24, 0x1f, 0x66, 0x5b,
+		0x51, 0x06, 0xca, 0xa8, 0xcd, 0x52, 0x77, 0x95, 0x4c, 0xdd, 0x06, 0xd1,
+		0xc4, 0x7a, 0x8f, 0x0b, 0xf0, 0xe6, 0x07, 0xeb, 0xe8, 0x94, 0x0b, 0xf8,
+		0x9c, 0x5a, 0x31, 0x1d, 0xc8, 0xc5, 0x47, 0x1f, 0x6e, 0x9e, 0xea, 0x3f,
+		0xd1, 0x56, 0xe1, 0x43, 0x3a, 0xa1, 0x00, 0xe8, 0xe6, 0x4b, 0xc2, 0x8e
+	},
+	{
+		0xb6, 0xc9, 0xdc, 0x11, 0xaa, 0x72, 0x42, 0x86, 0xc6, 0xc2, 0x2c, 0x15,
+		0xb7, 0xa5, 0x26, 0x81, 0xdc, 0x48, 0x95, 0x1d, 0x9e, 0x1d, 0x7a, 0x6f,
+		0x41, 0x9e, 0xf5, 0xad, 0xca, 0x36, 0xfb, 0xdf, 0xa6, 0xcd, 0xa0, 0x79,
+		0x6f, 0x1d, 0x57, 0x14, 0xac, 0xd8, 0xe2, 0x51, 0x0d, 0x46, 0x06, 0x6d,
+		0x3e, 0x65, 0x4e, 0x44, 0x41, 0xc3, 0xa4, 0x34, 0xdf, 0xfa, 0xeb, 0xad,
+		0xb0, 0x04, 0x84, 0x9a, 0x2c, 0xd0, 0xb8, 0xcb, 0xce, 0x83, 0x4f, 0x82,
+		0x46, 0x89, 0x3c, 0x57, 0x12, 0x58, 0x76, 0x82, 0x80, 0xa8, 0xc0, 0x60,
+		0xd8, 0x44, 0x6a, 0x48, 0xd4, 0xab, 0x3c, 0x62, 0xa7, 0x64, 0x6c, 0x3f
+	},
+	{
+		0x1c, 0xb8, 0xdf, 0xe5, 0x95, 0x90, 0x21, 0x9d, 0x67, 0x5b, 0x40, 0x89,
+		0x94, 0x5f, 0x1d, 0xca, 0x2c, 0x55, 0x27, 0x35, 0xf9, 0x41, 0x71, 0x06,
+		0xf9, 0x14, 0x06, 0x2a, 0x16, 0xdb, 0x2d, 0xb3, 0x14, 0x92, 0xac, 0x19,
+		0x25, 0xc6, 0x2a, 0xfc, 0x77, 0x65, 0xeb, 0xe9, 0xb0, 0xe0, 0x16, 0x00,
+		0x5d, 0x60, 0xf3, 0x5e, 0x51, 0x0e, 0xf1, 0xa2, 0x81, 0xf4, 0x25, 0x47,
+		0x50, 0x99, 0xc3, 0x72, 0xb8, 0x99, 0x49, 0x1c, 0xc2, 0x7d, 0xd5, 0xd2,
+		0x07, 0xaa, 0xea, 0xb6, 0x46, 0x6b, 0x69, 0xd0, 0x34, 0x9a, 0xa2, 0xd4,
+		0xe2, 0x36, 0xb8, 0x8d, 0xce, 0xf9, 0xbd, 0xca, 0x41, 0xfa, 0xb1, 0x75
+	},
+	{
+		0xb6, 0x1f, 0x00, 0x40, 0x34, 0x1c, 0x16, 0x5a, 0x9f, 0x1e, 0xe7, 0xcd,
+		0xfb, 0xed, 0xae, 0xf5, 0xbc, 0x17, 0xd3, 0x34, 0x1c, 0x54, 0xe3, 0x27,
+		0x6f, 0x26, 0xcc, 0x31, 0x57, 0xe6, 0xf0, 0xb7, 0x2c, 0xbd, 0xa6, 0xc0,
+		0xf8, 0x32, 0x53, 0x58, 0xc1, 0x20, 0x65, 0xe7, 0x1c, 0xa9, 0x16, 0xb6,
+		0x42, 0xb6, 0xa3, 0x35, 0xe2, 0xda, 0xff, 0xc9, 0x66, 0x8b, 0x62, 0x37,
+		0x0c, 0xb1, 0xf4, 0xbf, 0x67, 0x32, 0x74, 0x9d, 0xb1, 0x2d, 0xa4, 0x29,
+		0x62, 0x29, 0x94, 0xd4, 0x1b, 0x18, 0x73, 0x83, 0x44, 0x16, 0x4a, 0x0c,
+		0x8f, 0x99, 0xe0, 0x34, 0x09, 0x1a, 0x3b, 0xd4, 0xc2, 0x00, 0x32, 0x6a
+	},
+	{
+		0x65, 0x75, 0x99, 0x4a, 0x3b, 0xc7, 0xfa, 0x44, 0xc2, 0x3d, 0xc6, 0x88,
+		0x36, 0x1d, 0x12, 0xb2, 0x33, 0x3c, 0x14, 0x50, 0x52, 0x8f, 0x0a, 0x1d,
+		0xbf, 0xb2, 0x66, 0xeb, 0x95, 0xf2, 0xa5, 0x11, 0x4a, 0x11, 0x56, 0xc0,
+		0x2f, 0x8b, 0xac, 0x59, 0x34, 0xc9, 0x5b, 0x84, 0x4b, 0xfb, 0x94, 0x9b,
+		0xad, 0x81, 0xee, 0x03, 0x40, 0xd4, 0x3d, 0xf2, 0xc3, 0xc2, 0x7c, 0x16,
+		0x3b, 0x5b, 0xd8, 0xe4, 0x6b, 0x7f, 0x93, 0x71, 0x8a, 0xdd, 0x12, 0xfc,
+		0x56, 0xc1, 0x1e, 0xb8, 0xb2, 0xc4, 0x6c, 0x12, 0x14, 0xd1, 0x97, 0xfe,
+		0xde, 0xd4, 0x9c, 0x21, 0xc4, 0x5d, 0x8d, 0xb0, 0xc2, 0xcc, 0xe9, 0xed
+	},
+	{
+		0x12, 0x37, 0xde, 0xa2, 0x85, 0x32, 0x75, 0x2b, 0x0c, 0xf8, 0xb9, 0x3f,
+		0xa4, 0x72, 0xe0, 0xa8, 0x34, 0x15, 0xb9, 0xa6, 0x69, 0x31, 0x7a, 0xd6,
+		0x55, 0x07, 0x4e, 0xd7, 0xc0, 0x7e, 0x0a, 0x7b, 0x2b, 0x6f, 0x4e, 0xa7,
+		0xf3, 0x9a, 0x42, 0x79, 0xef, 0x16, 0xed, 0xc5, 0x65, 0x99, 0x49, 0x91,
+		0x77, 0x35, 0xa2, 0x8d, 0x7b, 0x81, 0x18, 0x4a, 0x1e, 0xa3, 0x8b, 0x16,
+		0x0a, 0xa3, 0x43, 0xe2, 0x2c, 0x4f, 0x74, 0x1b, 0x18, 0x81, 0xf3, 0xc5,
+		0x62, 0x9a, 0x7a, 0x2d, 0x58, 0x0b, 0xbe, 0x2b, 0x4b, 0x83, 0x85, 0xc3,
+		0x48, 0xb2, 0xfc, 0x9b, 0xf4, 0xa4, 0x41, 0x25, 0xcf, 0x0d, 0xc0, 0xbc
+	},
+	{
+		0xc0, 0xf3, 0x95, 0x09, 0x55, 0x7c, 0xca, 0x45, 0xc2, 0xb4, 0x21, 0x59,
+		0x2d, 0x60, 0x41, 0xd1, 0xc6, 0x65, 0x8e, 0x67, 0x1a, 0x96, 0x48, 0x62,
+		0xef, 0xbc, 0x79, 0x6e, 0x90, 0x51, 0xe2, 0xa6, 0xe1, 0x2f, 0x0b, 0x82,
+		0xd0, 0x05, 0x43, 0x2c, 0xed, 0xfa, 0x66, 0xb6, 0xeb, 0xc7, 0xa0, 0x5a,
+		0xfa, 0x6f, 0x0e, 0xb0, 0xc5, 0x6b, 0x72, 0x57, 0x1e, 0x61, 0xb4, 0x10,
+		0x3f, 0x54, 0x0a, 0xa1, 0x8e, 0xf4, 0x7b, 0x07, 0x8d, 0x75, 0x09, 0x55,
+		0xf5, 0x5a, 0x55, 0xa9, 0x22, 0xd9, 0x7e, 0x5c, 0xfa, 0x10, 0xba, 0x0d,
+		0xd6, 0x0f, 0xb2, 0x3c, 0x42, 0x48, 0x6f, 0x73, 0x95, 0x09, 0xf4, 0xce
+	},
+	{
+		0x0b, 0x63, 0x53, 0x99, 0x34, 0xd1, 0x6b, 0x96, 0xfe, 0xe7, 0x7e, 0xe2,
+		0xfc, 0xad, 0x95, 0xb0, 0x9c, 0x99, 0xcd, 0x5a, 0x13, 0xb5, 0xa1, 0xe8,
+		0xbf, 0xba, 0xe8, 0xc8, 0x48, 0xa4, 0x00, 0x04, 0xff, 0x56, 0x5a, 0xad,
+		0xb6, 0xb7, 0x2b, 0xf0, 0x03, 0x99, 0x5f, 0xe7, 0x2c, 0x3f, 0xc4, 0x86,
+		0x41, 0x9e, 0x88, 0x89, 0xad, 0xae, 0x97, 0xb4, 0xa5, 0xf0, 0xb6, 0x9b,
+		0xfe, 0x41, 0x43, 0x95, 0xc9, 0xe2, 0xb6, 0xe1, 0x07, 0x61, 0xae, 0x3a,
+		0x7a, 0xaf, 0x00, 0x3b, 0x30, 0x91, 0xc6, 0x81, 0x60, 0x4d, 0x83, 0x49,
+		0xd5, 0xd0, 0x85, 0x4e, 0x28, 0x01, 0xab, 0x2b, 0x5d, 0x77, 0x8a, 0x19
+	}
+};
+#endif
+
+#endif /* DROPBEAR_NISTP_TABLES_H_ */
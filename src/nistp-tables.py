@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+# Prints nistp-tables.h, the base point comb tables for nistp.c. Entry j-1
+# is the affine point of the sum of 2^(i*d)*G over the bits i set in j,
+# with d = ceil(bits / NISTP_COMB_TEETH).
+#
+# python3 nistp-tables.py > nistp-tables.h
+
+TEETH = 6
+
+curves = [
+	("256", 256,
+		2**256 - 2**224 + 2**192 + 2**96 - 1,
+		0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296,
+		0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5),
+	("384", 384,
+		2**384 - 2**128 - 2**96 + 2**32 - 1,
+		0xaa87ca22be8b05378eb1c71ef320ad746e1d3b628ba79b9859f741e082542a385502f25dbf55296c3a545e3872760ab7,
+		0x3617de4a96262c6f5d9e98bf9292dc29f8f41dbd289a147ce9da3113b5f0b8c00a60b1ce1d7e819d7a431d7c90ea0e5f),
+]
+
+def add(P, Q, p):
+	if P is None:
+		return Q
+	if Q is None:
+		return P
+	x1, y1 = P
+	x2, y2 = Q
+	if x1 == x2:
+		if (y1 + y2) % p == 0:
+			return None
+		l = (3 * x1 * x1 - 3) * pow(2 * y1, p - 2, p) % p
+	else:
+		l = (y2 - y1) * pow(x2 - x1, p - 2, p) % p
+	x3 = (l * l - x1 - x2) % p
+	return (x3, (l * (x1 - x3) - y1) % p)
+
+def mul(k, P, p):
+	R = None
+	while k > 0:
+		if k & 1:
+			R = add(R, P, p)
+		P = add(P, P, p)
+		k >>= 1
+	return R
+
+print("/* Base point tables for the comb multiplication in nistp.c. Entry j-1 is")
+print(" * the affine point x || y (big endian) of the sum of 2^(i*d) G over the bits")
+print(" * i that are set in j, for j from 1 to 2^NISTP_COMB_TEETH - 1. d is the")
+print(" * curve's comb spacing, ceil(bits / NISTP_COMB_TEETH). Generated by")
+print(" * nistp-tables.py */")
+print("")
+print("#ifndef DROPBEAR_NISTP_TABLES_H_")
+print("#define DROPBEAR_NISTP_TABLES_H_")
+
+for name, bits, p, gx, gy in curves:
+	size = bits // 8
+	d = (bits + TEETH - 1) // TEETH
+	teeth = [mul(2**(i * d), (gx, gy), p) for i in range(TEETH)]
+	print("")
+	print("#if DROPBEAR_ECC_%s" % name)
+	print("static const unsigned char nistp%s_comb[(1 << NISTP_COMB_TEETH) - 1][%d] = {"
+		% (name, 2 * size))
+	for j in range(1, 2**TEETH):
+		P = None
+		for i in range(TEETH):
+			if j & (1 << i):
+				P = add(P, teeth[i], p)
+		raw = P[0].to_bytes(size, "big") + P[1].to_bytes(size, "big")
+		lines = [", ".join("0x%02x" % c for c in raw[n:n + 12])
+			for n in range(0, len(raw), 12)]
+		print("\t{")
+		print(",\n".join("\t\t" + l for l in lines))
+		print("\t}%s" % ("," if j < 2**TEETH - 1 else ""))
+	print("};")
+	print("#endif")
+
+print("")
+print("#endif /* DROPBEAR_NISTP_TABLES_H_ */")
@@ -0,0 +1,692 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "nistp.h"
+
+#if DROPBEAR_NISTP
+
+/* Field elements are in Montgomery form, with 64 bit limbs where the
+ * compiler has a 128 bit type and 32 bit limbs otherwise.
+ *
+ * Points are projective (X:Y:Z) and use the complete formulas for a = -3
+ * from Renes, Costello and Batina, "Complete addition formulas for prime
+ * order elliptic curves" (2015). They have no special cases for doubling
+ * or the point at infinity, so the same operations are done whatever the
+ * scalar is. Table entries are selected by reading every entry. */
+
+#if defined(__SIZEOF_INT128__)
+typedef uint64_t limb;
+typedef unsigned __int128 dlimb;
+#define LIMB_BITS 64
+#else
+typedef uint32_t limb;
+typedef uint64_t dlimb;
+#define LIMB_BITS 32
+#endif
+
+#define MAX_LIMBS (NISTP_MAX_BYTES * 8 / LIMB_BITS)
+
+/* Dropbear is often built with -Os, the field arithmetic needs to be
+ * inlined, and specialised for each curve's number of limbs */
+#if defined(__GNUC__)
+#define FE_INLINE static inline __attribute__((always_inline))
+#else
+#define FE_INLINE static inline
+#endif
+
+/* k*G is computed with a comb: bit i*d+j of k selects 2^(i*d) G for
+ * column j, so d doublings and additions are needed, from a table of
+ * the 2^NISTP_COMB_TEETH - 1 sums of those points */
+#define NISTP_COMB_TEETH 6
+#define COMB_SIZE ((1 << NISTP_COMB_TEETH) - 1)
+
+#include "nistp-tables.h"
+
+typedef limb fe[MAX_LIMBS];
+
+struct point {
+	fe x, y, z;
+};
+
+struct affine {
+	fe x, y;
+};
+
+struct nistp_curve {
+	unsigned int bytes;
+	unsigned int comb_spacing; /* d, ceil(bits / NISTP_COMB_TEETH) */
+	const unsigned char *p_bytes;
+	const unsigned char *b_bytes;
+	const unsigned char *comb_bytes;
+
+	/* set up on first use */
+	int ready;
+	unsigned int nlimbs;
+	limb p[MAX_LIMBS];
+	limb p_inv; /* -p^-1 mod 2^LIMB_BITS */
+	fe rr; /* R^2 mod p, to convert to Montgomery form */
+	fe one; /* R mod p */
+	fe b;
+	struct affine comb[COMB_SIZE];
+};
+
+#if DROPBEAR_ECC_256
+static const unsigned char nistp256_p[32] = {
+	0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+static const unsigned char nistp256_b[32] = {
+	0x5a, 0xc6, 0x35, 0xd8, 0xaa, 0x3a, 0x93, 0xe7,
+	0xb3, 0xeb, 0xbd, 0x55, 0x76, 0x98, 0x86, 0xbc,
+	0x65, 0x1d, 0x06, 0xb0, 0xcc, 0x53, 0xb0, 0xf6,
+	0x3b, 0xce, 0x3c, 0x3e, 0x27, 0xd2, 0x60, 0x4b
+};
+static struct nistp_curve nistp256 = {
+	32, 43, nistp256_p, nistp256_b, &nistp256_comb[0][0],
+	0, 0, {0}, 0, {0}, {0}, {0}, {{{0}, {0}}}
+};
+#endif
+
+#if DROPBEAR_ECC_384
+static const unsigned char nistp384_p[48] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+	0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff
+};
+static const unsigned char nistp384_b[48] = {
+	0xb3, 0x31, 0x2f, 0xa7, 0xe2, 0x3e, 0xe7, 0xe4,
+	0x98, 0x8e, 0x05, 0x6b, 0xe3, 0xf8, 0x2d, 0x19,
+	0x18, 0x1d, 0x9c, 0x6e, 0xfe, 0x81, 0x41, 0x12,
+	0x03, 0x14, 0x08, 0x8f, 0x50, 0x13, 0x87, 0x5a,
+	0xc6, 0x56, 0x39, 0x8d, 0x8a, 0x2e, 0xd1, 0x9d,
+	0x2a, 0x85, 0xc8, 0xed, 0xd3, 0xec, 0x2a, 0xef
+};
+static struct nistp_curve nistp384 = {
+	48, 64, nistp384_p, nistp384_b, &nistp384_comb[0][0],
+	0, 0, {0}, 0, {0}, {0}, {0}, {{{0}, {0}}}
+};
+#endif
+
+/* All ones if a == b, otherwise zero */
+static limb ct_eq_mask(unsigned int a, unsigned int b) {
+	uint32_t x = a ^ b;
+	return (limb)0 - (limb)(((x | (0U - x)) >> 31) ^ 1);
+}
+
+/* r = a + b, returns the carry */
+FE_INLINE limb limbs_add(unsigned int n, limb *r, const limb *a, const limb *b) {
+	dlimb acc = 0;
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		acc += (dlimb)a[i] + b[i];
+		r[i] = (limb)acc;
+		acc >>= LIMB_BITS;
+	}
+	return (limb)acc;
+}
+
+/* r = a - b, returns the borrow */
+FE_INLINE limb limbs_sub(unsigned int n, limb *r, const limb *a, const limb *b) {
+	dlimb acc;
+	limb borrow = 0;
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		acc = (dlimb)a[i] - b[i] - borrow;
+		r[i] = (limb)acc;
+		borrow = (limb)(acc >> LIMB_BITS) & 1;
+	}
+	return borrow;
+}
+
+/* r = t mod p, for t < 2p where hi is the bit above t's limbs */
+FE_INLINE void fe_reduce_once(const struct nistp_curve *c, limb *r,
+		const limb *t, limb hi) {
+	limb u[MAX_LIMBS];
+	limb keep;
+	unsigned int i;
+
+	/* t is kept if subtracting p borrows with no high bit */
+	keep = 0 - (limbs_sub(c->nlimbs, u, t, c->p) & (hi ^ 1));
+	for (i = 0; i < c->nlimbs; i++) {
+		r[i] = (t[i] & keep) | (u[i] & ~keep);
+	}
+}
+
+FE_INLINE void fe_add(const struct nistp_curve *c, limb *r, const limb *a, const limb *b) {
+	limb t[MAX_LIMBS];
+	limb carry;
+
+	carry = limbs_add(c->nlimbs, t, a, b);
+	fe_reduce_once(c, r, t, carry);
+}
+
+FE_INLINE void fe_sub(const struct nistp_curve *c, limb *r, const limb *a, const limb *b) {
+	limb p[MAX_LIMBS];
+	limb mask;
+	unsigned int i;
+
+	/* add p back if it went negative */
+	mask = 0 - limbs_sub(c->nlimbs, r, a, b);
+	for (i = 0; i < c->nlimbs; i++) {
+		p[i] = c->p[i] & mask;
+	}
+	limbs_add(c->nlimbs, r, r, p);
+}
+
+/* Montgomery multiplication, r = a*b/R mod p, for n == c->nlimbs */
+FE_INLINE void fe_mul_n(const struct nistp_curve *c, limb *r, const limb *a,
+		const limb *b, const unsigned int n) {
+	limb t[MAX_LIMBS + 2];
+	limb m, carry;
+	dlimb acc;
+	unsigned int i, j;
+
+	memset(t, 0x0, sizeof(t));
+	for (i = 0; i < n; i++) {
+		carry = 0;
+		for (j = 0; j < n; j++) {
+			acc = (dlimb)a[j] * b[i] + t[j] + carry;
+			t[j] = (limb)acc;
+			carry = (limb)(acc >> LIMB_BITS);
+		}
+		acc = (dlimb)t[n] + carry;
+		t[n] = (limb)acc;
+		t[n + 1] = (limb)(acc >> LIMB_BITS);
+
+		/* add a multiple of p that clears the low limb, and shift down */
+		m = t[0] * c->p_inv;
+		acc = (dlimb)m * c->p[0] + t[0];
+		carry = (limb)(acc >> LIMB_BITS);
+		for (j = 1; j < n; j++) {
+			acc = (dlimb)m * c->p[j] + t[j] + carry;
+			t[j - 1] = (limb)acc;
+			carry = (limb)(acc >> LIMB_BITS);
+		}
+		acc = (dlimb)t[n] + carry;
+		t[n - 1] = (limb)acc;
+		t[n] = t[n + 1] + (limb)(acc >> LIMB_BITS);
+	}
+	fe_reduce_once(c, r, t, t[n]);
+}
+
+static void fe_mul(const struct nistp_curve *c, limb *r, const limb *a, const limb *b) {
+	if (c->nlimbs == 256 / LIMB_BITS) {
+		fe_mul_n(c, r, a, b, 256 / LIMB_BITS);
+	} else {
+		fe_mul_n(c, r, a, b, 384 / LIMB_BITS);
+	}
+}
+
+FE_INLINE void fe_copy(const struct nistp_curve *c, limb *r, const limb *a) {
+	memcpy(r, a, c->nlimbs * sizeof(limb));
+}
+
+/* r = a if mask is all ones, unchanged if zero */
+FE_INLINE void fe_cmov(const struct nistp_curve *c, limb *r, const limb *a, limb mask) {
+	unsigned int i;
+
+	for (i = 0; i < c->nlimbs; i++) {
+		r[i] ^= mask & (r[i] ^ a[i]);
+	}
+}
+
+static int fe_is_zero(const struct nistp_curve *c, const limb *a) {
+	limb acc = 0;
+	unsigned int i;
+
+	for (i = 0; i < c->nlimbs; i++) {
+		acc |= a[i];
+	}
+	return acc == 0;
+}
+
+/* r = a^-1, as a^(p-2). The exponent is public */
+static void fe_inv(const struct nistp_curve *c, limb *r, const limb *a) {
+	fe e, x, two;
+	int i;
+
+	memset(two, 0x0, sizeof(two));
+	two[0] = 2;
+	limbs_sub(c->nlimbs, e, c->p, two);
+
+	fe_copy(c, x, c->one);
+	for (i = c->nlimbs * LIMB_BITS - 1; i >= 0; i--) {
+		fe_mul(c, x, x, x);
+		if ((e[i / LIMB_BITS] >> (i % LIMB_BITS)) & 1) {
+			fe_mul(c, x, x, a);
+		}
+	}
+	fe_copy(c, r, x);
+}
+
+/* Big endian bytes to limbs, without conversion */
+static void limbs_from_bytes(const struct nistp_curve *c, limb *r,
+		const unsigned char *in) {
+	unsigned int i;
+
+	memset(r, 0x0, sizeof(fe));
+	for (i = 0; i < c->bytes; i++) {
+		r[i / sizeof(limb)] |= (limb)in[c->bytes - 1 - i] << (8 * (i % sizeof(limb)));
+	}
+}
+
+static void fe_from_bytes(const struct nistp_curve *c, limb *r,
+		const unsigned char *in) {
+	fe t;
+
+	limbs_from_bytes(c, t, in);
+	fe_mul(c, r, t, c->rr);
+}
+
+static void fe_to_bytes(const struct nistp_curve *c, unsigned char *out,
+		const limb *a) {
+	fe t, raw_one;
+	unsigned int i;
+
+	/* out of Montgomery form */
+	memset(raw_one, 0x0, sizeof(raw_one));
+	raw_one[0] = 1;
+	fe_mul(c, t, a, raw_one);
+	for (i = 0; i < c->bytes; i++) {
+		out[c->bytes - 1 - i] = (unsigned char)(t[i / sizeof(limb)] >> (8 * (i % sizeof(limb))));
+	}
+}
+
+static void point_set_infinity(const struct nistp_curve *c, struct point *r) {
+	memset(r, 0x0, sizeof(*r));
+	fe_copy(c, r->y, c->one);
+}
+
+static void point_cmov(const struct nistp_curve *c, struct point *r,
+		const struct point *a, limb mask) {
+	fe_cmov(c, r->x, a->x, mask);
+	fe_cmov(c, r->y, a->y, mask);
+	fe_cmov(c, r->z, a->z, mask);
+}
+
+/* r = 2p, algorithm 6 of Renes, Costello and Batina */
+static void point_double(const struct nistp_curve *c, struct point *r,
+		const struct point *p) {
+	fe t0, t1, t2, t3, x3, y3, z3;
+
+	fe_mul(c, t0, p->x, p->x);
+	fe_mul(c, t1, p->y, p->y);
+	fe_mul(c, t2, p->z, p->z);
+	fe_mul(c, t3, p->x, p->y);
+	fe_add(c, t3, t3, t3);
+	fe_mul(c, z3, p->x, p->z);
+	fe_add(c, z3, z3, z3);
+	fe_mul(c, y3, c->b, t2);
+	fe_sub(c, y3, y3, z3);
+	fe_add(c, x3, y3, y3);
+	fe_add(c, y3, x3, y3);
+	fe_sub(c, x3, t1, y3);
+	fe_add(c, y3, t1, y3);
+	fe_mul(c, y3, x3, y3);
+	fe_mul(c, x3, x3, t3);
+	fe_add(c, t3, t2, t2);
+	fe_add(c, t2, t2, t3);
+	fe_mul(c, z3, c->b, z3);
+	fe_sub(c, z3, z3, t2);
+	fe_sub(c, z3, z3, t0);
+	fe_add(c, t3, z3, z3);
+	fe_add(c, z3, z3, t3);
+	fe_add(c, t3, t0, t0);
+	fe_add(c, t0, t3, t0);
+	fe_sub(c, t0, t0, t2);
+	fe_mul(c, t0, t0, z3);
+	fe_add(c, y3, y3, t0);
+	fe_mul(c, t0, p->y, p->z);
+	fe_add(c, t0, t0, t0);
+	fe_mul(c, z3, t0, z3);
+	fe_sub(c, x3, x3, z3);
+	fe_mul(c, z3, t0, t1);
+	fe_add(c, z3, z3, z3);
+	fe_add(c, z3, z3, z3);
+
+	fe_copy(c, r->x, x3);
+	fe_copy(c, r->y, y3);
+	fe_copy(c, r->z, z3);
+}
+
+/* r = p + q, algorithm 4 of Renes, Costello and Batina */
+static void point_add(const struct nistp_curve *c, struct point *r,
+		const struct point *p, const struct point *q) {
+	fe t0, t1, t2, t3, t4, x3, y3, z3;
+
+	fe_mul(c, t0, p->x, q->x);
+	fe_mul(c, t1, p->y, q->y);
+	fe_mul(c, t2, p->z, q->z);
+	fe_add(c, t3, p->x, p->y);
+	fe_add(c, t4, q->x, q->y);
+	fe_mul(c, t3, t3, t4);
+	fe_add(c, t4, t0, t1);
+	fe_sub(c, t3, t3, t4);
+	fe_add(c, t4, p->y, p->z);
+	fe_add(c, x3, q->y, q->z);
+	fe_mul(c, t4, t4, x3);
+	fe_add(c, x3, t1, t2);
+	fe_sub(c, t4, t4, x3);
+	fe_add(c, x3, p->x, p->z);
+	fe_add(c, y3, q->x, q->z);
+	fe_mul(c, x3, x3, y3);
+	fe_add(c, y3, t0, t2);
+	fe_sub(c, y3, x3, y3);
+	fe_mul(c, z3, c->b, t2);
+	fe_sub(c, x3, y3, z3);
+	fe_add(c, z3, x3, x3);
+	fe_add(c, x3, x3, z3);
+	fe_sub(c, z3, t1, x3);
+	fe_add(c, x3, t1, x3);
+	fe_mul(c, y3, c->b, y3);
+	fe_add(c, t1, t2, t2);
+	fe_add(c, t2, t1, t2);
+	fe_sub(c, y3, y3, t2);
+	fe_sub(c, y3, y3, t0);
+	fe_add(c, t1, y3, y3);
+	fe_add(c, y3, t1, y3);
+	fe_add(c, t1, t0, t0);
+	fe_add(c, t0, t1, t0);
+	fe_sub(c, t0, t0, t2);
+	fe_mul(c, t1, t4, y3);
+	fe_mul(c, t2, t0, y3);
+	fe_mul(c, y3, x3, z3);
+	fe_add(c, y3, y3, t2);
+	fe_mul(c, x3, t3, x3);
+	fe_sub(c, x3, x3, t1);
+	fe_mul(c, z3, t4, z3);
+	fe_mul(c, t1, t3, t0);
+	fe_add(c, z3, z3, t1);
+
+	fe_copy(c, r->x, x3);
+	fe_copy(c, r->y, y3);
+	fe_copy(c, r->z, z3);
+}
+
+/* r = p + q for affine q, which can't be the point at infinity.
+ * Algorithm 5 of Renes, Costello and Batina */
+static void point_add_affine(const struct nistp_curve *c, struct point *r,
+		const struct point *p, const struct affine *q) {
+	fe t0, t1, t2, t3, t4, x3, y3, z3;
+
+	fe_mul(c, t0, p->x, q->x);
+	fe_mul(c, t1, p->y, q->y);
+	fe_add(c, t3, q->x, q->y);
+	fe_add(c, t4, p->x, p->y);
+	fe_mul(c, t3, t3, t4);
+	fe_add(c, t4, t0, t1);
+	fe_sub(c, t3, t3, t4);
+	fe_mul(c, t4, q->y, p->z);
+	fe_add(c, t4, t4, p->y);
+	fe_mul(c, y3, q->x, p->z);
+	fe_add(c, y3, y3, p->x);
+	fe_mul(c, z3, c->b, p->z);
+	fe_sub(c, x3, y3, z3);
+	fe_add(c, z3, x3, x3);
+	fe_add(c, x3, x3, z3);
+	fe_sub(c, z3, t1, x3);
+	fe_add(c, x3, t1, x3);
+	fe_mul(c, y3, c->b, y3);
+	fe_add(c, t1, p->z, p->z);
+	fe_add(c, t2, t1, p->z);
+	fe_sub(c, y3, y3, t2);
+	fe_sub(c, y3, y3, t0);
+	fe_add(c, t1, y3, y3);
+	fe_add(c, y3, t1, y3);
+	fe_add(c, t1, t0, t0);
+	fe_add(c, t0, t1, t0);
+	fe_sub(c, t0, t0, t2);
+	fe_mul(c, t1, t4, y3);
+	fe_mul(c, t2, t0, y3);
+	fe_mul(c, y3, x3, z3);
+	fe_add(c, y3, y3, t2);
+	fe_mul(c, x3, t3, x3);
+	fe_sub(c, x3, x3, t1);
+	fe_mul(c, z3, t4, z3);
+	fe_mul(c, t1, t3, t0);
+	fe_add(c, z3, z3, t1);
+
+	fe_copy(c, r->x, x3);
+	fe_copy(c, r->y, y3);
+	fe_copy(c, r->z, z3);
+}
+
+/* Writes the affine x and, if out_y isn't NULL, y of p */
+static int point_to_bytes(const struct nistp_curve *c, unsigned char *out_x,
+		unsigned char *out_y, const struct point *p) {
+	fe zinv, t;
+
+	if (fe_is_zero(c, p->z)) {
+		return DROPBEAR_FAILURE;
+	}
+	fe_inv(c, zinv, p->z);
+	fe_mul(c, t, p->x, zinv);
+	fe_to_bytes(c, out_x, t);
+	if (out_y) {
+		fe_mul(c, t, p->y, zinv);
+		fe_to_bytes(c, out_y, t);
+	}
+	return DROPBEAR_SUCCESS;
+}
+
+static unsigned int scalar_bit(const struct nistp_curve *c,
+		const unsigned char *k, unsigned int i) {
+	if (i >= c->bytes * 8) {
+		return 0;
+	}
+	return (k[c->bytes - 1 - i / 8] >> (i % 8)) & 1;
+}
+
+/* r = k*G */
+static void mul_base(const struct nistp_curve *c, struct point *r,
+		const unsigned char *k) {
+	struct point sum;
+	struct affine sel;
+	unsigned int col, i, idx;
+
+	point_set_infinity(c, r);
+	for (col = c->comb_spacing; col-- > 0;) {
+		point_double(c, r, r);
+
+		idx = 0;
+		for (i = 0; i < NISTP_COMB_TEETH; i++) {
+			idx |= scalar_bit(c, k, i * c->comb_spacing + col) << i;
+		}
+
+		/* entry idx-1, reading them all. For idx 0 the sum is discarded */
+		sel = c->comb[0];
+		for (i = 1; i < COMB_SIZE; i++) {
+			fe_cmov(c, sel.x, c->comb[i].x, ct_eq_mask(idx, i + 1));
+			fe_cmov(c, sel.y, c->comb[i].y, ct_eq_mask(idx, i + 1));
+		}
+		point_add_affine(c, &sum, r, &sel);
+		point_cmov(c, r, &sum, ~ct_eq_mask(idx, 0));
+	}
+
+	m_burn(&sum, sizeof(sum));
+	m_burn(&sel, sizeof(sel));
+}
+
+/* r = k*p, with 4 bit windows */
+static void mul_point(const struct nistp_curve *c, struct point *r,
+		const unsigned char *k, const struct point *p) {
+	struct point table[16], sel;
+	unsigned int i, w, digit;
+
+	point_set_infinity(c, &table[0]);
+	table[1] = *p;
+	for (i = 2; i < 16; i++) {
+		if (i % 2 == 0) {
+			point_double(c, &table[i], &table[i / 2]);
+		} else {
+			point_add(c, &table[i], &table[i - 1], p);
+		}
+	}
+
+	point_set_infinity(c, r);
+	for (w = c->bytes * 2; w-- > 0;) {
+		for (i = 0; i < 4; i++) {
+			point_double(c, r, r);
+		}
+		digit = (k[c->bytes - 1 - w / 2] >> (4 * (w % 2))) & 0xf;
+		sel = table[0];
+		for (i = 1; i < 16; i++) {
+			point_cmov(c, &sel, &table[i], ct_eq_mask(digit, i));
+		}
+		point_add(c, r, r, &sel);
+	}
+
+	m_burn(table, sizeof(table));
+	m_burn(&sel, sizeof(sel));
+}
+
+static void point_from_bytes(const struct nistp_curve *c, struct point *r,
+		const unsigned char *in) {
+	fe_from_bytes(c, r->x, in);
+	fe_from_bytes(c, r->y, in + c->bytes);
+	fe_copy(c, r->z, c->one);
+}
+
+#if DEBUG_TRACE
+/* Checks nistp-tables.h against multiples of G computed here: the first
+ * entry must be on the curve, each tooth 2^(i*d) G must be d doublings of
+ * the one before it, and the last entry must be the sum of all teeth */
+static void check_comb(const struct nistp_curve *c) {
+	struct point tooth, sum;
+	unsigned char out[2 * NISTP_MAX_BYTES];
+	fe lhs, rhs, t;
+	unsigned int i, j;
+
+	/* y^2 = x^3 - 3x + b */
+	fe_mul(c, lhs, c->comb[0].y, c->comb[0].y);
+	fe_mul(c, t, c->comb[0].x, c->comb[0].x);
+	fe_mul(c, rhs, t, c->comb[0].x);
+	fe_sub(c, rhs, rhs, c->comb[0].x);
+	fe_sub(c, rhs, rhs, c->comb[0].x);
+	fe_sub(c, rhs, rhs, c->comb[0].x);
+	fe_add(c, rhs, rhs, c->b);
+	fe_sub(c, t, lhs, rhs);
+	if (!fe_is_zero(c, t)) {
+		dropbear_exit("Bad nistp comb table");
+	}
+
+	point_from_bytes(c, &tooth, c->comb_bytes);
+	sum = tooth;
+	for (i = 1; i < NISTP_COMB_TEETH; i++) {
+		for (j = 0; j < c->comb_spacing; j++) {
+			point_double(c, &tooth, &tooth);
+		}
+		point_add(c, &sum, &sum, &tooth);
+		if (point_to_bytes(c, out, out + c->bytes, &tooth) != DROPBEAR_SUCCESS
+			|| memcmp(out, &c->comb_bytes[((1 << i) - 1) * 2 * c->bytes],
+				2 * c->bytes) != 0) {
+			dropbear_exit("Bad nistp comb table");
+		}
+	}
+	if (point_to_bytes(c, out, out + c->bytes, &sum) != DROPBEAR_SUCCESS
+		|| memcmp(out, &c->comb_bytes[(COMB_SIZE - 1) * 2 * c->bytes],
+			2 * c->bytes) != 0) {
+		dropbear_exit("Bad nistp comb table");
+	}
+	TRACE(("nistp comb table for %u bytes checked", c->bytes))
+}
+#endif
+
+static void curve_setup(struct nistp_curve *c) {
+	fe raw;
+	limb inv;
+	unsigned int i;
+
+	c->nlimbs = c->bytes * 8 / LIMB_BITS;
+	limbs_from_bytes(c, c->p, c->p_bytes);
+
+	/* Newton's method, each step doubles the correct low bits */
+	inv = c->p[0];
+	for (i = 0; i < 5; i++) {
+		inv *= 2 - c->p[0] * inv;
+	}
+	c->p_inv = 0 - inv;
+
+	/* R^2 mod p by doubling 1 */
+	memset(c->rr, 0x0, sizeof(c->rr));
+	c->rr[0] = 1;
+	for (i = 0; i < 2 * c->nlimbs * LIMB_BITS; i++) {
+		fe_add(c, c->rr, c->rr, c->rr);
+	}
+
+	memset(raw, 0x0, sizeof(raw));
+	raw[0] = 1;
+	fe_mul(c, c->one, raw, c->rr);
+	fe_from_bytes(c, c->b, c->b_bytes);
+
+	for (i = 0; i < COMB_SIZE; i++) {
+		fe_from_bytes(c, c->comb[i].x, &c->comb_bytes[i * 2 * c->bytes]);
+		fe_from_bytes(c, c->comb[i].y, &c->comb_bytes[(i * 2 + 1) * c->bytes]);
+	}
+#if DEBUG_TRACE
+	check_comb(c);
+#endif
+	c->ready = 1;
+}
+
+const struct nistp_curve* nistp_curve_for_size(int size) {
+	struct nistp_curve *c = NULL;
+
+#if DROPBEAR_ECC_256
+	if (size == 32) {
+		c = &nistp256;
+	}
+#endif
+#if DROPBEAR_ECC_384
+	if (size == 48) {
+		c = &nistp384;
+	}
+#endif
+	if (c && !c->ready) {
+		curve_setup(c);
+	}
+	return c;
+}
+
+int nistp_mul_base(const struct nistp_curve *c, const unsigned char *k,
+		unsigned char *out) {
+	struct point r;
+	int ret;
+
+	mul_base(c, &r, k);
+	ret = point_to_bytes(c, out, out + c->bytes, &r);
+	m_burn(&r, sizeof(r));
+	return ret;
+}
+
+int nistp_mul(const struct nistp_curve *c, const unsigned char *k,
+		const unsigned char *point, unsigned char *out) {
+	struct point p, r;
+	int ret;
+
+	point_from_bytes(c, &p, point);
+	mul_point(c, &r, k, &p);
+	ret = point_to_bytes(c, out, out + c->bytes, &r);
+	m_burn(&r, sizeof(r));
+	return ret;
+}
+
+int nistp_mul2(const struct nistp_curve *c, const unsigned char *u1,
+		const unsigned char *u2, const unsigned char *point,
+		unsigned char *out_x) {
+	struct point p, r1, r2;
+
+	point_from_bytes(c, &p, point);
+	mul_base(c, &r1, u1);
+	mul_point(c, &r2, u2, &p);
+	point_add(c, &r1, &r1, &r2);
+	return point_to_bytes(c, out_x, NULL, &r1);
+}
+
+#endif /* DROPBEAR_NISTP */
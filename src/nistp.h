@@ -0,0 +1,36 @@
+#ifndef DROPBEAR_NISTP_H_
+#define DROPBEAR_NISTP_H_
+
+#include "includes.h"
+
+/* Constant time point multiplication on the nistp256 and nistp384 curves,
+ * used for ECDH and ECDSA in place of libtomcrypt's generic code.
+ * Scalars are big endian byte strings of the curve's size, points are the
+ * affine x || y, each big endian of the curve's size. */
+
+#if DROPBEAR_NISTP
+
+#define NISTP_MAX_BYTES 48
+
+struct nistp_curve;
+
+/* size is the field size in bytes, as ltc_ecc_set_type's size.
+ * Returns NULL for curves that aren't handled here */
+const struct nistp_curve* nistp_curve_for_size(int size);
+
+/* out = k*G. Returns DROPBEAR_FAILURE if it is the point at infinity */
+int nistp_mul_base(const struct nistp_curve *curve, const unsigned char *k,
+		unsigned char *out);
+/* out = k*point, which must be on the curve.
+ * Returns DROPBEAR_FAILURE if it is the point at infinity */
+int nistp_mul(const struct nistp_curve *curve, const unsigned char *k,
+		const unsigned char *point, unsigned char *out);
+/* out_x = the x coordinate of u1*G + u2*point, for verifying signatures.
+ * Returns DROPBEAR_FAILURE if it is the point at infinity */
+int nistp_mul2(const struct nistp_curve *curve, const unsigned char *u1,
+		const unsigned char *u2, const unsigned char *point,
+		unsigned char *out_x);
+
+#endif /* DROPBEAR_NISTP */
+
+#endif /* DROPBEAR_NISTP_H_ */
@@ -36,11 +36,12 @@
 #include "channel.h"
 #include "netio.h"
 #include "runopts.h"
+#include "metrics.h"
 
 static int read_packet_init(void);
-static void make_mac(unsigned int seqno, const struct key_context_directional * key_state,
-		buffer * clear_buf, unsigned int clear_len,
-		unsigned char *output_mac);
+static void recvbuf_fill(void);
+static int readbuf_read_direct(void);
+static unsigned int recvbuf_take(unsigned char *dest, unsigned int maxlen);
 static int checkmac(void);
 
 /* For exact details see http://www.zlib.net/zlib_tech.html
@@ -53,6 +54,21 @@ static int checkmac(void);
 static buffer* buf_decompress(const buffer* buf, unsigned int len);
 static void buf_compress(buffer * dest, buffer * src, unsigned int len);
 #endif
+static void writepayload_attach(buffer *wire);
+
+/* Outgoing packets all use the same size of buffer so they can be
+ * recycled. This has space for a maximal payload with the packet length and
+ * padding length header, padding (add extra 3 since we need at least 4
+ * bytes), the MAC, and an extra byte for the packet type. */
+#ifndef DISABLE_ZLIB
+/* some extra in case 'compression' makes it larger */
+#define WRITEBUF_ZLIB_EXTRA ZLIB_COMPRESS_EXPANSION
+#else
+#define WRITEBUF_ZLIB_EXTRA 0
+#endif
+#define WRITEBUF_SIZE (PACKET_PAYLOAD_OFF + TRANS_MAX_PAYLOAD_LEN \
+		+ MAX(MIN_PACKET_LEN, MAX_IV_LEN) + 3 \
+		+ MAX_MAC_LEN + WRITEBUF_ZLIB_EXTRA + 1)
 
 /* non-blocking function writing out a current encrypted packet */
 void write_packet() {
@@ -144,67 +160,208 @@ void write_packet() {
 	TRACE2(("leave write_packet"))
 }
 
-/* Non-blocking function reading available portion of a packet into the
- * ses's buffer, decrypting the length if encrypted, decrypting the
- * full portion if possible */
+/* Non-blocking function reading whatever is available from the socket,
+ * then handling the first packet from it as for read_buffered_packet() */
 void read_packet() {
 
+	TRACE2(("enter read_packet"))
+	if (readbuf_read_direct()) {
+		TRACE2(("leave read_packet: direct"))
+		return;
+	}
+	recvbuf_fill();
+	read_buffered_packet();
+	TRACE2(("leave read_packet"))
+}
+
+/* Returns 1 if data has been read from the socket that hasn't been
+ * handled by read_buffered_packet() yet */
+int read_packet_pending() {
+	return ses.recvbuf != NULL && ses.recvbuf->pos < ses.recvbuf->len;
+}
+
+/* Reads as much as will fit from the socket into ses.recvbuf, so that
+ * several packets can be handled per read() call */
+static void recvbuf_fill() {
+
+	int len;
+	unsigned int maxlen;
+	buffer *recvbuf;
+
+	if (ses.recvbuf == NULL) {
+		ses.recvbuf = buf_new(RECV_BUFFER_LEN);
+	}
+	recvbuf = ses.recvbuf;
+
+	/* move any partial packet to the start to make space */
+	if (recvbuf->pos == recvbuf->len) {
+		buf_setlen(recvbuf, 0);
+	} else if (recvbuf->pos > 0) {
+		len = recvbuf->len - recvbuf->pos;
+		memmove(recvbuf->data, buf_getptr(recvbuf, len), len);
+		buf_setpos(recvbuf, 0);
+		buf_setlen(recvbuf, len);
+	}
+
+	maxlen = recvbuf->size - recvbuf->len;
+	if (maxlen == 0) {
+		return;
+	}
+
+	len = read(ses.sock_in, &recvbuf->data[recvbuf->len], maxlen);
+	ses.recv_reads++;
+
+	if (len == 0) {
+		ses.remoteclosed();
+		return;
+	}
+
+	if (len < 0) {
+		if (errno == EINTR || errno == EAGAIN) {
+			TRACE2(("leave recvbuf_fill: EINTR or EAGAIN"))
+			return;
+		} else {
+			dropbear_exit("Error reading: %s", strerror(errno));
+		}
+	}
+
+	buf_incrlen(recvbuf, len);
+}
+
+/* When everything buffered has been handled and the rest of a large packet
+ * is still to come, reads it from the socket straight into ses.readbuf
+ * rather than through ses.recvbuf, saving a copy of bulk data. Returns 1 if
+ * it handled the read, 0 if recvbuf_fill() should be used instead */
+static int readbuf_read_direct() {
+
 	int len;
 	unsigned int maxlen;
+
+	if (ses.readbuf == NULL || read_packet_pending()
+		|| ses.readbuf->len < ses.keys->recv.algo_crypt->blocksize) {
+		/* no packet length known yet, or data to use first */
+		return 0;
+	}
+
+	maxlen = ses.readbuf->len - ses.readbuf->pos;
+	if (maxlen < RECV_DIRECT_MIN_LEN) {
+		/* a small remainder is better read along with following packets */
+		return 0;
+	}
+
+	len = read(ses.sock_in, buf_getptr(ses.readbuf, maxlen), maxlen);
+	ses.recv_reads++;
+
+	if (len == 0) {
+		ses.remoteclosed();
+		return 1;
+	}
+
+	if (len < 0) {
+		if (errno == EINTR || errno == EAGAIN) {
+			TRACE2(("leave readbuf_read_direct: EINTR or EAGAIN"))
+			return 1;
+		} else {
+			dropbear_exit("Error reading: %s", strerror(errno));
+		}
+	}
+
+	buf_incrpos(ses.readbuf, len);
+	if ((unsigned int)len == maxlen) {
+		/* The whole packet has been read */
+		decrypt_packet(NULL);
+	}
+	return 1;
+}
+
+/* Copies up to maxlen bytes of data that has been read from the socket,
+ * returns the length copied */
+static unsigned int recvbuf_take(unsigned char *dest, unsigned int maxlen) {
+	unsigned int len;
+
+	if (ses.recvbuf == NULL) {
+		return 0;
+	}
+
+	len = MIN(maxlen, ses.recvbuf->len - ses.recvbuf->pos);
+	if (len > 0) {
+		memcpy(dest, buf_getptr(ses.recvbuf, len), len);
+		buf_incrpos(ses.recvbuf, len);
+	}
+	return len;
+}
+
+/* Copies the available portion of a packet from ses.recvbuf into the
+ * ses's buffer, decrypting the length if encrypted, decrypting the
+ * full portion if possible. Doesn't read from the socket. */
+void read_buffered_packet() {
+
+	unsigned int len;
+	unsigned int maxlen;
 	unsigned char blocksize;
+	int contiguous = 0;
+
+	TRACE2(("enter read_buffered_packet"))
+	if (!read_packet_pending()) {
+		TRACE2(("leave read_buffered_packet: nothing buffered"))
+		return;
+	}
 
-	TRACE2(("enter read_packet"))
 	blocksize = ses.keys->recv.algo_crypt->blocksize;
 	
 	if (ses.readbuf == NULL || ses.readbuf->len < blocksize) {
 		int ret;
 		/* In the first blocksize of a packet */
 
+		/* The first block is still in ses.recvbuf directly before the
+		 * rest of the packet if it is all taken now */
+		contiguous = (ses.readbuf == NULL || ses.readbuf->pos == 0);
+
 		/* Read the first blocksize of the packet, so we can decrypt it and
 		 * find the length of the whole packet */
 		ret = read_packet_init();
 
 		if (ret == DROPBEAR_FAILURE) {
 			/* didn't read enough to determine the length */
-			TRACE2(("leave read_packet: packetinit done"))
+			TRACE2(("leave read_buffered_packet: packetinit done"))
 			return;
 		}
 	}
 
-	/* Attempt to read the remainder of the packet, note that there
-	 * mightn't be any available (EAGAIN) */
+	/* Attempt to copy the remainder of the packet, note that there
+	 * mightn't be all available yet */
 	maxlen = ses.readbuf->len - ses.readbuf->pos;
 	if (maxlen == 0) {
 		/* Occurs when the packet is only a single block long and has all
 		 * been read in read_packet_init().  Usually means that MAC is disabled
 		 */
 		len = 0;
+	} else if (maxlen <= ses.recvbuf->len - ses.recvbuf->pos
+			&& ses.readbuf->pos == blocksize
+#if DROPBEAR_AEAD_MODE
+			&& (contiguous || !ses.keys->recv.crypt_mode->aead_crypt)
+#endif
+			) {
+		/* The rest of the packet is buffered, decrypt it from there
+		 * rather than copying it first */
+		const unsigned char *wire = buf_getptr(ses.recvbuf, maxlen);
+		buf_incrpos(ses.recvbuf, maxlen);
+		buf_incrpos(ses.readbuf, maxlen);
+		decrypt_packet(wire);
+		TRACE2(("leave read_buffered_packet: decrypted from recvbuf"))
+		return;
 	} else {
-		len = read(ses.sock_in, buf_getptr(ses.readbuf, maxlen), maxlen);
-
-		if (len == 0) {
-			ses.remoteclosed();
-		}
-
-		if (len < 0) {
-			if (errno == EINTR || errno == EAGAIN) {
-				TRACE2(("leave read_packet: EINTR or EAGAIN"))
-				return;
-			} else {
-				dropbear_exit("Error reading: %s", strerror(errno));
-			}
-		}
-
+		len = recvbuf_take(buf_getptr(ses.readbuf, maxlen), maxlen);
 		buf_incrpos(ses.readbuf, len);
 	}
 
-	if ((unsigned int)len == maxlen) {
+	if (len == maxlen) {
 		/* The whole packet has been read */
-		decrypt_packet();
-		/* The main select() loop process_packet() to
+		decrypt_packet(NULL);
+		/* The main loop calls process_packet() to
 		 * handle the packet contents... */
 	}
-	TRACE2(("leave read_packet"))
+	TRACE2(("leave read_buffered_packet"))
 }
 
 /* Function used to read the initial portion of a packet, and determine the
@@ -214,7 +371,7 @@ void read_packet() {
 static int read_packet_init() {
 
 	unsigned int maxlen;
-	int slen;
+	unsigned int slen;
 	unsigned int len, plen;
 	unsigned int blocksize;
 	unsigned int macsize;
@@ -230,23 +387,11 @@ static int read_packet_init() {
 
 	maxlen = blocksize - ses.readbuf->pos;
 			
-	/* read the rest of the packet if possible */
-	slen = read(ses.sock_in, buf_getwriteptr(ses.readbuf, maxlen),
-			maxlen);
-	if (slen == 0) {
-		ses.remoteclosed();
-	}
-	if (slen < 0) {
-		if (errno == EINTR || errno == EAGAIN) {
-			TRACE2(("leave read_packet_init: EINTR"))
-			return DROPBEAR_FAILURE;
-		}
-		dropbear_exit("Error reading: %s", strerror(errno));
-	}
-
+	/* copy the rest of the first block if possible */
+	slen = recvbuf_take(buf_getwriteptr(ses.readbuf, maxlen), maxlen);
 	buf_incrwritepos(ses.readbuf, slen);
 
-	if ((unsigned int)slen != maxlen) {
+	if (slen != maxlen) {
 		/* don't have enough bytes to determine length, get next time */
 		return DROPBEAR_FAILURE;
 	}
@@ -294,29 +439,36 @@ static int read_packet_init() {
 	return DROPBEAR_SUCCESS;
 }
 
-/* handle the received packet */
-void decrypt_packet() {
+/* handle the received packet. If wire isn't NULL it holds the received
+ * packet following the first block, which is decrypted from there into
+ * ses.readbuf instead of in place. For AEAD modes the first block must
+ * directly precede it. */
+void decrypt_packet(const unsigned char *wire) {
 
 	unsigned char blocksize;
 	unsigned char macsize;
 	unsigned int padlen;
 	unsigned int len;
+	unsigned long long start;
 
 	TRACE2(("enter decrypt_packet"))
+	start = metrics_now();
 	blocksize = ses.keys->recv.algo_crypt->blocksize;
 	macsize = ses.keys->recv.algo_mac->hashsize;
 
 	ses.kexstate.datarecv += ses.readbuf->len;
+	metrics_add(METRIC_PACKETS_IN, 1);
+	metrics_add(METRIC_BYTES_IN, ses.readbuf->len);
 
 #if DROPBEAR_AEAD_MODE
 	if (ses.keys->recv.crypt_mode->aead_crypt) {
 		/* first blocksize is not decrypted yet */
 		buf_setpos(ses.readbuf, 0);
 
-		/* decrypt it in-place */
+		/* decrypt it in-place, or from the wire */
 		len = ses.readbuf->len - macsize - ses.readbuf->pos;
 		if (ses.keys->recv.crypt_mode->aead_crypt(ses.recvseq,
-					buf_getptr(ses.readbuf, len + macsize),
+					wire ? wire - blocksize : buf_getptr(ses.readbuf, len + macsize),
 					buf_getwriteptr(ses.readbuf, len),
 					len, macsize,
 					&ses.keys->recv.cipher_state, LTC_DECRYPT) != CRYPT_OK) {
@@ -329,16 +481,20 @@ void decrypt_packet() {
 		/* we've already decrypted the first blocksize in read_packet_init */
 		buf_setpos(ses.readbuf, blocksize);
 
-		/* decrypt it in-place */
+		/* decrypt it in-place, or from the wire */
 		len = ses.readbuf->len - macsize - ses.readbuf->pos;
 		if (ses.keys->recv.crypt_mode->decrypt(
-					buf_getptr(ses.readbuf, len),
+					wire ? wire : buf_getptr(ses.readbuf, len),
 					buf_getwriteptr(ses.readbuf, len),
 					len,
 					&ses.keys->recv.cipher_state) != CRYPT_OK) {
 			dropbear_exit("Error decrypting");
 		}
 		buf_incrpos(ses.readbuf, len);
+		if (wire) {
+			/* the MAC is compared in ses.readbuf */
+			memcpy(buf_getwriteptr(ses.readbuf, macsize), wire + len, macsize);
+		}
 
 		/* check the hmac */
 		if (checkmac() != DROPBEAR_SUCCESS) {
@@ -382,6 +538,7 @@ void decrypt_packet() {
 
 	ses.recvseq++;
 
+	metrics_time(METRIC_DECRYPT_NSEC, start);
 	TRACE2(("leave decrypt_packet"))
 }
 
@@ -476,42 +633,26 @@ static int packet_is_okay_kex(unsigned char type) {
 }
 
 static void enqueue_reply_packet() {
-	struct packetlist * new_item = NULL;
-	new_item = m_malloc(sizeof(struct packetlist));
-	new_item->next = NULL;
-	
-	new_item->payload = buf_newcopy(ses.writepayload);
+	enqueue(&ses.reply_queue, buf_newcopy(ses.writepayload));
 	buf_setpos(ses.writepayload, 0);
 	buf_setlen(ses.writepayload, 0);
-	
-	if (ses.reply_queue_tail) {
-		ses.reply_queue_tail->next = new_item;
-	} else {
-		ses.reply_queue_head = new_item;
-	}
-	ses.reply_queue_tail = new_item;
 }
 
 void maybe_flush_reply_queue() {
-	struct packetlist *tmp_item = NULL, *curr_item = NULL;
+	buffer *payload = NULL;
 	if (!ses.dataallowed)
 	{
 		TRACE(("maybe_empty_reply_queue - no data allowed"))
 		return;
 	}
 		
-	for (curr_item = ses.reply_queue_head; curr_item; ) {
+	while (!isempty(&ses.reply_queue)) {
+		payload = (buffer*)dequeue(&ses.reply_queue);
 		CHECKCLEARTOWRITE();
-		buf_putbytes(ses.writepayload,
-			curr_item->payload->data, curr_item->payload->len);
-			
-		buf_free(curr_item->payload);
-		tmp_item = curr_item;
-		curr_item = curr_item->next;
-		m_free(tmp_item);
+		buf_putbytes(ses.writepayload, payload->data, payload->len);
+		buf_free(payload);
 		encrypt_packet();
 	}
-	ses.reply_queue_head = ses.reply_queue_tail = NULL;
 }
 	
 /* encrypt the writepayload, putting into writebuf, ready for write_packet()
@@ -523,8 +664,9 @@ void encrypt_packet() {
 	buffer * writebuf; /* the packet which will go on the wire. This is
 	                      encrypted in-place. */
 	unsigned char packet_type;
-	unsigned int len, encrypt_buf_size;
+	unsigned int len;
 	unsigned char mac_bytes[MAX_MAC_LEN];
+	unsigned long long start;
 
 	time_t now;
 	
@@ -543,46 +685,34 @@ void encrypt_packet() {
 		enqueue_reply_packet();
 		return;
 	}
+
+	start = metrics_now();
 		
 	blocksize = ses.keys->trans.algo_crypt->blocksize;
 	mac_size = ses.keys->trans.algo_mac->hashsize;
 
-	/* Encrypted packet len is payload+5. We need to then make sure
-	 * there is enough space for padding or MIN_PACKET_LEN.
-	 * Add extra 3 since we need at least 4 bytes of padding */
-	encrypt_buf_size = (ses.writepayload->len+4+1)
-		+ MAX(MIN_PACKET_LEN, blocksize) + 3
-	/* add space for the MAC at the end */
-				+ mac_size
-#ifndef DISABLE_ZLIB
-	/* some extra in case 'compression' makes it larger */
-				+ ZLIB_COMPRESS_EXPANSION
-#endif
-	/* and an extra cleartext (stripped before transmission) byte for the
-	 * packet type */
-				+ 1;
-
-	writebuf = buf_new(encrypt_buf_size);
-	buf_setlen(writebuf, PACKET_PAYLOAD_OFF);
-	buf_setpos(writebuf, PACKET_PAYLOAD_OFF);
-
 #ifndef DISABLE_ZLIB
 	/* compression */
 	if (is_compress_trans()) {
+		writebuf = writebuf_alloc();
+		buf_setlen(writebuf, PACKET_PAYLOAD_OFF);
+		buf_setpos(writebuf, PACKET_PAYLOAD_OFF);
 		buf_compress(writebuf, ses.writepayload, ses.writepayload->len);
+
+		/* finished with payload, its wire buffer is kept for the next one */
+		buf_setpos(ses.writepayload, 0);
+		buf_setlen(ses.writepayload, 0);
 	} else
 #endif
 	{
-		memcpy(buf_getwriteptr(writebuf, ses.writepayload->len),
-				buf_getptr(ses.writepayload, ses.writepayload->len),
-				ses.writepayload->len);
-		buf_incrwritepos(writebuf, ses.writepayload->len);
+		/* The payload was written in place after space for the header,
+		 * take its wire buffer and give writepayload a fresh one */
+		writebuf = ses.writepayload_wire;
+		buf_setlen(writebuf, PACKET_PAYLOAD_OFF + ses.writepayload->len);
+		buf_setpos(writebuf, writebuf->len);
+		writepayload_attach(writebuf_alloc());
 	}
 
-	/* finished with payload */
-	buf_setpos(ses.writepayload, 0);
-	buf_setlen(ses.writepayload, 0);
-
 	/* length of padding - packet length excluding the packetlength uint32
 	 * field in aead mode must be a multiple of blocksize, with a minimum of
 	 * 4 bytes of padding */
@@ -651,6 +781,22 @@ void encrypt_packet() {
 
 	/* Update counts */
 	ses.kexstate.datatrans += writebuf->len;
+	metrics_time(METRIC_ENCRYPT_NSEC, start);
+	metrics_hist_add(METRIC_WRITEQUEUE_BYTES, ses.writequeue_len);
+	metrics_add(METRIC_PACKETS_OUT, 1);
+	metrics_add(METRIC_BYTES_OUT, writebuf->len);
+
+	/* Once the queue holds as many buffers as the pool, small packets are
+	 * moved to a buffer of their own size. Otherwise a peer that doesn't
+	 * read could have each of many tiny replies hold a full sized buffer */
+	if (writebuf->len < WRITEBUF_SIZE / 2
+			&& ses.writequeue.count >= WRITEBUF_POOL_SIZE) {
+		buffer *small = buf_new(writebuf->len);
+		buf_putbytes(small, writebuf->data, writebuf->len);
+		writebuf_release(writebuf);
+		writebuf = small;
+		metrics_add(METRIC_WRITEBUF_COPIES, 1);
+	}
 
 	writebuf_enqueue(writebuf);
 
@@ -679,43 +825,134 @@ void writebuf_enqueue(buffer * writebuf) {
 	ses.writequeue_len += writebuf->len;
 }
 
+/* Returns an empty wire buffer of WRITEBUF_SIZE, from the pool if
+ * one is available */
+buffer* writebuf_alloc() {
+	buffer *writebuf;
+	if (ses.writebuf_pool_count > 0) {
+		ses.writebuf_pool_count--;
+		writebuf = ses.writebuf_pool[ses.writebuf_pool_count];
+		ses.writebuf_pool[ses.writebuf_pool_count] = NULL;
+		buf_setpos(writebuf, 0);
+		buf_setlen(writebuf, 0);
+		metrics_add(METRIC_WRITEBUF_REUSES, 1);
+	} else {
+		writebuf = buf_new(WRITEBUF_SIZE);
+		metrics_add(METRIC_WRITEBUF_ALLOCS, 1);
+	}
+	return writebuf;
+}
+
+/* Frees a transmitted buffer, or keeps it for reuse. Any buffer may be
+ * passed, only ones of WRITEBUF_SIZE are kept */
+void writebuf_release(buffer * writebuf) {
+	if (writebuf->size == WRITEBUF_SIZE
+			&& ses.writebuf_pool_count < WRITEBUF_POOL_SIZE) {
+		ses.writebuf_pool[ses.writebuf_pool_count] = writebuf;
+		ses.writebuf_pool_count++;
+	} else {
+		buf_free(writebuf);
+	}
+}
+
+/* Point writepayload at a wire buffer, leaving room for the packet header */
+static void writepayload_attach(buffer *wire) {
+	ses.writepayload_wire = wire;
+	buf_setview(ses.writepayload, wire, PACKET_PAYLOAD_OFF, TRANS_MAX_PAYLOAD_LEN);
+}
+
+void writebuf_pool_init() {
+	ses.writebuf_pool_count = 0;
+	ses.writepayload = m_malloc(sizeof(buffer));
+	writepayload_attach(writebuf_alloc());
+}
+
+void writebuf_pool_cleanup() {
+	while (ses.writebuf_pool_count > 0) {
+		ses.writebuf_pool_count--;
+		buf_free(ses.writebuf_pool[ses.writebuf_pool_count]);
+		ses.writebuf_pool[ses.writebuf_pool_count] = NULL;
+	}
+
+	if (ses.writepayload_wire) {
+		/* May hold cleartext */
+		buf_burn_free(ses.writepayload_wire);
+		ses.writepayload_wire = NULL;
+	}
+	m_free(ses.writepayload);
+}
+
+
+/* Hashes the MAC key XORed with ipad and with opad (RFC 2104) once per
+ * key, so that make_mac() can start each packet's HMAC from copies of the
+ * resulting states. algo_mac, hash_index and mackey must be set */
+void setup_mac_key(struct key_context_directional * key_state) {
+	const struct ltc_hash_descriptor *hash = NULL;
+	unsigned char pad[MAXBLOCKSIZE];
+	unsigned long i;
+
+	if (key_state->algo_mac->hashsize == 0) {
+		return;
+	}
+	hash = &hash_descriptor[key_state->hash_index];
+
+	/* MAC keys are never longer than the hash's block, so are used as is */
+	dropbear_assert(key_state->algo_mac->keysize <= hash->blocksize);
+	memset(pad, 0x0, sizeof(pad));
+	memcpy(pad, key_state->mackey, key_state->algo_mac->keysize);
+
+	for (i = 0; i < hash->blocksize; i++) {
+		pad[i] ^= 0x36;
+	}
+	if (hash->init(&key_state->mac_inner) != CRYPT_OK
+		|| hash->process(&key_state->mac_inner, pad, hash->blocksize) != CRYPT_OK) {
+		dropbear_exit("HMAC error");
+	}
+
+	for (i = 0; i < hash->blocksize; i++) {
+		pad[i] ^= 0x36 ^ 0x5c;
+	}
+	if (hash->init(&key_state->mac_outer) != CRYPT_OK
+		|| hash->process(&key_state->mac_outer, pad, hash->blocksize) != CRYPT_OK) {
+		dropbear_exit("HMAC error");
+	}
+
+	m_burn(pad, sizeof(pad));
+}
 
 /* Create the packet mac, and append H(seqno|clearbuf) to the output */
 /* output_mac must have ses.keys->trans.algo_mac->hashsize bytes. */
-static void make_mac(unsigned int seqno, const struct key_context_directional * key_state,
+void make_mac(unsigned int seqno, const struct key_context_directional * key_state,
 		buffer * clear_buf, unsigned int clear_len,
 		unsigned char *output_mac) {
+	const struct ltc_hash_descriptor *hash = NULL;
 	unsigned char seqbuf[4];
-	unsigned long bufsize;
-	hmac_state hmac;
+	unsigned char digest[MAXBLOCKSIZE];
+	hash_state hs;
 
 	if (key_state->algo_mac->hashsize > 0) {
-		/* calculate the mac */
-		if (hmac_init(&hmac,
-					key_state->hash_index,
-					key_state->mackey,
-					key_state->algo_mac->keysize) != CRYPT_OK) {
-			dropbear_exit("HMAC error");
-		}
-	
-		/* sequence number */
+		hash = &hash_descriptor[key_state->hash_index];
+
+		/* H(K ^ ipad || seqno || contents), from the saved key state */
+		hs = key_state->mac_inner;
 		STORE32H(seqno, seqbuf);
-		if (hmac_process(&hmac, seqbuf, 4) != CRYPT_OK) {
-			dropbear_exit("HMAC error");
-		}
-	
-		/* the actual contents */
 		buf_setpos(clear_buf, 0);
-		if (hmac_process(&hmac,
-					buf_getptr(clear_buf, clear_len),
-					clear_len) != CRYPT_OK) {
+		if (hash->process(&hs, seqbuf, 4) != CRYPT_OK
+			|| hash->process(&hs, buf_getptr(clear_buf, clear_len),
+				clear_len) != CRYPT_OK
+			|| hash->done(&hs, digest) != CRYPT_OK) {
 			dropbear_exit("HMAC error");
 		}
-	
-		bufsize = MAX_MAC_LEN;
-		if (hmac_done(&hmac, output_mac, &bufsize) != CRYPT_OK) {
+
+		/* H(K ^ opad || inner digest) */
+		hs = key_state->mac_outer;
+		if (hash->process(&hs, digest, hash->hashsize) != CRYPT_OK
+			|| hash->done(&hs, digest) != CRYPT_OK) {
 			dropbear_exit("HMAC error");
 		}
+		memcpy(output_mac, digest, MIN(hash->hashsize, MAX_MAC_LEN));
+		m_burn(&hs, sizeof(hs));
+		m_burn(digest, sizeof(digest));
 	}
 	TRACE2(("leave writemac"))
 }
@@ -32,13 +32,25 @@
 
 void write_packet(void);
 void read_packet(void);
-void decrypt_packet(void);
+void read_buffered_packet(void);
+int read_packet_pending(void);
+void decrypt_packet(const unsigned char *wire);
 void encrypt_packet(void);
 
 void writebuf_enqueue(buffer * writebuf);
+buffer* writebuf_alloc(void);
+void writebuf_release(buffer * writebuf);
+void writebuf_pool_init(void);
+void writebuf_pool_cleanup(void);
 
 void process_packet(void);
 
+struct key_context_directional;
+void setup_mac_key(struct key_context_directional * key_state);
+void make_mac(unsigned int seqno, const struct key_context_directional * key_state,
+		buffer * clear_buf, unsigned int clear_len,
+		unsigned char *output_mac);
+
 void maybe_flush_reply_queue(void);
 typedef struct PacketType {
 	unsigned char type; /* SSH_MSG_FOO */
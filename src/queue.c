@@ -26,62 +26,84 @@
 #include "dbutil.h"
 #include "queue.h"
 
+/* Initial number of slots, must be a power of two */
+#define QUEUE_INITIAL_SIZE 16
+
 void initqueue(struct Queue* queue) {
 
-	queue->head = NULL;
-	queue->tail = NULL;
+	queue->items = NULL;
+	queue->head = 0;
 	queue->count = 0;
+	queue->size = 0;
+}
+
+/* Frees the queue's storage, any remaining items are the caller's */
+void freequeue(struct Queue* queue) {
+
+	m_free(queue->items);
+	initqueue(queue);
 }
 
 int isempty(const struct Queue* queue) {
 
-	return (queue->head == NULL);
+	return (queue->count == 0);
 }
 	
 void* dequeue(struct Queue* queue) {
 
 	void* ret;
-	struct Link* oldhead;
 	dropbear_assert(!isempty(queue));
 	
-	ret = queue->head->item;
-	oldhead = queue->head;
-	
-	if (oldhead->link != NULL) {
-		queue->head = oldhead->link;
-	} else {
-		queue->head = NULL;
-		queue->tail = NULL;
-		TRACE(("empty queue dequeing"))
-	}
-
-	m_free(oldhead);
+	ret = queue->items[queue->head];
+	queue->items[queue->head] = NULL;
+	queue->head = (queue->head + 1) & (queue->size - 1);
 	queue->count--;
 	return ret;
 }
 
 void *examine(const struct Queue* queue) {
 
-	dropbear_assert(!isempty(queue));
-	return queue->head->item;
+	return examine_nth(queue, 0);
 }
 
-void enqueue(struct Queue* queue, void* item) {
+/* Returns the item n places from the head of the queue */
+void *examine_nth(const struct Queue* queue, unsigned int n) {
 
-	struct Link* newlink;
+	dropbear_assert(n < queue->count);
+	return queue->items[(queue->head + n) & (queue->size - 1)];
+}
+
+/* Doubles the ring, unwrapping the items to the start of the new one */
+static void growqueue(struct Queue* queue) {
 
-	newlink = (struct Link*)m_malloc(sizeof(struct Link));
+	unsigned int newsize, first;
+	void** newitems;
 
-	newlink->item = item;
-	newlink->link = NULL;
+	newsize = queue->size ? queue->size * 2 : QUEUE_INITIAL_SIZE;
+	if (newsize <= queue->size) {
+		dropbear_exit("Queue too long");
+	}
+	newitems = (void**)m_malloc(newsize * sizeof(void*));
 
-	if (queue->tail != NULL) {
-		queue->tail->link = newlink;
+	first = MIN(queue->count, queue->size - queue->head);
+	if (queue->count > 0) {
+		memcpy(newitems, &queue->items[queue->head], first * sizeof(void*));
+		memcpy(&newitems[first], queue->items,
+				(queue->count - first) * sizeof(void*));
 	}
-	queue->tail = newlink;
 
-	if (queue->head == NULL) {
-		queue->head = newlink;
+	m_free(queue->items);
+	queue->items = newitems;
+	queue->head = 0;
+	queue->size = newsize;
+}
+
+void enqueue(struct Queue* queue, void* item) {
+
+	if (queue->count == queue->size) {
+		growqueue(queue);
 	}
+
+	queue->items[(queue->head + queue->count) & (queue->size - 1)] = item;
 	queue->count++;
 }
@@ -25,25 +25,24 @@
 #ifndef DROPBEAR_QUEUE_H_
 #define DROPBEAR_QUEUE_H_
 
-struct Link {
-
-	void* item;
-	struct Link* link;
-
-};
-
+/* A FIFO of pointers, kept in a ring that doubles in size when full so
+ * that queueing doesn't allocate once it has grown to its working size.
+ * The storage is only allocated by the first enqueue() */
 struct Queue {
 
-	struct Link* head;
-	struct Link* tail;
+	void** items;
+	unsigned int head; /* index of the first item */
 	unsigned int count;
+	unsigned int size; /* zero or a power of two */
 
 };
 
 void initqueue(struct Queue* queue);
+void freequeue(struct Queue* queue);
 int isempty(const struct Queue* queue);
 void* dequeue(struct Queue* queue);
 void *examine(const struct Queue* queue);
+void *examine_nth(const struct Queue* queue, unsigned int n);
 void enqueue(struct Queue* queue, void* item);
 
 #endif
@@ -59,6 +59,9 @@ int buf_get_rsa_pub_key(buffer* buf, dropbear_rsa_key *key) {
 	key->d = NULL;
 	key->p = NULL;
 	key->q = NULL;
+	key->dP = NULL;
+	key->dQ = NULL;
+	key->qInv = NULL;
 
 	buf_incrpos(buf, 4+SSH_SIGNKEY_RSA_LEN); /* int + "ssh-rsa" */
 
@@ -128,6 +131,7 @@ int buf_get_rsa_priv_key(buffer* buf, dropbear_rsa_key *key) {
 		}
 	}
 
+	rsa_key_crt_init(key);
 	ret = DROPBEAR_SUCCESS;
 out:
 	if (ret == DROPBEAR_FAILURE) {
@@ -147,11 +151,78 @@ void rsa_key_free(dropbear_rsa_key *key) {
 		TRACE2(("leave rsa_key_free: key == NULL"))
 		return;
 	}
-	m_mp_free_multi(&key->d, &key->e, &key->p, &key->q, &key->n, NULL);
+	m_mp_free_multi(&key->d, &key->e, &key->p, &key->q, &key->n,
+		&key->dP, &key->dQ, &key->qInv, NULL);
 	m_free(key);
 	TRACE2(("leave rsa_key_free"))
 }
 
+/* Precomputes the values for signing with the Chinese Remainder Theorem,
+ * which does two exponentiations of half the size instead of one with d.
+ * Keys without p and q, or where they don't match n, keep using d.
+ * Must be called again if the private parts of the key change */
+void rsa_key_crt_init(dropbear_rsa_key *key) {
+	DEF_MP_INT(tmp);
+	int ok = 0;
+
+	TRACE2(("enter rsa_key_crt_init"))
+	m_mp_free_multi(&key->dP, &key->dQ, &key->qInv, NULL);
+	if (!(key->d && key->p && key->q)) {
+		TRACE2(("leave rsa_key_crt_init: no p and q"))
+		return;
+	}
+
+	m_mp_init(&tmp);
+	m_mp_alloc_init_multi(&key->dP, &key->dQ, &key->qInv, NULL);
+	if (mp_mul(key->p, key->q, &tmp) == MP_OKAY
+		&& mp_cmp(&tmp, key->n) == MP_EQ
+		&& mp_sub_d(key->p, 1, &tmp) == MP_OKAY
+		&& mp_mod(key->d, &tmp, key->dP) == MP_OKAY
+		&& mp_sub_d(key->q, 1, &tmp) == MP_OKAY
+		&& mp_mod(key->d, &tmp, key->dQ) == MP_OKAY
+		&& mp_invmod(key->q, key->p, key->qInv) == MP_OKAY) {
+		ok = 1;
+	}
+	mp_clear(&tmp);
+
+	if (!ok) {
+		dropbear_log(LOG_WARNING, "RSA key has inconsistent p and q");
+		m_mp_free_multi(&key->dP, &key->dQ, &key->qInv, NULL);
+	}
+	TRACE2(("leave rsa_key_crt_init: crt %d", ok))
+}
+
+/* s = m^d mod n, using the CRT values if the key has them */
+static void rsa_private_exptmod(const dropbear_rsa_key *key,
+		const mp_int *m, mp_int *s) {
+	DEF_MP_INT(m1);
+	DEF_MP_INT(m2);
+
+	if (key->dP == NULL) {
+		if (mp_exptmod(m, key->d, key->n, s) != MP_OKAY) {
+			dropbear_exit("RSA error");
+		}
+		return;
+	}
+
+	m_mp_init_multi(&m1, &m2, NULL);
+	/* m1 = m^dP mod p, m2 = m^dQ mod q */
+	if (mp_mod(m, key->p, &m1) != MP_OKAY
+		|| mp_exptmod(&m1, key->dP, key->p, &m1) != MP_OKAY
+		|| mp_mod(m, key->q, &m2) != MP_OKAY
+		|| mp_exptmod(&m2, key->dQ, key->q, &m2) != MP_OKAY) {
+		dropbear_exit("RSA error");
+	}
+	/* h = qInv*(m1 - m2) mod p, s = m2 + h*q */
+	if (mp_sub(&m1, &m2, &m1) != MP_OKAY
+		|| mp_mulmod(&m1, key->qInv, key->p, &m1) != MP_OKAY
+		|| mp_mul(&m1, key->q, &m1) != MP_OKAY
+		|| mp_add(&m1, &m2, s) != MP_OKAY) {
+		dropbear_exit("RSA error");
+	}
+	mp_clear_multi(&m1, &m2, NULL);
+}
+
 /* Put the public rsa key into the buffer in the required format:
  *
  * string	"ssh-rsa"
@@ -259,6 +330,7 @@ void buf_put_rsa_sign(buffer* buf, const dropbear_rsa_key *key,
 	unsigned int i;
 	size_t written;
 	DEF_MP_INT(rsa_s);
+	DEF_MP_INT(rsa_em);
 	DEF_MP_INT(rsa_tmp1);
 	DEF_MP_INT(rsa_tmp2);
 	DEF_MP_INT(rsa_tmp3);
@@ -266,9 +338,9 @@ void buf_put_rsa_sign(buffer* buf, const dropbear_rsa_key *key,
 	TRACE(("enter buf_put_rsa_sign"))
 	dropbear_assert(key != NULL);
 
-	m_mp_init_multi(&rsa_s, &rsa_tmp1, &rsa_tmp2, &rsa_tmp3, NULL);
+	m_mp_init_multi(&rsa_s, &rsa_em, &rsa_tmp1, &rsa_tmp2, &rsa_tmp3, NULL);
 
-	rsa_pad_em(key, data_buf, &rsa_tmp1, sigtype);
+	rsa_pad_em(key, data_buf, &rsa_em, sigtype);
 
 	/* the actual signing of the padded data */
 
@@ -280,7 +352,6 @@ void buf_put_rsa_sign(buffer* buf, const dropbear_rsa_key *key,
 	/* rsa_tmp2 is r */
 	gen_random_mpint(key->n, &rsa_tmp2);
 
-	/* rsa_tmp1 is em */
 	/* em' = em * r^e mod n */
 
 	/* rsa_s used as a temp var*/
@@ -290,15 +361,13 @@ void buf_put_rsa_sign(buffer* buf, const dropbear_rsa_key *key,
 	if (mp_invmod(&rsa_tmp2, key->n, &rsa_tmp3) != MP_OKAY) {
 		dropbear_exit("RSA error");
 	}
-	if (mp_mulmod(&rsa_tmp1, &rsa_s, key->n, &rsa_tmp2) != MP_OKAY) {
+	if (mp_mulmod(&rsa_em, &rsa_s, key->n, &rsa_tmp2) != MP_OKAY) {
 		dropbear_exit("RSA error");
 	}
 
 	/* rsa_tmp2 is em' */
 	/* s' = (em')^d mod n */
-	if (mp_exptmod(&rsa_tmp2, key->d, key->n, &rsa_tmp1) != MP_OKAY) {
-		dropbear_exit("RSA error");
-	}
+	rsa_private_exptmod(key, &rsa_tmp2, &rsa_tmp1);
 
 	/* rsa_tmp1 is s' */
 	/* rsa_tmp3 is r^(-1) mod n */
@@ -310,14 +379,20 @@ void buf_put_rsa_sign(buffer* buf, const dropbear_rsa_key *key,
 #else
 
 	/* s = em^d mod n */
-	/* rsa_tmp1 is em */
-	if (mp_exptmod(&rsa_tmp1, key->d, key->n, &rsa_s) != MP_OKAY) {
-		dropbear_exit("RSA error");
-	}
+	rsa_private_exptmod(key, &rsa_em, &rsa_s);
 
 #endif /* DROPBEAR_RSA_BLINDING */
 
-	mp_clear_multi(&rsa_tmp1, &rsa_tmp2, &rsa_tmp3, NULL);
+	/* Check the signature before it is sent. A fault in one half of the
+	 * CRT computation would otherwise give away a factor of n */
+	if (mp_exptmod(&rsa_s, key->e, key->n, &rsa_tmp1) != MP_OKAY) {
+		dropbear_exit("RSA error");
+	}
+	if (mp_cmp(&rsa_tmp1, &rsa_em) != MP_EQ) {
+		dropbear_exit("RSA signature check failed");
+	}
+
+	mp_clear_multi(&rsa_em, &rsa_tmp1, &rsa_tmp2, &rsa_tmp3, NULL);
 	
 	/* create the signature to return */
 	name = signature_name_from_type(sigtype, &namelen);
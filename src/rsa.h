@@ -39,6 +39,11 @@ typedef struct dropbear_RSA_Key {
 	mp_int* d;
 	mp_int* p;
 	mp_int* q;
+	/* CRT values d mod (p-1), d mod (q-1) and q^-1 mod p, computed by
+	 * rsa_key_crt_init(). NULL if p and q aren't known */
+	mp_int* dP;
+	mp_int* dQ;
+	mp_int* qInv;
 
 } dropbear_rsa_key;
 
@@ -53,6 +58,7 @@ int buf_get_rsa_priv_key(buffer* buf, dropbear_rsa_key *key);
 void buf_put_rsa_pub_key(buffer* buf, const dropbear_rsa_key *key);
 void buf_put_rsa_priv_key(buffer* buf, const dropbear_rsa_key *key);
 void rsa_key_free(dropbear_rsa_key *key);
+void rsa_key_crt_init(dropbear_rsa_key *key);
 
 #endif /* DROPBEAR_RSA */
 
@@ -78,6 +78,17 @@ typedef struct svr_runopts {
 	/* Hidden "-2 childpipe_fd" flag indicates it's re-executing itself,
 	   stores the childpipe preauth file descriptor. Set to -1 otherwise. */
 	int reexec_childpipe;
+	/* Hidden "-3 workersock_fd" flag for a re-executed process started
+	   ahead of connections, which waits for a connection fd on the socket.
+	   Set to -1 otherwise. */
+	int reexec_workersock;
+	/* Hidden "-4 metrics_fd" flag passes the listener's shared metrics to a
+	   re-executed process. Set to -1 otherwise. */
+	int reexec_metricsfd;
+	/* Number of processes to keep waiting for connections, -N */
+	unsigned int prefork_workers;
+	/* Number of processes accepting connections, -L */
+	unsigned int listeners;
 
 	/* Flags indicating whether to use ipv4 and ipv6 */
 	/* not used yet
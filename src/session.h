@@ -95,6 +95,10 @@ struct key_context_directional {
 #endif
 	} cipher_state;
 	unsigned char mackey[MAX_MAC_LEN];
+	/* HMAC hash states after the ipad and opad key blocks, from
+	 * setup_mac_key() */
+	hash_state mac_inner;
+	hash_state mac_outer;
 	int valid;
 };
 
@@ -111,12 +115,6 @@ struct key_context {
 							zlib@openssh.com delayed compression case) */
 };
 
-struct packetlist;
-struct packetlist {
-	struct packetlist *next;
-	buffer * payload;
-};
-
 struct sshsession {
 
 	/* Is it a client or server? */
@@ -141,9 +139,19 @@ struct sshsession {
 	/* Packet buffers/values etc */
 	buffer *writepayload; /* Unencrypted payload to write - this is used
 							 throughout the code, as handlers fill out this
-							 buffer with the packet to send. */
+							 buffer with the packet to send. It is a view
+							 into writepayload_wire, see encrypt_packet() */
+	buffer *writepayload_wire; /* The wire buffer that writepayload is
+								  written into */
 	struct Queue writequeue; /* A queue of encrypted packets to send */
 	unsigned int writequeue_len; /* Number of bytes pending to send in writequeue */
+	/* Spare wire buffers, recycled after transmission */
+	buffer *writebuf_pool[WRITEBUF_POOL_SIZE];
+	unsigned int writebuf_pool_count;
+	buffer *recvbuf; /* Raw data read from the socket but not yet copied to
+						readbuf, may hold several packets. Still encrypted,
+						so keys may change between the packets it holds. */
+	unsigned int recv_reads; /* Number of read() calls, compare to recvseq */
 	buffer *readbuf; /* From the wire, decrypted in-place */
 	buffer *payload; /* Post-decompression, the actual SSH packet.
 						May have extra data at the beginning, will be
@@ -208,7 +216,7 @@ struct sshsession {
 							
 	/* a list of queued replies that should be sent after a KEX has
 	   concluded (ie, while dataallowed was unset)*/
-	struct packetlist *reply_queue_head, *reply_queue_tail;
+	struct Queue reply_queue; /* payload buffers */
 
 	void(*remoteclosed)(void); /* A callback to handle closure of the
 									  remote connection */
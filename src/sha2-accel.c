@@ -0,0 +1,220 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "cpufeatures.h"
+#include "sha2-accel.h"
+
+#if DROPBEAR_SHA2_ACCEL
+
+static const ulong32 sha256_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+	0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+	0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+	0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+	0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+	0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+	0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+	0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#if DROPBEAR_CPU_X86
+/* SHA-NI. Functions using the instructions are compiled for them with a
+ * target attribute, and only called after cpu_has() */
+#include <immintrin.h>
+
+#define SHANI_TARGET __attribute__((target("sha,sse4.1")))
+
+/* Four rounds. SHA256RNDS2 does two, with the state split as ABEF and
+ * CDGH and the message words plus constants in the low half */
+#define SHANI_ROUNDS4(k, m) do { \
+	wk = _mm_add_epi32(m, _mm_loadu_si128((const __m128i*)&sha256_k[k])); \
+	cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk); \
+	wk = _mm_shuffle_epi32(wk, 0x0e); \
+	abef = _mm_sha256rnds2_epu32(abef, cdgh, wk); \
+} while (0)
+
+/* The message schedule, as the 16 words of the window move along by four.
+ * SHANI_SCHED2 finishes next from the words before it, then SHANI_SCHED1
+ * starts on prev, which is only needed again after three more groups */
+#define SHANI_SCHED2(next, cur, prev) \
+	next = _mm_sha256msg2_epu32( \
+		_mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4)), cur)
+#define SHANI_SCHED1(prev, cur) prev = _mm_sha256msg1_epu32(prev, cur)
+
+SHANI_TARGET static void shani_compress(ulong32 *state,
+		const unsigned char *buf, unsigned long nblocks) {
+	const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+		0x0405060700010203ULL);
+	__m128i abef, cdgh, abef_save, cdgh_save, wk, t;
+	__m128i m0, m1, m2, m3;
+
+	/* from ABCD EFGH to ABEF CDGH, with A in the high word */
+	t = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xb1);
+	cdgh = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1b);
+	abef = _mm_alignr_epi8(t, cdgh, 8);
+	cdgh = _mm_blend_epi16(cdgh, t, 0xf0);
+
+	for (; nblocks > 0; nblocks--, buf += 64) {
+		abef_save = abef;
+		cdgh_save = cdgh;
+
+		m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(buf + 0)), bswap);
+		m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(buf + 16)), bswap);
+		m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(buf + 32)), bswap);
+		m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(buf + 48)), bswap);
+
+		SHANI_ROUNDS4(0, m0);
+		SHANI_ROUNDS4(4, m1);
+		SHANI_SCHED1(m0, m1);
+		SHANI_ROUNDS4(8, m2);
+		SHANI_SCHED1(m1, m2);
+		SHANI_ROUNDS4(12, m3);
+		SHANI_SCHED2(m0, m3, m2);
+		SHANI_SCHED1(m2, m3);
+		SHANI_ROUNDS4(16, m0);
+		SHANI_SCHED2(m1, m0, m3);
+		SHANI_SCHED1(m3, m0);
+		SHANI_ROUNDS4(20, m1);
+		SHANI_SCHED2(m2, m1, m0);
+		SHANI_SCHED1(m0, m1);
+		SHANI_ROUNDS4(24, m2);
+		SHANI_SCHED2(m3, m2, m1);
+		SHANI_SCHED1(m1, m2);
+		SHANI_ROUNDS4(28, m3);
+		SHANI_SCHED2(m0, m3, m2);
+		SHANI_SCHED1(m2, m3);
+		SHANI_ROUNDS4(32, m0);
+		SHANI_SCHED2(m1, m0, m3);
+		SHANI_SCHED1(m3, m0);
+		SHANI_ROUNDS4(36, m1);
+		SHANI_SCHED2(m2, m1, m0);
+		SHANI_SCHED1(m0, m1);
+		SHANI_ROUNDS4(40, m2);
+		SHANI_SCHED2(m3, m2, m1);
+		SHANI_SCHED1(m1, m2);
+		SHANI_ROUNDS4(44, m3);
+		SHANI_SCHED2(m0, m3, m2);
+		SHANI_SCHED1(m2, m3);
+		SHANI_ROUNDS4(48, m0);
+		SHANI_SCHED2(m1, m0, m3);
+		SHANI_SCHED1(m3, m0);
+		SHANI_ROUNDS4(52, m1);
+		SHANI_SCHED2(m2, m1, m0);
+		SHANI_ROUNDS4(56, m2);
+		SHANI_SCHED2(m3, m2, m1);
+		SHANI_ROUNDS4(60, m3);
+
+		abef = _mm_add_epi32(abef, abef_save);
+		cdgh = _mm_add_epi32(cdgh, cdgh_save);
+	}
+
+	/* back to ABCD EFGH */
+	t = _mm_shuffle_epi32(abef, 0x1b);
+	cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+	_mm_storeu_si128((__m128i*)&state[0], _mm_blend_epi16(t, cdgh, 0xf0));
+	_mm_storeu_si128((__m128i*)&state[4], _mm_alignr_epi8(cdgh, t, 8));
+}
+#endif /* DROPBEAR_CPU_X86 */
+
+#if DROPBEAR_CPU_ARM64
+/* ARMv8 SHA2 extension */
+#include <arm_neon.h>
+
+#if defined(__clang__)
+#define ARMSHA2_TARGET __attribute__((target("sha2")))
+#else
+#define ARMSHA2_TARGET __attribute__((target("+sha2")))
+#endif
+
+/* Four rounds, SHA256H updates ABCD and SHA256H2 EFGH */
+#define ARMSHA2_ROUNDS4(k, m) do { \
+	wk = vaddq_u32(m, vld1q_u32(&sha256_k[k])); \
+	t = abcd; \
+	abcd = vsha256hq_u32(abcd, efgh, wk); \
+	efgh = vsha256h2q_u32(efgh, t, wk); \
+} while (0)
+
+/* The next four message words after m3, replacing m0 */
+#define ARMSHA2_SCHED(m0, m1, m2, m3) \
+	m0 = vsha256su1q_u32(vsha256su0q_u32(m0, m1), m2, m3)
+
+ARMSHA2_TARGET static void armsha2_compress(ulong32 *state,
+		const unsigned char *buf, unsigned long nblocks) {
+	uint32x4_t abcd, efgh, abcd_save, efgh_save, wk, t;
+	uint32x4_t m0, m1, m2, m3;
+
+	abcd = vld1q_u32(&state[0]);
+	efgh = vld1q_u32(&state[4]);
+
+	for (; nblocks > 0; nblocks--, buf += 64) {
+		abcd_save = abcd;
+		efgh_save = efgh;
+
+		m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(buf + 0)));
+		m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(buf + 16)));
+		m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(buf + 32)));
+		m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(buf + 48)));
+
+		ARMSHA2_ROUNDS4(0, m0);
+		ARMSHA2_SCHED(m0, m1, m2, m3);
+		ARMSHA2_ROUNDS4(4, m1);
+		ARMSHA2_SCHED(m1, m2, m3, m0);
+		ARMSHA2_ROUNDS4(8, m2);
+		ARMSHA2_SCHED(m2, m3, m0, m1);
+		ARMSHA2_ROUNDS4(12, m3);
+		ARMSHA2_SCHED(m3, m0, m1, m2);
+		ARMSHA2_ROUNDS4(16, m0);
+		ARMSHA2_SCHED(m0, m1, m2, m3);
+		ARMSHA2_ROUNDS4(20, m1);
+		ARMSHA2_SCHED(m1, m2, m3, m0);
+		ARMSHA2_ROUNDS4(24, m2);
+		ARMSHA2_SCHED(m2, m3, m0, m1);
+		ARMSHA2_ROUNDS4(28, m3);
+		ARMSHA2_SCHED(m3, m0, m1, m2);
+		ARMSHA2_ROUNDS4(32, m0);
+		ARMSHA2_SCHED(m0, m1, m2, m3);
+		ARMSHA2_ROUNDS4(36, m1);
+		ARMSHA2_SCHED(m1, m2, m3, m0);
+		ARMSHA2_ROUNDS4(40, m2);
+		ARMSHA2_SCHED(m2, m3, m0, m1);
+		ARMSHA2_ROUNDS4(44, m3);
+		ARMSHA2_SCHED(m3, m0, m1, m2);
+		ARMSHA2_ROUNDS4(48, m0);
+		ARMSHA2_ROUNDS4(52, m1);
+		ARMSHA2_ROUNDS4(56, m2);
+		ARMSHA2_ROUNDS4(60, m3);
+
+		abcd = vaddq_u32(abcd, abcd_save);
+		efgh = vaddq_u32(efgh, efgh_save);
+	}
+
+	vst1q_u32(&state[0], abcd);
+	vst1q_u32(&state[4], efgh);
+}
+#endif /* DROPBEAR_CPU_ARM64 */
+
+int sha256_accel_compress(ulong32 *state, const unsigned char *buf,
+		unsigned long nblocks) {
+#if DROPBEAR_CPU_X86
+	if (cpu_has(CPU_SHANI)) {
+		shani_compress(state, buf, nblocks);
+		return 1;
+	}
+#endif
+#if DROPBEAR_CPU_ARM64
+	if (cpu_has(CPU_ARM_SHA2)) {
+		armsha2_compress(state, buf, nblocks);
+		return 1;
+	}
+#endif
+	return 0;
+}
+
+#endif /* DROPBEAR_SHA2_ACCEL */
@@ -0,0 +1,21 @@
+#ifndef DROPBEAR_SHA2_ACCEL_H_
+#define DROPBEAR_SHA2_ACCEL_H_
+
+#include "includes.h"
+
+/* The SHA-256 compression function using the CPU's SHA instructions
+ * (SHA-NI on x86, the ARMv8 SHA2 extension on arm64). libtomcrypt's
+ * sha256_process() calls it for each block, so every SHA-256 user,
+ * including HMAC, the exchange hash and dbrandom, gets it. */
+
+#if DROPBEAR_SHA2_ACCEL
+
+/* Compresses nblocks 64 byte blocks into state. Returns 0 without doing
+ * anything if the CPU lacks the instructions, then the portable code
+ * should be used. Declared again in libtomcrypt's sha256.c */
+int sha256_accel_compress(ulong32 *state, const unsigned char *buf,
+		unsigned long nblocks);
+
+#endif /* DROPBEAR_SHA2_ACCEL */
+
+#endif /* DROPBEAR_SHA2_ACCEL_H_ */
@@ -63,6 +63,7 @@ int buf_get_rsa_priv_ossh(buffer *buf, sign_key *akey) {
 		&& buf_getmpint(buf, &iqmp) == DROPBEAR_SUCCESS
 		&& buf_getmpint(buf, key->p) == DROPBEAR_SUCCESS
 		&& buf_getmpint(buf, key->q) == DROPBEAR_SUCCESS) {
+		rsa_key_crt_init(key);
 		ret = DROPBEAR_SUCCESS;
 	}
 	mp_clear(&iqmp);
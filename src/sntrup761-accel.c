@@ -0,0 +1,524 @@
+#include "includes.h"
+#include "dbutil.h"
+#include "cpufeatures.h"
+#include "sntrup761-accel.h"
+
+#if DROPBEAR_SNTRUP761_ACCEL
+
+#define P 761
+#define Q 4591
+#define Q12 ((Q - 1) / 2)
+/* p + 1 coefficients, rounded up to whole vectors of either size */
+#define LEN 768
+/* The 2p - 1 coefficients of a product, rounded up likewise */
+#define PRODUCT_LEN 1528
+/* Zeroes either side of g for the product kernels */
+#define GPAD 16
+
+/* Scalar parts, as in sntrup761.c */
+
+static int16_t fq_freeze(int32_t x) {
+	const int32_t q16 = (0x10000 + Q / 2) / Q;
+	const int32_t q20 = (0x100000 + Q / 2) / Q;
+	const int32_t q28 = (0x10000000 + Q / 2) / Q;
+	x -= Q * ((q16 * x) >> 16);
+	x -= Q * ((q20 * x) >> 20);
+	return x - Q * ((q28 * x + 0x8000000) >> 28);
+}
+
+static int8_t f3_freeze(int16_t x) {
+	return x - 3 * ((10923 * x + 16384) >> 15);
+}
+
+static int16_t fq_recip(int16_t a1) {
+	int i;
+	int16_t ai = a1;
+
+	for (i = 1; i < Q - 2; i++) {
+		ai = fq_freeze(a1 * (int32_t)ai);
+	}
+	return ai;
+}
+
+/* All ones if x is negative or non-zero, without branches */
+static int32_t negative_mask(int32_t x) {
+	return x >> 31;
+}
+
+static int32_t nonzero_mask(int32_t x) {
+	return negative_mask(x | -x);
+}
+
+/* round(b * 2^15 / q) give or take one, so that the product of a
+ * coefficient and b can be reduced with a rounding high multiply */
+static int16_t fq_shoup(int16_t b) {
+	return (int16_t)(((int32_t)b * 233878) >> 15);
+}
+
+/* Reduces a product modulo x^p - x - 1 */
+static void product_reduce(int32_t *fg) {
+	int i;
+
+	for (i = P; i < P + P - 1; i++) {
+		fg[i - P] += fg[i];
+	}
+	for (i = P; i < P + P - 1; i++) {
+		fg[i - P + 1] += fg[i];
+	}
+}
+
+/* Each instruction set defines vectors of 16, 8 and 32 bit lanes and the
+ * operations on them used by the shared code further down, and the
+ * product kernel. Loads and stores are unaligned */
+
+#if DROPBEAR_CPU_X86
+#include <immintrin.h>
+
+#define SIMD_TARGET __attribute__((target("avx2")))
+
+typedef __m256i vec16;
+typedef __m256i vec8;
+typedef __m256i vec32;
+typedef __m256i vmask32;
+
+#define V16_LANES 16
+#define V16_LOAD(p) _mm256_loadu_si256((const __m256i*)(p))
+#define V16_STORE(p, a) _mm256_storeu_si256((__m256i*)(p), a)
+#define V16_SET1(x) _mm256_set1_epi16(x)
+#define V16_ADD(a, b) _mm256_add_epi16(a, b)
+#define V16_SUB(a, b) _mm256_sub_epi16(a, b)
+#define V16_AND(a, b) _mm256_and_si256(a, b)
+#define V16_XOR(a, b) _mm256_xor_si256(a, b)
+#define V16_GT(a, b) _mm256_cmpgt_epi16(a, b)
+#define V16_MULLO(a, b) _mm256_mullo_epi16(a, b)
+/* round(a * b / 2^15) */
+#define V16_MULHRS(a, b) _mm256_mulhrs_epi16(a, b)
+
+#define V8_LANES 32
+#define V8_LOAD(p) _mm256_loadu_si256((const __m256i*)(p))
+#define V8_STORE(p, a) _mm256_storeu_si256((__m256i*)(p), a)
+#define V8_SET1(x) _mm256_set1_epi8(x)
+#define V8_ADD(a, b) _mm256_add_epi8(a, b)
+#define V8_SUB(a, b) _mm256_sub_epi8(a, b)
+#define V8_AND(a, b) _mm256_and_si256(a, b)
+#define V8_XOR(a, b) _mm256_xor_si256(a, b)
+#define V8_GT(a, b) _mm256_cmpgt_epi8(a, b)
+/* a times s, where the lanes of s are -1, 0 or 1 */
+#define V8_MULSIGN(a, s) _mm256_sign_epi8(a, s)
+
+#define V32_LANES 8
+#define V32_LOAD(p) _mm256_loadu_si256((const __m256i*)(p))
+#define V32_STORE(p, a) _mm256_storeu_si256((__m256i*)(p), a)
+#define V32_MIN(a, b) _mm256_min_epi32(a, b)
+#define V32_MAX(a, b) _mm256_max_epi32(a, b)
+/* The lane numbers l, l + 1, ... */
+#define V32_INDEX(l) _mm256_add_epi32(_mm256_set1_epi32(l), \
+	_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))
+/* Lanes i where (i & j) != 0 differs from (i & k) != 0 */
+#define V32_BITSDIFFER(i, j, k) _mm256_xor_si256( \
+	_mm256_cmpeq_epi32(_mm256_and_si256(i, _mm256_set1_epi32(j)), \
+		_mm256_setzero_si256()), \
+	_mm256_cmpeq_epi32(_mm256_and_si256(i, _mm256_set1_epi32(k)), \
+		_mm256_setzero_si256()))
+/* b where the mask is set, a elsewhere */
+#define V32_SELECT(m, b, a) _mm256_blendv_epi8(a, b, m)
+/* Lane i of the result is lane i ^ j of a, for j < V32_LANES */
+#define V32_PARTNER(a, j) ((j) == 4 ? _mm256_permute2x128_si256(a, a, 0x01) \
+	: (j) == 2 ? _mm256_shuffle_epi32(a, 0x4e) : _mm256_shuffle_epi32(a, 0xb1))
+
+/* fg = f*g, unreduced. VPMADDWD multiplies pairs of 16 bit lanes and adds
+ * each pair into a 32 bit lane, so each step adds two terms to eight
+ * coefficients: f[2m] and f[2m+1] are broadcast as a pair, against a pair
+ * array holding (g[t], g[t-1]) in lane t */
+SIMD_TARGET static void product_simd(int32_t *fg, const int16_t *f,
+		const int8_t *g) {
+	uint32_t fpair[(P + 1) / 2], gpair[P + 2 * GPAD + 8];
+	__m256i acc0, acc1;
+	int i, k, m, mlo, mhi;
+
+	for (m = 0; m < (P + 1) / 2; m++) {
+		fpair[m] = (uint16_t)f[2 * m];
+		if (2 * m + 1 < P) {
+			fpair[m] |= (uint32_t)(uint16_t)f[2 * m + 1] << 16;
+		}
+	}
+	for (i = -GPAD; i < P + GPAD + 8; i++) {
+		gpair[i + GPAD] = 0;
+		if (i >= 0 && i < P) {
+			gpair[i + GPAD] |= (uint16_t)g[i];
+		}
+		if (i >= 1 && i <= P) {
+			gpair[i + GPAD] |= (uint32_t)(uint16_t)g[i - 1] << 16;
+		}
+	}
+
+	for (k = 0; k < PRODUCT_LEN; k += 8) {
+		/* outside of these all of g's lanes are zero */
+		mlo = k > P + 1 ? (k - P - 1) / 2 : 0;
+		mhi = MIN((P + 1) / 2, (k + 8) / 2 + 1);
+		acc0 = _mm256_setzero_si256();
+		acc1 = _mm256_setzero_si256();
+		for (m = mlo; m + 1 < mhi; m += 2) {
+			acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(
+				_mm256_set1_epi32((int)fpair[m]),
+				_mm256_loadu_si256((const __m256i*)&gpair[GPAD + k - 2*m])));
+			acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(
+				_mm256_set1_epi32((int)fpair[m + 1]),
+				_mm256_loadu_si256((const __m256i*)&gpair[GPAD + k - 2*m - 2])));
+		}
+		if (m < mhi) {
+			acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(
+				_mm256_set1_epi32((int)fpair[m]),
+				_mm256_loadu_si256((const __m256i*)&gpair[GPAD + k - 2*m])));
+		}
+		_mm256_storeu_si256((__m256i*)&fg[k], _mm256_add_epi32(acc0, acc1));
+	}
+}
+#endif /* DROPBEAR_CPU_X86 */
+
+#if DROPBEAR_CPU_ARM64
+#include <arm_neon.h>
+
+#define SIMD_TARGET
+
+typedef int16x8_t vec16;
+typedef int8x16_t vec8;
+typedef int32x4_t vec32;
+typedef uint32x4_t vmask32;
+
+#define V16_LANES 8
+#define V16_LOAD(p) vld1q_s16(p)
+#define V16_STORE(p, a) vst1q_s16(p, a)
+#define V16_SET1(x) vdupq_n_s16(x)
+#define V16_ADD(a, b) vaddq_s16(a, b)
+#define V16_SUB(a, b) vsubq_s16(a, b)
+#define V16_AND(a, b) vandq_s16(a, b)
+#define V16_XOR(a, b) veorq_s16(a, b)
+#define V16_GT(a, b) vreinterpretq_s16_u16(vcgtq_s16(a, b))
+#define V16_MULLO(a, b) vmulq_s16(a, b)
+/* round(a * b / 2^15), it only saturates for -2^15 * -2^15 */
+#define V16_MULHRS(a, b) vqrdmulhq_s16(a, b)
+
+#define V8_LANES 16
+#define V8_LOAD(p) vld1q_s8(p)
+#define V8_STORE(p, a) vst1q_s8(p, a)
+#define V8_SET1(x) vdupq_n_s8(x)
+#define V8_ADD(a, b) vaddq_s8(a, b)
+#define V8_SUB(a, b) vsubq_s8(a, b)
+#define V8_AND(a, b) vandq_s8(a, b)
+#define V8_XOR(a, b) veorq_s8(a, b)
+#define V8_GT(a, b) vreinterpretq_s8_u8(vcgtq_s8(a, b))
+#define V8_MULSIGN(a, s) vmulq_s8(a, s)
+
+#define V32_LANES 4
+#define V32_LOAD(p) vld1q_s32(p)
+#define V32_STORE(p, a) vst1q_s32(p, a)
+#define V32_MIN(a, b) vminq_s32(a, b)
+#define V32_MAX(a, b) vmaxq_s32(a, b)
+static const uint32_t lane_numbers[4] = { 0, 1, 2, 3 };
+#define V32_INDEX(l) vaddq_u32(vdupq_n_u32(l), vld1q_u32(lane_numbers))
+#define V32_BITSDIFFER(i, j, k) veorq_u32(vtstq_u32(i, vdupq_n_u32(j)), \
+	vtstq_u32(i, vdupq_n_u32(k)))
+#define V32_SELECT(m, b, a) vbslq_s32(m, b, a)
+#define V32_PARTNER(a, j) ((j) == 2 ? vextq_s32(a, a, 2) : vrev64q_s32(a))
+
+/* fg = f*g, unreduced, with a widening multiply-accumulate of four
+ * coefficients of g by one of f */
+static void product_simd(int32_t *fg, const int16_t *f, const int8_t *g) {
+	int16_t gpad[P + 2 * GPAD];
+	int32x4_t acc0, acc1;
+	int i, k, lo, hi;
+
+	for (i = 0; i < P + 2 * GPAD; i++) {
+		gpad[i] = (i >= GPAD && i < P + GPAD) ? g[i - GPAD] : 0;
+	}
+
+	for (k = 0; k < PRODUCT_LEN; k += 8) {
+		lo = k >= P ? k - P + 1 : 0;
+		hi = MIN(P, k + 8);
+		acc0 = vdupq_n_s32(0);
+		acc1 = vdupq_n_s32(0);
+		for (i = lo; i < hi; i++) {
+			acc0 = vmlal_n_s16(acc0, vld1_s16(&gpad[GPAD + k - i]), f[i]);
+			acc1 = vmlal_n_s16(acc1, vld1_s16(&gpad[GPAD + k - i + 4]), f[i]);
+		}
+		vst1q_s32(&fg[k], acc0);
+		vst1q_s32(&fg[k + 4], acc1);
+	}
+}
+#endif /* DROPBEAR_CPU_ARM64 */
+
+/* The reciprocals run the same 2p - 1 constant time division steps as
+ * sntrup761.c, on whole vectors of coefficients. v's shift right is done
+ * by loading it one lane back and g's shift left by storing it one lane
+ * back, each into the other of a pair of buffers, with a zero lane before
+ * v. Only v and r's first loop + 2 coefficients can be non-zero */
+
+SIMD_TARGET static int rq_recip3_simd(int16_t *out, const int8_t *in) {
+	int16_t f[LEN], r[LEN], gbuf[2][LEN + 1], vbuf[2][LEN + 1];
+	int16_t *g, *gnext, *v, *vnext, *tmp;
+	vec16 sw, fv, gv, vv, rv, t, x, vf0, vf0s, vg0, vg0s;
+	const vec16 vq = V16_SET1(Q), vq12 = V16_SET1(Q12);
+	const vec16 vnq12 = V16_SET1(-Q12), v7 = V16_SET1(7);
+	int32_t swap, delta = 1, d, f0, g0;
+	int i, loop, nvr;
+
+	memset(f, 0x0, sizeof(f));
+	memset(r, 0x0, sizeof(r));
+	memset(gbuf, 0x0, sizeof(gbuf));
+	memset(vbuf, 0x0, sizeof(vbuf));
+	g = &gbuf[0][1];
+	gnext = &gbuf[1][1];
+	v = &vbuf[0][1];
+	vnext = &vbuf[1][1];
+
+	r[0] = fq_recip(3);
+	f[0] = 1;
+	f[P - 1] = f[P] = -1;
+	for (i = 0; i < P; i++) {
+		g[P - 1 - i] = in[i];
+	}
+
+	/* x = f0*a - g0*b, canonical. Each product is reduced to less than q
+	 * by subtracting a multiple of q estimated from a * round(b*2^15/q),
+	 * then the difference to within q12 */
+#define FQ_MULSUB(a, b) do { \
+	x = V16_SUB( \
+		V16_SUB(V16_MULLO(a, vf0), V16_MULLO(V16_MULHRS(a, vf0s), vq)), \
+		V16_SUB(V16_MULLO(b, vg0), V16_MULLO(V16_MULHRS(b, vg0s), vq))); \
+	x = V16_SUB(x, V16_MULLO(V16_MULHRS(x, v7), vq)); \
+	x = V16_SUB(x, V16_AND(V16_GT(x, vq12), vq)); \
+	x = V16_ADD(x, V16_AND(V16_GT(vnq12, x), vq)); \
+} while (0)
+
+	for (loop = 0; loop < 2 * P - 1; loop++) {
+		swap = negative_mask(-delta) & nonzero_mask(g[0]);
+		delta ^= swap & (delta ^ -delta);
+		delta += 1;
+		d = swap & (f[0] ^ g[0]);
+		f0 = f[0] ^ d;
+		g0 = g[0] ^ d;
+
+		sw = V16_SET1(swap);
+		vf0 = V16_SET1(f0);
+		vf0s = V16_SET1(fq_shoup(f0));
+		vg0 = V16_SET1(g0);
+		vg0s = V16_SET1(fq_shoup(g0));
+
+		for (i = 0; i < LEN; i += V16_LANES) {
+			fv = V16_LOAD(&f[i]);
+			gv = V16_LOAD(&g[i]);
+			t = V16_AND(sw, V16_XOR(fv, gv));
+			fv = V16_XOR(fv, t);
+			gv = V16_XOR(gv, t);
+			V16_STORE(&f[i], fv);
+			FQ_MULSUB(gv, fv);
+			V16_STORE(&gnext[i - 1], x);
+		}
+
+		nvr = MIN(loop + 2, LEN);
+		for (i = 0; i < nvr; i += V16_LANES) {
+			vv = V16_LOAD(&v[i - 1]);
+			rv = V16_LOAD(&r[i]);
+			t = V16_AND(sw, V16_XOR(vv, rv));
+			vv = V16_XOR(vv, t);
+			rv = V16_XOR(rv, t);
+			V16_STORE(&vnext[i], vv);
+			FQ_MULSUB(rv, vv);
+			V16_STORE(&r[i], x);
+		}
+
+		tmp = g; g = gnext; gnext = tmp;
+		tmp = v; v = vnext; vnext = tmp;
+	}
+#undef FQ_MULSUB
+
+	f0 = fq_recip(f[0]);
+	for (i = 0; i < P; i++) {
+		out[i] = fq_freeze(f0 * (int32_t)v[P - 1 - i]);
+	}
+	return nonzero_mask(delta);
+}
+
+SIMD_TARGET static int r3_recip_simd(int8_t *out, const int8_t *in) {
+	int8_t f[LEN], r[LEN], gbuf[2][LEN + 1], vbuf[2][LEN + 1];
+	int8_t *g, *gnext, *v, *vnext, *tmp;
+	vec8 sw, vsign, fv, gv, vv, rv, t, x;
+	const vec8 one = V8_SET1(1), mone = V8_SET1(-1), three = V8_SET1(3);
+	int32_t swap, delta = 1, sign;
+	int i, loop, nvr;
+
+	memset(f, 0x0, sizeof(f));
+	memset(r, 0x0, sizeof(r));
+	memset(gbuf, 0x0, sizeof(gbuf));
+	memset(vbuf, 0x0, sizeof(vbuf));
+	g = &gbuf[0][1];
+	gnext = &gbuf[1][1];
+	v = &vbuf[0][1];
+	vnext = &vbuf[1][1];
+
+	r[0] = 1;
+	f[0] = 1;
+	f[P - 1] = f[P] = -1;
+	for (i = 0; i < P; i++) {
+		g[P - 1 - i] = in[i];
+	}
+
+	/* x = a + sign*b, from -2 to 2, then to -1, 0 or 1 */
+#define F3_ADDMUL(a, b) do { \
+	x = V8_ADD(a, V8_MULSIGN(b, vsign)); \
+	x = V8_SUB(x, V8_AND(V8_GT(x, one), three)); \
+	x = V8_ADD(x, V8_AND(V8_GT(mone, x), three)); \
+} while (0)
+
+	for (loop = 0; loop < 2 * P - 1; loop++) {
+		sign = -g[0] * f[0];
+		swap = negative_mask(-delta) & nonzero_mask(g[0]);
+		delta ^= swap & (delta ^ -delta);
+		delta += 1;
+
+		sw = V8_SET1(swap);
+		vsign = V8_SET1(sign);
+
+		for (i = 0; i < LEN; i += V8_LANES) {
+			fv = V8_LOAD(&f[i]);
+			gv = V8_LOAD(&g[i]);
+			t = V8_AND(sw, V8_XOR(fv, gv));
+			fv = V8_XOR(fv, t);
+			gv = V8_XOR(gv, t);
+			V8_STORE(&f[i], fv);
+			F3_ADDMUL(gv, fv);
+			V8_STORE(&gnext[i - 1], x);
+		}
+
+		nvr = MIN(loop + 2, LEN);
+		for (i = 0; i < nvr; i += V8_LANES) {
+			vv = V8_LOAD(&v[i - 1]);
+			rv = V8_LOAD(&r[i]);
+			t = V8_AND(sw, V8_XOR(vv, rv));
+			vv = V8_XOR(vv, t);
+			rv = V8_XOR(rv, t);
+			V8_STORE(&vnext[i], vv);
+			F3_ADDMUL(rv, vv);
+			V8_STORE(&r[i], x);
+		}
+
+		tmp = g; g = gnext; gnext = tmp;
+		tmp = v; v = vnext; vnext = tmp;
+	}
+#undef F3_ADDMUL
+
+	sign = f[0];
+	for (i = 0; i < P; i++) {
+		out[i] = sign * v[P - 1 - i];
+	}
+	return nonzero_mask(delta);
+}
+
+/* Bitonic sorting network over n, a power of two of at least two vectors.
+ * Compare-exchanges between lanes of one vector are done against a
+ * shuffled copy, keeping the minimum or maximum in each lane */
+SIMD_TARGET static void sort_int32_simd(int32_t *x, int n) {
+	vec32 a, b, mn, mx;
+	vmask32 idx;
+	int i, j, k, l;
+
+	for (k = 2; k <= n; k <<= 1) {
+		for (j = k >> 1; j >= V32_LANES; j >>= 1) {
+			for (i = 0; i < n; i += 2 * j) {
+				for (l = i; l < i + j; l += V32_LANES) {
+					a = V32_LOAD(&x[l]);
+					b = V32_LOAD(&x[l + j]);
+					mn = V32_MIN(a, b);
+					mx = V32_MAX(a, b);
+					/* descending where bit k is set */
+					if (l & k) {
+						V32_STORE(&x[l], mx);
+						V32_STORE(&x[l + j], mn);
+					} else {
+						V32_STORE(&x[l], mn);
+						V32_STORE(&x[l + j], mx);
+					}
+				}
+			}
+		}
+
+		for (l = 0; l < n; l += V32_LANES) {
+			a = V32_LOAD(&x[l]);
+			idx = V32_INDEX(l);
+			for (j = MIN(k >> 1, V32_LANES >> 1); j > 0; j >>= 1) {
+				b = V32_PARTNER(a, j);
+				a = V32_SELECT(V32_BITSDIFFER(idx, j, k),
+					V32_MAX(a, b), V32_MIN(a, b));
+			}
+			V32_STORE(&x[l], a);
+		}
+	}
+}
+
+int sntrup761_accel(void) {
+#if DROPBEAR_CPU_X86
+	return cpu_has(CPU_AVX2);
+#else
+	return cpu_has(CPU_ARM_NEON);
+#endif
+}
+
+void sntrup761_accel_r3_mult(int8_t *h, const int8_t *f, const int8_t *g) {
+	int16_t f16[P];
+	int32_t fg[PRODUCT_LEN];
+	int i;
+
+	for (i = 0; i < P; i++) {
+		f16[i] = f[i];
+	}
+	product_simd(fg, f16, g);
+	product_reduce(fg);
+	for (i = 0; i < P; i++) {
+		h[i] = f3_freeze(fg[i]);
+	}
+}
+
+void sntrup761_accel_rq_mult_small(int16_t *h, const int16_t *f,
+		const int8_t *g) {
+	int32_t fg[PRODUCT_LEN];
+	int i;
+
+	product_simd(fg, f, g);
+	product_reduce(fg);
+	for (i = 0; i < P; i++) {
+		h[i] = fq_freeze(fg[i]);
+	}
+}
+
+int sntrup761_accel_r3_recip(int8_t *out, const int8_t *in) {
+	return r3_recip_simd(out, in);
+}
+
+int sntrup761_accel_rq_recip3(int16_t *out, const int8_t *in) {
+	return rq_recip3_simd(out, in);
+}
+
+/* Sorted as signed integers with the top bit flipped, padded with the
+ * largest value up to a power of two */
+void sntrup761_accel_sort_uint32(uint32_t *x, long long n) {
+	int32_t buf[SNTRUP761_ACCEL_SORT_MAX];
+	int i, len = 2 * V32_LANES;
+
+	dropbear_assert(n <= SNTRUP761_ACCEL_SORT_MAX);
+	while (len < n) {
+		len <<= 1;
+	}
+	for (i = 0; i < n; i++) {
+		buf[i] = (int32_t)(x[i] ^ 0x80000000);
+	}
+	for (; i < len; i++) {
+		buf[i] = 0x7fffffff;
+	}
+	sort_int32_simd(buf, len);
+	for (i = 0; i < n; i++) {
+		x[i] = (uint32_t)buf[i] ^ 0x80000000;
+	}
+}
+
+#endif /* DROPBEAR_SNTRUP761_ACCEL */
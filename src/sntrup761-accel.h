@@ -0,0 +1,46 @@
+#ifndef DROPBEAR_SNTRUP761_ACCEL_H_
+#define DROPBEAR_SNTRUP761_ACCEL_H_
+
+#include "includes.h"
+
+/* The polynomial arithmetic and sorting of sntrup761 key generation,
+ * encapsulation and decapsulation using SIMD instructions (AVX2 on x86,
+ * NEON on arm64). sntrup761.c calls these in place of its portable
+ * functions when sntrup761_accel() says they can be used, and the results
+ * are identical. Everything is constant time like the portable code. */
+
+#if DROPBEAR_SNTRUP761_ACCEL
+
+/* p and q of sntrup761.c, polynomials have SNTRUP761_P coefficients */
+#define SNTRUP761_P 761
+#define SNTRUP761_Q 4591
+
+/* Largest array crypto_sort_uint32() can be replaced for */
+#define SNTRUP761_ACCEL_SORT_MAX 1024
+
+/* Returns non-zero if the CPU has the instructions needed */
+int sntrup761_accel(void);
+
+/* The same as R3_mult(), Rq_mult_small(), R3_recip(), Rq_recip3() and
+ * crypto_sort_uint32() in sntrup761.c */
+void sntrup761_accel_r3_mult(int8_t *h, const int8_t *f, const int8_t *g);
+void sntrup761_accel_rq_mult_small(int16_t *h, const int16_t *f,
+		const int8_t *g);
+int sntrup761_accel_r3_recip(int8_t *out, const int8_t *in);
+int sntrup761_accel_rq_recip3(int16_t *out, const int8_t *in);
+void sntrup761_accel_sort_uint32(uint32_t *x, long long n);
+
+#if DROPBEAR_BENCH
+/* The same functions as sntrup761.c calls them, using the above if
+ * sntrup761_accel() and the portable code otherwise. bench-kex checks
+ * one against the other */
+void sntrup761_r3_mult(int8_t *h, const int8_t *f, const int8_t *g);
+void sntrup761_rq_mult_small(int16_t *h, const int16_t *f, const int8_t *g);
+int sntrup761_r3_recip(int8_t *out, const int8_t *in);
+int sntrup761_rq_recip3(int16_t *out, const int8_t *in);
+void sntrup761_sort_uint32(uint32_t *x, long long n);
+#endif
+
+#endif /* DROPBEAR_SNTRUP761_ACCEL */
+
+#endif /* DROPBEAR_SNTRUP761_ACCEL_H_ */
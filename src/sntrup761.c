@@ -8,6 +8,7 @@
 
 #include <string.h>
 #include "sntrup761_compat.h"
+#include "sntrup761-accel.h"
 
 #if DROPBEAR_SNTRUP761
 
@@ -1743,6 +1744,12 @@ static void crypto_sort_uint32(void *array,long long n)
 {
   crypto_uint32 *x = array;
   long long j;
+#if DROPBEAR_SNTRUP761_ACCEL
+  if (sntrup761_accel() && n <= SNTRUP761_ACCEL_SORT_MAX) {
+    sntrup761_accel_sort_uint32(x, n);
+    return;
+  }
+#endif
   for (j = 0;j < n;++j) x[j] ^= 0x80000000;
   crypto_sort_int32(array,n);
   for (j = 0;j < n;++j) x[j] ^= 0x80000000;
@@ -1889,6 +1896,12 @@ static void R3_fromRq(small *out, const Fq *r) {
 static void R3_mult(small *h, const small *f, const small *g) {
   int16_t fg[p + p - 1];
   int i, j;
+#if DROPBEAR_SNTRUP761_ACCEL
+  if (sntrup761_accel()) {
+    sntrup761_accel_r3_mult(h, f, g);
+    return;
+  }
+#endif
   for (i = 0; i < p + p - 1; ++i) fg[i] = 0;
   for (i = 0; i < p; ++i)
     for (j = 0; j < p; ++j) fg[i + j] += f[i] * (int16_t)g[j];
@@ -1900,6 +1913,9 @@ static void R3_mult(small *h, const small *f, const small *g) {
 static int R3_recip(small *out, const small *in) {
   small f[p + 1], g[p + 1], v[p + 1], r[p + 1];
   int sign, swap, t, i, loop, delta = 1;
+#if DROPBEAR_SNTRUP761_ACCEL
+  if (sntrup761_accel()) return sntrup761_accel_r3_recip(out, in);
+#endif
   for (i = 0; i < p + 1; ++i) v[i] = 0;
   for (i = 0; i < p + 1; ++i) r[i] = 0;
   r[0] = 1;
@@ -1936,6 +1952,12 @@ static int R3_recip(small *out, const small *in) {
 static void Rq_mult_small(Fq *h, const Fq *f, const small *g) {
   int32_t fg[p + p - 1];
   int i, j;
+#if DROPBEAR_SNTRUP761_ACCEL
+  if (sntrup761_accel()) {
+    sntrup761_accel_rq_mult_small(h, f, g);
+    return;
+  }
+#endif
   for (i = 0; i < p + p - 1; ++i) fg[i] = 0;
   for (i = 0; i < p; ++i)
     for (j = 0; j < p; ++j) fg[i + j] += f[i] * (int32_t)g[j];
@@ -1963,6 +1985,9 @@ static int Rq_recip3(Fq *out, const small *in) {
   Fq f[p + 1], g[p + 1], v[p + 1], r[p + 1], scale;
   int swap, t, i, loop, delta = 1;
   int32_t f0, g0;
+#if DROPBEAR_SNTRUP761_ACCEL
+  if (sntrup761_accel()) return sntrup761_accel_rq_recip3(out, in);
+#endif
   for (i = 0; i < p + 1; ++i) v[i] = 0;
   for (i = 0; i < p + 1; ++i) r[i] = 0;
   r[0] = Fq_recip(3);
@@ -2215,4 +2240,26 @@ int crypto_kem_sntrup761_dec(unsigned char *k, const unsigned char *c, const uns
   return 0;
 }
 
+#if DROPBEAR_SNTRUP761_ACCEL && DROPBEAR_BENCH
+void sntrup761_r3_mult(int8_t *h, const int8_t *f, const int8_t *g) {
+  R3_mult(h, f, g);
+}
+
+void sntrup761_rq_mult_small(int16_t *h, const int16_t *f, const int8_t *g) {
+  Rq_mult_small(h, f, g);
+}
+
+int sntrup761_r3_recip(int8_t *out, const int8_t *in) {
+  return R3_recip(out, in);
+}
+
+int sntrup761_rq_recip3(int16_t *out, const int8_t *in) {
+  return Rq_recip3(out, in);
+}
+
+void sntrup761_sort_uint32(uint32_t *x, long long n) {
+  crypto_sort_uint32(x, n);
+}
+#endif /* DROPBEAR_SNTRUP761_ACCEL && DROPBEAR_BENCH */
+
 #endif /* DROPBEAR_SNTRUP761 */
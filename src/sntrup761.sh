@@ -21,6 +21,7 @@ echo ' */'
 echo
 echo '#include <string.h>'
 echo '#include "sntrup761_compat.h"'
+echo '#include "sntrup761-accel.h"'
 echo
 echo '#if DROPBEAR_SNTRUP761'
 echo
@@ -83,8 +84,40 @@ for i in $FILES; do
 	    sed -e "s/crypto_sort_smallindices/crypto_sort_int32_smallindices/"\
 	        -e "s/void crypto_sort[(]/void crypto_sort_int32(/g"
 	    ;;
+	# Use the SIMD versions from sntrup761-accel.c when the CPU has them.
 	*/uint32/useint32/sort.c)
-	    sed -e "s/void crypto_sort/void crypto_sort_uint32/g"
+	    sed -e "s/void crypto_sort/void crypto_sort_uint32/g" \
+		-e '/^static [a-z]* crypto_sort_uint32(/,/^}$/s/^  long long j;$/&\
+#if DROPBEAR_SNTRUP761_ACCEL\
+  if (sntrup761_accel() \&\& n <= SNTRUP761_ACCEL_SORT_MAX) {\
+    sntrup761_accel_sort_uint32(x, n);\
+    return;\
+  }\
+#endif/'
+	    ;;
+	*/crypto_kem/sntrup761/compact/kem.c)
+	    sed -e '/^static [a-z]* R3_mult(/,/^}$/s/^  int i, j;$/&\
+#if DROPBEAR_SNTRUP761_ACCEL\
+  if (sntrup761_accel()) {\
+    sntrup761_accel_r3_mult(h, f, g);\
+    return;\
+  }\
+#endif/' \
+		-e '/^static [a-z]* R3_recip(/,/^}$/s/^  int sign, swap, t, i, loop, delta = 1;$/&\
+#if DROPBEAR_SNTRUP761_ACCEL\
+  if (sntrup761_accel()) return sntrup761_accel_r3_recip(out, in);\
+#endif/' \
+		-e '/^static [a-z]* Rq_mult_small(/,/^}$/s/^  int i, j;$/&\
+#if DROPBEAR_SNTRUP761_ACCEL\
+  if (sntrup761_accel()) {\
+    sntrup761_accel_rq_mult_small(h, f, g);\
+    return;\
+  }\
+#endif/' \
+		-e '/^static [a-z]* Rq_recip3(/,/^}$/s/^  int32_t f0, g0;$/&\
+#if DROPBEAR_SNTRUP761_ACCEL\
+  if (sntrup761_accel()) return sntrup761_accel_rq_recip3(out, in);\
+#endif/'
 	    ;;
 	# Remove unused function to prevent warning.
 	*/crypto_kem/sntrup761/ref/int32.c)
@@ -101,4 +134,30 @@ for i in $FILES; do
 	esac
 	echo
 done
+# The functions with SIMD versions, as kem.c calls them, so that bench-kex
+# can check the SIMD and portable code against each other.
+cat <<'EOF'
+#if DROPBEAR_SNTRUP761_ACCEL && DROPBEAR_BENCH
+void sntrup761_r3_mult(int8_t *h, const int8_t *f, const int8_t *g) {
+  R3_mult(h, f, g);
+}
+
+void sntrup761_rq_mult_small(int16_t *h, const int16_t *f, const int8_t *g) {
+  Rq_mult_small(h, f, g);
+}
+
+int sntrup761_r3_recip(int8_t *out, const int8_t *in) {
+  return R3_recip(out, in);
+}
+
+int sntrup761_rq_recip3(int16_t *out, const int8_t *in) {
+  return Rq_recip3(out, in);
+}
+
+void sntrup761_sort_uint32(uint32_t *x, long long n) {
+  crypto_sort_uint32(x, n);
+}
+#endif /* DROPBEAR_SNTRUP761_ACCEL && DROPBEAR_BENCH */
+
+EOF
 echo '#endif /* DROPBEAR_SNTRUP761 */'
@@ -35,6 +35,7 @@
 #include "auth.h"
 #include "runopts.h"
 #include "dbrandom.h"
+#include "metrics.h"
 
 static int checkusername(const char *username, unsigned int userlen);
 
@@ -87,6 +88,9 @@ void recv_msg_userauth_request() {
 		return;
 	}
 
+	/* auth time is from the first request */
+	metrics_event_start(METRIC_AUTH_USEC);
+
 	/* send the banner if it exists, it will only exist once */
 	if (svr_opts.banner) {
 		send_msg_userauth_banner(svr_opts.banner);
@@ -425,6 +429,7 @@ void send_msg_userauth_failure(int partial, int incrfail) {
 		}
 
 		ses.authstate.failcount++;
+		metrics_add(METRIC_AUTH_FAILURE, 1);
 	}
 
 	if (ses.authstate.failcount >= svr_opts.maxauthtries) {
@@ -458,6 +463,8 @@ void send_msg_userauth_success() {
 	 * delayed-zlib mode */
 	ses.authstate.authdone = 1;
 	ses.connect_time = 0;
+	metrics_event_done(METRIC_AUTH_USEC);
+	metrics_add(METRIC_AUTH_SUCCESS, 1);
 
 
 	if (ses.authstate.pw_uid == 0) {
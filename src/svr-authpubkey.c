@@ -70,6 +70,7 @@
 
 #define MIN_AUTHKEYS_LINE 10 /* "ssh-rsa AB" - short but doesn't matter */
 #define MAX_AUTHKEYS_LINE 4200 /* max length of a line in authkeys */
+#define MAX_AUTHKEYS_INDEX_SIZE 10000000 /* larger files aren't held in memory */
 
 static char * authorized_keys_filepath(void);
 static int checkpubkey(const char* keyalgo, unsigned int keyalgolen,
@@ -78,6 +79,9 @@ static int checkpubkeyperms(void);
 static void send_msg_userauth_pk_ok(const char* sigalgo, unsigned int sigalgolen,
 		const unsigned char* keyblob, unsigned int keybloblen);
 static int checkfileperm(char * filename);
+#if DROPBEAR_SVR_PUBKEY_INDEX
+static void authkeys_index_free(void);
+#endif
 
 /* process a pubkey auth request, sending success or failure message as
  * appropriate */
@@ -261,6 +265,12 @@ out:
 	if (!ses.authstate.authdone) {
 		svr_pubkey_options_cleanup();
 	}
+#if DROPBEAR_SVR_PUBKEY_INDEX
+	if (ses.authstate.authdone) {
+		/* no more keys will be checked */
+		authkeys_index_free();
+	}
+#endif
 	TRACE(("leave pubkeyauth"))
 }
 
@@ -451,6 +461,291 @@ static char *authorized_keys_filepath() {
 	return pathname;
 }
 
+/* Checks each line of an opened authorized_keys file in turn */
+static int checkpubkey_scan(FILE *authfile, const char *filename,
+		const char* keyalgo, unsigned int keyalgolen,
+		const unsigned char* keyblob, unsigned int keybloblen) {
+	buffer * line = NULL;
+	int line_num = 0;
+	int ret = DROPBEAR_FAILURE;
+
+	line = buf_new(MAX_AUTHKEYS_LINE);
+
+	/* iterate through the lines */
+	do {
+		if (buf_getline(line, authfile) == DROPBEAR_FAILURE) {
+			/* EOF reached */
+			TRACE(("checkpubkey: authorized_keys EOF reached"))
+			break;
+		}
+		line_num++;
+
+		ret = checkpubkey_line(line, line_num, filename, keyalgo, keyalgolen,
+			keyblob, keybloblen, &ses.authstate.pubkey_info);
+		if (ret == DROPBEAR_SUCCESS) {
+			break;
+		}
+
+		/* We continue to the next line otherwise */
+	} while (1);
+
+	buf_free(line);
+	return ret;
+}
+
+#if DROPBEAR_SVR_PUBKEY_INDEX
+/* The lines of authorized_keys are indexed by a hash of the key blob they
+ * contain, so each key offered by the client only needs the lines holding
+ * that key checked rather than every line decoded again. The index is kept
+ * for the session and rebuilt if the file changes. */
+struct authkeys_entry {
+	uint32_t hash;
+	unsigned int line; /* 0 based */
+	unsigned int next; /* entry index + 1, 0 at the end of a chain */
+};
+
+struct authkeys_index {
+	char *filename;
+	dev_t dev;
+	ino_t ino;
+	off_t size;
+	time_t mtime;
+	time_t ctime;
+
+	/* line contents as read by buf_getline(), concatenated */
+	buffer *lines;
+	/* num_lines+1 offsets into lines */
+	unsigned int *line_offsets;
+	unsigned int num_lines;
+
+	/* at most two per line */
+	struct authkeys_entry *entries;
+	unsigned int num_entries;
+	/* entry index + 1 of the first entry, chains are in line order */
+	unsigned int *buckets;
+	unsigned int bucket_mask;
+};
+
+static struct authkeys_index *authkeys_index = NULL;
+
+/* FNV-1a */
+static uint32_t authkeys_hash(const unsigned char *data, unsigned int len) {
+	uint32_t hash = 2166136261U;
+	unsigned int i;
+
+	for (i = 0; i < len; i++) {
+		hash ^= data[i];
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+static void authkeys_index_free(void) {
+	struct authkeys_index *idx = authkeys_index;
+
+	if (idx == NULL) {
+		return;
+	}
+	m_free(idx->filename);
+	buf_free(idx->lines);
+	m_free(idx->line_offsets);
+	m_free(idx->entries);
+	m_free(idx->buckets);
+	m_free(idx);
+	authkeys_index = NULL;
+}
+
+/* Length of the token at data, up to the next space */
+static unsigned int authkeys_token_len(const unsigned char *data, unsigned int len) {
+	const unsigned char *end = memchr(data, ' ', len);
+	return end ? (unsigned int)(end - data) : len;
+}
+
+/* Adds an entry for the base64 key following the key type at data[pos] */
+static void authkeys_index_add(struct authkeys_index *idx, unsigned int line_idx,
+		const unsigned char *data, unsigned int pos, unsigned int len) {
+	unsigned char blob[MAX_AUTHKEYS_LINE];
+	unsigned long bloblen = sizeof(blob);
+	struct authkeys_entry *entry = NULL;
+	unsigned int b64len;
+
+	pos += authkeys_token_len(&data[pos], len - pos);
+	if (pos >= len) {
+		return;
+	}
+	/* skip the space */
+	pos++;
+	b64len = authkeys_token_len(&data[pos], len - pos);
+	/* decoded the same way as cmp_base64_key() */
+	if (b64len == 0
+			|| base64_decode(&data[pos], b64len, blob, &bloblen) != CRYPT_OK) {
+		return;
+	}
+	entry = &idx->entries[idx->num_entries];
+	entry->hash = authkeys_hash(blob, bloblen);
+	entry->line = line_idx;
+	entry->next = 0;
+	idx->num_entries++;
+}
+
+/* Adds the keys that checkpubkey_line() could match on a line. The key
+ * type isn't known yet so both "type key" and "options type key" are
+ * tried. Lookups check candidate lines in full, so an entry for something
+ * that isn't really a key only costs a comparison. */
+static void authkeys_index_line(struct authkeys_index *idx, unsigned int line_idx) {
+	const unsigned char *data = &idx->lines->data[idx->line_offsets[line_idx]];
+	unsigned int len = idx->line_offsets[line_idx+1] - idx->line_offsets[line_idx];
+	unsigned int pos = 0;
+	int escape = 0, quoted = 0;
+
+	if (len < MIN_AUTHKEYS_LINE) {
+		return;
+	}
+
+	authkeys_index_add(idx, line_idx, data, 0, len);
+
+	/* skip whitespace, comments and options as checkpubkey_line() does */
+	while (pos < len && (data[pos] == ' ' || data[pos] == '\t')) {
+		pos++;
+	}
+	if (pos == len || data[pos] == '#') {
+		return;
+	}
+	while (pos < len) {
+		const unsigned char c = data[pos++];
+		if (!quoted && (c == ' ' || c == '\t')) {
+			break;
+		}
+		escape = (!escape && c == '\\');
+		if (!escape && c == '"') {
+			quoted = !quoted;
+		}
+	}
+	if (pos < len) {
+		authkeys_index_add(idx, line_idx, data, pos, len);
+	}
+}
+
+/* Reads authorized_keys and builds the index */
+static struct authkeys_index *authkeys_index_build(FILE *authfile,
+		const char *filename, const struct stat *st) {
+	struct authkeys_index *idx = m_malloc(sizeof(*idx));
+	buffer *line = buf_new(MAX_AUTHKEYS_LINE);
+	unsigned int max_lines = 64, nbuckets, i;
+
+	idx->filename = m_strdup(filename);
+	idx->dev = st->st_dev;
+	idx->ino = st->st_ino;
+	idx->size = st->st_size;
+	idx->mtime = st->st_mtime;
+	idx->ctime = st->st_ctime;
+
+	idx->lines = buf_new(st->st_size + 1);
+	idx->line_offsets = m_malloc((max_lines + 1) * sizeof(unsigned int));
+	idx->line_offsets[0] = 0;
+	idx->num_lines = 0;
+
+	while (buf_getline(line, authfile) == DROPBEAR_SUCCESS) {
+		if (idx->num_lines == max_lines) {
+			max_lines *= 2;
+			idx->line_offsets = m_realloc(idx->line_offsets,
+				(max_lines + 1) * sizeof(unsigned int));
+		}
+		if (idx->lines->size - idx->lines->len < line->len) {
+			/* the file grew while being read */
+			idx->lines = buf_resize(idx->lines, idx->lines->size * 2 + line->len);
+		}
+		buf_putbytes(idx->lines, line->data, line->len);
+		idx->num_lines++;
+		idx->line_offsets[idx->num_lines] = idx->lines->len;
+	}
+	buf_free(line);
+
+	idx->entries = m_malloc((idx->num_lines * 2 + 1) * sizeof(struct authkeys_entry));
+	idx->num_entries = 0;
+	for (i = 0; i < idx->num_lines; i++) {
+		authkeys_index_line(idx, i);
+	}
+
+	/* power of two, at least as many buckets as entries */
+	for (nbuckets = 16; nbuckets < idx->num_entries; nbuckets *= 2) {
+		/* nothing */
+	}
+	idx->buckets = m_malloc(nbuckets * sizeof(unsigned int));
+	idx->bucket_mask = nbuckets - 1;
+	/* insert in reverse so chains are in line order */
+	for (i = idx->num_entries; i > 0; i--) {
+		unsigned int *bucket = &idx->buckets[idx->entries[i-1].hash & idx->bucket_mask];
+		idx->entries[i-1].next = *bucket;
+		*bucket = i;
+	}
+
+	TRACE(("authkeys_index_build: %u lines, %u entries", idx->num_lines, idx->num_entries))
+	return idx;
+}
+
+/* Checks the lines of an opened authorized_keys file that contain the key,
+ * reusing the index from an earlier request if the file hasn't changed */
+static int checkpubkey_indexed(FILE *authfile, const char *filename,
+		const char* keyalgo, unsigned int keyalgolen,
+		const unsigned char* keyblob, unsigned int keybloblen) {
+	struct authkeys_index *idx = authkeys_index;
+	struct stat st;
+	buffer *line = NULL;
+	unsigned int e, last_line = UINT_MAX;
+	uint32_t hash;
+	int ret = DROPBEAR_FAILURE;
+
+	if (fstat(fileno(authfile), &st) != 0) {
+		TRACE(("checkpubkey_indexed: fstat failed: %s", strerror(errno)))
+		return DROPBEAR_FAILURE;
+	}
+	if (st.st_size > MAX_AUTHKEYS_INDEX_SIZE) {
+		return checkpubkey_scan(authfile, filename, keyalgo, keyalgolen,
+			keyblob, keybloblen);
+	}
+
+	if (idx == NULL
+			|| strcmp(idx->filename, filename) != 0
+			|| idx->dev != st.st_dev
+			|| idx->ino != st.st_ino
+			|| idx->size != st.st_size
+			|| idx->mtime != st.st_mtime
+			|| idx->ctime != st.st_ctime) {
+		authkeys_index_free();
+		idx = authkeys_index = authkeys_index_build(authfile, filename, &st);
+	}
+
+	line = buf_new(MAX_AUTHKEYS_LINE);
+	hash = authkeys_hash(keyblob, keybloblen);
+	for (e = idx->buckets[hash & idx->bucket_mask]; e != 0; e = idx->entries[e-1].next) {
+		const struct authkeys_entry *entry = &idx->entries[e-1];
+		unsigned int start, len;
+
+		if (entry->hash != hash || entry->line == last_line) {
+			continue;
+		}
+		last_line = entry->line;
+
+		start = idx->line_offsets[entry->line];
+		len = idx->line_offsets[entry->line+1] - start;
+		buf_setpos(line, 0);
+		buf_setlen(line, 0);
+		buf_putbytes(line, &idx->lines->data[start], len);
+		buf_setpos(line, 0);
+
+		ret = checkpubkey_line(line, entry->line + 1, filename, keyalgo, keyalgolen,
+			keyblob, keybloblen, &ses.authstate.pubkey_info);
+		if (ret == DROPBEAR_SUCCESS) {
+			break;
+		}
+	}
+	buf_free(line);
+
+	return ret;
+}
+#endif /* DROPBEAR_SVR_PUBKEY_INDEX */
+
 /* Checks whether a specified publickey (and associated algorithm) is an
  * acceptable key for authentication */
 /* Returns DROPBEAR_SUCCESS if key is ok for auth, DROPBEAR_FAILURE otherwise */
@@ -460,8 +755,6 @@ static int checkpubkey(const char* keyalgo, unsigned int keyalgolen,
 	FILE * authfile = NULL;
 	char * filename = NULL;
 	int ret = DROPBEAR_FAILURE;
-	buffer * line = NULL;
-	int line_num;
 	uid_t origuid;
 	gid_t origgid;
 
@@ -500,34 +793,18 @@ static int checkpubkey(const char* keyalgo, unsigned int keyalgolen,
 	}
 	TRACE(("checkpubkey: opened authorized_keys OK"))
 
-	line = buf_new(MAX_AUTHKEYS_LINE);
-	line_num = 0;
-
-	/* iterate through the lines */
-	do {
-		if (buf_getline(line, authfile) == DROPBEAR_FAILURE) {
-			/* EOF reached */
-			TRACE(("checkpubkey: authorized_keys EOF reached"))
-			break;
-		}
-		line_num++;
-
-		ret = checkpubkey_line(line, line_num, filename, keyalgo, keyalgolen,
-			keyblob, keybloblen, &ses.authstate.pubkey_info);
-		if (ret == DROPBEAR_SUCCESS) {
-			break;
-		}
-
-		/* We continue to the next line otherwise */
-	} while (1);
+#if DROPBEAR_SVR_PUBKEY_INDEX
+	ret = checkpubkey_indexed(authfile, filename, keyalgo, keyalgolen,
+		keyblob, keybloblen);
+#else
+	ret = checkpubkey_scan(authfile, filename, keyalgo, keyalgolen,
+		keyblob, keybloblen);
+#endif
 
 out:
 	if (authfile) {
 		fclose(authfile);
 	}
-	if (line) {
-		buf_free(line);
-	}
 	m_free(filename);
 	TRACE(("leave checkpubkey: ret=%d", ret))
 	return ret;
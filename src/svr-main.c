@@ -30,14 +30,22 @@
 #include "runopts.h"
 #include "dbrandom.h"
 #include "crypto_desc.h"
+#include "metrics.h"
 
 static size_t listensockets(int *sock, size_t sockcount, int *maxfd);
 static void sigchld_handler(int dummy);
 static void sigsegv_handler(int);
 static void sigintterm_handler(int fish);
+#if DROPBEAR_METRICS && NON_INETD_MODE
+static void sigusr1_handler(int dummy);
+static volatile sig_atomic_t metrics_dump_pending;
+#endif
 static void main_inetd(void);
 static void main_noinetd(int argc, char ** argv, const char* multipath);
 static void commonsetup(void);
+#if NON_INETD_MODE
+static void prefork_worker_run(int workersock, int childpipe);
+#endif
 
 #if defined(DBMULTI_dropbear) || !DROPBEAR_MULTI
 #if defined(DBMULTI_dropbear) && DROPBEAR_MULTI
@@ -72,6 +80,11 @@ int main(int argc, char ** argv)
 
 #if DROPBEAR_DO_REEXEC
 	if (svr_opts.reexec_childpipe >= 0) {
+#if DROPBEAR_METRICS
+		if (svr_opts.reexec_metricsfd >= 0) {
+			metrics_shared_attach(svr_opts.reexec_metricsfd);
+		}
+#endif
 #ifdef PR_SET_NAME
 		/* Fix the "Name:" in /proc/pid/status, otherwise it's
 		a FD number from fexecve.
@@ -115,6 +128,13 @@ static void main_inetd() {
 		setsid();
 	}
 
+#if NON_INETD_MODE
+	if (svr_opts.reexec_workersock >= 0) {
+		prefork_worker_run(svr_opts.reexec_workersock, svr_opts.reexec_childpipe);
+		/* notreached */
+	}
+#endif
+
 	/* -1 for childpipe in the inetd case is discarded */
 	svr_session(0, svr_opts.reexec_childpipe);
 
@@ -122,10 +142,454 @@ static void main_inetd() {
 }
 #endif /* INETD_MODE */
 
+#if NON_INETD_MODE
+/* Processes started ahead of connections, with -N. The listening process
+ * passes each accepted socket to a waiting worker over a unix socket, the
+ * worker's childpipe then takes the place of a newly forked child's */
+struct prefork_worker {
+	int workersock; /* -1 for an empty slot */
+	int childpipe;
+};
+
+static struct prefork_worker prefork_workers[MAX_UNAUTH_CLIENTS];
+/* Empty slots aren't refilled before this time, if workers were exiting
+ * without a connection */
+static time_t prefork_pause_until;
+
+/* With -L, the first listener holds the write end of a pipe that the
+ * other listeners watch, so that they exit with it */
+static int listener_pipe = -1;
+static int listener_sibling;
+
+/* Unauthenticated connections are counted by remote address in a hash
+ * table, so that checking MAX_UNAUTH_PER_IP doesn't compare against every
+ * connection */
+struct unauth_addr {
+	unsigned char addr[16];
+	unsigned int addrlen;
+	unsigned int count;
+	struct unauth_addr *next;
+};
+
+static struct unauth_addr *unauth_buckets[UNAUTH_ADDR_BUCKETS];
+/* random, so that remote hosts can't choose colliding addresses */
+static uint32_t unauth_hash_seed;
+
+static time_t next_reseed;
+
+#if DROPBEAR_DO_REEXEC
+/* Adds "-2 childpipe", "-3 workersock" if workersock >= 0 and "-4 metricsfd"
+ * if there are shared metrics to the arguments and re-executes. Only
+ * returns if fexecve() fails */
+static void reexec_self(int execfd, int argc, char ** argv, const char* multipath,
+		int childpipe, int workersock) {
+	char **new_argv = m_malloc(sizeof(char*) * (argc+8));
+	char pipebuf[12], sockbuf[12];
+#if DROPBEAR_METRICS
+	char metricsbuf[12];
+	int metricsfd = metrics_shared_fd();
+#endif
+	int pos0 = 0, new_argc = argc+2;
+
+	/* We need to specially handle "dropbearmulti dropbear". */
+	if (multipath) {
+		new_argv[0] = (char*)multipath;
+		pos0 = 1;
+		new_argc++;
+	}
+
+	memcpy(&new_argv[pos0], argv, sizeof(char*) * argc);
+	new_argv[new_argc-2] = "-2";
+	snprintf(pipebuf, sizeof(pipebuf), "%d", childpipe);
+	new_argv[new_argc-1] = pipebuf;
+	if (workersock >= 0) {
+		new_argv[new_argc++] = "-3";
+		snprintf(sockbuf, sizeof(sockbuf), "%d", workersock);
+		new_argv[new_argc++] = sockbuf;
+	}
+#if DROPBEAR_METRICS
+	/* it is close-on-exec so user processes don't get it */
+	if (metricsfd >= 0 && fcntl(metricsfd, F_SETFD, 0) == 0) {
+		new_argv[new_argc++] = "-4";
+		snprintf(metricsbuf, sizeof(metricsbuf), "%d", metricsfd);
+		new_argv[new_argc++] = metricsbuf;
+	}
+#endif
+	new_argv[new_argc] = NULL;
+
+	/* Re-execute ourself */
+	fexecve(execfd, new_argv, environ);
+	/* Not reached on success */
+
+	/* Fall back on plain fork otherwise.
+	 * To be removed in future once re-exec has been well tested */
+	dropbear_log(LOG_WARNING, "fexecve failed, disabling re-exec: %s", strerror(errno));
+	m_free(new_argv);
+}
+#endif /* DROPBEAR_DO_REEXEC */
+
+/* Returns 0 on success */
+static int send_fd(int sock, int fd) {
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg = NULL;
+	union {
+		struct cmsghdr hdr;
+		char buf[CMSG_SPACE(sizeof(int))];
+	} control;
+	char byte = 0;
+
+	memset(&msg, 0x0, sizeof(msg));
+	memset(&control, 0x0, sizeof(control));
+	iov.iov_base = &byte;
+	iov.iov_len = 1;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof(control.buf);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+	memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+	return sendmsg(sock, &msg, 0) == 1 ? 0 : -1;
+}
+
+/* Returns the received fd, or -1 on failure or if the sender closed */
+static int recv_fd(int sock) {
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg = NULL;
+	union {
+		struct cmsghdr hdr;
+		char buf[CMSG_SPACE(sizeof(int))];
+	} control;
+	char byte;
+	int fd = -1;
+	ssize_t len;
+
+	memset(&msg, 0x0, sizeof(msg));
+	iov.iov_base = &byte;
+	iov.iov_len = 1;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof(control.buf);
+
+	do {
+		len = recvmsg(sock, &msg, 0);
+	} while (len < 0 && errno == EINTR && !ses.exitflag);
+	if (len != 1) {
+		return -1;
+	}
+	cmsg = CMSG_FIRSTHDR(&msg);
+	if (cmsg == NULL
+			|| cmsg->cmsg_level != SOL_SOCKET
+			|| cmsg->cmsg_type != SCM_RIGHTS
+			|| cmsg->cmsg_len != CMSG_LEN(sizeof(int))) {
+		return -1;
+	}
+	memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+	return fd;
+}
+
+/* Waits for a connection from the listening process then runs the
+ * session. Exits if the listening process has gone away. */
+static void prefork_worker_run(int workersock, int childpipe) {
+	char *host = NULL, *port = NULL;
+	int sock;
+
+	sock = recv_fd(workersock);
+	if (sock < 0) {
+		exit(EXIT_SUCCESS);
+	}
+	m_close(workersock);
+
+	get_socket_address(sock, NULL, NULL, &host, &port, 0);
+	dropbear_log(LOG_INFO, "Child connection from %s:%s", host, port);
+	m_free(host);
+	m_free(port);
+
+	svr_session(sock, childpipe);
+	/* notreached */
+}
+
+/* For a forked child, so that workers see the listening process exit */
+static void prefork_close_all(void) {
+	unsigned int i;
+
+	for (i = 0; i < svr_opts.prefork_workers; i++) {
+		if (prefork_workers[i].workersock >= 0) {
+			m_close(prefork_workers[i].workersock);
+			m_close(prefork_workers[i].childpipe);
+			prefork_workers[i].workersock = -1;
+		}
+	}
+}
+
+/* Closes the listener's fds in a forked child */
+static void listener_close_all(const int *listensocks, size_t listensockcount) {
+	unsigned int i;
+
+	for (i = 0; i < listensockcount; i++) {
+		m_close(listensocks[i]);
+	}
+	prefork_close_all();
+	if (listener_pipe >= 0) {
+		m_close(listener_pipe);
+		listener_pipe = -1;
+	}
+}
+
+/* Seeding reads many files, so the listener only does it occasionally.
+ * A forked child adds fresh entropy itself before using its pool */
+static void listener_reseed(void) {
+	time_t now = monotonic_now();
+
+	if (now >= next_reseed) {
+		seedrandom();
+		next_reseed = now + LISTENER_RESEED_INTERVAL;
+	}
+}
+
+static void prefork_spawn(struct prefork_worker *worker,
+		const int *listensocks, size_t listensockcount,
+		int execfd, int argc, char ** argv, const char* multipath) {
+	int sockpair[2], childpipe[2];
+	pid_t fork_ret;
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockpair) < 0) {
+		TRACE(("prefork socketpair failed: %s", strerror(errno)))
+		return;
+	}
+	if (pipe(childpipe) < 0) {
+		TRACE(("prefork pipe failed: %s", strerror(errno)))
+		m_close(sockpair[0]);
+		m_close(sockpair[1]);
+		return;
+	}
+
+	listener_reseed();
+	fork_ret = fork();
+	if (fork_ret < 0) {
+		dropbear_log(LOG_WARNING, "Error forking: %s", strerror(errno));
+		m_close(sockpair[0]);
+		m_close(sockpair[1]);
+		m_close(childpipe[0]);
+		m_close(childpipe[1]);
+		return;
+	}
+	addrandom((void*)&fork_ret, sizeof(fork_ret));
+
+	if (fork_ret > 0) {
+		/* parent */
+		m_close(sockpair[1]);
+		m_close(childpipe[1]);
+		setnonblocking(sockpair[0]);
+		worker->workersock = sockpair[0];
+		worker->childpipe = childpipe[0];
+		return;
+	}
+
+	/* child */
+	if (setsid() < 0) {
+		dropbear_exit("setsid: %s", strerror(errno));
+	}
+	listener_close_all(listensocks, listensockcount);
+	m_close(sockpair[0]);
+	m_close(childpipe[0]);
+
+#if DROPBEAR_DO_REEXEC
+	if (execfd >= 0) {
+		reexec_self(execfd, argc, argv, multipath, childpipe[1], sockpair[1]);
+	}
+#else
+	(void)execfd;
+	(void)argc;
+	(void)argv;
+	(void)multipath;
+#endif
+	prefork_worker_run(sockpair[1], childpipe[1]);
+	/* notreached */
+}
+
+/* Starts workers for any empty slots */
+static void prefork_fill(const int *listensocks, size_t listensockcount,
+		int execfd, int argc, char ** argv, const char* multipath) {
+	unsigned int i;
+
+	if (monotonic_now() < prefork_pause_until) {
+		return;
+	}
+	for (i = 0; i < svr_opts.prefork_workers; i++) {
+		if (prefork_workers[i].workersock < 0) {
+			prefork_spawn(&prefork_workers[i], listensocks, listensockcount,
+				execfd, argc, argv, multipath);
+		}
+	}
+}
+
+/* Passes a connection to a waiting worker. Returns the worker's childpipe
+ * or -1 if none could take it */
+static int prefork_handoff(int childsock) {
+	unsigned int i;
+	int childpipe;
+
+	for (i = 0; i < svr_opts.prefork_workers; i++) {
+		struct prefork_worker *worker = &prefork_workers[i];
+		if (worker->workersock < 0) {
+			continue;
+		}
+		childpipe = worker->childpipe;
+		if (send_fd(worker->workersock, childsock) < 0) {
+			TRACE(("prefork send failed: %s", strerror(errno)))
+			m_close(childpipe);
+			childpipe = -1;
+		}
+		m_close(worker->workersock);
+		worker->workersock = -1;
+		if (childpipe >= 0) {
+			return childpipe;
+		}
+	}
+	return -1;
+}
+
+/* The key is the address without the port. Other families share an
+ * empty key */
+static unsigned int unauth_addr_key(const struct sockaddr_storage *addr,
+		unsigned char *key) {
+	if (addr->ss_family == AF_INET) {
+		memcpy(key, &((const struct sockaddr_in*)addr)->sin_addr, 4);
+		return 4;
+	}
+	if (addr->ss_family == AF_INET6) {
+		memcpy(key, &((const struct sockaddr_in6*)addr)->sin6_addr, 16);
+		return 16;
+	}
+	return 0;
+}
+
+static struct unauth_addr** unauth_bucket(const unsigned char *key,
+		unsigned int keylen) {
+	/* FNV-1a */
+	uint32_t h = 2166136261U ^ unauth_hash_seed;
+	unsigned int i;
+
+	for (i = 0; i < keylen; i++) {
+		h ^= key[i];
+		h *= 16777619U;
+	}
+	return &unauth_buckets[h & (UNAUTH_ADDR_BUCKETS - 1)];
+}
+
+/* Returns the entry counting connections from addr, which is new with
+ * a count of 0 if there are none */
+static struct unauth_addr* unauth_lookup(const struct sockaddr_storage *addr) {
+	unsigned char key[16];
+	unsigned int keylen;
+	struct unauth_addr **bucket, *ua;
+
+	keylen = unauth_addr_key(addr, key);
+	bucket = unauth_bucket(key, keylen);
+	for (ua = *bucket; ua; ua = ua->next) {
+		if (ua->addrlen == keylen && memcmp(ua->addr, key, keylen) == 0) {
+			return ua;
+		}
+	}
+
+	ua = m_malloc(sizeof(*ua));
+	memcpy(ua->addr, key, keylen);
+	ua->addrlen = keylen;
+	ua->next = *bucket;
+	*bucket = ua;
+	return ua;
+}
+
+/* Drops a connection from the entry's count, removing it at zero */
+static void unauth_release(struct unauth_addr *ua) {
+	struct unauth_addr **prev;
+
+	if (ua->count > 0) {
+		ua->count--;
+	}
+	if (ua->count > 0) {
+		return;
+	}
+	for (prev = unauth_bucket(ua->addr, ua->addrlen); *prev; prev = &(*prev)->next) {
+		if (*prev == ua) {
+			*prev = ua->next;
+			break;
+		}
+	}
+	m_free(ua);
+}
+
+/* Accepted sockets are close-on-exec and non-blocking where possible,
+ * saving a session from setting them */
+static int accept_conn(int listensock, struct sockaddr_storage *addr,
+		socklen_t *addrlen) {
+#ifdef HAVE_ACCEPT4
+	int sock;
+
+	sock = accept4(listensock, (struct sockaddr*)addr, addrlen,
+			SOCK_CLOEXEC|SOCK_NONBLOCK);
+	if (sock >= 0 || errno != ENOSYS) {
+		return sock;
+	}
+#endif
+	return accept(listensock, (struct sockaddr*)addr, addrlen);
+}
+
+/* Starts the other listening processes for -L. Where SO_REUSEPORT is
+ * available each opens its own listening sockets, otherwise they share
+ * the first's. Returns 1 in the new processes */
+static int listener_spawn(int *listensocks, size_t *listensockcount, int *maxsock) {
+	int lpipe[2];
+	unsigned int i;
+	pid_t fork_ret;
+
+	if (pipe(lpipe) < 0) {
+		dropbear_exit("Error creating pipe: %s", strerror(errno));
+	}
+	/* not for re-executed sessions */
+	fcntl(lpipe[0], F_SETFD, FD_CLOEXEC);
+	fcntl(lpipe[1], F_SETFD, FD_CLOEXEC);
+
+	for (i = 1; i < svr_opts.listeners; i++) {
+		fork_ret = fork();
+		if (fork_ret < 0) {
+			dropbear_log(LOG_WARNING, "Error forking: %s", strerror(errno));
+			break;
+		}
+		if (fork_ret == 0) {
+			m_close(lpipe[1]);
+			listener_pipe = lpipe[0];
+			*maxsock = MAX(*maxsock, listener_pipe);
+#ifdef SO_REUSEPORT
+			for (i = 0; i < *listensockcount; i++) {
+				m_close(listensocks[i]);
+			}
+			*listensockcount = listensockets(listensocks, MAX_LISTEN_ADDR, maxsock);
+			if (*listensockcount == 0) {
+				dropbear_exit("No listening ports available.");
+			}
+#endif
+			return 1;
+		}
+	}
+
+	m_close(lpipe[0]);
+	listener_pipe = lpipe[1];
+	return 0;
+}
+#endif /* NON_INETD_MODE */
+
 #if NON_INETD_MODE
 static void main_noinetd(int argc, char ** argv, const char* multipath) {
 	fd_set fds;
-	unsigned int i, j;
+	unsigned int i, n;
 	int val;
 	int maxsock = -1;
 	int listensocks[MAX_LISTEN_ADDR];
@@ -134,10 +598,15 @@ static void main_noinetd(int argc, char ** argv, const char* multipath) {
 	int execfd = -1;
 
 	int childpipes[MAX_UNAUTH_CLIENTS];
-	char * preauth_addrs[MAX_UNAUTH_CLIENTS];
+	struct unauth_addr * preauth_addrs[MAX_UNAUTH_CLIENTS];
+	/* stack of unused childpipes[] slots */
+	unsigned int free_slots[MAX_UNAUTH_CLIENTS];
+	unsigned int num_free_slots;
 
 	int childsock;
 	int childpipe[2];
+	time_t timeout;
+	struct timeval tv;
 
 	(void)argc;
 	(void)argv;
@@ -148,11 +617,27 @@ static void main_noinetd(int argc, char ** argv, const char* multipath) {
 	   hostkeys. */
 	commonsetup();
 
+#if DROPBEAR_METRICS
+	/* sessions add up their metrics for the listener to report */
+	metrics_shared_init();
+	if (signal(SIGUSR1, sigusr1_handler) == SIG_ERR) {
+		dropbear_exit("signal() error");
+	}
+#endif
+
 	/* sockets to identify pre-authenticated clients */
 	for (i = 0; i < MAX_UNAUTH_CLIENTS; i++) {
 		childpipes[i] = -1;
+		free_slots[i] = MAX_UNAUTH_CLIENTS - 1 - i;
 	}
+	num_free_slots = MAX_UNAUTH_CLIENTS;
 	memset(preauth_addrs, 0x0, sizeof(preauth_addrs));
+	for (i = 0; i < MAX_UNAUTH_CLIENTS; i++) {
+		prefork_workers[i].workersock = -1;
+	}
+#if DEBUG_NOFORK
+	svr_opts.prefork_workers = 0;
+#endif
 
 	/* Set up the listening sockets */
 	listensockcount = listensockets(listensocks, MAX_LISTEN_ADDR, &maxsock);
@@ -204,9 +689,18 @@ static void main_noinetd(int argc, char ** argv, const char* multipath) {
 		fclose(pidfile);
 	}
 
+	if (svr_opts.listeners > 1) {
+		listener_sibling = listener_spawn(listensocks, &listensockcount, &maxsock);
+	}
+
+	listener_reseed();
+	genrandom((void*)&unauth_hash_seed, sizeof(unauth_hash_seed));
+
 	/* incoming connection select loop */
 	for(;;) {
 
+		prefork_fill(listensocks, listensockcount, execfd, argc, argv, multipath);
+
 		DROPBEAR_FD_ZERO(&fds);
 
 		/* listening sockets */
@@ -214,6 +708,10 @@ static void main_noinetd(int argc, char ** argv, const char* multipath) {
 			FD_SET(listensocks[i], &fds);
 		}
 
+		if (listener_sibling) {
+			FD_SET(listener_pipe, &fds);
+		}
+
 		/* pre-authentication clients */
 		for (i = 0; i < MAX_UNAUTH_CLIENTS; i++) {
 			if (childpipes[i] >= 0) {
@@ -222,13 +720,36 @@ static void main_noinetd(int argc, char ** argv, const char* multipath) {
 			}
 		}
 
-		val = select(maxsock+1, &fds, NULL, NULL, NULL);
+		/* waiting workers, which only close their pipe on exiting */
+		timeout = 0;
+		for (i = 0; i < svr_opts.prefork_workers; i++) {
+			if (prefork_workers[i].workersock >= 0) {
+				FD_SET(prefork_workers[i].childpipe, &fds);
+				maxsock = MAX(maxsock, prefork_workers[i].childpipe);
+			} else {
+				/* refill once the pause is over */
+				timeout = 1;
+			}
+		}
+
+		tv.tv_sec = timeout;
+		tv.tv_usec = 0;
+		val = select(maxsock+1, &fds, NULL, NULL, timeout ? &tv : NULL);
 
 		if (ses.exitflag) {
-			unlink(svr_opts.pidfile);
+			if (!listener_sibling) {
+				unlink(svr_opts.pidfile);
+			}
 			dropbear_close("Terminated by signal");
 		}
 
+#if DROPBEAR_METRICS
+		if (metrics_dump_pending) {
+			metrics_dump_pending = 0;
+			metrics_dump(DROPBEAR_METRICS_FILE);
+		}
+#endif
+
 		if (val == 0) {
 			/* timeout reached - shouldn't happen. eh */
 			continue;
@@ -241,157 +762,153 @@ static void main_noinetd(int argc, char ** argv, const char* multipath) {
 			dropbear_exit("Listening socket error");
 		}
 
+		if (listener_sibling && FD_ISSET(listener_pipe, &fds)) {
+			/* the first listener has exited */
+			exit(EXIT_SUCCESS);
+		}
+
 		/* close fds which have been authed or closed - svr-auth.c handles
 		 * closing the auth sockets on success */
 		for (i = 0; i < MAX_UNAUTH_CLIENTS; i++) {
 			if (childpipes[i] >= 0 && FD_ISSET(childpipes[i], &fds)) {
 				m_close(childpipes[i]);
 				childpipes[i] = -1;
-				m_free(preauth_addrs[i]);
+				unauth_release(preauth_addrs[i]);
+				preauth_addrs[i] = NULL;
+				free_slots[num_free_slots++] = i;
+			}
+		}
+
+		for (i = 0; i < svr_opts.prefork_workers; i++) {
+			if (prefork_workers[i].workersock >= 0
+					&& FD_ISSET(prefork_workers[i].childpipe, &fds)) {
+				/* exited without a connection, probably failed to start.
+				 * Don't replace it straight away */
+				dropbear_log(LOG_WARNING, "Prestarted server process exited");
+				m_close(prefork_workers[i].workersock);
+				m_close(prefork_workers[i].childpipe);
+				prefork_workers[i].workersock = -1;
+				prefork_pause_until = monotonic_now() + 1;
 			}
 		}
 
 		/* handle each socket which has something to say */
 		for (i = 0; i < listensockcount; i++) {
-			size_t num_unauthed_for_addr = 0;
-			size_t num_unauthed_total = 0;
-			char *remote_host = NULL, *remote_port = NULL;
-			pid_t fork_ret = 0;
-			size_t conn_idx = 0;
-			struct sockaddr_storage remoteaddr;
-			socklen_t remoteaddrlen;
-
-			if (!FD_ISSET(listensocks[i], &fds))
-				continue;
-
-			remoteaddrlen = sizeof(remoteaddr);
-			childsock = accept(listensocks[i],
-					(struct sockaddr*)&remoteaddr, &remoteaddrlen);
-
-			if (childsock < 0) {
-				/* accept failed */
+			if (!FD_ISSET(listensocks[i], &fds)) {
 				continue;
 			}
 
-			/* Limit the number of unauthenticated connections per IP */
-			getaddrstring(&remoteaddr, &remote_host, NULL, 0);
+			/* take what is waiting, up to a limit so that the other
+			 * sockets get a turn */
+			for (n = 0; n < DROPBEAR_ACCEPT_BATCH; n++) {
+				struct unauth_addr *ua = NULL;
+				char *remote_host = NULL, *remote_port = NULL;
+				pid_t fork_ret = 0;
+				size_t conn_idx = 0;
+				struct sockaddr_storage remoteaddr;
+				socklen_t remoteaddrlen;
+
+				remoteaddrlen = sizeof(remoteaddr);
+				childsock = accept_conn(listensocks[i], &remoteaddr, &remoteaddrlen);
+
+				if (childsock < 0) {
+					/* nothing more waiting, or accept failed */
+					break;
+				}
 
-			num_unauthed_for_addr = 0;
-			num_unauthed_total = 0;
-			for (j = 0; j < MAX_UNAUTH_CLIENTS; j++) {
-				if (childpipes[j] >= 0) {
-					num_unauthed_total++;
-					if (strcmp(remote_host, preauth_addrs[j]) == 0) {
-						num_unauthed_for_addr++;
-					}
-				} else {
-					/* a free slot */
-					conn_idx = j;
+				/* Limit the number of unauthenticated connections per IP */
+				if (num_free_slots == 0) {
+					goto out;
 				}
-			}
+				ua = unauth_lookup(&remoteaddr);
+				if (ua->count >= MAX_UNAUTH_PER_IP) {
+					goto out;
+				}
+				conn_idx = free_slots[num_free_slots-1];
 
-			if (num_unauthed_total >= MAX_UNAUTH_CLIENTS
-					|| num_unauthed_for_addr >= MAX_UNAUTH_PER_IP) {
-				goto out;
-			}
+				childpipes[conn_idx] = prefork_handoff(childsock);
+				if (childpipes[conn_idx] >= 0) {
+					goto used_slot;
+				}
 
-			seedrandom();
+				listener_reseed();
 
-			if (pipe(childpipe) < 0) {
-				TRACE(("error creating child pipe"))
-				goto out;
-			}
+				if (pipe(childpipe) < 0) {
+					TRACE(("error creating child pipe"))
+					goto out;
+				}
 
 #if DEBUG_NOFORK
-			fork_ret = 0;
+				fork_ret = 0;
 #else
-			fork_ret = fork();
+				fork_ret = fork();
 #endif
-			if (fork_ret < 0) {
-				dropbear_log(LOG_WARNING, "Error forking: %s", strerror(errno));
-				goto out;
-			}
+				if (fork_ret < 0) {
+					dropbear_log(LOG_WARNING, "Error forking: %s", strerror(errno));
+					m_close(childpipe[0]);
+					m_close(childpipe[1]);
+					goto out;
+				}
 
-			addrandom((void*)&fork_ret, sizeof(fork_ret));
+				addrandom((void*)&fork_ret, sizeof(fork_ret));
 
-			if (fork_ret > 0) {
+				if (fork_ret > 0) {
 
-				/* parent */
-				childpipes[conn_idx] = childpipe[0];
-				m_close(childpipe[1]);
-				preauth_addrs[conn_idx] = remote_host;
-				remote_host = NULL;
+					/* parent */
+					childpipes[conn_idx] = childpipe[0];
+					m_close(childpipe[1]);
+					goto used_slot;
 
-			} else {
+				} else {
 
-				/* child */
-				getaddrstring(&remoteaddr, NULL, &remote_port, 0);
-				dropbear_log(LOG_INFO, "Child connection from %s:%s", remote_host, remote_port);
-				m_free(remote_host);
-				m_free(remote_port);
+					/* child */
+					getaddrstring(&remoteaddr, &remote_host, &remote_port, 0);
+					dropbear_log(LOG_INFO, "Child connection from %s:%s", remote_host, remote_port);
+					m_free(remote_host);
+					m_free(remote_port);
 
 #if !DEBUG_NOFORK
-				if (setsid() < 0) {
-					dropbear_exit("setsid: %s", strerror(errno));
-				}
+					if (setsid() < 0) {
+						dropbear_exit("setsid: %s", strerror(errno));
+					}
 #endif
 
-				/* make sure we close sockets */
-				for (j = 0; j < listensockcount; j++) {
-					m_close(listensocks[j]);
-				}
+					/* make sure we close sockets */
+					listener_close_all(listensocks, listensockcount);
 
-				m_close(childpipe[0]);
+					m_close(childpipe[0]);
 
-				if (execfd >= 0) {
+					if (execfd >= 0) {
 #if DROPBEAR_DO_REEXEC
-					/* Add "-2 childpipe[1]" to the args and re-execute ourself. */
-					char **new_argv = m_malloc(sizeof(char*) * (argc+4));
-					char buf[10];
-					int pos0 = 0, new_argc = argc+2;
-
-					/* We need to specially handle "dropbearmulti dropbear". */
-					if (multipath) {
-						new_argv[0] = (char*)multipath;
-						pos0 = 1;
-						new_argc++;
+						if ((dup2(childsock, STDIN_FILENO) < 0)) {
+							dropbear_exit("dup2 failed: %s", strerror(errno));
+						}
+						if (fcntl(childsock, F_SETFD, FD_CLOEXEC) < 0) {
+							TRACE(("cloexec for childsock %d failed: %s", childsock, strerror(errno)))
+						}
+						reexec_self(execfd, argc, argv, multipath, childpipe[1], -1);
+						m_close(STDIN_FILENO);
+#endif /* DROPBEAR_DO_REEXEC */
 					}
 
-					memcpy(&new_argv[pos0], argv, sizeof(char*) * argc);
-					new_argv[new_argc-2] = "-2";
-					snprintf(buf, sizeof(buf), "%d", childpipe[1]);
-					new_argv[new_argc-1] = buf;
-					new_argv[new_argc] = NULL;
-
-					if ((dup2(childsock, STDIN_FILENO) < 0)) {
-						dropbear_exit("dup2 failed: %s", strerror(errno));
-					}
-					if (fcntl(childsock, F_SETFD, FD_CLOEXEC) < 0) {
-						TRACE(("cloexec for childsock %d failed: %s", childsock, strerror(errno)))
-					}
-					/* Re-execute ourself */
-					fexecve(execfd, new_argv, environ);
-					/* Not reached on success */
-
-					/* Fall back on plain fork otherwise.
-					 * To be removed in future once re-exec has been well tested */
-					dropbear_log(LOG_WARNING, "fexecve failed, disabling re-exec: %s", strerror(errno));
-					m_close(STDIN_FILENO);
-					m_free(new_argv);
-#endif /* DROPBEAR_DO_REEXEC */
+					/* start the session */
+					svr_session(childsock, childpipe[1]);
+					/* don't return */
+					dropbear_assert(0);
 				}
 
-				/* start the session */
-				svr_session(childsock, childpipe[1]);
-				/* don't return */
-				dropbear_assert(0);
-			}
+used_slot:
+				num_free_slots--;
+				ua->count++;
+				preauth_addrs[conn_idx] = ua;
+				ua = NULL;
 
 out:
-			/* This section is important for the parent too */
-			m_close(childsock);
-			if (remote_host) {
-				m_free(remote_host);
+				/* This section is important for the parent too */
+				m_close(childsock);
+				if (ua && ua->count == 0) {
+					unauth_release(ua);
+				}
 			}
 		}
 	} /* for(;;) loop */
@@ -435,6 +952,14 @@ static void sigintterm_handler(int UNUSED(unused)) {
 	ses.exitflag = 1;
 }
 
+#if DROPBEAR_METRICS && NON_INETD_MODE
+/* the listener writes out metrics on SIGUSR1 */
+static void sigusr1_handler(int UNUSED(unused)) {
+
+	metrics_dump_pending = 1;
+}
+#endif
+
 /* Things used by inetd and non-inetd modes */
 static void commonsetup() {
 
@@ -488,7 +1013,7 @@ static size_t listensockets(int *socks, size_t sockcount, int *maxfd) {
 
 		nsock = dropbear_listen(svr_opts.addresses[i], svr_opts.ports[i], &socks[sockpos],
 				sockcount - sockpos,
-				&errstring, maxfd, svr_opts.interface);
+				&errstring, maxfd, svr_opts.interface, svr_opts.listeners > 1);
 
 		if (nsock < 0) {
 			dropbear_log(LOG_WARNING, "Failed listening on '%s': %s",
@@ -499,6 +1024,8 @@ static size_t listensockets(int *socks, size_t sockcount, int *maxfd) {
 
 		for (n = 0; n < (unsigned int)nsock; n++) {
 			int sock = socks[sockpos + n];
+			/* connections are accepted until there are no more */
+			setnonblocking(sock);
 			set_sock_priority(sock, DROPBEAR_PRIO_LOWDELAY);
 #if DROPBEAR_SERVER_TCP_FAST_OPEN
 			set_listen_fast_open(sock);
@@ -108,6 +108,10 @@ static void printhelp(const char * progname) {
 #endif
 #if INETD_MODE
 					"-i		Start for inetd\n"
+#endif
+#if NON_INETD_MODE
+					"-N <workers>	Processes started ahead of connections (default %d, max %d)\n"
+					"-L <listeners>	Processes accepting connections (default %d, max %d)\n"
 #endif
 					"-W <receive_window_buffer> (default %d, larger may be faster, max 10MB)\n"
 					"-K <keepalive>  (0 is never, default %d, in seconds)\n"
@@ -136,6 +140,10 @@ static void printhelp(const char * progname) {
 #endif
 					MAX_AUTH_TRIES,
 					DROPBEAR_MAX_PORTS, DROPBEAR_DEFPORT, DROPBEAR_PIDFILE,
+#if NON_INETD_MODE
+					DEFAULT_PREFORK_WORKERS, MAX_UNAUTH_CLIENTS,
+					DEFAULT_LISTENERS, MAX_LISTEN_PROCESSES,
+#endif
 					DEFAULT_RECV_WINDOW, DEFAULT_KEEPALIVE, DEFAULT_IDLE_TIMEOUT);
 }
 
@@ -149,6 +157,10 @@ void svr_getopts(int argc, char ** argv) {
 	char* idle_timeout_arg = NULL;
 	char* maxauthtries_arg = NULL;
 	char* reexec_fd_arg = NULL;
+	char* reexec_workersock_arg = NULL;
+	char* reexec_metricsfd_arg = NULL;
+	char* prefork_arg = NULL;
+	char* listeners_arg = NULL;
 	char* keyfile = NULL;
 	char c;
 #if DROPBEAR_PLUGIN
@@ -189,6 +201,10 @@ void svr_getopts(int argc, char ** argv) {
 #endif
 	svr_opts.pass_on_env = 0;
 	svr_opts.reexec_childpipe = -1;
+	svr_opts.reexec_workersock = -1;
+	svr_opts.reexec_metricsfd = -1;
+	svr_opts.prefork_workers = DEFAULT_PREFORK_WORKERS;
+	svr_opts.listeners = DEFAULT_LISTENERS;
 
 #ifndef DISABLE_ZLIB
 	opts.allow_compress = 1;
@@ -272,6 +288,20 @@ void svr_getopts(int argc, char ** argv) {
 				case '2':
 					next = &reexec_fd_arg;
 					break;
+				case '3':
+					next = &reexec_workersock_arg;
+					break;
+				case '4':
+					next = &reexec_metricsfd_arg;
+					break;
+#endif
+#if NON_INETD_MODE
+				case 'N':
+					next = &prefork_arg;
+					break;
+				case 'L':
+					next = &listeners_arg;
+					break;
 #endif
 				case 'p':
 					nextisport = 1;
@@ -451,6 +481,33 @@ void svr_getopts(int argc, char ** argv) {
 			dropbear_exit("Bad -2");
 		}
 	}
+	if (reexec_workersock_arg) {
+		if (m_str_to_uint(reexec_workersock_arg, &svr_opts.reexec_workersock) == DROPBEAR_FAILURE
+			|| svr_opts.reexec_workersock < 0
+			|| svr_opts.reexec_childpipe < 0) {
+			dropbear_exit("Bad -3");
+		}
+	}
+	if (reexec_metricsfd_arg) {
+		if (m_str_to_uint(reexec_metricsfd_arg, &svr_opts.reexec_metricsfd) == DROPBEAR_FAILURE
+			|| svr_opts.reexec_metricsfd < 0
+			|| svr_opts.reexec_childpipe < 0) {
+			dropbear_exit("Bad -4");
+		}
+	}
+	if (prefork_arg) {
+		if (m_str_to_uint(prefork_arg, &svr_opts.prefork_workers) == DROPBEAR_FAILURE
+			|| svr_opts.prefork_workers > MAX_UNAUTH_CLIENTS) {
+			dropbear_exit("Bad -N '%s'", prefork_arg);
+		}
+	}
+	if (listeners_arg) {
+		if (m_str_to_uint(listeners_arg, &svr_opts.listeners) == DROPBEAR_FAILURE
+			|| svr_opts.listeners == 0
+			|| svr_opts.listeners > MAX_LISTEN_PROCESSES) {
+			dropbear_exit("Bad -L '%s'", listeners_arg);
+		}
+	}
 
 	if (svr_opts.multiauthmethod && svr_opts.noauthpass) {
 		dropbear_exit("-t and -s are incompatible");
@@ -34,6 +34,11 @@
 #ifndef AUTH_TIMEOUT
 #define AUTH_TIMEOUT 300 /* we choose 5 minutes */
 #endif
+/* How often a session adds its metrics to the listening server's totals,
+ * in seconds. They are also added when it exits */
+#ifndef METRICS_FLUSH_INTERVAL
+#define METRICS_FLUSH_INTERVAL 10
+#endif
 
 #define DROPBEAR_SVR_PUBKEY_OPTIONS_BUILT ((DROPBEAR_SVR_PUBKEY_AUTH) && (DROPBEAR_SVR_PUBKEY_OPTIONS))
 
@@ -48,6 +53,13 @@
 #define DROPBEAR_DO_REEXEC 0
 #endif
 
+/* Fuzzing wraps select() so needs that backend */
+#if defined(HAVE_SYS_EPOLL_H) && defined(HAVE_EPOLL_CREATE1) && DROPBEAR_EPOLL && !DROPBEAR_FUZZ
+#define DROPBEAR_DO_EPOLL 1
+#else
+#define DROPBEAR_DO_EPOLL 0
+#endif
+
 /* A client should try and send an initial key exchange packet guessing
  * the algorithm that will match - saves a round trip connecting, has little
  * overhead if the guess was "wrong". */
@@ -177,6 +189,9 @@
 #define LTC_ECC521
 #endif
 
+#define DROPBEAR_NISTP ((DROPBEAR_NISTP_FAST) && (DROPBEAR_ECC) \
+	&& ((DROPBEAR_ECC_256) || (DROPBEAR_ECC_384)))
+
 #define DROPBEAR_LTC_PRNG (DROPBEAR_ECC)
 
 /* RSA can be vulnerable to timing attacks which use the time required for
@@ -242,17 +257,68 @@
 
 #define RECV_MAX_PACKET_LEN (MAX(35000, ((RECV_MAX_PAYLOAD_LEN)+100)))
 
+/* Size of the buffer that incoming data is read into, large enough to
+ * hold several packets so bulk transfers need fewer read() calls */
+#define RECV_BUFFER_LEN 65536
+
+/* The rest of a packet at least this long is read from the socket straight
+ * into the packet buffer, skipping the copy out of the receive buffer */
+#define RECV_DIRECT_MIN_LEN 4096
+
+/* Data read from all channels in one pass of the main loop before the
+ * queued packets are written out (less while an interactive channel is
+ * open), and the data each backlogged channel may send per round of the
+ * channel scheduler */
+#define SESSION_SEND_BATCH_LEN (8*TRANS_MAX_PAYLOAD_LEN)
+#define SESSION_SEND_BATCH_LOWDELAY_LEN (2*TRANS_MAX_PAYLOAD_LEN)
+/* Number of spare outgoing packet buffers kept for reuse. A pass queues a
+ * batch of full packets, overshooting by up to a scheduler turn, on top of
+ * the backlog the session loop allows, and one more buffer is being
+ * filled */
+#define WRITEBUF_POOL_SIZE (SESSION_SEND_BATCH_LEN/TRANS_MAX_PAYLOAD_LEN + 4)
+#define CHANNEL_SCHED_QUANTUM TRANS_MAX_PAYLOAD_LEN
+/* Scheduler weights. Session channels (shells, commands, scp and sftp)
+ * get a larger share than forwarded connections, which can otherwise
+ * crowd them out when there are many */
+#ifndef CHANNEL_SCHED_WEIGHT_SESSION
+#define CHANNEL_SCHED_WEIGHT_SESSION 2
+#endif
+#ifndef CHANNEL_SCHED_WEIGHT_FORWARD
+#define CHANNEL_SCHED_WEIGHT_FORWARD 1
+#endif
+
 /* for channel code */
 #define TRANS_MAX_WINDOW 500000000 /* 500MB is sufficient, stopping overflow */
 #define TRANS_MAX_WIN_INCR 500000000 /* overflow prevention */
 
-#define RECV_WINDOWEXTEND (opts.recv_window / 3) /* We send a "window extend" every
-								RECV_WINDOWEXTEND bytes */
+#define RECV_WINDOWEXTEND(channel) ((channel)->recvwindowsize / 3) /* We send a
+								"window extend" every RECV_WINDOWEXTEND bytes */
 #define MAX_RECV_WINDOW (10*1024*1024) /* 10 MB should be enough */
 
 #define MAX_CHANNELS 1000 /* simple mem restriction, includes each tcp/x11
 							connection, so can't be _too_ small */
 
+/* Lookups for outgoing connections (tcp forwarding, dbclient's host) run
+ * in a separate process and are cached. getaddrinfo() doesn't give the DNS
+ * TTL, so successful lookups are kept for a fixed time. */
+#ifndef RESOLVE_CACHE_TTL
+#define RESOLVE_CACHE_TTL 30
+#endif
+/* Names that don't exist, other failures aren't cached */
+#ifndef RESOLVE_CACHE_NEGATIVE_TTL
+#define RESOLVE_CACHE_NEGATIVE_TTL 5
+#endif
+#define RESOLVE_CACHE_SIZE 32
+/* Limits the number of addresses used from a lookup */
+#define RESOLVE_MAX_RESPONSE 4096
+
+/* Outgoing connections try the next address if an attempt hasn't connected
+ * within this time, keeping earlier attempts going (RFC 8305) */
+#ifndef CONNECT_ATTEMPT_DELAY_MS
+#define CONNECT_ATTEMPT_DELAY_MS 250
+#endif
+#define CONNECT_MAX_ATTEMPTS 8
+
 #define MAX_STRING_LEN (MAX(MAX_CMD_LEN, 2400)) /* Sun SSH needs 2400 for algos,
                                                    MAX_CMD_LEN is usually longer */
 
@@ -304,6 +370,32 @@
 
 #define DROPBEAR_AES ((DROPBEAR_AES256) || (DROPBEAR_AES128))
 
+/* Accelerated crypto uses GCC style target attributes, with the
+ * instructions detected at runtime (cpufeatures.c) */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DROPBEAR_CPU_X86 1
+#else
+#define DROPBEAR_CPU_X86 0
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) \
+	&& defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ \
+	&& ((defined(HAVE_GETAUXVAL) && defined(HAVE_SYS_AUXV_H)) \
+		|| defined(__APPLE__))
+#define DROPBEAR_CPU_ARM64 1
+#else
+#define DROPBEAR_CPU_ARM64 0
+#endif
+
+#define DROPBEAR_AES_ACCEL ((DROPBEAR_CRYPTO_ACCEL) && (DROPBEAR_AES) \
+	&& ((DROPBEAR_CPU_X86) || (DROPBEAR_CPU_ARM64)))
+#define DROPBEAR_CHACHA_ACCEL ((DROPBEAR_CRYPTO_ACCEL) && (DROPBEAR_CHACHA20POLY1305) \
+	&& ((DROPBEAR_CPU_X86) || (DROPBEAR_CPU_ARM64)))
+#define DROPBEAR_SHA2_ACCEL ((DROPBEAR_CRYPTO_ACCEL) && (DROPBEAR_SHA256) \
+	&& ((DROPBEAR_CPU_X86) || (DROPBEAR_CPU_ARM64)))
+#define DROPBEAR_SNTRUP761_ACCEL ((DROPBEAR_CRYPTO_ACCEL) && (DROPBEAR_SNTRUP761) \
+	&& ((DROPBEAR_CPU_X86) || (DROPBEAR_CPU_ARM64)))
+
 #define DROPBEAR_AEAD_MODE ((DROPBEAR_CHACHA20POLY1305) || (DROPBEAR_ENABLE_GCM_MODE))
 
 #define DROPBEAR_CLI_ANYTCPFWD ((DROPBEAR_CLI_REMOTETCPFWD) || (DROPBEAR_CLI_LOCALTCPFWD))
@@ -406,6 +498,27 @@
 #endif
 #endif
 
+/* Most connections accepted from a listening socket at a time, before
+ * the listener checks its other sockets */
+#ifndef DROPBEAR_ACCEPT_BATCH
+#define DROPBEAR_ACCEPT_BATCH 32
+#endif
+
+/* Buckets for counting unauthenticated connections by address,
+ * must be a power of two */
+#ifndef UNAUTH_ADDR_BUCKETS
+#define UNAUTH_ADDR_BUCKETS 256
+#endif
+
+/* The listener's random pool is reseeded with seedrandom() at most this
+ * often (seconds). Forked sessions reseed from the system themselves */
+#ifndef LISTENER_RESEED_INTERVAL
+#define LISTENER_RESEED_INTERVAL 60
+#endif
+
+/* Limit for -L */
+#define MAX_LISTEN_PROCESSES 64
+
 /* free memory before exiting */
 #define DROPBEAR_CLEANUP 1
 
@@ -425,6 +538,12 @@
 
 #define DROPBEAR_TRACKING_MALLOC (DROPBEAR_FUZZ)
 
+/* Set only for the objects built for "make bench", hooks for the
+ * benchmarks' self checks that mustn't be in the programs */
+#ifndef DROPBEAR_BENCH
+#define DROPBEAR_BENCH 0
+#endif
+
 /* Used to work around Memory Sanitizer false positives */
 #if defined(__has_feature)
 #  if __has_feature(memory_sanitizer)